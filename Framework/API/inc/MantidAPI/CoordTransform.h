@@ -40,6 +40,10 @@ public:
   virtual CoordTransform *clone() const = 0;
   virtual std::string id() const = 0;
 
+  /// Apply the transformation to a block of points
+  virtual void applyBatch(const coord_t *inputVectors, size_t inputStride,
+                          coord_t *outVectors, size_t numPoints) const;
+
   /// Wrapper for VMD
   Mantid::Kernel::VMD applyVMD(const Mantid::Kernel::VMD &inputVector) const;
 
@@ -4,14 +4,46 @@
 //   NScD Oak Ridge National Laboratory, European Spallation Source,
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
-#include "MantidAPI/AlgoTimeRegister.h"
 #include "MantidAPI/Algorithm.h"
+#include "MantidAPI/IEventWorkspace.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidKernel/AlgoTimeRegister.h"
 
 namespace Mantid {
-Instrumentation::AlgoTimeRegister
-    Instrumentation::AlgoTimeRegister::globalAlgoTimeRegister;
 namespace API {
 
+namespace {
+/// Starts recording spans when the library is loaded
+struct EnableProfiling {
+  EnableProfiling() {
+    Instrumentation::AlgoTimeRegister::globalAlgoTimeRegister.enable();
+  }
+} enableProfiling;
+
+/** Count the events in the event workspace properties of an algorithm
+ * @param properties :: the properties of the algorithm
+ * @param output :: count the output workspaces if true, else the inputs
+ * @return the number of events
+ */
+uint64_t countEvents(const std::vector<Kernel::Property *> &properties,
+                     bool output) {
+  uint64_t events = 0;
+  for (const auto *prop : properties) {
+    const auto *wsProp = dynamic_cast<const IWorkspaceProperty *>(prop);
+    if (!wsProp)
+      continue;
+    const bool isOutput = prop->direction() != Kernel::Direction::Input;
+    const bool isInput = prop->direction() != Kernel::Direction::Output;
+    if (output ? !isOutput : !isInput)
+      continue;
+    if (auto eventWS =
+            std::dynamic_pointer_cast<IEventWorkspace>(wsProp->getWorkspace()))
+      events += eventWS->getNumberEvents();
+  }
+  return events;
+}
+} // namespace
+
 //---------------------------------------------------------------------------------------------
 /** The actions to be performed by the algorithm on a dataset. This method is
  *  invoked for top level algorithms by the application manager.
@@ -19,14 +51,24 @@ namespace API {
  *  For Child Algorithms either the execute() method or exec() method
  *  must be EXPLICITLY invoked by the parent algorithm.
  *
+ *  The execution is recorded as a span of the global AlgoTimeRegister, along
+ *  with the number of events in its input event workspaces, or its output
+ *  event workspaces if it has no inputs (e.g. loaders).
+ *
  *  @throw runtime_error Thrown if algorithm or Child Algorithm cannot be
  *executed
  *  @return true if executed successfully.
  */
 bool Algorithm::execute() {
-  Instrumentation::AlgoTimeRegister::AlgoTimeRegister::Dump dmp(
+  Instrumentation::AlgoTimeRegister::Dump dmp(
       Instrumentation::AlgoTimeRegister::globalAlgoTimeRegister, name());
-  return executeInternal();
+  const bool result = executeInternal();
+  const auto &properties = getProperties();
+  uint64_t events = countEvents(properties, false);
+  if (events == 0)
+    events = countEvents(properties, true);
+  Instrumentation::AlgoTimeRegister::addEventsProcessed(events);
+  return result;
 }
 } // namespace API
-} // namespace Mantid
\ No newline at end of file
+} // namespace Mantid
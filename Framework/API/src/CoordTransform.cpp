@@ -58,5 +58,26 @@ CoordTransform::applyVMD(const Mantid::Kernel::VMD &inputVector) const {
   return out;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the transformation to a block of points, e.g. the centers of the
+ * events of a box. Subclasses override this with kernels that avoid the
+ * virtual call and the loop overheads for each point.
+ *
+ * @param inputVectors :: the coordinates of the first point, of size inD
+ * @param inputStride :: the distance between the first coordinates of
+ *consecutive points, in units of coord_t. This is inD for packed
+ *coordinates, or sizeof(event) / sizeof(coord_t) for the centers of an array
+ *of events.
+ * @param outVectors :: array of size outD * numPoints for the packed output
+ *coordinates
+ * @param numPoints :: the number of points
+ */
+void CoordTransform::applyBatch(const coord_t *inputVectors,
+                                const size_t inputStride, coord_t *outVectors,
+                                const size_t numPoints) const {
+  for (size_t i = 0; i < numPoints; ++i)
+    this->apply(inputVectors + i * inputStride, outVectors + i * outD);
+}
+
 } // namespace API
 } // namespace Mantid
@@ -105,6 +105,9 @@ private:
   /// Set up detector calibration parameters from customized values
   void setupCustomizedTOFCorrection();
 
+  /// Output workspaces indexed by target + 1
+  std::vector<DataObjects::EventWorkspace *> outputWorkspacesByTarget();
+
   /// Filter events by splitters in format of Splitter
   void filterEventsBySplitters(double progressamount);
 
@@ -150,11 +153,18 @@ private:
           &string_tsp_vector);
 
   template <typename TYPE>
-  void splitTimeSeriesProperty(
-      Kernel::TimeSeriesProperty<TYPE> *tsp,
-      std::vector<Types::Core::DateAndTime> &split_datetime_vec,
+  void splitTimeSeriesProperties(
+      const std::vector<Kernel::TimeSeriesProperty<TYPE> *> &tsp_vector,
+      const std::vector<Types::Core::DateAndTime> &split_datetime_vec,
       const int max_target_index);
 
+  template <typename TYPE>
+  std::vector<std::unique_ptr<Kernel::TimeSeriesProperty<TYPE>>>
+  splitTimeSeriesProperty(
+      Kernel::TimeSeriesProperty<TYPE> *tsp,
+      const std::vector<Types::Core::DateAndTime> &split_datetime_vec,
+      const int max_target_index) const;
+
   void groupOutputWorkspace();
 
   /// calculate split-workspace's duration according to splitter time series
@@ -0,0 +1,66 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAlgorithms/DllConfig.h"
+#include "MantidKernel/LRUCache.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Algorithms {
+
+/**
+  MCAbsorptionCache : Keeps the attenuation factors simulated by
+  MonteCarloAbsorption for a detector, so that later runs with the same
+  sample, environment, beam, instrument and settings can reuse them.
+
+  The entries are found by the Kernel::HashBuilder hash of everything the
+  simulation of a detector depends on. They are kept in a Kernel::LRUCache up
+  to a memory limit, beyond which the least recently used are dropped. If
+  a spill directory is set every entry is also written to it, where later
+  runs and sessions find the entries that are no longer in memory.
+
+  One cache is shared by all the runs of the algorithm, see instance().
+  All the methods are thread safe.
+*/
+class MANTID_ALGORITHMS_DLL MCAbsorptionCache {
+public:
+  /// The simulated attenuation factors of a detector
+  struct Entry {
+    std::vector<double> lambdas;
+    std::vector<double> attenuationFactors;
+    std::vector<double> attenuationFactorErrors;
+  };
+
+  static MCAbsorptionCache &instance();
+
+  explicit MCAbsorptionCache(const size_t memoryLimit = DEFAULT_MEMORY_LIMIT);
+
+  bool find(const uint64_t key, Entry &entry);
+  void insert(const uint64_t key, Entry entry);
+  void clear();
+  void setMemoryLimit(const size_t bytes);
+  void setSpillDirectory(const std::string &directory);
+  size_t numberInMemory() const;
+  size_t memoryUsed() const;
+
+  /// The default size in bytes of the entries kept in memory
+  static constexpr size_t DEFAULT_MEMORY_LIMIT = 256 * 1024 * 1024;
+
+private:
+  Kernel::LRUCache<Entry> m_entries;
+  /// Guards the spill directory
+  mutable std::mutex m_mutex;
+  std::string m_spillDirectory;
+};
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -14,6 +14,8 @@
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/SampleEnvironment.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/RayBatch.h"
 #include "MantidGeometry/Objects/ShapeFactory.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidHistogramData/Interpolate.h"
@@ -430,6 +432,17 @@ void AbsorptionCorrection::calculateDistances(const IDetector &detector,
                           detector.getPhi() * 180.0 / M_PI);
   }
 
+  // Trace the rays from every element at once through a CSG shape
+  if (const auto *csgObject = dynamic_cast<const CSGObject *>(m_sampleObject)) {
+    RayBatch rays;
+    rays.reserve(m_numVolumeElements);
+    for (size_t i = 0; i < m_numVolumeElements; ++i)
+      rays.add(m_elementPositions[i],
+               normalize(detectorPos - m_elementPositions[i]));
+    csgObject->pathLengths(rays, L2s);
+    return;
+  }
+
   for (size_t i = 0; i < m_numVolumeElements; ++i) {
     // Create track for distance in cylinder between scattering point and
     // detector
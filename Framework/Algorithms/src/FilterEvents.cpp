@@ -706,25 +706,14 @@ void FilterEvents::splitTimeSeriesLogs(
   if (m_useSplittersWorkspace)
     ++max_target_index;
 
-  // deal with integer time series property
-  for (const auto &int_tsp : int_tsp_vector) {
-    splitTimeSeriesProperty(int_tsp, split_datetime_vec, max_target_index);
-  }
-
-  // split double time series property
-  for (const auto &dbl_tsp : dbl_tsp_vector) {
-    splitTimeSeriesProperty(dbl_tsp, split_datetime_vec, max_target_index);
-  }
-
-  // deal with bool time series property
-  for (const auto &bool_tsp : bool_tsp_vector) {
-    splitTimeSeriesProperty(bool_tsp, split_datetime_vec, max_target_index);
-  }
-
-  // deal with string time series property
-  for (const auto &string_tsp : string_tsp_vector) {
-    splitTimeSeriesProperty(string_tsp, split_datetime_vec, max_target_index);
-  }
+  splitTimeSeriesProperties(int_tsp_vector, split_datetime_vec,
+                            max_target_index);
+  splitTimeSeriesProperties(dbl_tsp_vector, split_datetime_vec,
+                            max_target_index);
+  splitTimeSeriesProperties(bool_tsp_vector, split_datetime_vec,
+                            max_target_index);
+  splitTimeSeriesProperties(string_tsp_vector, split_datetime_vec,
+                            max_target_index);
 
   // integrate proton charge
   for (int tindex = 0; tindex <= max_target_index; ++tindex) {
@@ -743,19 +732,64 @@ void FilterEvents::splitTimeSeriesLogs(
   return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Split time-series properties of one type to all the output workspaces.
+ * The logs are split in parallel, each in one pass over its entries, and are
+ * then added to the output workspaces in their original order.
+ * @param tsp_vector :: the time series properties
+ * @param split_datetime_vec :: splitter
+ * @param max_target_index :: maximum number of separated time series
+ */
+template <typename TYPE>
+void FilterEvents::splitTimeSeriesProperties(
+    const std::vector<Kernel::TimeSeriesProperty<TYPE> *> &tsp_vector,
+    const std::vector<Types::Core::DateAndTime> &split_datetime_vec,
+    const int max_target_index) {
+  const auto numberOfLogs = static_cast<int64_t>(tsp_vector.size());
+  std::vector<std::vector<std::unique_ptr<TimeSeriesProperty<TYPE>>>>
+      split_logs(tsp_vector.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numberOfLogs; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    split_logs[i] = splitTimeSeriesProperty(tsp_vector[i], split_datetime_vec,
+                                            max_target_index);
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // assign to output workspaces
+  for (auto &output_vector : split_logs) {
+    for (int tindex = 0; tindex <= max_target_index; ++tindex) {
+      // find output workspace
+      auto wsiter = m_outputWorkspacesMap.find(tindex);
+      if (wsiter == m_outputWorkspacesMap.end()) {
+        // unable to find workspace associated with target index
+        g_log.information() << "Workspace target (" << tindex
+                            << ") does not have workspace associated."
+                            << "\n";
+      } else {
+        // add property to the associated workspace
+        DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
+        ws_i->mutableRun().addProperty(std::move(output_vector[tindex]), true);
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** split one single time-series property (template)
  * @brief FilterEvents::splitTimeSeriesProperty
  * @param tsp :: a time series property instance
  * @param split_datetime_vec :: splitter
  * @param max_target_index :: maximum number of separated time series
+ * @return the split properties indexed by target
  */
 template <typename TYPE>
-void FilterEvents::splitTimeSeriesProperty(
+std::vector<std::unique_ptr<TimeSeriesProperty<TYPE>>>
+FilterEvents::splitTimeSeriesProperty(
     Kernel::TimeSeriesProperty<TYPE> *tsp,
-    std::vector<Types::Core::DateAndTime> &split_datetime_vec,
-    const int max_target_index) {
-  // skip the sample logs if they are specified
+    const std::vector<Types::Core::DateAndTime> &split_datetime_vec,
+    const int max_target_index) const {
   // get property name and etc
   const std::string &property_name = tsp->name();
   // generate new propertys for the source to split to
@@ -787,23 +821,7 @@ void FilterEvents::splitTimeSeriesProperty(
                            split_properties);
   }
 
-  // assign to output workspaces
-  for (int tindex = 0; tindex <= max_target_index; ++tindex) {
-    // find output workspace
-    auto wsiter = m_outputWorkspacesMap.find(tindex);
-    if (wsiter == m_outputWorkspacesMap.end()) {
-      // unable to find workspace associated with target index
-      g_log.information() << "Workspace target (" << tindex
-                          << ") does not have workspace associated."
-                          << "\n";
-    } else {
-      // add property to the associated workspace
-      DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
-      ws_i->mutableRun().addProperty(std::move(output_vector[tindex]), true);
-    }
-  }
-
-  return;
+  return output_vector;
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1685,6 +1703,26 @@ void FilterEvents::setupCustomizedTOFCorrection() {
   }
 }
 
+/** Index the output workspaces by target + 1, the first one being for the
+ * unfiltered events, and invalidate their common bins flags once so that the
+ * event lists of every target can be fetched without a lock in the filtering
+ * loops
+ * @return the output workspaces, nullptr for a target without one
+ */
+std::vector<EventWorkspace *> FilterEvents::outputWorkspacesByTarget() {
+  std::vector<EventWorkspace *> outputWorkspaces;
+  for (auto &ws : m_outputWorkspacesMap) {
+    if (ws.first < -1)
+      continue;
+    const auto index = static_cast<size_t>(ws.first + 1);
+    if (index >= outputWorkspaces.size())
+      outputWorkspaces.resize(index + 1, nullptr);
+    outputWorkspaces[index] = ws.second.get();
+    ws.second->invalidateCommonBinsFlag();
+  }
+  return outputWorkspaces;
+}
+
 /** Main filtering method
  * Structure: per spectrum --> per workspace
  */
@@ -1696,7 +1734,8 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   g_log.debug() << "Number of spectra in input/source EventWorkspace = "
                 << numberOfSpectra << ".\n";
 
-  // FIXME - Turn on parallel:
+  const auto outputWorkspaces = outputWorkspacesByTarget();
+
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
@@ -1705,12 +1744,10 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
     if (!m_vecSkip[iws]) {
       // Get the output event lists (should be empty) to be a map
       std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
+      for (size_t i = 0; i < outputWorkspaces.size(); ++i) {
+        if (outputWorkspaces[i])
+          outputs.emplace(static_cast<int>(i) - 1,
+                          outputWorkspaces[i]->getSpectrumUnsafe(iws));
       }
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
@@ -1741,7 +1778,6 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
  */
 void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
   size_t numberOfSpectra = m_eventWS->getNumberHistograms();
-  // FIXME : consider to use vector to index workspace and event list
 
   // Loop over the histograms (detector spectra) to do split from 1 event list
   // to N event list
@@ -1769,20 +1805,20 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
                     "by pulse time.");
   }
 
+  const auto outputWorkspaces = outputWorkspacesByTarget();
+
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped spectrum
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
+      // Get the output event lists (should be empty) indexed by target + 1
+      std::vector<DataObjects::EventList *> outputs(outputWorkspaces.size(),
+                                                    nullptr);
+      for (size_t i = 0; i < outputWorkspaces.size(); ++i) {
+        if (outputWorkspaces[i])
+          outputs[i] = outputWorkspaces[i]->getSpectrumUnsafe(iws);
       }
 
       // Get a holder on input workspace's event list of this spectrum
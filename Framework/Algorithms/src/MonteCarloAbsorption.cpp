@@ -5,27 +5,38 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAlgorithms/MonteCarloAbsorption.h"
+#include "MantidAPI/FileProperty.h"
 #include "MantidAPI/InstrumentValidator.h"
 #include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceUnitValidator.h"
 #include "MantidAlgorithms/InterpolationOption.h"
 #include "MantidAlgorithms/SampleCorrections/DetectorGridDefinition.h"
+#include "MantidAlgorithms/SampleCorrections/MCAbsorptionCache.h"
 #include "MantidAlgorithms/SampleCorrections/MCInteractionStatistics.h"
 #include "MantidAlgorithms/SampleCorrections/RectangularBeamProfile.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/SampleEnvironment.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/MeshObject.h"
+#include "MantidGeometry/Objects/MeshObject2D.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/DeltaEMode.h"
 #include "MantidKernel/EnabledWhenProperty.h"
+#include "MantidKernel/HashBuilder.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/Material.h"
 #include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/Philox.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <typeinfo>
+
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
@@ -39,6 +50,7 @@ constexpr int DEFAULT_NEVENTS = 1000;
 constexpr int DEFAULT_SEED = 123456789;
 constexpr int DEFAULT_LATITUDINAL_DETS = 5;
 constexpr int DEFAULT_LONGITUDINAL_DETS = 10;
+constexpr int DEFAULT_CACHE_MEMORY_LIMIT = 256;
 
 /// Energy (meV) to wavelength (angstroms)
 inline double toWavelength(double energy) {
@@ -68,6 +80,67 @@ private:
   const DeltaEMode::Type m_emode;
   double m_value;
 };
+
+/**
+ * Add the geometry of a shape to a hash, and keep its material
+ * @param hash The hash to add to
+ * @param shape The shape
+ * @param materials The materials of the shapes added so far
+ * @return false if the geometry cannot be described, so the attenuation
+ * factors must not be cached
+ */
+bool addShape(HashBuilder &hash, const IObject &shape,
+              std::vector<const Material *> &materials) {
+  materials.emplace_back(&shape.material());
+  hash.add(std::string(typeid(shape).name()));
+  if (const auto *csgObject = dynamic_cast<const CSGObject *>(&shape)) {
+    // A CSG object built without XML cannot be told apart from others
+    const auto shapeXML = csgObject->getShapeXML();
+    hash.add(shapeXML);
+    return !shapeXML.empty() || !csgObject->hasValidShape();
+  }
+  std::vector<uint32_t> triangles;
+  if (const auto *mesh = dynamic_cast<const MeshObject *>(&shape)) {
+    hash.add(mesh->getVertices());
+    triangles = mesh->getTriangles();
+  } else if (const auto *mesh2D = dynamic_cast<const MeshObject2D *>(&shape)) {
+    hash.add(mesh2D->getVertices());
+    triangles = mesh2D->getTriangles();
+  } else {
+    return false;
+  }
+  hash.add(static_cast<uint64_t>(triangles.size()));
+  hash.add(triangles.data(), triangles.size() * sizeof(uint32_t));
+  return true;
+}
+
+/**
+ * Add the geometry of the sample, its environment and the beam to a hash
+ * @param hash The hash to add to
+ * @param sample The sample
+ * @param instrument The instrument
+ * @param materials The materials of the sample and its environment
+ * @return false if the geometry cannot be described, so the attenuation
+ * factors must not be cached
+ */
+bool addSetup(HashBuilder &hash, const Sample &sample,
+              const Instrument &instrument,
+              std::vector<const Material *> &materials) {
+  bool described = addShape(hash, sample.getShape(), materials);
+  if (sample.hasEnvironment()) {
+    const auto &environment = sample.getEnvironment();
+    hash.add(static_cast<uint64_t>(environment.nelements()));
+    for (size_t i = 0; i < environment.nelements(); ++i)
+      described &= addShape(hash, environment.getComponent(i), materials);
+  }
+  const auto frame = instrument.getReferenceFrame();
+  const auto source = instrument.getSource();
+  hash.add(frame->vecPointingUp()).add(frame->vecPointingAlongBeam());
+  hash.add(source->getPos());
+  hash.add(source->getNumberParameter("beam-width"));
+  hash.add(source->getNumberParameter("beam-height"));
+  return described;
+}
 } // namespace
 /// @endcond
 
@@ -107,6 +180,14 @@ void MonteCarloAbsorption::init() {
       "The number of \"neutron\" events to generate per simulated point");
   declareProperty("SeedValue", DEFAULT_SEED, positiveInt,
                   "Seed the random number generator with this value");
+  auto generatorValidator = std::make_shared<StringListValidator>();
+  generatorValidator->addAllowedValue("MersenneTwister");
+  generatorValidator->addAllowedValue("Philox");
+  declareProperty("RandomNumberGenerator", "MersenneTwister",
+                  "The random number generator. With MersenneTwister every "
+                  "spectrum draws the same sequence of random numbers. With "
+                  "Philox every detector draws its own independent sequence.",
+                  generatorValidator);
 
   auto interpolateOpt = createInterpolateOption();
   declareProperty(interpolateOpt->property(), interpolateOpt->propertyDoc());
@@ -160,6 +241,25 @@ void MonteCarloAbsorption::init() {
       "Simulate the scattering point in the vicinity of the sample or its "
       "environment or both (default).",
       scatteringOptionValidator);
+
+  declareProperty("UseCache", false,
+                  "Reuse the attenuation factors of the detectors simulated "
+                  "by earlier runs with the same sample, environment, beam, "
+                  "instrument and settings, and keep the new ones for later "
+                  "runs.");
+  declareProperty(std::make_unique<FileProperty>(
+                      "CacheDirectory", "", FileProperty::OptionalDirectory),
+                  "A directory the cached attenuation factors are also "
+                  "written to, where later sessions can find them.");
+  setPropertySettings("CacheDirectory",
+                      std::make_unique<EnabledWhenProperty>(
+                          "UseCache", ePropertyCriterion::IS_NOT_DEFAULT));
+  declareProperty("CacheMemoryLimit", DEFAULT_CACHE_MEMORY_LIMIT, positiveInt,
+                  "The size in MB of the cached attenuation factors kept in "
+                  "memory, shared by all runs of the algorithm.");
+  setPropertySettings("CacheMemoryLimit",
+                      std::make_unique<EnabledWhenProperty>(
+                          "UseCache", ePropertyCriterion::IS_NOT_DEFAULT));
 }
 
 /**
@@ -351,6 +451,33 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
       createStrategy(*interactionVolume, *beamProfile, efixed.emode(), nevents,
                      maxScatterPtAttempts, resimulateTracksForDiffWavelengths);
 
+  // The attenuation factors of a detector depend on the setup hashed here,
+  // its position and the wavelengths
+  MCAbsorptionCache *cache(nullptr);
+  HashBuilder setupHash;
+  std::vector<const Material *> materials;
+  const auto generator = getPropertyValue("RandomNumberGenerator");
+  const bool useCache = getProperty("UseCache");
+  if (useCache) {
+    setupHash.add(std::string(typeid(*this).name()))
+        .add(generator)
+        .add(static_cast<uint64_t>(nevents))
+        .add(static_cast<uint64_t>(seed))
+        .add(static_cast<uint64_t>(maxScatterPtAttempts))
+        .add(static_cast<uint64_t>(resimulateTracksForDiffWavelengths))
+        .add(static_cast<uint64_t>(pointsIn))
+        .add(static_cast<uint64_t>(efixed.emode()));
+    if (addSetup(setupHash, inputWS.sample(), *instrument, materials)) {
+      cache = &MCAbsorptionCache::instance();
+      const int memoryLimit = getProperty("CacheMemoryLimit");
+      cache->setMemoryLimit(static_cast<size_t>(memoryLimit) * 1024 * 1024);
+      cache->setSpillDirectory(getPropertyValue("CacheDirectory"));
+    } else {
+      g_log.warning("The attenuation factors are not cached as the shape of "
+                    "the sample or its environment has no description.\n");
+    }
+  }
+
   const auto &spectrumInfo = simulationWS.spectrumInfo();
 
   PARALLEL_FOR_IF(Kernel::threadSafe(simulationWS))
@@ -366,9 +493,19 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
     }
     // Per spectrum values
     const auto &detPos = spectrumInfo.position(i);
-    const double lambdaFixed =
-        toWavelength(efixed.value(spectrumInfo.detector(i).getID()));
-    MersenneTwister rng(seed);
+    const auto detID = spectrumInfo.detector(i).getID();
+    const double lambdaFixed = toWavelength(efixed.value(detID));
+    // The stream of the Philox generator is given by the detector, so that
+    // the factors of a detector do not depend on its workspace index
+    const auto stream = static_cast<uint64_t>(static_cast<uint32_t>(detID));
+    std::unique_ptr<PseudoRandomNumberGenerator> rng;
+    if (generator == "Philox") {
+      auto philox = std::make_unique<Philox>(seed);
+      philox->setStream(stream);
+      rng = std::move(philox);
+    } else {
+      rng = std::make_unique<MersenneTwister>(seed);
+    }
 
     const auto lambdas = simulationWS.points(i).rawData();
 
@@ -388,14 +525,39 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
         j = nbins - lambdaStepSize - 1;
       }
     }
-    MCInteractionStatistics detStatistics(spectrumInfo.detector(i).getID(),
-                                          inputWS.sample());
+    uint64_t cacheKey(0);
+    MCAbsorptionCache::Entry cached;
+    if (cache) {
+      auto hash = setupHash;
+      hash.add(detPos).add(lambdaFixed).add(packedLambdas);
+      if (generator == "Philox")
+        hash.add(stream);
+      for (const auto *material : materials) {
+        for (const auto lambda : packedLambdas)
+          hash.add(material->attenuationCoefficient(lambda));
+        if (efixed.emode() != DeltaEMode::Elastic)
+          hash.add(material->attenuationCoefficient(lambdaFixed));
+      }
+      cacheKey = hash.value();
+    }
+    if (cache && cache->find(cacheKey, cached) &&
+        cached.lambdas == packedLambdas) {
+      packedAttFactors = std::move(cached.attenuationFactors);
+      packedAttFactorErrors = std::move(cached.attenuationFactorErrors);
+    } else {
+      MCInteractionStatistics detStatistics(detID, inputWS.sample());
 
-    strategy->calculate(rng, detPos, packedLambdas, lambdaFixed,
-                        packedAttFactors, packedAttFactorErrors, detStatistics);
+      strategy->calculate(*rng, detPos, packedLambdas, lambdaFixed,
+                          packedAttFactors, packedAttFactorErrors,
+                          detStatistics);
 
-    if (g_log.is(Kernel::Logger::Priority::PRIO_DEBUG)) {
-      g_log.debug(detStatistics.generateScatterPointStats());
+      if (g_log.is(Kernel::Logger::Priority::PRIO_DEBUG)) {
+        g_log.debug(detStatistics.generateScatterPointStats());
+      }
+      if (cache) {
+        cache->insert(cacheKey, {packedLambdas, packedAttFactors,
+                                 packedAttFactorErrors});
+      }
     }
 
     for (size_t j = 0; j < packedLambdas.size(); j++) {
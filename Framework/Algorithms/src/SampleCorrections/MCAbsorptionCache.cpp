@@ -0,0 +1,187 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAlgorithms/SampleCorrections/MCAbsorptionCache.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Mantid {
+namespace Algorithms {
+
+namespace {
+/// The first value of a spilled entry, to recognise the files
+constexpr uint64_t SPILL_MAGIC = 0x3130305342414d43ull; // "MCABS001"
+
+/// @return the size in bytes of the values of an entry
+size_t entrySize(const MCAbsorptionCache::Entry &entry) {
+  return (entry.lambdas.size() + entry.attenuationFactors.size() +
+          entry.attenuationFactorErrors.size()) *
+         sizeof(double);
+}
+
+/**
+ * @param directory :: the spill directory
+ * @param key :: the hash of what an entry depends on
+ * @return the path of the file of the entry in the spill directory
+ */
+std::string spillPath(const std::string &directory, const uint64_t key) {
+  std::ostringstream name;
+  name << "MCAbsorption_" << std::hex << std::setw(16) << std::setfill('0')
+       << key << ".bin";
+  return Poco::Path(Poco::Path(directory), name.str()).toString();
+}
+
+/**
+ * Read an entry from the spill directory
+ * @param directory :: the spill directory
+ * @param key :: the hash of what the entry depends on
+ * @param[out] entry :: the entry, if found
+ * @return true if a complete entry was read
+ */
+bool readSpilled(const std::string &directory, const uint64_t key,
+                 MCAbsorptionCache::Entry &entry) {
+  std::ifstream file(spillPath(directory, key), std::ios::binary);
+  if (!file)
+    return false;
+  uint64_t header[2];
+  if (!file.read(reinterpret_cast<char *>(header), sizeof(header)) ||
+      header[0] != SPILL_MAGIC || header[1] != key)
+    return false;
+  MCAbsorptionCache::Entry read;
+  for (auto *values : {&read.lambdas, &read.attenuationFactors,
+                       &read.attenuationFactorErrors}) {
+    uint64_t size;
+    if (!file.read(reinterpret_cast<char *>(&size), sizeof(size)))
+      return false;
+    values->resize(static_cast<size_t>(size));
+    if (!file.read(reinterpret_cast<char *>(values->data()),
+                   values->size() * sizeof(double)))
+      return false;
+  }
+  entry = std::move(read);
+  return true;
+}
+
+/**
+ * Write an entry to the spill directory. It is written to a temporary file
+ * first, so that other processes never read part of it.
+ * @param directory :: the spill directory
+ * @param key :: the hash of what the entry depends on
+ * @param entry :: the entry
+ */
+void writeSpilled(const std::string &directory, const uint64_t key,
+                  const MCAbsorptionCache::Entry &entry) {
+  const auto path = spillPath(directory, key);
+  const auto temporary = path + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    const uint64_t header[2] = {SPILL_MAGIC, key};
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    for (const auto *values : {&entry.lambdas, &entry.attenuationFactors,
+                               &entry.attenuationFactorErrors}) {
+      const uint64_t size = values->size();
+      file.write(reinterpret_cast<const char *>(&size), sizeof(size));
+      file.write(reinterpret_cast<const char *>(values->data()),
+                 values->size() * sizeof(double));
+    }
+    if (!file)
+      return;
+  }
+  std::rename(temporary.c_str(), path.c_str());
+}
+} // namespace
+
+/// @return the cache shared by all the runs of MonteCarloAbsorption
+MCAbsorptionCache &MCAbsorptionCache::instance() {
+  static MCAbsorptionCache cache;
+  return cache;
+}
+
+/**
+ * Constructor
+ * @param memoryLimit :: the size in bytes of the entries kept in memory
+ */
+MCAbsorptionCache::MCAbsorptionCache(const size_t memoryLimit)
+    : m_entries(memoryLimit) {}
+
+/**
+ * Find an entry, in memory or else in the spill directory
+ * @param key :: the hash of what the entry depends on
+ * @param[out] entry :: the entry, if found
+ * @return true if the entry was found
+ */
+bool MCAbsorptionCache::find(const uint64_t key, Entry &entry) {
+  if (const auto found = m_entries.find(key)) {
+    entry = *found;
+    return true;
+  }
+  std::string spillDirectory;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    spillDirectory = m_spillDirectory;
+  }
+  if (spillDirectory.empty() || !readSpilled(spillDirectory, key, entry))
+    return false;
+  m_entries.insert(key, std::make_shared<const Entry>(entry), entrySize(entry));
+  return true;
+}
+
+/**
+ * Add an entry, replacing any with the same key. It is also written to the
+ * spill directory, if one is set.
+ * @param key :: the hash of what the entry depends on
+ * @param entry :: the entry
+ */
+void MCAbsorptionCache::insert(const uint64_t key, Entry entry) {
+  std::string spillDirectory;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    spillDirectory = m_spillDirectory;
+  }
+  if (!spillDirectory.empty())
+    writeSpilled(spillDirectory, key, entry);
+  const auto size = entrySize(entry);
+  m_entries.insert(key, std::make_shared<const Entry>(std::move(entry)), size);
+}
+
+/// Remove every entry from memory. The spill directory is left as it is.
+void MCAbsorptionCache::clear() { m_entries.clear(); }
+
+/**
+ * Set the size of the entries kept in memory, removing the least recently
+ * used entries beyond it
+ * @param bytes :: the size in bytes
+ */
+void MCAbsorptionCache::setMemoryLimit(const size_t bytes) {
+  m_entries.setMemoryLimit(bytes);
+}
+
+/**
+ * Set the directory the entries are written to, creating it if needed
+ * @param directory :: the directory, or an empty string to keep the entries
+ * in memory only
+ */
+void MCAbsorptionCache::setSpillDirectory(const std::string &directory) {
+  if (!directory.empty())
+    Poco::File(directory).createDirectories();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_spillDirectory = directory;
+}
+
+/// @return the number of entries in memory
+size_t MCAbsorptionCache::numberInMemory() const { return m_entries.size(); }
+
+/// @return the size in bytes of the entries in memory
+size_t MCAbsorptionCache::memoryUsed() const { return m_entries.memory(); }
+
+} // namespace Algorithms
+} // namespace Mantid
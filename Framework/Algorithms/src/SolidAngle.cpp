@@ -14,11 +14,13 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/SolidAngleEngine.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/UnitFactory.h"
 
 #include <atomic>
+#include <cmath>
 
 namespace Mantid {
 namespace Algorithms {
@@ -109,10 +111,29 @@ protected:
 };
 
 struct GenericShape : public SolidAngleCalculator {
-  using SolidAngleCalculator::SolidAngleCalculator;
+  /// Use the solid angles of all the detectors from SolidAngleEngine if
+  /// useEngine is set, else compute each detector when asked
+  GenericShape(const ComponentInfo &componentInfo,
+               const DetectorInfo &detectorInfo, const std::string &method,
+               const double pixelArea, const bool useEngine)
+      : SolidAngleCalculator(componentInfo, detectorInfo, method, pixelArea) {
+    if (useEngine) {
+      m_solidAngles = SolidAngleEngine::instance().solidAngles(
+          componentInfo, detectorInfo, m_samplePos);
+    }
+  }
   double solidAngle(size_t index) const override {
+    if (m_solidAngles) {
+      const double solidAngle = (*m_solidAngles)[index];
+      // Detectors without a shape are NaN, and throw below as before
+      if (!std::isnan(solidAngle))
+        return solidAngle;
+    }
     return m_detectorInfo.detector(index).solidAngle(m_samplePos);
   }
+
+private:
+  std::shared_ptr<const SolidAngleEngine::Table> m_solidAngles;
 };
 
 struct Rectangle : public SolidAngleCalculator {
@@ -253,8 +274,11 @@ void SolidAngle::exec() {
 
   std::unique_ptr<SolidAngleCalculator> solidAngleCalculator;
   if (method == GENERIC_SHAPE) {
+    // Computing every detector at once pays off unless only a few are asked
+    const bool useEngine =
+        2 * (m_MaxSpec - m_MinSpec + 1) >= numberOfSpectra;
     solidAngleCalculator = std::make_unique<GenericShape>(
-        componentInfo, detectorInfo, method, pixelArea);
+        componentInfo, detectorInfo, method, pixelArea, useEngine);
   } else if (method == RECTANGLE) {
     solidAngleCalculator = std::make_unique<Rectangle>(
         componentInfo, detectorInfo, method, pixelArea);
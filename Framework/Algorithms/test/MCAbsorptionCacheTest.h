@@ -0,0 +1,86 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAlgorithms/SampleCorrections/MCAbsorptionCache.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+using Mantid::Algorithms::MCAbsorptionCache;
+
+class MCAbsorptionCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MCAbsorptionCacheTest *createSuite() {
+    return new MCAbsorptionCacheTest();
+  }
+  static void destroySuite(MCAbsorptionCacheTest *suite) { delete suite; }
+
+  void test_find_returns_inserted_entry() {
+    MCAbsorptionCache cache;
+    MCAbsorptionCache::Entry entry;
+    TS_ASSERT(!cache.find(1, entry));
+    cache.insert(1, makeEntry(1.));
+    TS_ASSERT(cache.find(1, entry));
+    TS_ASSERT_EQUALS(entry.lambdas, std::vector<double>({1., 2.}));
+    TS_ASSERT_EQUALS(entry.attenuationFactors, std::vector<double>({0.5, 1.}));
+    TS_ASSERT_EQUALS(entry.attenuationFactorErrors,
+                     std::vector<double>({0.05, 0.1}));
+    TS_ASSERT(!cache.find(2, entry));
+    TS_ASSERT_EQUALS(cache.numberInMemory(), 1);
+    TS_ASSERT_EQUALS(cache.memoryUsed(), 6 * sizeof(double));
+    cache.clear();
+    TS_ASSERT(!cache.find(1, entry));
+    TS_ASSERT_EQUALS(cache.memoryUsed(), 0);
+  }
+
+  void test_least_recently_used_entries_are_dropped() {
+    MCAbsorptionCache cache(12 * sizeof(double));
+    cache.insert(1, makeEntry(1.));
+    cache.insert(2, makeEntry(2.));
+    MCAbsorptionCache::Entry entry;
+    TS_ASSERT(cache.find(1, entry));
+    cache.insert(3, makeEntry(3.));
+    TS_ASSERT_EQUALS(cache.numberInMemory(), 2);
+    TS_ASSERT(cache.find(1, entry));
+    TS_ASSERT(!cache.find(2, entry));
+    TS_ASSERT(cache.find(3, entry));
+    cache.setMemoryLimit(0);
+    TS_ASSERT_EQUALS(cache.numberInMemory(), 0);
+  }
+
+  void test_entries_are_found_in_the_spill_directory() {
+    const auto directory =
+        Poco::Path(Poco::Path::temp(), "MCAbsorptionCacheTest").toString();
+    MCAbsorptionCache cache;
+    cache.setSpillDirectory(directory);
+    cache.insert(42, makeEntry(4.));
+    cache.clear();
+
+    // Also by another cache, as in a later session
+    MCAbsorptionCache later;
+    later.setSpillDirectory(directory);
+    MCAbsorptionCache::Entry entry;
+    TS_ASSERT(later.find(42, entry));
+    TS_ASSERT_EQUALS(entry.lambdas, std::vector<double>({4., 8.}));
+    TS_ASSERT_EQUALS(entry.attenuationFactors, std::vector<double>({2., 4.}));
+    TS_ASSERT_EQUALS(later.numberInMemory(), 1);
+    TS_ASSERT(!later.find(43, entry));
+    Poco::File(directory).remove(true);
+  }
+
+private:
+  static MCAbsorptionCache::Entry makeEntry(const double lambda) {
+    return {{lambda, 2. * lambda},
+            {0.5 * lambda, lambda},
+            {0.05 * lambda, 0.1 * lambda}};
+  }
+};
@@ -15,6 +15,7 @@
 #include "MantidAlgorithms/MonteCarloAbsorption.h"
 #include "MantidAlgorithms/SampleCorrections/IBeamProfile.h"
 #include "MantidAlgorithms/SampleCorrections/IMCInteractionVolume.h"
+#include "MantidAlgorithms/SampleCorrections/MCAbsorptionCache.h"
 #include "MantidAlgorithms/SampleCorrections/MCInteractionStatistics.h"
 #include "MantidDataHandling/LoadBinaryStl.h"
 #include "MantidGeometry/Instrument/SampleEnvironment.h"
@@ -280,6 +281,30 @@ public:
     TS_ASSERT_DELTA(calculatedAttFactorSD2, attenuationFactorsSD2, delta);
   }
 
+  void test_Philox_Generator_Gives_Same_Factors_On_Every_Run() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {
+        1, 2, false, Environment::CubeRotatedSampleOnly, DeltaEMode::Elastic,
+        -1};
+    auto testWS = setUpWS(wsProps);
+    const auto runWithPhilox = [&testWS, this]() {
+      auto mcAbsorb = createAlgorithm();
+      mcAbsorb->setProperty("EventsPerPoint", 100000);
+      mcAbsorb->setProperty("RandomNumberGenerator", "Philox");
+      TS_ASSERT_THROWS_NOTHING(mcAbsorb->setProperty("InputWorkspace", testWS));
+      TS_ASSERT_THROWS_NOTHING(mcAbsorb->execute());
+      return getOutputWorkspace(mcAbsorb);
+    };
+    auto outputWS = runWithPhilox();
+    verifyDimensions(wsProps, outputWS);
+
+    // The expected values are derived in the elastic test above
+    const auto &yData = outputWS->y(0);
+    TS_ASSERT_DELTA((1 - 3 * exp(-2)) / 2, yData[0], 3e-03);
+    TS_ASSERT_DELTA((1 - 5 * exp(-4)) / 8, yData[1], 3e-03);
+    TS_ASSERT_EQUALS(runWithPhilox()->y(0).rawData(), yData.rawData());
+  }
+
   void test_Workspace_With_Just_Sample_For_Direct() {
     using namespace Mantid::Geometry;
     namespace PhysicalConstants = Mantid::PhysicalConstants;
@@ -466,6 +491,61 @@ public:
     TS_ASSERT_EQUALS(1.0, outputWS->e(0).front());
   }
 
+  void test_Cache_Reuses_Attenuation_Factors_Of_Earlier_Run() {
+    using Mantid::Algorithms::MCAbsorptionCache;
+    using Mantid::Kernel::DeltaEMode;
+    MCAbsorptionCache::instance().clear();
+    const int nspectra = 5;
+    TestWorkspaceDescriptor wsProps = {
+        nspectra, 10, true, Environment::CylinderSampleOnly,
+        DeltaEMode::Elastic, -1};
+    auto testWS = setUpWS(wsProps);
+
+    using namespace ::testing;
+    const std::vector<double> attenuationFactors = {
+        10.0, 9.0, 8.0, 7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0};
+    const std::vector<double> attenuationFactorErrors(10, 0.5);
+    auto firstStrategy = std::make_shared<MockMCAbsorptionStrategy>();
+    EXPECT_CALL(*firstStrategy, calculate(_, _, _, _, _, _, _))
+        .Times(Exactly(nspectra))
+        .WillRepeatedly(DoAll(SetArgReferee<4>(attenuationFactors),
+                              SetArgReferee<5>(attenuationFactorErrors)));
+    auto first = createTestAlgorithm();
+    first->setAbsorptionStrategy(firstStrategy);
+    first->setProperty("UseCache", true);
+    TS_ASSERT_THROWS_NOTHING(first->setProperty("InputWorkspace", testWS));
+    TS_ASSERT_THROWS_NOTHING(first->execute());
+    TS_ASSERT_EQUALS(MCAbsorptionCache::instance().numberInMemory(),
+                     nspectra);
+
+    // Nothing is simulated by a run with the same setup
+    auto secondStrategy = std::make_shared<MockMCAbsorptionStrategy>();
+    EXPECT_CALL(*secondStrategy, calculate(_, _, _, _, _, _, _)).Times(0);
+    auto second = createTestAlgorithm();
+    second->setAbsorptionStrategy(secondStrategy);
+    second->setProperty("UseCache", true);
+    TS_ASSERT_THROWS_NOTHING(second->setProperty("InputWorkspace", testWS));
+    TS_ASSERT_THROWS_NOTHING(second->execute());
+    auto outputWS = getOutputWorkspace(second);
+    TS_ASSERT_EQUALS(outputWS->y(nspectra - 1).rawData(), attenuationFactors);
+    TS_ASSERT_EQUALS(outputWS->e(nspectra - 1).rawData(),
+                     attenuationFactorErrors);
+
+    // A different number of events is simulated again
+    auto thirdStrategy = std::make_shared<MockMCAbsorptionStrategy>();
+    EXPECT_CALL(*thirdStrategy, calculate(_, _, _, _, _, _, _))
+        .Times(Exactly(nspectra))
+        .WillRepeatedly(DoAll(SetArgReferee<4>(attenuationFactors),
+                              SetArgReferee<5>(attenuationFactorErrors)));
+    auto third = createTestAlgorithm();
+    third->setAbsorptionStrategy(thirdStrategy);
+    third->setProperty("UseCache", true);
+    third->setProperty("EventsPerPoint", 301);
+    TS_ASSERT_THROWS_NOTHING(third->setProperty("InputWorkspace", testWS));
+    TS_ASSERT_THROWS_NOTHING(third->execute());
+    MCAbsorptionCache::instance().clear();
+  }
+
   void test_Lambda_StepSize_Two_Linear_Interpolation() {
     using Mantid::Kernel::DeltaEMode;
     const int nspectra = 5;
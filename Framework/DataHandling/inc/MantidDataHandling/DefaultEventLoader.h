@@ -9,8 +9,12 @@
 #include "MantidAPI/Axis.h"
 #include "MantidDataHandling/DllConfig.h"
 #include "MantidDataHandling/EventWorkspaceCollection.h"
+#include "MantidKernel/MemoryPool.h"
 
 class BankPulseTimes;
+namespace NeXus {
+class File;
+}
 
 namespace Mantid {
 namespace DataHandling {
@@ -29,6 +33,18 @@ public:
        std::vector<std::size_t> bankNumEvents, const bool oldNeXusFileNames,
        const bool precount, const int chunk, const int totalChunks);
 
+  static void loadPipelined(LoadEventNexus *alg, EventWorkspaceCollection &ws,
+                            bool event_id_is_spec,
+                            const std::vector<std::string> &bankNames,
+                            const std::vector<int> &periodLog,
+                            const std::string &classType,
+                            const std::vector<std::size_t> &bankNumEvents,
+                            const bool precount);
+
+  std::shared_ptr<BankPulseTimes>
+  loadPulseTimes(::NeXus::File &file,
+                 const std::vector<int> &framePeriodNumbers);
+
   /// Flag for dealing with a simulated file
   bool m_haveWeights;
 
@@ -76,6 +92,10 @@ public:
   /// One entry of pulse times for each preprocessor
   std::vector<std::shared_ptr<BankPulseTimes>> m_bankPulseTimes;
 
+  /// Pool for the temporaries of the tasks processing the banks, which is
+  /// released in one go when loading ends
+  std::shared_ptr<Kernel::MemoryPool> temporaries;
+
 private:
   DefaultEventLoader(LoadEventNexus *alg, EventWorkspaceCollection &ws,
                      bool haveWeights, bool event_id_is_spec,
@@ -37,7 +37,6 @@ public:
   void run() override;
 
 private:
-  void loadPulseTimes(::NeXus::File &file);
   std::vector<uint64_t> loadEventIndex(::NeXus::File &file);
   void prepareEventId(::NeXus::File &file, int64_t &start_event,
                       int64_t &stop_event,
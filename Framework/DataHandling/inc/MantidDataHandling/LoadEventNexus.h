@@ -221,6 +221,9 @@ private:
 
   DataObjects::EventWorkspace_sptr createEmptyEventWorkspace();
 
+  bool loadLazily(const std::vector<std::string> &bankNames,
+                  const std::vector<std::size_t> &bankNumEvents);
+
   void loadEvents(API::Progress *const prog, const bool monitors);
   void createSpectraMapping(
       const std::string &nxsfile, const bool monitorsOnly,
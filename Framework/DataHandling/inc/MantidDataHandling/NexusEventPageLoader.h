@@ -0,0 +1,60 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidDataObjects/EventPager.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class EventWorkspace;
+}
+namespace DataHandling {
+
+/** NexusEventPageLoader : Loads the events of a lazy EventWorkspace from the
+  NXevent_data banks of a NeXus file, one bank per page.
+
+  The spectra of a bank are those of the detectors in the instrument component
+  with the name of the bank, without the "_events" suffix. As in
+  ParallelEventLoader, the detector IDs within a bank must be contiguous. The
+  events are read with Parallel::IO::EventLoader, which combines the
+  event_time_offset with the pulse time found from the event_index.
+*/
+class MANTID_DATAHANDLING_DLL NexusEventPageLoader
+    : public DataObjects::EventPageLoader {
+public:
+  NexusEventPageLoader(const DataObjects::EventWorkspace &ws,
+                       std::string filename, std::string groupName,
+                       std::vector<std::string> bankNames,
+                       std::vector<std::size_t> bankNumEvents,
+                       const double tofOffset = 0.);
+
+  std::size_t numberOfPages() const override;
+  std::vector<std::size_t> workspaceIndices(std::size_t page) const override;
+  std::size_t numberOfEvents(std::size_t page) const override;
+  void loadPage(std::size_t page,
+                const std::vector<DataObjects::EventList *> &spectra) override;
+  DataObjects::EventSortType sortOrder() const override;
+
+private:
+  const std::string m_filename;
+  /// Path of the NXentry holding the banks
+  const std::string m_groupName;
+  const std::vector<std::string> m_bankNames;
+  const std::vector<std::size_t> m_bankNumEvents;
+  /// Difference between the event ID and the workspace index, for each bank
+  std::vector<int32_t> m_bankOffsets;
+  std::vector<std::vector<std::size_t>> m_workspaceIndices;
+  /// Added to the time-of-flight of every event, e.g. T0
+  const double m_tofOffset;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,12 @@ public:
                                const std::vector<std::string> &bankNames,
                                const bool eventIDIsSpectrumNumber,
                                const bool precalcEvents);
+
+  static std::vector<int32_t>
+  bankOffsets(const DataObjects::EventWorkspace &ws,
+              const std::string &filename, const std::string &groupName,
+              const std::vector<std::string> &bankNames,
+              const bool eventIDIsSpectrumNumber);
 };
 
 } // namespace DataHandling
@@ -6,16 +6,81 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidAPI/Progress.h"
+#include "MantidDataHandling/BankPulseTimes.h"
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/ThreadPool.h"
-#include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/Unit.h"
+#include "MantidNexus/NexusIOHelper.h"
+#include "MantidParallel/IO/BoundedQueue.h"
+#include "MantidParallel/IO/Chunker.h"
+#include "MantidParallel/IO/PipelinedEventDataLoader.h"
+
+#include <nexus/NeXusFile.hpp>
 
 using namespace Mantid::Kernel;
+using Mantid::Parallel::IO::EventDataChunk;
 
 namespace Mantid {
 namespace DataHandling {
 
+namespace {
+/// Number of events read at once by the pipelined loader
+constexpr size_t PIPELINED_CHUNK_SIZE = 1 << 20;
+
+/// The data of a bank shared by the chunks of its events
+struct PipelinedBank {
+  std::string name;
+  std::shared_ptr<std::vector<uint64_t>> eventIndex;
+  std::shared_ptr<BankPulseTimes> pulseTimes;
+};
+
+/** Add the events of a chunk to the event lists
+ * @param loader :: the loader holding the event lists
+ * @param bank :: the bank of the chunk
+ * @param chunk :: the events, in file order
+ * @param prog :: progress reporting
+ */
+void processChunk(DefaultEventLoader &loader, const PipelinedBank &bank,
+                  EventDataChunk &chunk, API::Progress *prog) {
+  const auto numEvents = chunk.eventId.size();
+  Kernel::Units::timeConversionVector(chunk.eventTimeOffset,
+                                      chunk.eventTimeOffsetUnit,
+                                      "microseconds");
+  // Limit the range of event IDs processed to the IDs known, like
+  // LoadBankFromDiskTask
+  const auto range =
+      std::minmax_element(chunk.eventId.cbegin(), chunk.eventId.cend());
+  auto minId = *range.first;
+  auto maxId = *range.second;
+  if (static_cast<int32_t>(minId) + loader.pixelID_to_wi_offset < 0)
+    minId = static_cast<uint32_t>(abs(loader.pixelID_to_wi_offset));
+  maxId = std::min(maxId, static_cast<uint32_t>(loader.eventid_max));
+  const auto emptyInt = static_cast<uint32_t>(EMPTY_INT());
+  const auto specMin = static_cast<uint32_t>(loader.alg->m_specMin);
+  const auto specMax = static_cast<uint32_t>(loader.alg->m_specMax);
+  if (specMin != emptyInt)
+    minId = std::max(minId, specMin);
+  if (specMax != emptyInt)
+    maxId = std::min(maxId, specMax);
+  if (minId > maxId) {
+    prog->reportIncrement(3, bank.name);
+    return;
+  }
+
+  ProcessBankData task(
+      loader, bank.name, prog,
+      std::make_shared<std::vector<uint32_t>>(std::move(chunk.eventId)),
+      std::make_shared<std::vector<float>>(std::move(chunk.eventTimeOffset)),
+      numEvents, chunk.eventOffset, bank.eventIndex, bank.pulseTimes, false,
+      nullptr, minId, maxId);
+  task.run();
+}
+} // namespace
+
 void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
                               bool haveWeights, bool event_id_is_spec,
                               std::vector<std::string> bankNames,
@@ -30,7 +95,7 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
   auto bankRange = loader.setupChunking(bankNames, bankNumEvents);
 
   // Make the thread pool
-  auto scheduler = new ThreadSchedulerMutexes;
+  auto scheduler = new ThreadSchedulerWorkStealing;
   ThreadPool pool(scheduler);
   auto diskIOMutex = std::make_shared<std::mutex>();
 
@@ -49,6 +114,169 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
   // Start and end all threads
   pool.joinAll();
   diskIOMutex.reset();
+  // Events that were counted and then filtered out leave reserved room
+  if (precount)
+    ws.shrinkEventLists();
+}
+
+/** Load the events with reading, decompression and processing running
+ * concurrently. The chunks of events of the banks are read in turn by a
+ * Parallel::IO::PipelinedEventDataLoader, and the chunks of a bank are
+ * processed in file order by one of several threads.
+ * @param alg :: the algorithm
+ * @param ws :: the workspace to fill
+ * @param event_id_is_spec :: true if the event IDs are spectrum numbers
+ * @param bankNames :: names of the NXevent_data groups
+ * @param periodLog :: period numbers corresponding to each frame
+ * @param classType :: NX class of the groups
+ * @param bankNumEvents :: number of events in each bank
+ * @param precount :: true to reserve the event lists before filling them
+ */
+void DefaultEventLoader::loadPipelined(
+    LoadEventNexus *alg, EventWorkspaceCollection &ws, bool event_id_is_spec,
+    const std::vector<std::string> &bankNames,
+    const std::vector<int> &periodLog, const std::string &classType,
+    const std::vector<std::size_t> &bankNumEvents, const bool precount) {
+  DefaultEventLoader loader(alg, ws, false, event_id_is_spec, bankNames.size(),
+                            precount, EMPTY_INT(), EMPTY_INT());
+
+  // The event indices and pulse times are read first, such that the file is
+  // only read by the pipeline while the events are loaded
+  std::vector<PipelinedBank> banks(bankNames.size());
+  std::vector<size_t> bankSizes(bankNames.size(), 0);
+  ::NeXus::File file(alg->m_filename);
+  file.openGroup(alg->m_top_entry_name, "NXentry");
+  for (size_t i = 0; i < bankNames.size(); ++i) {
+    if (bankNumEvents[i] == 0)
+      continue;
+    file.openGroup(bankNames[i], classType);
+    auto eventIndex =
+        NeXus::NeXusIOHelper::readNexusVector<uint64_t>(file, "event_index");
+    file.openData("event_id");
+    const bool validIds = file.getInfo().type == ::NeXus::UINT32;
+    file.closeData();
+    if (!validIds)
+      alg->getLogger().warning()
+          << "Entry " << bankNames[i]
+          << "'s event_id field is not UINT32! It will be skipped.\n";
+    // One entry, only zero, means no events in the bank
+    if (validIds && (eventIndex.size() != 1 || eventIndex[0] != 0)) {
+      banks[i].name = bankNames[i];
+      banks[i].eventIndex =
+          std::make_shared<std::vector<uint64_t>>(std::move(eventIndex));
+      banks[i].pulseTimes = loader.loadPulseTimes(file, periodLog);
+      bankSizes[i] = bankNumEvents[i];
+    }
+    file.closeGroup();
+  }
+  file.close();
+
+  auto ranges = Parallel::IO::Chunker(1, 0, bankSizes, PIPELINED_CHUNK_SIZE)
+                    .makeLoadRanges();
+  // Interleave the chunks of the banks such that they are processed
+  // concurrently
+  std::stable_sort(ranges.begin(), ranges.end(),
+                   [](const Parallel::IO::Chunker::LoadRange &a,
+                      const Parallel::IO::Chunker::LoadRange &b) {
+                     return a.eventOffset < b.eventOffset;
+                   });
+  auto prog = std::make_unique<API::Progress>(alg, 0.3, 1.0, 3 * ranges.size());
+
+  // Chunks of a bank must be processed in order and not concurrently, so
+  // every bank is given to one processing thread
+  const auto numThreads =
+      std::max<size_t>(ThreadPool::getNumPhysicalCores(), 2);
+  const auto numProcessors = numThreads / 2;
+  std::vector<std::unique_ptr<Parallel::IO::BoundedQueue<EventDataChunk>>>
+      queues;
+  for (size_t i = 0; i < numProcessors; ++i)
+    queues.emplace_back(
+        std::make_unique<Parallel::IO::BoundedQueue<EventDataChunk>>(2));
+
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  const auto stop = [&](std::exception_ptr e) {
+    {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (!error)
+        error = std::move(e);
+    }
+    for (auto &queue : queues)
+      queue->close();
+  };
+
+  ThreadPool pool(new ThreadSchedulerFIFO, numProcessors);
+  for (auto &queue : queues) {
+    auto *chunks = queue.get();
+    pool.schedule(std::make_shared<FunctionTask>([&, chunks] {
+      try {
+        EventDataChunk chunk;
+        while (chunks->pop(chunk))
+          processChunk(loader, banks[chunk.bankIndex], chunk, prog.get());
+      } catch (...) {
+        stop(std::current_exception());
+      }
+    }));
+  }
+  pool.start();
+  try {
+    Parallel::IO::PipelinedEventDataLoader reader(
+        alg->m_filename, alg->m_top_entry_name, bankNames, std::move(ranges),
+        static_cast<int>(numThreads - numProcessors), 2 * numProcessors);
+    EventDataChunk chunk;
+    while (!alg->getCancel() && reader.next(chunk)) {
+      const auto bankIndex = chunk.bankIndex;
+      if (!queues[bankIndex % numProcessors]->push(std::move(chunk)))
+        break;
+    }
+  } catch (...) {
+    stop(std::current_exception());
+  }
+  for (auto &queue : queues)
+    queue->close();
+  pool.joinAll();
+  if (error)
+    std::rethrow_exception(error);
+  // Events that were counted and then filtered out leave reserved room
+  if (precount)
+    ws.shrinkEventLists();
+}
+
+/** Get the pulse times of the bank that is open in the file, sharing them
+ * with the banks read before if they are the same. Not thread safe.
+ * @param file :: the file, with the bank open
+ * @param framePeriodNumbers :: period numbers corresponding to each frame
+ * @return the pulse times
+ */
+std::shared_ptr<BankPulseTimes>
+DefaultEventLoader::loadPulseTimes(::NeXus::File &file,
+                                   const std::vector<int> &framePeriodNumbers) {
+  try {
+    // First, get info about the event_time_zero field in this bank
+    file.openData("event_time_zero");
+  } catch (::NeXus::Exception &) {
+    // Field not found error is most likely.
+    // Use the "proton_charge" das logs.
+    return alg->m_allBanksPulseTimes;
+  }
+  std::string thisStartTime;
+  size_t thisNumPulses = 0;
+  file.getAttr("offset", thisStartTime);
+  if (!file.getInfo().dims.empty())
+    thisNumPulses = file.getInfo().dims[0];
+  file.closeData();
+
+  // Now, we look through existing ones to see if it is already loaded
+  for (auto &bankPulseTime : m_bankPulseTimes) {
+    if (bankPulseTime->equals(thisNumPulses, thisStartTime))
+      return bankPulseTime;
+  }
+
+  // Not found? Need to load and add it
+  auto pulseTimes =
+      std::make_shared<BankPulseTimes>(boost::ref(file), framePeriodNumbers);
+  m_bankPulseTimes.emplace_back(pulseTimes);
+  return pulseTimes;
 }
 
 DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
@@ -59,7 +287,7 @@ DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
                                        const int totalChunks)
     : m_haveWeights(haveWeights), event_id_is_spec(event_id_is_spec),
       precount(precount), chunk(chunk), totalChunks(totalChunks), alg(alg),
-      m_ws(ws) {
+      m_ws(ws), temporaries(std::make_shared<Kernel::MemoryPool>()) {
   // This map will be used to find the workspace index
   if (event_id_is_spec)
     pixelID_to_wi_vector =
@@ -12,8 +12,10 @@
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidIndexing/IndexInfo.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/UnitFactory.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <unordered_set>
@@ -114,9 +116,30 @@ void EventWorkspaceCollection::setNPeriods(
   }
 }
 
+/** Reserve room for a number of events to be added to an event list, on top
+ * of the events it already holds. The room at least doubles, so that a list
+ * filled in many chunks is not reallocated for each of them;
+ * shrinkEventLists() releases the excess once loading is done.
+ * @param wi :: workspace index of the event list
+ * @param size :: the number of events to be added
+ */
 void EventWorkspaceCollection::reserveEventListAt(size_t wi, size_t size) {
   for (auto &ws : m_WsVec) {
-    ws->getSpectrum(wi).reserve(size);
+    auto &eventList = ws->getSpectrum(wi);
+    const size_t numEvents = eventList.getNumberEvents();
+    eventList.reserve(std::max(numEvents + size, 2 * numEvents));
+  }
+}
+
+/** Release the memory reserved for events that were not added to the event
+ * lists, e.g. because they were counted but then filtered out.
+ */
+void EventWorkspaceCollection::shrinkEventLists() {
+  for (auto &ws : m_WsVec) {
+    const auto numHistograms = static_cast<int64_t>(ws->getNumberHistograms());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t wi = 0; wi < numHistograms; ++wi)
+      ws->getSpectrum(wi).shrinkToFit();
   }
 }
 
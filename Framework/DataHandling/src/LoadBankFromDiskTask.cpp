@@ -9,6 +9,7 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/AlgoTimeRegister.h"
 #include "MantidKernel/Unit.h"
 #include <algorithm>
 
@@ -45,41 +46,6 @@ LoadBankFromDiskTask::LoadBankFromDiskTask(
   m_max_id = 0;
 }
 
-/** Load the pulse times, if needed. This sets
- * thisBankPulseTimes to the right pointer.
- * */
-void LoadBankFromDiskTask::loadPulseTimes(::NeXus::File &file) {
-  try {
-    // First, get info about the event_time_zero field in this bank
-    file.openData("event_time_zero");
-  } catch (::NeXus::Exception &) {
-    // Field not found error is most likely.
-    // Use the "proton_charge" das logs.
-    thisBankPulseTimes = m_loader.alg->m_allBanksPulseTimes;
-    return;
-  }
-  std::string thisStartTime;
-  size_t thisNumPulses = 0;
-  file.getAttr("offset", thisStartTime);
-  if (!file.getInfo().dims.empty())
-    thisNumPulses = file.getInfo().dims[0];
-  file.closeData();
-
-  // Now, we look through existing ones to see if it is already loaded
-  // thisBankPulseTimes = NULL;
-  for (auto &bankPulseTime : m_loader.m_bankPulseTimes) {
-    if (bankPulseTime->equals(thisNumPulses, thisStartTime)) {
-      thisBankPulseTimes = bankPulseTime;
-      return;
-    }
-  }
-
-  // Not found? Need to load and add it
-  thisBankPulseTimes =
-      std::make_shared<BankPulseTimes>(boost::ref(file), m_framePeriodNumbers);
-  m_loader.m_bankPulseTimes.emplace_back(thisBankPulseTimes);
-}
-
 /** Load the event_index field
  * (a list of size of # of pulses giving the index in the event list for that
     pulse)
@@ -206,9 +172,11 @@ LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
 
   if (!m_loadError) {
     // Must be uint32
-    if (id_info.type == ::NeXus::UINT32)
+    if (id_info.type == ::NeXus::UINT32) {
       file.getSlab(event_id->data(), m_loadStart, m_loadSize);
-    else {
+      Instrumentation::AlgoTimeRegister::addBytesRead(event_id->size() *
+                                                      sizeof(uint32_t));
+    } else {
       m_loader.alg->getLogger().warning()
           << "Entry " << entry_name
           << "'s event_id field is not UINT32! It will be skipped.\n";
@@ -279,6 +247,7 @@ LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
   // skipped.
   auto vec = NeXus::NeXusIOHelper::readNexusSlab<float>(file, key, m_loadStart,
                                                         m_loadSize);
+  Instrumentation::AlgoTimeRegister::addBytesRead(vec.size() * sizeof(float));
   file.getAttr("units", tof_unit);
   file.closeData();
   // Convert Tof to microseconds
@@ -319,9 +288,11 @@ LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   }
 
   // Check that the type is what it is supposed to be
-  if (weight_info.type == ::NeXus::FLOAT32)
+  if (weight_info.type == ::NeXus::FLOAT32) {
     file.getSlab(event_weight->data(), m_loadStart, m_loadSize);
-  else {
+    Instrumentation::AlgoTimeRegister::addBytesRead(event_weight->size() *
+                                                    sizeof(float));
+  } else {
     m_loader.alg->getLogger().warning()
         << "Entry " << entry_name
         << "'s event_weight field is not FLOAT32! It will be skipped.\n";
@@ -363,8 +334,9 @@ void LoadBankFromDiskTask::run() {
     event_index = this->loadEventIndex(file);
 
     if (!m_loadError) {
-      // Load and validate the pulse times
-      this->loadPulseTimes(file);
+      // Load and validate the pulse times. The task holds the disk I/O mutex,
+      // which guards the pulse times shared by the banks.
+      thisBankPulseTimes = m_loader.loadPulseTimes(file, m_framePeriodNumbers);
 
       // The event_index should be the same length as the pulse times from DAS
       // logs.
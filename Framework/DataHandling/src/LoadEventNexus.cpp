@@ -13,6 +13,7 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 #include "MantidDataHandling/LoadEventNexusIndexSetup.h"
+#include "MantidDataHandling/NexusEventPageLoader.h"
 #include "MantidDataHandling/ParallelEventLoader.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/Goniometer.h"
@@ -281,7 +282,7 @@ void LoadEventNexus::init() {
   declareProperty(std::make_unique<PropertyWithValue<bool>>("LoadLogs", true,
                                                             Direction::Input),
                   "Load the Sample/DAS logs from the file (default True).");
-  std::vector<std::string> loadType{"Default"};
+  std::vector<std::string> loadType{"Default", "Lazy", "Pipelined"};
 
 #ifndef _WIN32
   loadType.emplace_back("Multiprocess (experimental)");
@@ -293,9 +294,18 @@ void LoadEventNexus::init() {
 
   auto loadTypeValidator = std::make_shared<StringListValidator>(loadType);
   declareProperty("LoadType", "Default", loadTypeValidator,
-                  "Set type of loader. 2 options {Default, Multiproceess},"
-                  "'Multiprocess' should work faster for big files and it is "
-                  "experimental, available only in Linux");
+                  "Set type of loader. 4 options {Default, Lazy, Pipelined, "
+                  "Multiproceess}, 'Multiprocess' should work faster for big "
+                  "files and it is experimental, available only in Linux. "
+                  "'Lazy' reads the events of a bank when they are first "
+                  "needed, within LazyMemoryLimit. 'Pipelined' reads, "
+                  "decompresses and processes chunks of events in separate "
+                  "threads.");
+
+  declareProperty("LazyMemoryLimit", 4096, mustBePositive,
+                  "With the Lazy LoadType, the memory in MB that unmodified "
+                  "events may use. Beyond it, the least recently used banks "
+                  "are dropped and read again from the file when needed.");
 
   declareProperty(std::make_unique<PropertyWithValue<bool>>(
                       "LoadNexusInstrumentXML", true, Direction::Input),
@@ -733,7 +743,13 @@ LoadEventNexus::runLoadNexusLogs<EventWorkspaceCollection_sptr>(
   return ret;
 }
 
-enum class LoadEventNexus::LoaderType { MPI, MULTIPROCESS, DEFAULT };
+enum class LoadEventNexus::LoaderType {
+  MPI,
+  MULTIPROCESS,
+  LAZY,
+  PIPELINED,
+  DEFAULT
+};
 
 //-----------------------------------------------------------------------------
 /**
@@ -1011,8 +1027,27 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
   longest_tof = 0.;
 
   bool loaded{false};
+  bool lazy{false};
   auto loaderType = defineLoaderType(haveWeights, oldNeXusFileNames, classType);
-  if (loaderType != LoaderType::DEFAULT) {
+  if (loaderType == LoaderType::LAZY) {
+    m_file->close();
+    loaded = lazy = loadLazily(bankNames, bankNumEvents);
+    if (loaded) {
+      // Finding the range would read every event. As for the parallel
+      // loaders, the default bins span any time-of-flight instead, so that
+      // no event falls outside them; the range is only logged otherwise.
+      shortest_tof = 0.0;
+      longest_tof = 1e10;
+    }
+    safeOpenFile(m_filename);
+  } else if (loaderType == LoaderType::PIPELINED) {
+    m_file->close();
+    DefaultEventLoader::loadPipelined(
+        this, *m_ws, event_id_is_spec, bankNames, periodLog->valuesAsVector(),
+        classType, bankNumEvents, getProperty("Precount"));
+    loaded = true;
+    safeOpenFile(m_filename);
+  } else if (loaderType != LoaderType::DEFAULT) {
     auto ws = m_ws->getSingleHeldWorkspace();
     m_file->close();
     if (loaderType == LoaderType::MPI) {
@@ -1092,7 +1127,8 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
         m_ws->getInstrument()->getNumberParameter("T0", true);
     if (!instrumentT0.empty()) {
       const double mT0 = instrumentT0.front();
-      if (mT0 != 0.0) {
+      // The offset of lazily loaded events is added as they are read
+      if (mT0 != 0.0 && !lazy) {
         auto numHistograms = static_cast<int64_t>(m_ws->getNumberHistograms());
         PARALLEL_FOR_IF(Kernel::threadSafe(*m_ws))
         for (int64_t i = 0; i < numHistograms; ++i) {
@@ -1102,6 +1138,8 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
           PARALLEL_END_INTERUPT_REGION
         }
         PARALLEL_CHECK_INTERUPT_REGION
+      }
+      if (mT0 != 0.0) {
         // set T0 in the run parameters
         API::Run &run = m_ws->mutableRun();
         run.addProperty<double>("T0", mT0, true);
@@ -1577,6 +1615,26 @@ LoadEventNexus::defineLoaderType(const bool haveWeights,
          !isDefault("ChunkNumber")));
   noParallelConstrictions &= !(classType != "NXevent_data");
 
+  if (propVal == "Lazy") {
+    if (noParallelConstrictions && !event_id_is_spec)
+      return LoaderType::LAZY;
+    g_log.warning() << "The events cannot be loaded lazily with the options "
+                       "given, falling back to the default loader.\n";
+    return LoaderType::DEFAULT;
+  }
+  if (propVal == "Pipelined") {
+    // Chunks of a bank are processed one after the other, so anything
+    // needing all the events of a bank at once is left to the default loader
+    if (!haveWeights && !oldNeXusFileNames && classType == "NXevent_data" &&
+        filter_time_start == Types::Core::DateAndTime::minimum() &&
+        filter_time_stop == Types::Core::DateAndTime::maximum() &&
+        isDefault("CompressTolerance") && isDefault("ChunkNumber"))
+      return LoaderType::PIPELINED;
+    g_log.warning() << "The events cannot be loaded by the pipelined loader "
+                       "with the options given, falling back to the default "
+                       "loader.\n";
+    return LoaderType::DEFAULT;
+  }
   if (!noParallelConstrictions)
     return LoaderType::DEFAULT;
 #ifndef MPI_EXPERIMENTAL
@@ -1586,6 +1644,45 @@ LoadEventNexus::defineLoaderType(const bool haveWeights,
 #endif
 }
 
+/** Set up the workspace to read the events of each bank from the file when
+ * they are first needed, rather than loading them now.
+ * @param bankNames :: names of the NXevent_data groups
+ * @param bankNumEvents :: number of events in each bank
+ * @return false if the banks do not match components of the instrument, in
+ * which case the events need loading with another loader
+ */
+bool LoadEventNexus::loadLazily(const std::vector<std::string> &bankNames,
+                                const std::vector<std::size_t> &bankNumEvents) {
+  auto ws = m_ws->getSingleHeldWorkspace();
+  // Unlike the other loaders, the T0 offset has to be added as events are read
+  double tofOffset = 0.;
+  if (ws->getInstrument()->hasParameter("T0")) {
+    const auto instrumentT0 =
+        ws->getInstrument()->getNumberParameter("T0", true);
+    if (!instrumentT0.empty())
+      tofOffset = instrumentT0.front();
+  }
+
+  std::shared_ptr<NexusEventPageLoader> loader;
+  try {
+    loader = std::make_shared<NexusEventPageLoader>(
+        *ws, m_filename, m_top_entry_name, bankNames, bankNumEvents,
+        tofOffset);
+  } catch (Kernel::Exception::NotFoundError &e) {
+    g_log.warning() << "The events cannot be loaded lazily as a bank is not "
+                       "in the instrument ("
+                    << e.what() << "), falling back to the default loader.\n";
+    return false;
+  }
+  const int memoryLimit = getProperty("LazyMemoryLimit");
+  ws->setPageLoader(std::move(loader), static_cast<std::size_t>(memoryLimit) *
+                                           1024 * 1024 /
+                                           sizeof(Types::Event::TofEvent));
+  g_log.information() << "Events of " << bankNames.size()
+                      << " banks will be loaded when needed.\n";
+  return true;
+}
+
 Parallel::ExecutionMode LoadEventNexus::getParallelExecutionMode(
     const std::map<std::string, Parallel::StorageMode> &storageModes) const {
   static_cast<void>(storageModes);
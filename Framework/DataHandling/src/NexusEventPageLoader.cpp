@@ -0,0 +1,112 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/NexusEventPageLoader.h"
+#include "MantidDataHandling/ParallelEventLoader.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidGeometry/IDetector.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidParallel/Communicator.h"
+#include "MantidParallel/IO/EventLoader.h"
+#include "MantidTypes/Event/TofEvent.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** Constructor, finding the spectra of each bank
+ * @param ws :: the workspace to load, with its instrument and a spectrum per
+ * detector
+ * @param filename :: the NeXus file
+ * @param groupName :: name of the NXentry holding the banks
+ * @param bankNames :: names of the NXevent_data groups, one per page
+ * @param bankNumEvents :: number of events in each bank
+ * @param tofOffset :: added to the time-of-flight of every event
+ * @throw Kernel::Exception::NotFoundError if the instrument has no component
+ * named after a bank
+ */
+NexusEventPageLoader::NexusEventPageLoader(
+    const DataObjects::EventWorkspace &ws, std::string filename,
+    std::string groupName, std::vector<std::string> bankNames,
+    std::vector<std::size_t> bankNumEvents, const double tofOffset)
+    : m_filename(std::move(filename)), m_groupName(std::move(groupName)),
+      m_bankNames(std::move(bankNames)),
+      m_bankNumEvents(std::move(bankNumEvents)),
+      m_workspaceIndices(m_bankNames.size()), m_tofOffset(tofOffset) {
+  if (m_bankNumEvents.size() != m_bankNames.size())
+    throw std::invalid_argument(
+        "NexusEventPageLoader: one number of events is needed per bank");
+
+  const auto instrument = ws.getInstrument();
+  const auto detIdToIndex = ws.getDetectorIDToWorkspaceIndexMap(true);
+  for (size_t bank = 0; bank < m_bankNames.size(); ++bank) {
+    const auto &name = m_bankNames[bank];
+    std::vector<Geometry::IDetector_const_sptr> detectors;
+    instrument->getDetectorsInBank(detectors,
+                                   name.substr(0, name.find("_events")));
+    auto &indices = m_workspaceIndices[bank];
+    for (const auto &detector : detectors) {
+      const auto index = detIdToIndex.find(detector->getID());
+      if (index != detIdToIndex.end())
+        indices.emplace_back(index->second);
+    }
+    std::sort(indices.begin(), indices.end());
+  }
+  m_bankOffsets = ParallelEventLoader::bankOffsets(ws, m_filename, m_groupName,
+                                                   m_bankNames, false);
+}
+
+/// @return the number of banks
+std::size_t NexusEventPageLoader::numberOfPages() const {
+  return m_bankNames.size();
+}
+
+/// @return the workspace indices of the detectors in a bank
+std::vector<std::size_t>
+NexusEventPageLoader::workspaceIndices(std::size_t page) const {
+  return m_workspaceIndices.at(page);
+}
+
+/// @return the number of events in a bank
+std::size_t NexusEventPageLoader::numberOfEvents(std::size_t page) const {
+  return m_bankNumEvents.at(page);
+}
+
+/** Read the events of a bank
+ * @param page :: index of the bank
+ * @param spectra :: every spectrum of the workspace, by workspace index
+ */
+void NexusEventPageLoader::loadPage(
+    std::size_t page, const std::vector<DataObjects::EventList *> &spectra) {
+  // Events outside of the bank, which break the assumption of contiguous
+  // detector IDs, end up here rather than in the spectra of other pages
+  std::vector<Types::Event::TofEvent> elsewhere;
+  std::vector<std::vector<Types::Event::TofEvent> *> eventLists(spectra.size(),
+                                                                &elsewhere);
+  for (const auto index : m_workspaceIndices[page])
+    DataObjects::getEventsFrom(*spectra[index], eventLists[index]);
+
+  Parallel::IO::EventLoader::load(Parallel::Communicator(), m_filename,
+                                  m_groupName, {m_bankNames[page]},
+                                  {m_bankOffsets[page]}, eventLists);
+
+  for (const auto index : m_workspaceIndices[page]) {
+    auto &spectrum = *spectra[index];
+    if (m_tofOffset != 0.)
+      spectrum.addTof(m_tofOffset);
+    // Events are stored in the order of their pulses
+    spectrum.setSortOrder(DataObjects::PULSETIME_SORT);
+  }
+}
+
+/// @return the order of the events of each spectrum, that of their pulses
+DataObjects::EventSortType NexusEventPageLoader::sortOrder() const {
+  return DataObjects::PULSETIME_SORT;
+}
+
+} // namespace DataHandling
+} // namespace Mantid
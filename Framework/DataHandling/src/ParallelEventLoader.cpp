@@ -130,5 +130,24 @@ void ParallelEventLoader::loadMultiProcess(
                                   std::move(eventLists), precalcEvents);
 }
 
+/** Find the difference between the event IDs of each bank and the workspace
+ * indices of their spectra, assuming that the IDs within a bank are
+ * contiguous.
+ * @param ws :: the workspace, with a spectrum per detector
+ * @param filename :: the NeXus file
+ * @param groupName :: name of the NXentry holding the banks
+ * @param bankNames :: names of the NXevent_data groups
+ * @param eventIDIsSpectrumNumber :: true if the event IDs are spectrum numbers
+ * rather than detector IDs
+ * @return the offset of each bank
+ */
+std::vector<int32_t> ParallelEventLoader::bankOffsets(
+    const DataObjects::EventWorkspace &ws, const std::string &filename,
+    const std::string &groupName, const std::vector<std::string> &bankNames,
+    const bool eventIDIsSpectrumNumber) {
+  return getOffsets(ws, filename, groupName, bankNames,
+                    eventIDIsSpectrumNumber);
+}
+
 } // namespace DataHandling
 } // namespace Mantid
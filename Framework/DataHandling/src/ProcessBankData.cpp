@@ -9,6 +9,7 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/AlgoTimeRegister.h"
 
 using namespace Mantid::DataObjects;
 
@@ -76,13 +77,17 @@ void ProcessBankData::run() { // override {
   size_t badTofs = 0;
   size_t my_discarded_events(0);
 
+  Instrumentation::AlgoTimeRegister::addEventsProcessed(numEvents);
+
   prog->report(entry_name + ": precount");
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
   if (m_loader.precount) {
 
-    std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
+    std::vector<size_t, Kernel::PoolAllocator<size_t>> counts(
+        m_max_id - m_min_id + 1, 0,
+        Kernel::PoolAllocator<size_t>(m_loader.temporaries));
     for (size_t i = 0; i < numEvents; i++) {
       const auto thisId = detid_t((*event_id)[i]);
       if (thisId >= m_min_id && thisId <= m_max_id)
@@ -126,7 +131,8 @@ void ProcessBankData::run() { // override {
   const bool compress = (alg->compressTolerance >= 0);
 
   // Which detector IDs were touched? - only matters if compress is on
-  std::vector<bool> usedDetIds;
+  std::vector<bool, Kernel::PoolAllocator<bool>> usedDetIds{
+      Kernel::PoolAllocator<bool>(m_loader.temporaries)};
   if (compress)
     usedDetIds.assign(m_max_id - m_min_id + 1, false);
 
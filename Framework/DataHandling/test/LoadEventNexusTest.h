@@ -37,12 +37,14 @@ using namespace Mantid::DataHandling;
 using Mantid::Types::Core::DateAndTime;
 using Mantid::Types::Event::TofEvent;
 
-void run_multiprocess_load(const std::string &file, bool precount) {
+/// Load a file with a LoadType and check the events against the default
+void run_load_and_compare(const std::string &file, const std::string &loadType,
+                          bool precount) {
   Mantid::API::FrameworkManager::Instance();
   LoadEventNexus ld;
   ld.initialize();
-  ld.setPropertyValue("Loadtype", "Multiprocess (experimental)");
-  std::string outws_name = "multiprocess";
+  ld.setPropertyValue("Loadtype", loadType);
+  std::string outws_name = "loaded";
   ld.setPropertyValue("Filename", file);
   ld.setPropertyValue("OutputWorkspace", outws_name);
   ld.setPropertyValue("Precount", std::to_string(precount));
@@ -89,6 +91,10 @@ void run_multiprocess_load(const std::string &file, bool precount) {
   }
 }
 
+void run_multiprocess_load(const std::string &file, bool precount) {
+  run_load_and_compare(file, "Multiprocess (experimental)", precount);
+}
+
 namespace {
 std::shared_ptr<const EventWorkspace>
 load_reference_workspace(const std::string &filename) {
@@ -306,6 +312,11 @@ public:
     }
   }
 
+  void test_pipelined_loader() {
+    run_load_and_compare("SANS2D00022048.nxs", "Pipelined", true);
+    run_load_and_compare("CNCS_7860_event.nxs", "Pipelined", false);
+  }
+
   void test_SingleBank_PixelsOnlyInThatBank() { doTestSingleBank(true, false); }
 
   void test_load_event_nexus_ornl_eqsans() {
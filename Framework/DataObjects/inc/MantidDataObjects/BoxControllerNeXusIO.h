@@ -56,6 +56,12 @@ public:
   void setDataType(const size_t blockSize,
                    const std::string &typeName) override;
   void getDataType(size_t &CoordSize, std::string &typeName) const override;
+  /// Compress the events of a file created by the next openFile. Each chunk of
+  /// events is compressed separately, so blocks are still read and written at
+  /// any position. Existing files are read whether compressed or not.
+  void setCompression(const bool compress) { m_compress = compress; }
+  ///@return true if the events of new files are compressed
+  bool getCompression() const { return m_compress; }
   //------------------------------------------------------------------------------------------------------------------------
   // Auxiliary functions (non-virtual, used for testing)
   int64_t getNDataColums() const { return m_BlockSize[1]; }
@@ -87,6 +93,8 @@ private:
   /// the vector, which describes the event specific data size, namely how many
   /// column an event is composed into and this class reads/writres
   std::vector<int64_t> m_BlockSize;
+  /// compress the events data array when it is created
+  bool m_compress;
   /// lock Nexus file operations as Nexus is not thread safe
   mutable std::mutex m_fileMutex;
 
@@ -53,6 +53,8 @@ public:
                           const Mantid::Kernel::VMD &scaling);
 
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
+  void applyBatch(const coord_t *inputVectors, size_t inputStride,
+                  coord_t *outVectors, size_t numPoints) const override;
 
   static CoordTransformAffine *combineTransformations(CoordTransform *first,
                                                       CoordTransform *second);
@@ -49,9 +49,15 @@ public:
   std::string toXMLString() const override;
   std::string id() const override;
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
+  void applyBatch(const coord_t *inputVectors, size_t inputStride,
+                  coord_t *outVectors, size_t numPoints) const override;
   Mantid::Kernel::Matrix<coord_t> makeAffineMatrix() const override;
 
 protected:
+  template <size_t OUT>
+  void applyAligned(const coord_t *inputVectors, size_t inputStride,
+                    coord_t *outVectors, size_t numPoints) const;
+
   /// For each dimension in the output, index in the input workspace of which
   /// dimension it is
   std::vector<size_t> m_dimensionToBinFrom;
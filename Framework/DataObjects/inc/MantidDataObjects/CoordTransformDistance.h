@@ -49,6 +49,8 @@ public:
   std::string id() const override;
 
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
+  void applyBatch(const coord_t *inputVectors, size_t inputStride,
+                  coord_t *outVectors, size_t numPoints) const override;
 
   /// Return the center coordinate array
   const std::vector<coord_t> &getCenter() { return m_center; }
@@ -0,0 +1,101 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** EventColumns : Structure-of-arrays storage for a list of neutron events.
+
+  Every field of an event (time-of-flight, pulse time, weight and squared
+  error) is kept in its own contiguous column. Passes that only need one field,
+  e.g. histogramming or converting the time-of-flight, therefore only stream
+  that field through the cache.
+
+  Which columns are populated follows the EventType:
+    - TOF: tof and pulse time (implied weight of 1).
+    - WEIGHTED: all four columns.
+    - WEIGHTED_NOTIME: tof, weight and squared error.
+*/
+class MANTID_DATAOBJECTS_DLL EventColumns {
+public:
+  EventColumns();
+  explicit EventColumns(const API::EventType type);
+
+  API::EventType getEventType() const;
+  void switchTo(const API::EventType newType);
+
+  /// Number of events held
+  std::size_t size() const { return m_tof.size(); }
+  /// True if there are no events
+  bool empty() const { return m_tof.empty(); }
+  void clear();
+  void reserve(const std::size_t num);
+  void shrinkToFit();
+  std::size_t getMemorySize() const;
+
+  void assign(const std::vector<Types::Event::TofEvent> &events);
+  void assign(const std::vector<WeightedEvent> &events);
+  void assign(const std::vector<WeightedEventNoTime> &events);
+
+  void copyTo(std::vector<Types::Event::TofEvent> &events) const;
+  void copyTo(std::vector<WeightedEvent> &events) const;
+  void copyTo(std::vector<WeightedEventNoTime> &events) const;
+
+  void append(const Types::Event::TofEvent &event);
+  void append(const WeightedEvent &event);
+  void append(const WeightedEventNoTime &event);
+
+  /// Time-of-flight column
+  std::vector<double> &tofs() { return m_tof; }
+  /// Time-of-flight column
+  const std::vector<double> &tofs() const { return m_tof; }
+  /// Pulse time column in nanoseconds. Empty for WEIGHTED_NOTIME.
+  const std::vector<int64_t> &pulseTimes() const { return m_pulseTime; }
+  /// Weight column. Empty for TOF.
+  const std::vector<float> &weights() const { return m_weight; }
+  /// Squared error column. Empty for TOF.
+  const std::vector<float> &errorSquareds() const { return m_errorSquared; }
+
+  bool hasPulseTimes() const;
+  bool hasWeights() const;
+
+  void sortByTof();
+  void sortByPulseTime();
+  void reverse();
+
+  void erase(const std::size_t first, const std::size_t last);
+  void move(const std::size_t from, const std::size_t to);
+  void resize(const std::size_t num);
+
+  bool operator==(const EventColumns &rhs) const;
+  bool operator!=(const EventColumns &rhs) const;
+
+private:
+  void permute(const std::vector<std::size_t> &order);
+
+  /// Type of the events held, decides which columns are populated
+  API::EventType m_eventType;
+  /// Time-of-flight of each event
+  std::vector<double> m_tof;
+  /// Pulse time of each event, in nanoseconds
+  std::vector<int64_t> m_pulseTime;
+  /// Weight of each event
+  std::vector<float> m_weight;
+  /// Square of the error on each event
+  std::vector<float> m_errorSquared;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
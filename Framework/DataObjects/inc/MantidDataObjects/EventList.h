@@ -7,6 +7,7 @@
 #pragma once
 
 #include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/EventColumns.h"
 #include "MantidDataObjects/Events.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
@@ -21,6 +22,7 @@ class DateAndTime;
 }
 } // namespace Types
 namespace Kernel {
+class BinEdgeLookup;
 class SplittingInterval;
 using TimeSplitterType = std::vector<SplittingInterval>;
 class Unit;
@@ -38,6 +40,14 @@ enum EventSortType {
   TIMEATSAMPLE_SORT
 };
 
+/// How the events of a list are laid out in memory.
+enum EventStorageType {
+  /// One vector of event structs (TofEvent, WeightedEvent, ...)
+  ROW_STORAGE,
+  /// One contiguous column per event field, see EventColumns
+  COLUMN_STORAGE
+};
+
 //==========================================================================================
 /** @class Mantid::DataObjects::EventList
 
@@ -50,6 +60,10 @@ enum EventSortType {
     or WeightedEvent (where each neutron can have a non-1 weight).
     This is done transparently.
 
+    The events can also be held column-wise (see EventColumns and
+    setStorageType()), which speeds up passes that only touch the
+    time-of-flight.
+
     @author Janik Zikovsky, SNS ORNL
     @date 4/02/2010
 */
@@ -104,7 +118,10 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const Types::Event::TofEvent &event) {
-    this->events.emplace_back(event);
+    if (m_storage == COLUMN_STORAGE)
+      m_columns.append(event);
+    else
+      this->events.emplace_back(event);
     this->order = UNSORTED;
   }
 
@@ -114,7 +131,10 @@ public:
    * @param event :: WeightedEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEvent &event) {
-    this->weightedEvents.emplace_back(event);
+    if (m_storage == COLUMN_STORAGE)
+      m_columns.append(event);
+    else
+      this->weightedEvents.emplace_back(event);
     this->order = UNSORTED;
   }
 
@@ -124,7 +144,10 @@ public:
    * @param event :: WeightedEventNoTime to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event) {
-    this->weightedEventsNoTime.emplace_back(event);
+    if (m_storage == COLUMN_STORAGE)
+      m_columns.append(event);
+    else
+      this->weightedEventsNoTime.emplace_back(event);
     this->order = UNSORTED;
   }
 
@@ -132,6 +155,10 @@ public:
 
   void switchTo(Mantid::API::EventType newType) override;
 
+  void setStorageType(const EventStorageType storage);
+
+  EventStorageType getStorageType() const;
+
   WeightedEvent getEvent(size_t event_number);
 
   std::vector<Types::Event::TofEvent> &getEvents();
@@ -152,6 +179,8 @@ public:
 
   void reserve(size_t num) override;
 
+  void shrinkToFit();
+
   void sort(const EventSortType order) const;
 
   void setSortOrder(const EventSortType order) const;
@@ -304,6 +333,14 @@ public:
                                 bool docorrection, double toffactor,
                                 double tofshift) const;
 
+  /// Split to outputs indexed by group + 1
+  std::string
+  splitByFullTimeMatrixSplitter(const std::vector<int64_t> &vec_splitters_time,
+                                const std::vector<int> &vecgroups,
+                                const std::vector<EventList *> &outputs,
+                                bool docorrection, double toffactor,
+                                double tofshift) const;
+
   /// Split events by pulse time
   void splitByPulseTime(Kernel::TimeSplitterType &splitter,
                         std::map<int, EventList *> outputs) const;
@@ -377,9 +414,15 @@ private:
   /// List of WeightedEvent's
   mutable std::vector<WeightedEventNoTime> weightedEventsNoTime;
 
+  /// Events held as columns when m_storage is COLUMN_STORAGE
+  mutable EventColumns m_columns;
+
   /// What type of event is in our list.
   Mantid::API::EventType eventType;
 
+  /// Whether the events are held in the vectors above or in m_columns
+  mutable EventStorageType m_storage;
+
   /// Last sorting order
   mutable EventSortType order;
 
@@ -400,8 +443,6 @@ private:
                              const double seek_time, const double &tofFactor,
                              const double &tofOffset) const;
 
-  void generateCountsHistogram(const MantidVec &X, MantidVec &Y) const;
-
   void generateCountsHistogramPulseTime(const MantidVec &X, MantidVec &Y) const;
 
   void generateCountsHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
@@ -412,6 +453,7 @@ private:
 
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
+  void switchToRowStorage() const;
   // should not be called externally
   void sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                              const double seconds) const;
@@ -436,8 +478,17 @@ private:
 
   template <class T>
   static void histogramForWeightsHelper(const std::vector<T> &events,
-                                        const MantidVec &X, MantidVec &Y,
-                                        MantidVec &E);
+                                        const Kernel::BinEdgeLookup &bins,
+                                        MantidVec &Y, MantidVec &E);
+  static void histogramForWeightsHelper(const EventColumns &events,
+                                        const Kernel::BinEdgeLookup &bins,
+                                        MantidVec &Y, MantidVec &E);
+  static void
+  countsHistogramHelper(const std::vector<Types::Event::TofEvent> &events,
+                        const Kernel::BinEdgeLookup &bins, MantidVec &Y);
+  static void countsHistogramHelper(const std::vector<double> &tofs,
+                                    const Kernel::BinEdgeLookup &bins,
+                                    MantidVec &Y);
   template <class T>
   static void integrateHelper(std::vector<T> &events, const double minX,
                               const double maxX, const bool entireRange,
@@ -445,6 +496,9 @@ private:
   template <class T>
   static double integrateHelper(std::vector<T> &events, const double minX,
                                 const double maxX, const bool entireRange);
+  static void integrateHelper(const EventColumns &events, const double minX,
+                              const double maxX, const bool entireRange,
+                              double &sum, double &error);
   template <class T>
   void convertTofHelper(std::vector<T> &events,
                         const std::function<double(double)> &func);
@@ -452,6 +506,10 @@ private:
   template <class T>
   void convertTofHelper(std::vector<T> &events, const double factor,
                         const double offset);
+  void convertTofHelper(EventColumns &events,
+                        const std::function<double(double)> &func);
+  void convertTofHelper(EventColumns &events, const double factor,
+                        const double offset);
   template <class T>
   void addPulsetimeHelper(std::vector<T> &events, const double seconds);
   template <class T>
@@ -460,6 +518,8 @@ private:
   template <class T>
   static std::size_t maskTofHelper(std::vector<T> &events, const double tofMin,
                                    const double tofMax);
+  static std::size_t maskTofHelper(EventColumns &events, const double tofMin,
+                                   const double tofMax);
   template <class T>
   static std::size_t maskConditionHelper(std::vector<T> &events,
                                          const std::vector<bool> &mask);
@@ -494,6 +554,8 @@ private:
   template <class T>
   void filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
                            typename std::vector<T> &events);
+  void filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
+                           EventColumns &events);
   template <class T>
   void splitByTimeHelper(Kernel::TimeSplitterType &splitter,
                          std::vector<EventList *> outputs,
@@ -520,14 +582,16 @@ private:
   template <class T>
   std::string splitByFullTimeVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-      bool docorrection, double toffactor, double tofshift) const;
+      const std::vector<EventList *> &outputs,
+      typename std::vector<T> &vecEvents, bool docorrection, double toffactor,
+      double tofshift) const;
 
   template <class T>
   std::string splitByFullTimeSparseVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-      bool docorrection, double toffactor, double tofshift) const;
+      const std::vector<EventList *> &outputs,
+      typename std::vector<T> &vecEvents, bool docorrection, double toffactor,
+      double tofshift) const;
 
   template <class T>
   static void multiplyHelper(std::vector<T> &events, const double value,
@@ -0,0 +1,117 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/EventList.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+/** EventPageLoader : Source of the events of an EventWorkspace that is loaded
+  lazily. The spectra are grouped into pages, e.g. the banks of a NeXus file,
+  whose events are read together. The events are loaded as TofEvents.
+*/
+class MANTID_DATAOBJECTS_DLL EventPageLoader {
+public:
+  virtual ~EventPageLoader() = default;
+
+  /// @return the number of pages
+  virtual std::size_t numberOfPages() const = 0;
+  /// @return the workspace indices of the spectra in a page
+  virtual std::vector<std::size_t> workspaceIndices(std::size_t page) const = 0;
+  /// @return the number of events in a page
+  virtual std::size_t numberOfEvents(std::size_t page) const = 0;
+  /** Append the events of a page to its spectra, which are empty, and set
+   * their sort order.
+   * @param page :: index of the page
+   * @param spectra :: every spectrum of the workspace, by workspace index
+   */
+  virtual void loadPage(std::size_t page,
+                        const std::vector<EventList *> &spectra) = 0;
+  /// @return the sort order loadPage() gives the spectra, UNSORTED if unknown
+  virtual EventSortType sortOrder() const { return UNSORTED; }
+};
+
+/** EventPager : Keeps the events of a lazily loaded EventWorkspace within a
+  memory limit.
+
+  A page is loaded when one of its spectra is first accessed. When the events
+  held exceed the limit, the least recently used pages are dropped again, to
+  be reloaded on their next access. Pages whose spectra are accessed for
+  writing are pinned: they stay in memory as they may have been modified.
+
+  Each thread holds the page of the last spectrum it accessed, and a page
+  held by any thread is never dropped. A reference to a spectrum of an
+  unpinned page therefore stays valid until the same thread accesses a
+  spectrum of another page, so that parallel loops over the spectra can work
+  on the spectrum of each iteration. The hold of a thread ends with the
+  thread.
+*/
+class MANTID_DATAOBJECTS_DLL EventPager {
+public:
+  using Spectra = std::vector<std::unique_ptr<EventList>>;
+
+  EventPager(std::shared_ptr<EventPageLoader> loader,
+             std::size_t numberOfSpectra, std::size_t maxResidentEvents);
+  EventPager(const EventPager &other);
+  EventPager &operator=(const EventPager &) = delete;
+
+  void require(std::size_t index, const Spectra &spectra, bool pin);
+  void pinAll(const Spectra &spectra);
+  std::shared_lock<std::shared_mutex> freeze() const;
+
+  bool isResident(std::size_t index) const;
+  bool isPinned(std::size_t index) const;
+  std::size_t numberOfAbsentEvents() const;
+  std::size_t numberOfEvents(const Spectra &spectra) const;
+  std::size_t numberOfResidentEvents() const;
+  API::EventType eventType(const Spectra &spectra) const;
+  EventSortType sortType(const Spectra &spectra) const;
+  /// @return the number of events held above which pages are dropped
+  std::size_t maxResidentEvents() const { return m_maxResidentEvents; }
+
+  /// Value of the page of a spectrum that is in no page
+  static constexpr std::size_t NO_PAGE = static_cast<std::size_t>(-1);
+
+private:
+  struct Page {
+    bool resident = false;
+    bool pinned = false;
+    /// Events held while resident
+    std::size_t events = 0;
+    /// Tick of the last access, for finding the least recently used page
+    std::atomic<uint64_t> lastUse{0};
+  };
+
+  void hold(std::size_t page);
+  void load(std::size_t page, const Spectra &spectra);
+  void makeRoom(std::size_t page, const Spectra &spectra);
+
+  std::shared_ptr<EventPageLoader> m_loader;
+  /// Page of each spectrum, or NO_PAGE
+  std::vector<std::size_t> m_pageOfSpectrum;
+  std::vector<std::vector<std::size_t>> m_spectraOfPage;
+  std::vector<Page> m_pages;
+  std::size_t m_residentEvents;
+  const std::size_t m_maxResidentEvents;
+  /// Number of threads holding each page. Shared with the threads, which may
+  /// outlive the pager.
+  std::shared_ptr<std::vector<std::atomic<std::size_t>>> m_holders;
+  std::atomic<uint64_t> m_tick;
+  /// Shared while checking that a page is resident, unique to change pages
+  mutable std::shared_mutex m_mutex;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
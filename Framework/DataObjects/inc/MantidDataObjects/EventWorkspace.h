@@ -19,6 +19,8 @@ class Progress;
 }
 
 namespace DataObjects {
+class EventPageLoader;
+class EventPager;
 class EventWorkspaceMRU;
 
 /** \class EventWorkspace
@@ -135,6 +137,15 @@ public:
   // Change the event type
   void switchEventType(const Mantid::API::EventType type);
 
+  void setStorageType(const EventStorageType storage);
+
+  // Load the events lazily, a page at a time
+  void setPageLoader(std::shared_ptr<EventPageLoader> loader,
+                     const std::size_t maxResidentEvents);
+  /// Returns true if the events are loaded lazily
+  bool isLazy() const { return static_cast<bool>(m_pager); }
+  const EventPager *pager() const { return m_pager.get(); }
+
   // Returns true always - an EventWorkspace always represents histogramm-able
   // data
   bool isHistogramData() const override;
@@ -173,6 +184,9 @@ private:
 
   /// Container for the MRU lists of the event lists contained.
   mutable std::unique_ptr<EventWorkspaceMRU> mru;
+
+  /// Loads the events on demand if the workspace is lazy
+  std::unique_ptr<EventPager> m_pager;
 };
 
 /// shared pointer to the EventWorkspace class
@@ -16,6 +16,7 @@
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/ZeroedAllocator.h"
 
 namespace Mantid {
 namespace DataObjects {
@@ -31,11 +32,20 @@ namespace DataObjects {
  *
  * This will be used by ParaView e.g. for visualization.
  *
+ * The arrays of the bins take memory from the operating system only where
+ * they are written, so a large workspace created with Initialisation::Zero
+ * only costs the memory of the regions holding data. Copying, setTo(0, 0, 0)
+ * and the binary operations skip the blocks of bins where they would not
+ * change anything, keeping the rest of the workspace untouched.
+ *
  * @author Janik Zikovsky
  * @date 2011-03-24 11:21:06.280523
  */
 class MANTID_DATAOBJECTS_DLL MDHistoWorkspace : public API::IMDHistoWorkspace {
 public:
+  /// The values of the bins of a new workspace
+  enum class Initialisation { NaN, Zero };
+
   MDHistoWorkspace(Mantid::Geometry::MDHistoDimension_sptr dimX,
                    Mantid::Geometry::MDHistoDimension_sptr dimY =
                        Mantid::Geometry::MDHistoDimension_sptr(),
@@ -49,10 +59,12 @@ public:
   MDHistoWorkspace(
       std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
       Mantid::API::MDNormalization displayNormalization =
-          Mantid::API::NoNormalization);
+          Mantid::API::NoNormalization,
+      Initialisation initialisation = Initialisation::NaN);
   MDHistoWorkspace(std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
                    Mantid::API::MDNormalization displayNormalization =
-                       Mantid::API::NoNormalization);
+                       Mantid::API::NoNormalization,
+                   Initialisation initialisation = Initialisation::NaN);
   MDHistoWorkspace &operator=(const MDHistoWorkspace &other) = delete;
 
   /// Returns a clone of the workspace
@@ -65,8 +77,10 @@ public:
     return std::unique_ptr<MDHistoWorkspace>(doCloneEmpty());
   }
 
-  void init(std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions);
-  void init(std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions);
+  void init(std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
+            Initialisation initialisation = Initialisation::NaN);
+  void init(std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
+            Initialisation initialisation = Initialisation::NaN);
 
   void cacheValues();
 
@@ -459,18 +473,22 @@ private:
                             std::vector<signal_t> &e) const;
 
   void initVertexesArray();
+  void allocateArrays();
+
+  /// Array of values for each bin, taking memory only where written
+  using BinArray = std::vector<signal_t, Kernel::ZeroedAllocator<signal_t>>;
 
   /// Number of dimensions in this workspace
   size_t numDimensions;
 
   /// Linear array of signals for each bin
-  std::vector<signal_t> m_signals;
+  BinArray m_signals;
 
   /// Linear array of errors for each bin
-  std::vector<signal_t> m_errorsSquared;
+  BinArray m_errorsSquared;
 
   /// Number of contributing events for each bin.
-  std::vector<signal_t> m_numEvents;
+  BinArray m_numEvents;
 
   /// Length of the m_signals / m_errorsSquared arrays.
   size_t m_length;
@@ -522,7 +540,7 @@ protected:
 
   /// Linear array of masks for each bin. Avoids using vector<bool>
   /// due to performance concerns.
-  std::unique_ptr<bool[]> m_masks;
+  std::unique_ptr<bool[], Kernel::ZeroedDeleter<bool>> m_masks;
 };
 
 /// A shared pointer to a MDHistoWorkspace
@@ -32,7 +32,8 @@ std::string BoxControllerNeXusIO::g_DBDataName("free_space_blocks");
 */
 BoxControllerNeXusIO::BoxControllerNeXusIO(API::BoxController *const bc)
     : m_File(nullptr), m_ReadOnly(true), m_dataChunk(DATA_CHUNK), m_bc(bc),
-      m_BlockStart(2, 0), m_BlockSize(2, 0), m_CoordSize(sizeof(coord_t)),
+      m_BlockStart(2, 0), m_BlockSize(2, 0), m_compress(false),
+      m_CoordSize(sizeof(coord_t)),
       m_EventType(FatEvent), m_EventsVersion("1.0"),
       m_ReadConversion(noConversion) {
   m_BlockSize[1] = 4 + m_bc->getNDims();
@@ -223,13 +224,16 @@ void BoxControllerNeXusIO::prepareNxSToWrite_CurVersion() {
     std::vector<int64_t> chunk(m_BlockSize);
     chunk[0] = static_cast<int64_t>(m_dataChunk);
 
+    // HDF5 compresses every chunk separately, so slabs can still be read and
+    // written at any position
+    const auto compression = m_compress ? ::NeXus::LZW : ::NeXus::NONE;
     // Make and open the data
     if (m_CoordSize == 4)
       m_File->makeCompData("event_data", ::NeXus::FLOAT32, m_BlockSize,
-                           ::NeXus::NONE, chunk, true);
+                           compression, chunk, true);
     else
       m_File->makeCompData("event_data", ::NeXus::FLOAT64, m_BlockSize,
-                           ::NeXus::NONE, chunk, true);
+                           compression, chunk, true);
 
     // A little bit of description for humans to read later
     m_File->putAttr("description", m_EventsTypeHeaders[m_EventType]);
@@ -23,6 +23,73 @@ using Mantid::API::CoordTransform;
 namespace Mantid {
 namespace DataObjects {
 
+namespace {
+/// Signature of the kernels transforming a block of points
+using AffineKernel = void (*)(const coord_t *, const coord_t *, size_t,
+                              coord_t *, size_t);
+
+/** Transform a block of points with an affine matrix of fixed size. With the
+ * dimensions known at compile time the loops over them are unrolled and
+ * the products of each point are vectorised by the compiler.
+ * @param matrix :: the (OUT + 1) x (IN + 1) affine matrix, row major
+ * @param input :: coordinates of the first point
+ * @param inputStride :: distance between consecutive points in the input
+ * @param output :: packed output coordinates
+ * @param numPoints :: number of points
+ */
+template <size_t IN, size_t OUT>
+void applyAffine(const coord_t *matrix, const coord_t *input,
+                 const size_t inputStride, coord_t *output,
+                 const size_t numPoints) {
+  coord_t rows[OUT][IN + 1];
+  for (size_t out = 0; out < OUT; ++out)
+    for (size_t in = 0; in <= IN; ++in)
+      rows[out][in] = matrix[out * (IN + 1) + in];
+  for (size_t i = 0; i < numPoints; ++i) {
+    const coord_t *point = input + i * inputStride;
+    coord_t *outPoint = output + i * OUT;
+    for (size_t out = 0; out < OUT; ++out) {
+      coord_t outVal = rows[out][IN];
+      for (size_t in = 0; in < IN; ++in)
+        outVal += rows[out][in] * point[in];
+      outPoint[out] = outVal;
+    }
+  }
+}
+
+/// @return the kernel for IN input dimensions and outD output ones, or null
+template <size_t IN> AffineKernel affineKernel(const size_t outD) {
+  switch (outD) {
+  case 1:
+    return &applyAffine<IN, 1>;
+  case 2:
+    return &applyAffine<IN, 2>;
+  case 3:
+    return &applyAffine<IN, 3>;
+  case 4:
+    return &applyAffine<IN, 4>;
+  default:
+    return nullptr;
+  }
+}
+
+/// @return the kernel for the given dimensions, or null if there is none
+AffineKernel affineKernel(const size_t inD, const size_t outD) {
+  switch (inD) {
+  case 1:
+    return affineKernel<1>(outD);
+  case 2:
+    return affineKernel<2>(outD);
+  case 3:
+    return affineKernel<3>(outD);
+  case 4:
+    return affineKernel<4>(outD);
+  default:
+    return nullptr;
+  }
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor.
  * Construct the affine matrix to and initialize to an identity matrix.
@@ -283,6 +350,28 @@ void CoordTransformAffine::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to a block of points. Up to 4 input
+ * and output dimensions this uses kernels specialised for the dimensions.
+ *
+ * @param inputVectors :: the coordinates of the first point, of size inD
+ * @param inputStride :: the distance between consecutive points in
+ *inputVectors, in units of coord_t
+ * @param outVectors :: array of size outD * numPoints for the output
+ * @param numPoints :: the number of points
+ */
+void CoordTransformAffine::applyBatch(const coord_t *inputVectors,
+                                      const size_t inputStride,
+                                      coord_t *outVectors,
+                                      const size_t numPoints) const {
+  if (auto kernel = affineKernel(inD, outD)) {
+    kernel(m_rawMemory, inputVectors, inputStride, outVectors, numPoints);
+    return;
+  }
+  for (size_t i = 0; i < numPoints; ++i)
+    apply(inputVectors + i * inputStride, outVectors + i * outD);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Serialize the coordinate transform
  *
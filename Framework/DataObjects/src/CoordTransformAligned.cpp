@@ -112,6 +112,69 @@ void CoordTransformAligned::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Transform a block of points with a fixed number of output dimensions, so
+ * the loop over them is unrolled.
+ *
+ * @param inputVectors :: the coordinates of the first point, of size inD
+ * @param inputStride :: the distance between consecutive points in
+ *inputVectors, in units of coord_t
+ * @param outVectors :: array of size OUT * numPoints for the output
+ * @param numPoints :: the number of points
+ */
+template <size_t OUT>
+void CoordTransformAligned::applyAligned(const coord_t *inputVectors,
+                                         const size_t inputStride,
+                                         coord_t *outVectors,
+                                         const size_t numPoints) const {
+  size_t dimensions[OUT];
+  coord_t origin[OUT];
+  coord_t scaling[OUT];
+  for (size_t out = 0; out < OUT; ++out) {
+    dimensions[out] = m_dimensionToBinFrom[out];
+    origin[out] = m_origin[out];
+    scaling[out] = m_scaling[out];
+  }
+  for (size_t i = 0; i < numPoints; ++i) {
+    const coord_t *point = inputVectors + i * inputStride;
+    coord_t *outPoint = outVectors + i * OUT;
+    for (size_t out = 0; out < OUT; ++out)
+      outPoint[out] = (point[dimensions[out]] - origin[out]) * scaling[out];
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to a block of points
+ *
+ * @param inputVectors :: the coordinates of the first point, of size inD
+ * @param inputStride :: the distance between consecutive points in
+ *inputVectors, in units of coord_t
+ * @param outVectors :: array of size outD * numPoints for the output
+ * @param numPoints :: the number of points
+ */
+void CoordTransformAligned::applyBatch(const coord_t *inputVectors,
+                                       const size_t inputStride,
+                                       coord_t *outVectors,
+                                       const size_t numPoints) const {
+  switch (outD) {
+  case 1:
+    applyAligned<1>(inputVectors, inputStride, outVectors, numPoints);
+    break;
+  case 2:
+    applyAligned<2>(inputVectors, inputStride, outVectors, numPoints);
+    break;
+  case 3:
+    applyAligned<3>(inputVectors, inputStride, outVectors, numPoints);
+    break;
+  case 4:
+    applyAligned<4>(inputVectors, inputStride, outVectors, numPoints);
+    break;
+  default:
+    CoordTransform::applyBatch(inputVectors, inputStride, outVectors,
+                               numPoints);
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Create an equivalent affine transformation matrix out of the
  * parameters of this axis-aligned transformation.
@@ -119,6 +119,63 @@ void CoordTransformDistance::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to a block of points. The values that
+ * do not depend on the point are computed once for the whole block.
+ *
+ * @param inputVectors :: the coordinates of the first point, of size inD
+ * @param inputStride :: the distance between consecutive points in
+ *inputVectors, in units of coord_t
+ * @param outVectors :: array of size outD * numPoints for the output
+ * @param numPoints :: the number of points
+ */
+void CoordTransformDistance::applyBatch(const coord_t *inputVectors,
+                                        const size_t inputStride,
+                                        coord_t *outVectors,
+                                        const size_t numPoints) const {
+  if (outD == 1 && m_eigenvals.size() == 3) {
+    // ellipsoid: the eigenvectors scaled by the ratio of the variances
+    coord_t axes[3][3];
+    coord_t weights[3];
+    coord_t center[3];
+    for (size_t d = 0; d < 3; d++) {
+      for (size_t dd = 0; dd < 3; dd++)
+        axes[d][dd] = static_cast<coord_t>(m_eigenvects[d][dd]);
+      weights[d] = static_cast<coord_t>(m_maxEigenval / m_eigenvals[d]);
+      center[d] = m_center[d];
+    }
+    for (size_t i = 0; i < numPoints; ++i) {
+      const coord_t *point = inputVectors + i * inputStride;
+      coord_t distanceSquared = 0;
+      for (size_t d = 0; d < 3; d++) {
+        coord_t dist = 0.0;
+        for (size_t dd = 0; dd < 3; dd++)
+          dist += axes[d][dd] * (point[dd] - center[dd]);
+        distanceSquared += (dist * dist) * weights[d];
+      }
+      outVectors[i] = distanceSquared;
+    }
+  } else if (outD == 1) {
+    // nd spherical: only the dimensions used
+    std::vector<size_t> dimensions;
+    for (size_t d = 0; d < inD; d++)
+      if (m_dimensionsUsed[d])
+        dimensions.emplace_back(d);
+    for (size_t i = 0; i < numPoints; ++i) {
+      const coord_t *point = inputVectors + i * inputStride;
+      coord_t distanceSquared = 0;
+      for (const auto d : dimensions) {
+        coord_t dist = point[d] - m_center[d];
+        distanceSquared += (dist * dist);
+      }
+      outVectors[i] = distanceSquared;
+    }
+  } else {
+    CoordTransform::applyBatch(inputVectors, inputStride, outVectors,
+                               numPoints);
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Serialize the coordinate transform distance
  *
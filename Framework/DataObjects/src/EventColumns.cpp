@@ -0,0 +1,373 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/EventColumns.h"
+
+#ifdef _MSC_VER
+// qualifier applied to function type has no meaning; ignored
+#pragma warning(disable : 4180)
+#endif
+#include "tbb/parallel_sort.h"
+#ifdef _MSC_VER
+#pragma warning(default : 4180)
+#endif
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+using Types::Core::DateAndTime;
+using Types::Event::TofEvent;
+using namespace Mantid::API;
+
+namespace {
+/**
+ * Reorder a single column so that element i of the output is element order[i]
+ * of the input.
+ * @param column :: the column to reorder in place
+ * @param order :: permutation giving the source index of each output element
+ */
+template <typename T>
+void applyOrder(std::vector<T> &column, const std::vector<std::size_t> &order) {
+  if (column.empty())
+    return;
+  std::vector<T> reordered;
+  reordered.reserve(column.size());
+  for (const auto index : order)
+    reordered.emplace_back(column[index]);
+  column.swap(reordered);
+}
+
+/// Release the memory held by a column
+template <typename T> void releaseColumn(std::vector<T> &column) {
+  std::vector<T>().swap(column);
+}
+} // namespace
+
+/// Constructor for an empty list of TofEvents
+EventColumns::EventColumns() : m_eventType(TOF) {}
+
+/** Constructor for an empty list of the given type
+ * @param type :: type of the events that will be stored
+ */
+EventColumns::EventColumns(const EventType type) : m_eventType(type) {}
+
+/// @return the type of the events that are stored
+EventType EventColumns::getEventType() const { return m_eventType; }
+
+/** Switch the stored events to another type. Going from TOF to WEIGHTED adds
+ * unit weights, going to WEIGHTED_NOTIME drops the pulse times.
+ * @param newType :: type to switch to
+ * @throw std::runtime_error if the switch would lose weights or pulse times
+ */
+void EventColumns::switchTo(const EventType newType) {
+  if (newType == m_eventType)
+    return;
+  switch (newType) {
+  case TOF:
+    throw std::runtime_error("EventColumns::switchTo() called on weighted "
+                             "events to go down to TofEvent's. This would "
+                             "remove weight information and therefore is not "
+                             "possible.");
+  case WEIGHTED:
+    if (m_eventType == WEIGHTED_NOTIME)
+      throw std::runtime_error("EventColumns::switchTo() called on events "
+                               "without pulse times. They can't go back to "
+                               "WeightedEvent's.");
+    m_weight.assign(m_tof.size(), 1.0f);
+    m_errorSquared.assign(m_tof.size(), 1.0f);
+    break;
+  case WEIGHTED_NOTIME:
+    if (m_eventType == TOF) {
+      m_weight.assign(m_tof.size(), 1.0f);
+      m_errorSquared.assign(m_tof.size(), 1.0f);
+    }
+    releaseColumn(m_pulseTime);
+    break;
+  }
+  m_eventType = newType;
+}
+
+/// Remove all events and release the memory held by the columns
+void EventColumns::clear() {
+  releaseColumn(m_tof);
+  releaseColumn(m_pulseTime);
+  releaseColumn(m_weight);
+  releaseColumn(m_errorSquared);
+}
+
+/** Pre-allocate the columns used by the current event type
+ * @param num :: number of events that will be stored
+ */
+void EventColumns::reserve(const std::size_t num) {
+  m_tof.reserve(num);
+  if (hasPulseTimes())
+    m_pulseTime.reserve(num);
+  if (hasWeights()) {
+    m_weight.reserve(num);
+    m_errorSquared.reserve(num);
+  }
+}
+
+/// Release the capacity of the columns that is not used by events
+void EventColumns::shrinkToFit() {
+  m_tof.shrink_to_fit();
+  m_pulseTime.shrink_to_fit();
+  m_weight.shrink_to_fit();
+  m_errorSquared.shrink_to_fit();
+}
+
+/// @return the memory used by the columns in bytes, based on their capacity
+std::size_t EventColumns::getMemorySize() const {
+  return m_tof.capacity() * sizeof(double) +
+         m_pulseTime.capacity() * sizeof(int64_t) +
+         (m_weight.capacity() + m_errorSquared.capacity()) * sizeof(float);
+}
+
+/// @return true if the pulse time column is populated
+bool EventColumns::hasPulseTimes() const {
+  return m_eventType != WEIGHTED_NOTIME;
+}
+
+/// @return true if the weight and error columns are populated
+bool EventColumns::hasWeights() const { return m_eventType != TOF; }
+
+/** Replace the contents with TofEvents
+ * @param events :: the events to copy
+ */
+void EventColumns::assign(const std::vector<TofEvent> &events) {
+  clear();
+  m_eventType = TOF;
+  reserve(events.size());
+  for (const auto &event : events)
+    append(event);
+}
+
+/** Replace the contents with WeightedEvents
+ * @param events :: the events to copy
+ */
+void EventColumns::assign(const std::vector<WeightedEvent> &events) {
+  clear();
+  m_eventType = WEIGHTED;
+  reserve(events.size());
+  for (const auto &event : events)
+    append(event);
+}
+
+/** Replace the contents with WeightedEventNoTimes
+ * @param events :: the events to copy
+ */
+void EventColumns::assign(const std::vector<WeightedEventNoTime> &events) {
+  clear();
+  m_eventType = WEIGHTED_NOTIME;
+  reserve(events.size());
+  for (const auto &event : events)
+    append(event);
+}
+
+/** Copy the events into a vector of TofEvents
+ * @param events :: output vector, any contents are replaced
+ * @throw std::runtime_error if the stored events are weighted
+ */
+void EventColumns::copyTo(std::vector<TofEvent> &events) const {
+  if (m_eventType != TOF)
+    throw std::runtime_error("EventColumns::copyTo() cannot copy weighted "
+                             "events into TofEvent's.");
+  events.clear();
+  events.reserve(size());
+  for (std::size_t i = 0; i < m_tof.size(); ++i)
+    events.emplace_back(m_tof[i], DateAndTime(m_pulseTime[i]));
+}
+
+/** Copy the events into a vector of WeightedEvents
+ * @param events :: output vector, any contents are replaced
+ * @throw std::runtime_error if the stored events have no pulse time
+ */
+void EventColumns::copyTo(std::vector<WeightedEvent> &events) const {
+  if (m_eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventColumns::copyTo() cannot copy events "
+                             "without pulse times into WeightedEvent's.");
+  events.clear();
+  events.reserve(size());
+  if (m_eventType == TOF) {
+    for (std::size_t i = 0; i < m_tof.size(); ++i)
+      events.emplace_back(m_tof[i], DateAndTime(m_pulseTime[i]), 1.0f, 1.0f);
+  } else {
+    for (std::size_t i = 0; i < m_tof.size(); ++i)
+      events.emplace_back(m_tof[i], DateAndTime(m_pulseTime[i]), m_weight[i],
+                          m_errorSquared[i]);
+  }
+}
+
+/** Copy the events into a vector of WeightedEventNoTimes
+ * @param events :: output vector, any contents are replaced
+ */
+void EventColumns::copyTo(std::vector<WeightedEventNoTime> &events) const {
+  events.clear();
+  events.reserve(size());
+  if (m_eventType == TOF) {
+    for (const auto tof : m_tof)
+      events.emplace_back(tof, 1.0f, 1.0f);
+  } else {
+    for (std::size_t i = 0; i < m_tof.size(); ++i)
+      events.emplace_back(m_tof[i], m_weight[i], m_errorSquared[i]);
+  }
+}
+
+/** Append an event. Only the fields stored for the current type are kept.
+ * @param event :: event to add at the end
+ */
+void EventColumns::append(const TofEvent &event) {
+  m_tof.emplace_back(event.tof());
+  if (hasPulseTimes())
+    m_pulseTime.emplace_back(event.pulseTime().totalNanoseconds());
+  if (hasWeights()) {
+    m_weight.emplace_back(1.0f);
+    m_errorSquared.emplace_back(1.0f);
+  }
+}
+
+/** Append an event. Only the fields stored for the current type are kept.
+ * @param event :: event to add at the end
+ */
+void EventColumns::append(const WeightedEvent &event) {
+  m_tof.emplace_back(event.tof());
+  if (hasPulseTimes())
+    m_pulseTime.emplace_back(event.pulseTime().totalNanoseconds());
+  if (hasWeights()) {
+    m_weight.emplace_back(event.m_weight);
+    m_errorSquared.emplace_back(event.m_errorSquared);
+  }
+}
+
+/** Append an event. Only the fields stored for the current type are kept.
+ * @param event :: event to add at the end
+ */
+void EventColumns::append(const WeightedEventNoTime &event) {
+  m_tof.emplace_back(event.tof());
+  if (hasPulseTimes())
+    m_pulseTime.emplace_back(0);
+  if (hasWeights()) {
+    m_weight.emplace_back(event.m_weight);
+    m_errorSquared.emplace_back(event.m_errorSquared);
+  }
+}
+
+/// Sort all columns by time-of-flight
+void EventColumns::sortByTof() {
+  if (std::is_sorted(m_tof.cbegin(), m_tof.cend()))
+    return;
+  // Only the tof column is read while sorting; the others are gathered once
+  std::vector<std::size_t> order(m_tof.size());
+  std::iota(order.begin(), order.end(), 0);
+  const auto &tof = m_tof;
+  tbb::parallel_sort(order.begin(), order.end(),
+                     [&tof](const std::size_t lhs, const std::size_t rhs) {
+                       return tof[lhs] < tof[rhs];
+                     });
+  permute(order);
+}
+
+/// Sort all columns by pulse time. Does nothing if there are no pulse times.
+void EventColumns::sortByPulseTime() {
+  if (!hasPulseTimes() ||
+      std::is_sorted(m_pulseTime.cbegin(), m_pulseTime.cend()))
+    return;
+  std::vector<std::size_t> order(m_pulseTime.size());
+  std::iota(order.begin(), order.end(), 0);
+  const auto &pulseTime = m_pulseTime;
+  tbb::parallel_sort(
+      order.begin(), order.end(),
+      [&pulseTime](const std::size_t lhs, const std::size_t rhs) {
+        return pulseTime[lhs] < pulseTime[rhs];
+      });
+  permute(order);
+}
+
+/// Reverse the order of the events in all columns
+void EventColumns::reverse() {
+  std::reverse(m_tof.begin(), m_tof.end());
+  std::reverse(m_pulseTime.begin(), m_pulseTime.end());
+  std::reverse(m_weight.begin(), m_weight.end());
+  std::reverse(m_errorSquared.begin(), m_errorSquared.end());
+}
+
+/** Remove the events in the index range [first, last)
+ * @param first :: index of the first event to remove
+ * @param last :: index one past the last event to remove
+ */
+void EventColumns::erase(const std::size_t first, const std::size_t last) {
+  m_tof.erase(m_tof.begin() + first, m_tof.begin() + last);
+  if (hasPulseTimes())
+    m_pulseTime.erase(m_pulseTime.begin() + first,
+                      m_pulseTime.begin() + last);
+  if (hasWeights()) {
+    m_weight.erase(m_weight.begin() + first, m_weight.begin() + last);
+    m_errorSquared.erase(m_errorSquared.begin() + first,
+                         m_errorSquared.begin() + last);
+  }
+}
+
+/** Overwrite one event with another, used when compacting the columns
+ * @param from :: index of the event to copy
+ * @param to :: index of the event to overwrite
+ */
+void EventColumns::move(const std::size_t from, const std::size_t to) {
+  m_tof[to] = m_tof[from];
+  if (hasPulseTimes())
+    m_pulseTime[to] = m_pulseTime[from];
+  if (hasWeights()) {
+    m_weight[to] = m_weight[from];
+    m_errorSquared[to] = m_errorSquared[from];
+  }
+}
+
+/** Resize all populated columns. New events have zero tof and pulse time and
+ * unit weight.
+ * @param num :: new number of events
+ */
+void EventColumns::resize(const std::size_t num) {
+  m_tof.resize(num, 0.);
+  if (hasPulseTimes())
+    m_pulseTime.resize(num, 0);
+  if (hasWeights()) {
+    m_weight.resize(num, 1.0f);
+    m_errorSquared.resize(num, 1.0f);
+  }
+}
+
+/** Reorder all populated columns
+ * @param order :: permutation giving the source index of each output event
+ */
+void EventColumns::permute(const std::vector<std::size_t> &order) {
+  applyOrder(m_tof, order);
+  applyOrder(m_pulseTime, order);
+  applyOrder(m_weight, order);
+  applyOrder(m_errorSquared, order);
+}
+
+/** Equality operator
+ * @param rhs :: other columns to compare
+ * @return true if the type and every stored field are equal
+ */
+bool EventColumns::operator==(const EventColumns &rhs) const {
+  return m_eventType == rhs.m_eventType && m_tof == rhs.m_tof &&
+         m_pulseTime == rhs.m_pulseTime && m_weight == rhs.m_weight &&
+         m_errorSquared == rhs.m_errorSquared;
+}
+
+/** Inequality operator
+ * @param rhs :: other columns to compare
+ * @return true if not equal
+ */
+bool EventColumns::operator!=(const EventColumns &rhs) const {
+  return !this->operator==(rhs);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
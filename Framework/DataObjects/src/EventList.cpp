@@ -8,6 +8,7 @@
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidDataObjects/Histogram1D.h"
+#include "MantidKernel/BinEdgeLookup.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Exception.h"
@@ -89,6 +90,68 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/**
+ * Calculate the time of an event that is compared with the splitting times
+ * of EventList::splitByFullTimeMatrixSplitter
+ * @param event : The event with pulse time and time-of-flight
+ * @param docorrection : Whether to correct the time-of-flight
+ * @param toffactor : Time of flight coefficient factor
+ * @param tofshift : Tof shift in seconds
+ * @return Full time in nanoseconds
+ */
+template <typename EventType>
+int64_t splitterEventTime(const EventType &event, const bool docorrection,
+                          const double toffactor, const double tofshift) {
+  if (docorrection)
+    return event.pulseTime().totalNanoseconds() +
+           static_cast<int64_t>(toffactor * event.tof() * 1000 +
+                                tofshift * 1.0E9);
+  return event.pulseTime().totalNanoseconds() +
+         static_cast<int64_t>(event.tof() * 1000);
+}
+
+/**
+ * @param outputs : Output event lists indexed by group + 1
+ * @param group : A group, -1 being the unfiltered events
+ * @return The output of the group or nullptr if there is none
+ */
+EventList *outputOfGroup(const std::vector<EventList *> &outputs,
+                         const int group) {
+  if (group < -1 || static_cast<size_t>(group + 1) >= outputs.size())
+    return nullptr;
+  return outputs[static_cast<size_t>(group + 1)];
+}
+
+/// Number of events whose bins are found in one call to the bin lookup
+constexpr size_t HISTOGRAM_BLOCK_SIZE = 256;
+
+/**
+ * Histogram events in blocks: the time-of-flight of a block of events is
+ * gathered and the bins of the whole block are found in one call, which lets
+ * the bin calculation be vectorised.
+ * @param bins : Lookup of the bin edges
+ * @param numEvents : Number of events
+ * @param getTof : Returns the time-of-flight of an event given its index
+ * @param addToBin : Adds an event, given its index, to a bin
+ */
+template <typename GetTof, typename AddToBin>
+void histogramInBlocks(const Kernel::BinEdgeLookup &bins,
+                       const size_t numEvents, GetTof getTof,
+                       AddToBin addToBin) {
+  double tofs[HISTOGRAM_BLOCK_SIZE];
+  size_t indices[HISTOGRAM_BLOCK_SIZE];
+  for (size_t start = 0; start < numEvents; start += HISTOGRAM_BLOCK_SIZE) {
+    const size_t count = std::min(HISTOGRAM_BLOCK_SIZE, numEvents - start);
+    for (size_t i = 0; i < count; ++i)
+      tofs[i] = getTof(start + i);
+    bins.bins(tofs, count, indices);
+    for (size_t i = 0; i < count; ++i) {
+      if (indices[i] != Kernel::BinEdgeLookup::npos)
+        addToBin(start + i, indices[i]);
+    }
+  }
+}
 } // namespace
 //==========================================================================
 /// --------------------- TofEvent Comparators
@@ -152,7 +215,7 @@ struct comparePulseTimeTOFDelta {
 EventList::EventList()
     : m_histogram(HistogramData::Histogram::XMode::BinEdges,
                   HistogramData::Histogram::YMode::Counts),
-      eventType(TOF), order(UNSORTED), mru(nullptr) {}
+      eventType(TOF), m_storage(ROW_STORAGE), order(UNSORTED), mru(nullptr) {}
 
 /** Constructor with a MRU list
  * @param mru :: pointer to the MRU of the parent EventWorkspace
@@ -161,12 +224,13 @@ EventList::EventList()
 EventList::EventList(EventWorkspaceMRU *mru, specnum_t specNo)
     : IEventList(specNo), m_histogram(HistogramData::Histogram::XMode::BinEdges,
                                       HistogramData::Histogram::YMode::Counts),
-      eventType(TOF), order(UNSORTED), mru(mru) {}
+      eventType(TOF), m_storage(ROW_STORAGE), order(UNSORTED), mru(mru) {}
 
 /** Constructor copying from an existing event list
  * @param rhs :: EventList object to copy*/
 EventList::EventList(const EventList &rhs)
-    : IEventList(rhs), m_histogram(rhs.m_histogram), mru{nullptr} {
+    : IEventList(rhs), m_histogram(rhs.m_histogram), m_storage(ROW_STORAGE),
+      mru{nullptr} {
   // Note that operator= also assigns m_histogram, but the above use of the copy
   // constructor avoid a memory allocation and is thus faster.
   this->operator=(rhs);
@@ -177,7 +241,7 @@ EventList::EventList(const EventList &rhs)
 EventList::EventList(const std::vector<TofEvent> &events)
     : m_histogram(HistogramData::Histogram::XMode::BinEdges,
                   HistogramData::Histogram::YMode::Counts),
-      eventType(TOF), mru(nullptr) {
+      eventType(TOF), m_storage(ROW_STORAGE), mru(nullptr) {
   this->events.assign(events.begin(), events.end());
   this->eventType = TOF;
   this->order = UNSORTED;
@@ -188,7 +252,7 @@ EventList::EventList(const std::vector<TofEvent> &events)
 EventList::EventList(const std::vector<WeightedEvent> &events)
     : m_histogram(HistogramData::Histogram::XMode::BinEdges,
                   HistogramData::Histogram::YMode::Counts),
-      mru(nullptr) {
+      m_storage(ROW_STORAGE), mru(nullptr) {
   this->weightedEvents.assign(events.begin(), events.end());
   this->eventType = WEIGHTED;
   this->order = UNSORTED;
@@ -199,7 +263,7 @@ EventList::EventList(const std::vector<WeightedEvent> &events)
 EventList::EventList(const std::vector<WeightedEventNoTime> &events)
     : m_histogram(HistogramData::Histogram::XMode::BinEdges,
                   HistogramData::Histogram::YMode::Counts),
-      mru(nullptr) {
+      m_storage(ROW_STORAGE), mru(nullptr) {
   this->weightedEventsNoTime.assign(events.begin(), events.end());
   this->eventType = WEIGHTED_NOTIME;
   this->order = UNSORTED;
@@ -228,7 +292,9 @@ void EventList::copyDataInto(EventList &sink) const {
   sink.events = events;
   sink.weightedEvents = weightedEvents;
   sink.weightedEventsNoTime = weightedEventsNoTime;
+  sink.m_columns = m_columns;
   sink.eventType = eventType;
+  sink.m_storage = m_storage;
   sink.order = order;
 }
 
@@ -254,6 +320,7 @@ void EventList::createFromHistogram(const ISpectrum *inSpec, bool GenerateZeros,
                                     int MaxEventsPerBin) {
   // Fresh start
   this->clear(true);
+  this->switchToRowStorage();
 
   // Get the input histogram
   const MantidVec &X = inSpec->readX();
@@ -338,7 +405,9 @@ EventList &EventList::operator=(const EventList &rhs) {
   events = rhs.events;
   weightedEvents = rhs.weightedEvents;
   weightedEventsNoTime = rhs.weightedEventsNoTime;
+  m_columns = rhs.m_columns;
   eventType = rhs.eventType;
+  m_storage = rhs.m_storage;
   order = rhs.order;
   return *this;
 }
@@ -349,6 +418,11 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns.append(event);
+    this->order = UNSORTED;
+    return *this;
+  }
 
   switch (this->eventType) {
   case TOF:
@@ -377,6 +451,7 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  this->switchToRowStorage();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -418,7 +493,10 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
   this->switchTo(WEIGHTED);
-  this->weightedEvents.emplace_back(event);
+  if (m_storage == COLUMN_STORAGE)
+    m_columns.append(event);
+  else
+    this->weightedEvents.emplace_back(event);
   this->order = UNSORTED;
   return *this;
 }
@@ -433,6 +511,7 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEvent> &more_events) {
+  this->switchToRowStorage();
   switch (this->eventType) {
   case TOF:
     // Need to switch to weighted
@@ -470,6 +549,7 @@ operator+=(const std::vector<WeightedEvent> &more_events) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEventNoTime> &more_events) {
+  this->switchToRowStorage();
   switch (this->eventType) {
   case TOF:
   case WEIGHTED:
@@ -498,6 +578,7 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
+  more_events.switchToRowStorage();
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
   case TOF:
@@ -565,6 +646,8 @@ EventList &EventList::operator-=(const EventList &more_events) {
     this->clearData();
     return *this;
   }
+  this->switchToRowStorage();
+  more_events.switchToRowStorage();
 
   // We'll let the -= operator for the given vector of event lists handle it
   switch (this->getEventType()) {
@@ -619,6 +702,10 @@ bool EventList::operator==(const EventList &rhs) const {
     return false;
   if (this->eventType != rhs.eventType)
     return false;
+  if (m_storage == COLUMN_STORAGE && rhs.m_storage == COLUMN_STORAGE)
+    return m_columns == rhs.m_columns;
+  this->switchToRowStorage();
+  rhs.switchToRowStorage();
   // Check all event lists; The empty ones will compare equal
   if (events != rhs.events)
     return false;
@@ -645,6 +732,9 @@ bool EventList::equals(const EventList &rhs, const double tolTof,
   if (this->eventType != rhs.eventType)
     return false;
 
+  this->switchToRowStorage();
+  rhs.switchToRowStorage();
+
   // loop over the events
   size_t numEvents = this->getNumberEvents();
   switch (this->eventType) {
@@ -687,6 +777,12 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns.switchTo(newType);
+    eventType = newType;
+    return;
+  }
+
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -767,6 +863,75 @@ void EventList::switchToWeightedEventsNoTime() {
   }
 }
 
+// -----------------------------------------------------------------------------------------------
+/** Set how the events are laid out in memory. Column storage keeps each event
+ * field in its own contiguous array (see EventColumns), which speeds up
+ * passes that only need the time-of-flight such as histogramming, converting
+ * or masking the tof. Operations that have no column implementation switch
+ * the list back to row storage on first use.
+ *
+ * @param storage :: the storage to switch to
+ */
+void EventList::setStorageType(const EventStorageType storage) {
+  if (storage == m_storage)
+    return;
+  if (storage == ROW_STORAGE) {
+    this->switchToRowStorage();
+    return;
+  }
+
+  switch (eventType) {
+  case TOF:
+    m_columns.assign(events);
+    break;
+  case WEIGHTED:
+    m_columns.assign(weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    m_columns.assign(weightedEventsNoTime);
+    break;
+  }
+  std::vector<TofEvent>().swap(this->events); // STL Trick to release memory
+  std::vector<WeightedEvent>().swap(this->weightedEvents);
+  std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime);
+  m_storage = COLUMN_STORAGE;
+}
+
+/** @return how the events are laid out in memory
+ */
+EventStorageType EventList::getStorageType() const { return m_storage; }
+
+// -----------------------------------------------------------------------------------------------
+/** Move the events from the columns back to the vector of the current event
+ * type. This is a const method because it does not change the events, only
+ * their layout, and is protected against calls from several threads in the
+ * same way as sorting.
+ */
+void EventList::switchToRowStorage() const {
+  if (m_storage == ROW_STORAGE)
+    return;
+
+  // Avoid converting from multiple threads
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  // If the list was converted while waiting for the lock, return.
+  if (m_storage == ROW_STORAGE)
+    return;
+
+  switch (eventType) {
+  case TOF:
+    m_columns.copyTo(events);
+    break;
+  case WEIGHTED:
+    m_columns.copyTo(weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    m_columns.copyTo(weightedEventsNoTime);
+    break;
+  }
+  m_columns.clear();
+  m_storage = ROW_STORAGE;
+}
+
 // ==============================================================================================
 // --- Testing functions (mostly)
 // ---------------------------------------------------------------
@@ -779,6 +944,7 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -809,6 +975,7 @@ const std::vector<TofEvent> &EventList::getEvents() const {
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
                              "getWeightedEventsNoTime().");
+  this->switchToRowStorage();
   return this->events;
 }
 
@@ -824,6 +991,7 @@ std::vector<TofEvent> &EventList::getEvents() {
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
                              "getWeightedEventsNoTime().");
+  this->switchToRowStorage();
   return this->events;
 }
 
@@ -839,6 +1007,7 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
                              "getEvents() or getWeightedEventsNoTime().");
+  this->switchToRowStorage();
   return this->weightedEvents;
 }
 
@@ -854,6 +1023,7 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
                              "getEvents() or getWeightedEventsNoTime().");
+  this->switchToRowStorage();
   return this->weightedEvents;
 }
 
@@ -867,6 +1037,7 @@ std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
                              "getEvents() or getWeightedEvents().");
+  this->switchToRowStorage();
   return this->weightedEventsNoTime;
 }
 
@@ -881,6 +1052,7 @@ EventList::getWeightedEventsNoTime() const {
     throw std::runtime_error("EventList::getWeightedEventsNoTime() called for "
                              "an EventList not of type WeightedEventNoTime. "
                              "Use getEvents() or getWeightedEvents().");
+  this->switchToRowStorage();
   return this->weightedEventsNoTime;
 }
 
@@ -898,6 +1070,7 @@ void EventList::clear(const bool removeDetIDs) {
   this->weightedEventsNoTime.clear();
   std::vector<WeightedEventNoTime>().swap(
       this->weightedEventsNoTime); // STL Trick to release memory
+  m_columns.clear();
   if (removeDetIDs)
     this->clearDetectorIDs();
 }
@@ -940,6 +1113,11 @@ void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
  * @param num :: number of events that will be in this EventList
  */
 void EventList::reserve(size_t num) {
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns.reserve(num);
+    return;
+  }
+
   switch (this->eventType) {
   case TOF:
     this->events.reserve(num);
@@ -953,6 +1131,28 @@ void EventList::reserve(size_t num) {
   }
 }
 
+/** Release the memory reserved for events that were never added, e.g. when
+ * fewer events were added than were reserved for.
+ */
+void EventList::shrinkToFit() {
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns.shrinkToFit();
+    return;
+  }
+
+  switch (this->eventType) {
+  case TOF:
+    this->events.shrink_to_fit();
+    break;
+  case WEIGHTED:
+    this->weightedEvents.shrink_to_fit();
+    break;
+  case WEIGHTED_NOTIME:
+    this->weightedEventsNoTime.shrink_to_fit();
+    break;
+  }
+}
+
 // ==============================================================================================
 // --- Sorting functions -----------------------------------------------------
 // ==============================================================================================
@@ -1003,6 +1203,12 @@ void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return;
 
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns.sortByTof();
+    this->order = TOF_SORT;
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     tbb::parallel_sort(events.begin(), events.end());
@@ -1031,6 +1237,7 @@ void EventList::sortTof() const {
 void EventList::sortTimeAtSample(const double &tofFactor,
                                  const double &tofShift,
                                  bool forceResort) const {
+  this->switchToRowStorage();
   // Check pre-cached sort flag.
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
@@ -1074,6 +1281,12 @@ void EventList::sortPulseTime() const {
   if (this->order == PULSETIME_SORT)
     return;
 
+  if (m_storage == COLUMN_STORAGE) {
+    m_columns.sortByPulseTime();
+    this->order = PULSETIME_SORT;
+    return;
+  }
+
   // Perform sort.
   switch (eventType) {
   case TOF:
@@ -1098,6 +1311,7 @@ void EventList::sortPulseTime() const {
 void EventList::sortPulseTimeTOF() const {
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered.
+  this->switchToRowStorage();
 
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
@@ -1131,6 +1345,7 @@ void EventList::sortPulseTimeTOF() const {
  */
 void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                                       const double seconds) const {
+  this->switchToRowStorage();
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
 
@@ -1173,7 +1388,9 @@ void EventList::reverse() {
   std::reverse(x.begin(), x.end());
 
   // flip the events if they are tof sorted
-  if (this->isSortedByTof()) {
+  if (this->isSortedByTof() && m_storage == COLUMN_STORAGE) {
+    m_columns.reverse();
+  } else if (this->isSortedByTof()) {
     switch (eventType) {
     case TOF:
       std::reverse(this->events.begin(), this->events.end());
@@ -1200,6 +1417,8 @@ void EventList::reverse() {
  * @return the number of events in the list.
  *  */
 size_t EventList::getNumberEvents() const {
+  if (m_storage == COLUMN_STORAGE)
+    return m_columns.size();
   switch (eventType) {
   case TOF:
     return this->events.size();
@@ -1215,6 +1434,8 @@ size_t EventList::getNumberEvents() const {
  * Much like stl containers, returns true if there is nothing in the event list.
  */
 bool EventList::empty() const {
+  if (m_storage == COLUMN_STORAGE)
+    return m_columns.empty();
   switch (eventType) {
   case TOF:
     return this->events.empty();
@@ -1234,6 +1455,8 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  if (m_storage == COLUMN_STORAGE)
+    return m_columns.getMemorySize() + sizeof(EventList);
   switch (eventType) {
   case TOF:
     return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
@@ -1761,6 +1984,8 @@ inline void EventList::compressFatEventsHelper(
  *be == this.
  */
 void EventList::compressEvents(double tolerance, EventList *destination) {
+  this->switchToRowStorage();
+  destination->switchToRowStorage();
   if (!this->empty()) {
     this->sortTof();
     switch (eventType) {
@@ -1817,6 +2042,8 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
 void EventList::compressFatEvents(
     const double tolerance, const Mantid::Types::Core::DateAndTime &timeStart,
     const double seconds, EventList *destination) {
+  this->switchToRowStorage();
+  destination->switchToRowStorage();
 
   // only worry about non-empty EventLists
   if (!this->empty()) {
@@ -1945,98 +2172,78 @@ typename std::vector<T>::iterator static findFirstEvent(std::vector<T> &events,
 }
 
 // --------------------------------------------------------------------------
-/** Generates both the Y and E (error) histograms
- * for an EventList with WeightedEvents.
+/** Add weighted events to the Y and squared E histograms.
  *
- * @param events: vector of events (with weights)
- * @param X: X-bins supplied
- * @param Y: counts returned
- * @param E: errors returned
- * @throw runtime_error if the EventList does not have weighted events
+ * @param events: vector of events (with weights), in any order
+ * @param bins: lookup of the X-bins
+ * @param Y: counts to add to, sized to the number of bins
+ * @param E: squared errors to add to, sized to the number of bins
  */
 template <class T>
 void EventList::histogramForWeightsHelper(const std::vector<T> &events,
-                                          const MantidVec &X, MantidVec &Y,
-                                          MantidVec &E) {
-  // For slight speed=up.
-  size_t x_size = X.size();
-
-  if (x_size <= 1) {
-    // X was not set. Return an empty array.
-    Y.resize(0, 0);
-    return;
-  }
-
-  // If the sizes are the same, then the "resize" command will NOT clear the
-  // original values.
-  bool mustFill = (Y.size() == x_size - 1);
-  // Clear the Y data, assign all to 0.
-  Y.resize(x_size - 1, 0.0);
-  // Clear the Error data, assign all to 0.
-  // Note: Errors will be squared until the last step.
-  E.resize(x_size - 1, 0.0);
-
-  if (mustFill) {
-    // We must make sure the starting point is 0.0
-    std::fill(Y.begin(), Y.end(), 0.0);
-    std::fill(E.begin(), E.end(), 0.0);
-  }
-
-  //---------------------- Histogram without weights
-  //---------------------------------
-
-  // Do we even have any events to do?
-  if (!events.empty()) {
-    // Iterate through all events (sorted by tof)
-    auto itev = findFirstEvent(events, T(X[0]));
-    auto itev_end = events.cend();
-    // The above can still take you to end() if no events above X[0], so check
-    // again.
-    if (itev == itev_end)
-      return;
+                                          const Kernel::BinEdgeLookup &bins,
+                                          MantidVec &Y, MantidVec &E) {
+  histogramInBlocks(
+      bins, events.size(), [&events](size_t i) { return events[i].tof(); },
+      [&events, &Y, &E](size_t i, size_t bin) {
+        // Convert to double before adding, to preserve precision
+        Y[bin] += double(events[i].m_weight);
+        E[bin] += double(events[i].m_errorSquared); // square of error
+      });
+}
 
-    // Find the first bin
-    size_t bin = 0;
-    // The tof is greater the first bin boundary, so we need to find the first
-    // bin
-    double tof = itev->tof();
-    while (bin < x_size - 1) {
-      // Within range?
-      if ((tof >= X[bin]) && (tof < X[bin + 1])) {
-        // Add up the weight (convert to double before adding, to preserve
-        // precision)
-        Y[bin] += double(itev->m_weight);
-        E[bin] += double(itev->m_errorSquared); // square of error
-        break;
-      }
-      ++bin;
-    }
-    // Go to the next event, we've already binned this first one.
-    ++itev;
+// --------------------------------------------------------------------------
+/** Add weighted events held in columns to the Y and squared E histograms.
+ * Only the tof, weight and error columns are read.
+ *
+ * @param events: columns of events (with weights), in any order
+ * @param bins: lookup of the X-bins
+ * @param Y: counts to add to, sized to the number of bins
+ * @param E: squared errors to add to, sized to the number of bins
+ */
+void EventList::histogramForWeightsHelper(const EventColumns &events,
+                                          const Kernel::BinEdgeLookup &bins,
+                                          MantidVec &Y, MantidVec &E) {
+  const auto &tofs = events.tofs();
+  const auto &weights = events.weights();
+  const auto &errorSquareds = events.errorSquareds();
+  histogramInBlocks(
+      bins, tofs.size(), [&tofs](size_t i) { return tofs[i]; },
+      [&weights, &errorSquareds, &Y, &E](size_t i, size_t bin) {
+        Y[bin] += double(weights[i]);
+        E[bin] += double(errorSquareds[i]); // square of error
+      });
+}
 
-    // Keep going through all the events
-    while ((itev != itev_end) && (bin < x_size - 1)) {
-      tof = itev->tof();
-      while (bin < x_size - 1) {
-        // Within range? Since both events and X are sorted, they are going to
-        // have
-        // tof >= X[bin] because the previous event was.
-        if (tof < X[bin + 1]) {
-          // Add up the weight (convert to double before adding, to preserve
-          // precision)
-          Y[bin] += double(itev->m_weight);
-          E[bin] += double(itev->m_errorSquared); // square of error
-          break;
-        }
-        ++bin;
-      }
-      ++itev;
-    }
-  } // end if (there are any events to histogram)
+// --------------------------------------------------------------------------
+/** Add the counts of unweighted events to a histogram.
+ *
+ * @param events: the events, in any order
+ * @param bins: lookup of the X-bins
+ * @param Y: counts histogram to add to, sized to the number of bins
+ */
+void EventList::countsHistogramHelper(const std::vector<TofEvent> &events,
+                                      const Kernel::BinEdgeLookup &bins,
+                                      MantidVec &Y) {
+  histogramInBlocks(
+      bins, events.size(), [&events](size_t i) { return events[i].tof(); },
+      [&Y](size_t, size_t bin) { ++Y[bin]; });
+}
 
-  // Now do the sqrt of all errors
-  std::transform(E.begin(), E.end(), E.begin(),
-                 static_cast<double (*)(double)>(sqrt));
+// --------------------------------------------------------------------------
+/** Add the counts of unweighted events to a histogram, reading only the
+ * time-of-flight column.
+ *
+ * @param tofs: time-of-flight of each event, in any order
+ * @param bins: lookup of the X-bins
+ * @param Y: counts histogram to add to, sized to the number of bins
+ */
+void EventList::countsHistogramHelper(const std::vector<double> &tofs,
+                                      const Kernel::BinEdgeLookup &bins,
+                                      MantidVec &Y) {
+  histogramInBlocks(
+      bins, tofs.size(), [&tofs](size_t i) { return tofs[i]; },
+      [&Y](size_t, size_t bin) { ++Y[bin]; });
 }
 
 // --------------------------------------------------------------------------
@@ -2051,6 +2258,7 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
  */
 void EventList::generateHistogramPulseTime(const MantidVec &X, MantidVec &Y,
                                            MantidVec &E, bool skipError) const {
+  this->switchToRowStorage();
   // All types of weights need to be sorted by Pulse Time
   this->sortPulseTime();
 
@@ -2088,6 +2296,7 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
                                               const double &tofFactor,
                                               const double &tofOffset,
                                               bool skipError) const {
+  this->switchToRowStorage();
   // All types of weights need to be sorted by time at sample
   this->sortTimeAtSample(tofFactor, tofOffset);
 
@@ -2113,6 +2322,11 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
 /** Generates both the Y and E (error) histograms w.r.t TOF
  * for an EventList with or without WeightedEvents.
  *
+ * The bin of each event is computed directly for linear and logarithmic bins
+ * (see Kernel::BinEdgeLookup), so the events are histogrammed in whatever
+ * order they are in. Arbitrary bin edges are searched, which is quickest with
+ * the events sorted by TOF, so the events are sorted first in that case.
+ *
  * @param X: x-bins supplied
  * @param Y: counts returned
  * @param E: errors returned
@@ -2121,26 +2335,46 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
+  if (X.size() <= 1) {
+    // X was not set. Return an empty array.
+    Y.clear();
+    E.clear();
+    return;
+  }
 
-  this->sortTof();
+  const Kernel::BinEdgeLookup bins(X);
+  std::unique_lock<std::mutex> lock(m_sortMutex, std::defer_lock);
+  if (bins.isArithmetic() && order != TOF_SORT) {
+    // Stop another thread sorting the events while they are read
+    lock.lock();
+  } else {
+    this->sortTof();
+  }
 
-  switch (eventType) {
-  case TOF:
-    // Make the single ones
-    this->generateCountsHistogram(X, Y);
+  // Start from zero whatever the previous size was
+  Y.assign(X.size() - 1, 0.0);
+  if (eventType == TOF) {
+    if (m_storage == COLUMN_STORAGE)
+      countsHistogramHelper(m_columns.tofs(), bins, Y);
+    else
+      countsHistogramHelper(this->events, bins, Y);
     if (!skipError)
       this->generateErrorsHistogram(Y, E);
-    break;
+    return;
+  }
 
-  case WEIGHTED:
-    histogramForWeightsHelper(this->weightedEvents, X, Y, E);
-    break;
+  // Note: Errors will be squared until the last step.
+  E.assign(X.size() - 1, 0.0);
+  if (m_storage == COLUMN_STORAGE)
+    histogramForWeightsHelper(m_columns, bins, Y, E);
+  else if (eventType == WEIGHTED)
+    histogramForWeightsHelper(this->weightedEvents, bins, Y, E);
+  else
+    histogramForWeightsHelper(this->weightedEventsNoTime, bins, Y, E);
 
-  case WEIGHTED_NOTIME:
-    histogramForWeightsHelper(this->weightedEventsNoTime, X, Y, E);
-    break;
-  }
+  // Now do the sqrt of all errors
+  std::transform(E.begin(), E.end(), E.begin(),
+                 static_cast<double (*)(double)>(sqrt));
 }
 
 // --------------------------------------------------------------------------
@@ -2231,6 +2465,7 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
                                                  MantidVec &Y,
                                                  const double TOF_min,
                                                  const double TOF_max) const {
+  this->switchToRowStorage();
 
   if (this->events.empty())
     return;
@@ -2327,51 +2562,6 @@ void EventList::generateCountsHistogramTimeAtSample(
   } // end if (there are any events to histogram)
 }
 
-// --------------------------------------------------------------------------
-/** Fill a histogram given specified histogram bounds. Does not modify
- * the eventlist (const method).
- * @param X :: The x bins
- * @param Y :: The generated counts histogram
- */
-void EventList::generateCountsHistogram(const MantidVec &X,
-                                        MantidVec &Y) const {
-  // For slight speed=up.
-  size_t x_size = X.size();
-
-  if (x_size <= 1) {
-    // X was not set. Return an empty array.
-    Y.resize(0, 0);
-    return;
-  }
-
-  // Sort the events by tof
-  this->sortTof();
-  // Clear the Y data, assign all to 0.
-  Y.resize(x_size - 1, 0);
-
-  //---------------------- Histogram without weights
-  //---------------------------------
-
-  // Do we even have any events to do?
-  if (!this->events.empty()) {
-    // Iterate through all events (sorted by tof) placing them in the correct
-    // bin.
-    auto itev = findFirstEvent(this->events, TofEvent(X[0]));
-    // Go through all the events,
-    for (auto itx = X.cbegin(); itev != events.end(); ++itev) {
-      double tof = itev->tof();
-      itx = std::find_if(itx, X.cend(),
-                         [tof](const double x) { return tof < x; });
-      if (itx == X.cend()) {
-        break;
-      }
-      auto bin =
-          std::max(std::distance(X.cbegin(), itx) - 1, std::ptrdiff_t{0});
-      ++Y[bin];
-    }
-  } // end if (there are any events to histogram)
-}
-
 // --------------------------------------------------------------------------
 /**
  * Generate the Error histogram for the provided counts histogram.
@@ -2455,6 +2645,50 @@ void EventList::integrateHelper(std::vector<T> &events, const double minX,
   error = std::sqrt(error);
 }
 
+/** Integrate the events held in columns between a range of X values, or all
+ * events.
+ *
+ * @param events :: columns of events, sorted by tof unless entireRange.
+ * @param minX :: minimum X bin to use in integrating.
+ * @param maxX :: maximum X bin to use in integrating.
+ * @param entireRange :: set to true to use the entire range. minX and maxX are
+ *then ignored!
+ * @param sum :: reference to a double to put the sum in.
+ * @param error :: reference to a double to put the error in.
+ */
+void EventList::integrateHelper(const EventColumns &events, const double minX,
+                                const double maxX, const bool entireRange,
+                                double &sum, double &error) {
+  sum = 0;
+  error = 0;
+  const auto &tofs = events.tofs();
+  auto lowit = tofs.cbegin();
+  auto highit = tofs.cend();
+  if (!entireRange) {
+    // If a silly range was given, return 0.
+    if (maxX < minX)
+      return;
+    lowit = std::lower_bound(tofs.cbegin(), tofs.cend(), minX);
+    highit = std::upper_bound(lowit, tofs.cend(), maxX);
+  }
+  const auto first = static_cast<size_t>(lowit - tofs.cbegin());
+  const auto last = static_cast<size_t>(highit - tofs.cbegin());
+
+  if (events.hasWeights()) {
+    const auto &weights = events.weights();
+    const auto &errorSquareds = events.errorSquareds();
+    for (size_t i = first; i < last; ++i) {
+      sum += weights[i];
+      error += errorSquareds[i];
+    }
+  } else {
+    // Unweighted events each count 1 with an error of 1
+    sum = static_cast<double>(last - first);
+    error = sum;
+  }
+  error = std::sqrt(error);
+}
+
 // --------------------------------------------------------------------------
 /** Integrate the events between a range of X values, or all events.
  *
@@ -2491,6 +2725,11 @@ void EventList::integrate(const double minX, const double maxX,
     this->sortTof();
   }
 
+  if (m_storage == COLUMN_STORAGE) {
+    integrateHelper(m_columns, minX, maxX, entireRange, sum, error);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2535,6 +2774,11 @@ void EventList::convertTof(std::function<double(double)> func,
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_storage == COLUMN_STORAGE) {
+    this->convertTofHelper(m_columns, func);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2561,6 +2805,16 @@ void EventList::convertTofHelper(std::vector<T> &events,
     ev.m_tof = func(ev.m_tof);
 }
 
+/**
+ * @param events :: columns of events to change
+ * @param func :: function applied to each time-of-flight
+ */
+void EventList::convertTofHelper(EventColumns &events,
+                                 const std::function<double(double)> &func) {
+  auto &tofs = events.tofs();
+  std::transform(tofs.begin(), tofs.end(), tofs.begin(), func);
+}
+
 // --------------------------------------------------------------------------
 /**
  * Convert the time of flight by tof'=tof*factor+offset
@@ -2579,6 +2833,11 @@ void EventList::convertTof(const double factor, const double offset) {
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_storage == COLUMN_STORAGE) {
+    this->convertTofHelper(m_columns, factor, offset);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2611,6 +2870,20 @@ void EventList::convertTofHelper(std::vector<T> &events, const double factor,
   }
 }
 
+/** Function to do the conversion factor work on events held in columns.
+ * Only the tof column is touched. Does NOT reverse the events if the
+ * factor < 0
+ *
+ * @param events :: columns of events to change.
+ * @param factor :: multiply by this
+ * @param offset :: add this
+ */
+void EventList::convertTofHelper(EventColumns &events, const double factor,
+                                 const double offset) {
+  for (auto &tof : events.tofs())
+    tof = tof * factor + offset;
+}
+
 // --------------------------------------------------------------------------
 /**
  * Convert the units in the TofEvent's m_tof field to
@@ -2665,6 +2938,7 @@ void EventList::addPulsetimesHelper(std::vector<T> &events,
  * @param seconds :: The value to shift the pulsetime by, in seconds
  */
 void EventList::addPulsetime(const double seconds) {
+  this->switchToRowStorage();
   if (this->getNumberEvents() <= 0)
     return;
 
@@ -2690,6 +2964,7 @@ void EventList::addPulsetime(const double seconds) {
  * @param seconds :: A set of values to shift the pulsetime by, in seconds
  */
 void EventList::addPulsetimes(const std::vector<double> &seconds) {
+  this->switchToRowStorage();
   if (this->getNumberEvents() <= 0)
     return;
   if (this->getNumberEvents() != seconds.size()) {
@@ -2752,6 +3027,34 @@ std::size_t EventList::maskTofHelper(std::vector<T> &events,
   return 0;
 }
 
+// --------------------------------------------------------------------------
+/** Mask out events held in columns that have a tof between tofMin and tofMax
+ * (inclusively). Events are removed from the list.
+ * @param events :: columns of events to change, sorted by tof.
+ * @param tofMin :: lower bound of TOF to filter out
+ * @param tofMax :: upper bound of TOF to filter out
+ * @returns The number of events deleted.
+ */
+std::size_t EventList::maskTofHelper(EventColumns &events, const double tofMin,
+                                     const double tofMax) {
+  const auto &tofs = events.tofs();
+  // quick checks to make sure that the masking range is even in the data
+  if (tofMin > tofs.back())
+    return 0;
+  if (tofMax < tofs.front())
+    return 0;
+
+  auto it_first = std::lower_bound(tofs.cbegin(), tofs.cend(), tofMin);
+  if ((it_first != tofs.cend()) && (*it_first < tofMax)) {
+    auto it_last = std::upper_bound(it_first, tofs.cend(), tofMax);
+    const auto first = static_cast<size_t>(it_first - tofs.cbegin());
+    const auto last = static_cast<size_t>(it_last - tofs.cbegin());
+    events.erase(first, last);
+    return last - first;
+  }
+  return 0;
+}
+
 // --------------------------------------------------------------------------
 /**
  * Mask out events that have a tof between tofMin and tofMax (inclusively).
@@ -2773,6 +3076,13 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   // Convert the list
   size_t numOrig = 0;
   size_t numDel = 0;
+  if (m_storage == COLUMN_STORAGE) {
+    numOrig = m_columns.size();
+    numDel = this->maskTofHelper(m_columns, tofMin, tofMax);
+    if (numDel >= numOrig)
+      this->clear(false);
+    return;
+  }
   switch (eventType) {
   case TOF:
     numOrig = this->events.size();
@@ -2830,6 +3140,7 @@ std::size_t EventList::maskConditionHelper(std::vector<T> &events,
  * @param mask :: condition vector
  */
 void EventList::maskCondition(const std::vector<bool> &mask) {
+  this->switchToRowStorage();
 
   // mask size must match the number of events
   if (this->getNumberEvents() != mask.size())
@@ -2882,6 +3193,11 @@ void EventList::getTofs(std::vector<double> &tofs) const {
   // Set the capacity of the vector to avoid multiple resizes
   tofs.reserve(this->getNumberEvents());
 
+  if (m_storage == COLUMN_STORAGE) {
+    tofs.assign(m_columns.tofs().cbegin(), m_columns.tofs().cend());
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2925,6 +3241,7 @@ void EventList::getWeightsHelper(const std::vector<T> &events,
  *  @param weights :: A reference to the vector to be filled
  */
 void EventList::getWeights(std::vector<double> &weights) const {
+  this->switchToRowStorage();
   // Set the capacity of the vector to avoid multiple resizes
   weights.reserve(this->getNumberEvents());
 
@@ -2973,6 +3290,7 @@ void EventList::getWeightErrorsHelper(const std::vector<T> &events,
  *  @param weightErrors :: A reference to the vector to be filled
  */
 void EventList::getWeightErrors(std::vector<double> &weightErrors) const {
+  this->switchToRowStorage();
   // Set the capacity of the vector to avoid multiple resizes
   weightErrors.reserve(this->getNumberEvents());
 
@@ -3022,6 +3340,7 @@ void EventList::getPulseTimesHelper(
  * @return by copy a vector of DateAndTime times
  */
 std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
+  this->switchToRowStorage();
   std::vector<Mantid::Types::Core::DateAndTime> times;
   // Set the capacity of the vector to avoid multiple resizes
   times.reserve(this->getNumberEvents());
@@ -3053,6 +3372,13 @@ double EventList::getTofMin() const {
   if (this->empty())
     return tMin;
 
+  if (m_storage == COLUMN_STORAGE) {
+    const auto &tofs = m_columns.tofs();
+    if (this->order == TOF_SORT)
+      return tofs.front();
+    return *std::min_element(tofs.cbegin(), tofs.cend());
+  }
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -3097,6 +3423,13 @@ double EventList::getTofMax() const {
   if (this->empty())
     return tMax;
 
+  if (m_storage == COLUMN_STORAGE) {
+    const auto &tofs = m_columns.tofs();
+    if (this->order == TOF_SORT)
+      return tofs.back();
+    return *std::max_element(tofs.cbegin(), tofs.cend());
+  }
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -3135,6 +3468,7 @@ double EventList::getTofMax() const {
  * @return The minimum tof value for the list of the events.
  */
 DateAndTime EventList::getPulseTimeMin() const {
+  this->switchToRowStorage();
   // set up as the maximum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3179,6 +3513,7 @@ DateAndTime EventList::getPulseTimeMin() const {
  * @return The maximum tof value for the list of events.
  */
 DateAndTime EventList::getPulseTimeMax() const {
+  this->switchToRowStorage();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3222,6 +3557,7 @@ DateAndTime EventList::getPulseTimeMax() const {
 void EventList::getPulseTimeMinMax(
     Mantid::Types::Core::DateAndTime &tMin,
     Mantid::Types::Core::DateAndTime &tMax) const {
+  this->switchToRowStorage();
   // set up as the minimum available date time.
   tMax = DateAndTime::minimum();
   tMin = DateAndTime::maximum();
@@ -3272,6 +3608,7 @@ void EventList::getPulseTimeMinMax(
 
 DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
                                           const double &tofOffset) const {
+  this->switchToRowStorage();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3319,6 +3656,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
 
 DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor,
                                           const double &tofOffset) const {
+  this->switchToRowStorage();
   // set up as the minimum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3391,6 +3729,7 @@ void EventList::setTofsHelper(std::vector<T> &events,
  * @param tofs :: The vector of doubles to set the tofs to.
  */
 void EventList::setTofs(const MantidVec &tofs) {
+  this->switchToRowStorage();
   this->order = UNSORTED;
 
   // Convert the list
@@ -3493,6 +3832,7 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  this->switchToRowStorage();
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3621,6 +3961,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events,
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y,
                          const MantidVec &E) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3761,6 +4102,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events,
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y,
                        const MantidVec &E) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3898,10 +4240,12 @@ void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
     throw std::invalid_argument("In-place filtering is not allowed");
   }
 
+  this->switchToRowStorage();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
   // Clear the output
   output.clear();
+  output.switchToRowStorage();
   // Has to match the given type
   output.switchTo(eventType);
   output.setDetectorIDs(this->getDetectorIDs());
@@ -3936,6 +4280,7 @@ void EventList::filterByTimeAtSample(Types::Core::DateAndTime start,
   this->sortTimeAtSample(tofFactor, tofOffset);
   // Clear the output
   output.clear();
+  output.switchToRowStorage();
   // Has to match the given type
   output.switchTo(eventType);
   output.setDetectorIDs(this->getDetectorIDs());
@@ -4035,6 +4380,55 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
   events.resize((itOut - events.begin()));
 }
 
+//------------------------------------------------------------------------------------------------
+/** Perform an in-place filtering on events held in columns. Only the pulse
+ * time column is read to decide which events are kept.
+ *
+ * @param splitter :: a TimeSplitterType where all the entries (start/end time)
+ *indicate events
+ *     that will be kept. Any other events will be deleted.
+ * @param events :: columns of events, sorted by pulse time.
+ */
+void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
+                                    EventColumns &events) {
+  const auto &pulseTimes = events.pulseTimes();
+  const size_t numEvents = pulseTimes.size();
+  // Index of the next input event, and of the next kept event
+  size_t in = 0;
+  size_t out = 0;
+
+  for (auto itspl = splitter.cbegin(); itspl != splitter.cend(); ++itspl) {
+    const int64_t start = itspl->start().totalNanoseconds();
+    const int64_t stop = itspl->stop().totalNanoseconds();
+    const int index = itspl->index();
+
+    // Skip the events before the start of the time
+    while ((in < numEvents) && (pulseTimes[in] < start))
+      ++in;
+
+    if (out == in) {
+      // Aligned, nothing to move
+      while ((in < numEvents) && (pulseTimes[in] < stop))
+        ++in;
+      out = in;
+    } else {
+      while ((in < numEvents) && (pulseTimes[in] < stop)) {
+        if (index >= 0) {
+          events.move(in, out);
+          ++out;
+        }
+        ++in;
+      }
+    }
+
+    // No need to keep looping through the filter if we are out of events
+    if (in == numEvents)
+      break;
+  }
+
+  events.resize(out);
+}
+
 //------------------------------------------------------------------------------------------------
 /** Use a TimeSplitterType to filter the event list in place.
  *
@@ -4049,10 +4443,16 @@ void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
   // Iterate through all events (sorted by pulse time)
   switch (eventType) {
   case TOF:
-    filterInPlaceHelper(splitter, this->events);
+    if (m_storage == COLUMN_STORAGE)
+      filterInPlaceHelper(splitter, m_columns);
+    else
+      filterInPlaceHelper(splitter, this->events);
     break;
   case WEIGHTED:
-    filterInPlaceHelper(splitter, this->weightedEvents);
+    if (m_storage == COLUMN_STORAGE)
+      filterInPlaceHelper(splitter, m_columns);
+    else
+      filterInPlaceHelper(splitter, this->weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     throw std::runtime_error("EventList::filterInPlace() called on an "
@@ -4134,6 +4534,7 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
                             std::vector<EventList *> outputs) const {
+  this->switchToRowStorage();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4271,6 +4672,7 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
                                 std::map<int, EventList *> outputs,
                                 bool docorrection, double toffactor,
                                 double tofshift) const {
+  this->switchToRowStorage();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4321,9 +4723,8 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
  *boundaries of splitters
  * @param vecgroups :: a vector of integer serving as the target workspace group
  *for splitters
- * @param outputs :: a vector of where the split events will end up. The # of
- *entries in there should
- *        be big enough to accommodate the indices.
+ * @param outputs :: the event lists where the split events will end up,
+ *indexed by group + 1. Missing groups may be nullptr.
  * @param vecEvents :: either this->events or this->weightedEvents.
  * @param docorrection :: flag to determine whether or not to apply correction
  * @param toffactor :: factor multiplied to TOF for correcting event time from
@@ -4334,24 +4735,15 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
 template <class T>
 std::string EventList::splitByFullTimeVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
+    const std::vector<EventList *> &outputs, typename std::vector<T> &vecEvents,
     bool docorrection, double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  typename std::vector<T>::iterator eviter;
   std::stringstream msgss;
 
   // Loop through events
-  for (eviter = vecEvents.begin(); eviter != vecEvents.end(); ++eviter) {
+  for (const auto &event : vecEvents) {
     // Obtain time of event
-    int64_t evabstimens;
-    if (docorrection)
-      evabstimens = eviter->m_pulsetime.totalNanoseconds() +
-                    static_cast<int64_t>(toffactor * eviter->m_tof * 1000 +
-                                         tofshift * 1.0E9);
-    else
-      evabstimens = eviter->m_pulsetime.totalNanoseconds() +
-                    static_cast<int64_t>(eviter->m_tof * 1000);
+    const int64_t evabstimens =
+        splitterEventTime(event, docorrection, toffactor, tofshift);
 
     // Search in vector
     int index = static_cast<int>(
@@ -4368,15 +4760,14 @@ std::string EventList::splitByFullTimeVectorSplitterHelper(
     }
 
     // Copy event to the proper group
-    EventList *myOutput = outputs[group];
+    EventList *myOutput = outputOfGroup(outputs, group);
     if (!myOutput) {
       std::stringstream errss;
       errss << "Group " << group << " has a NULL output EventList. "
             << "\n";
       msgss << errss.str();
     } else {
-      const T eventCopy(*eviter);
-      myOutput->addEventQuickly(eventCopy);
+      myOutput->addEventQuickly(event);
     }
   }
 
@@ -4393,9 +4784,8 @@ std::string EventList::splitByFullTimeVectorSplitterHelper(
  *boundaries of splitters
  * @param vecgroups :: a vector of integer serving as the target workspace group
  *for splitters
- * @param outputs :: a vector of where the split events will end up. The # of
- *entries in there should
- *        be big enough to accommodate the indices.
+ * @param outputs :: the event lists where the split events will end up,
+ *indexed by group + 1. Missing groups may be nullptr.
  * @param vecEvents :: either this->events or this->weightedEvents.
  * @param docorrection :: flag to determine whether or not to apply correction
  * @param toffactor :: factor multiplied to TOF for correcting event time from
@@ -4406,82 +4796,50 @@ std::string EventList::splitByFullTimeVectorSplitterHelper(
 template <class T>
 std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
+    const std::vector<EventList *> &outputs, typename std::vector<T> &vecEvents,
     bool docorrection, double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  // typename std::vector<T>::iterator eviter;
-  std::stringstream msgss;
-
-  size_t num_splitters = vecgroups.size();
-  // prepare to Iterate through all events (sorted by tof)
-  auto iter_events = vecEvents.begin();
-  auto iter_events_end = vecEvents.end();
-
-  // std::stringstream debug_ss;
-  // debug_ss << "\nFilter events...:\n";
-
-  for (size_t i = 0; i < num_splitters; ++i) {
-    // get one splitter
-    int64_t start_i64 = vectimes[i];
-    int64_t stop_i64 = vectimes[i + 1];
-    int group = vecgroups[i];
-    // debug_ss << "working on splitter: " << i << " from " << start_i64 << " to
-    // " << stop_i64 << "\n";
-
-    // go over events
-    while (iter_events != iter_events_end) {
-      int64_t absolute_time;
-      if (docorrection)
-        absolute_time =
-            iter_events->m_pulsetime.totalNanoseconds() +
-            static_cast<int64_t>(toffactor * iter_events->m_tof * 1000 +
-                                 tofshift * 1.0E9);
-      else
-        absolute_time = iter_events->m_pulsetime.totalNanoseconds() +
-                        static_cast<int64_t>(iter_events->m_tof * 1000);
-
-      // debug_ss << "  event " << iter_events - vecEvents.begin() << " abs.time
-      // = " << absolute_time << "\n";
-
-      if (absolute_time < start_i64) {
-        // event occurs before the splitter. only can happen with first
-        // splitter. Then ignore and move to next
-        ++iter_events;
-        continue;
-      }
-
-      if (absolute_time < stop_i64) {
-        // in the splitter, then copy the event into another
-        const T eventCopy(*iter_events);
-        // Copy event to the proper group
-        EventList *myOutput = outputs[group];
-        if (!myOutput) {
-          // there is no such group defined. quit for this group
-          std::stringstream errss;
-          errss << "Group " << group << " has a NULL output EventList. "
-                << "\n";
-          msgss << errss.str();
-          throw std::runtime_error(errss.str());
-        }
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++iter_events;
-      } else {
-        // event occurs after the stop time, it should belonged to the next
-        // splitter
-        break;
-      }
-    } // while
+  const size_t num_splitters = vecgroups.size();
+  // prepare to Iterate through all events (sorted by pulse time and tof)
+  auto iter_events = vecEvents.cbegin();
+  const auto iter_events_end = vecEvents.cend();
+
+  size_t i = 0;
+  while (iter_events != iter_events_end && i < num_splitters) {
+    const int64_t absolute_time =
+        splitterEventTime(*iter_events, docorrection, toffactor, tofshift);
+
+    if (absolute_time < vectimes[i]) {
+      // event occurs before the splitter. only happens with the first
+      // splitter or if the correction reorders events. Then ignore it.
+      ++iter_events;
+      continue;
+    }
 
-    // quit the loop if there is no more event left
-    if (iter_events == iter_events_end)
-      break;
-  } // for splitter
+    if (absolute_time >= vectimes[i + 1]) {
+      // event occurs after the stop time: jump to the splitter holding it
+      // rather than stepping through the splitters with no events
+      i = static_cast<size_t>(std::upper_bound(vectimes.cbegin() + i + 1,
+                                               vectimes.cend(),
+                                               absolute_time) -
+                              vectimes.cbegin()) -
+          1;
+      continue;
+    }
 
-  // std::cout << debug_ss.str();
+    // in the splitter, then copy the event to the proper group
+    EventList *myOutput = outputOfGroup(outputs, vecgroups[i]);
+    if (!myOutput) {
+      // there is no such group defined. quit for this group
+      std::stringstream errss;
+      errss << "Group " << vecgroups[i] << " has a NULL output EventList. "
+            << "\n";
+      throw std::runtime_error(errss.str());
+    }
+    myOutput->addEventQuickly(*iter_events);
+    ++iter_events;
+  }
 
-  return (msgss.str());
+  return "";
 }
 
 //----------------------------------------------------------------------------------------------
@@ -4495,13 +4853,46 @@ std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
  * @param tofshift :: shift to TOF in unit of SECOND for correction
  * @return
  */
-// TODO/FIXME/NOW - Consider to use vector to replace vec_outputEventList and
-// have an option to ignore the un-filtered events!
 std::string EventList::splitByFullTimeMatrixSplitter(
     const std::vector<int64_t> &vec_splitters_time,
     const std::vector<int> &vecgroups,
     std::map<int, EventList *> vec_outputEventList, bool docorrection,
     double toffactor, double tofshift) const {
+  // Index the output event lists by group + 1
+  int maxgroup = -1;
+  for (const auto &output : vec_outputEventList)
+    maxgroup = std::max(maxgroup, output.first);
+  std::vector<EventList *> outputs(static_cast<size_t>(maxgroup + 2), nullptr);
+  for (const auto &output : vec_outputEventList) {
+    if (output.first >= -1)
+      outputs[static_cast<size_t>(output.first + 1)] = output.second;
+  }
+
+  return splitByFullTimeMatrixSplitter(vec_splitters_time, vecgroups, outputs,
+                                       docorrection, toffactor, tofshift);
+}
+
+//----------------------------------------------------------------------------------------------
+/**
+ * @brief EventList::splitByFullTimeMatrixSplitter
+ * The events are sorted once by pulse time and TOF and go to their outputs in
+ * a single pass. Looking up an output is an index into a vector, so splitting
+ * into many targets costs no more per event than splitting into a few.
+ * @param vec_splitters_time  :: vector of splitting times
+ * @param vecgroups :: vector of index group for splitters
+ * @param outputs :: the event lists of the groups, indexed by group + 1 such
+ * that the first one takes the events of group -1. Missing groups may be
+ * nullptr.
+ * @param docorrection :: flag to do TOF correction from detector to sample
+ * @param toffactor :: factor multiplied to TOF for correction
+ * @param tofshift :: shift to TOF in unit of SECOND for correction
+ * @return
+ */
+std::string EventList::splitByFullTimeMatrixSplitter(
+    const std::vector<int64_t> &vec_splitters_time,
+    const std::vector<int> &vecgroups, const std::vector<EventList *> &outputs,
+    bool docorrection, double toffactor, double tofshift) const {
+  this->switchToRowStorage();
   // Check validity
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4512,10 +4903,9 @@ std::string EventList::splitByFullTimeMatrixSplitter(
   sortPulseTimeTOF();
 
   // Initialize all the output event list
-  std::map<int, EventList *>::iterator outiter;
-  for (outiter = vec_outputEventList.begin();
-       outiter != vec_outputEventList.end(); ++outiter) {
-    EventList *opeventlist = outiter->second;
+  for (auto *opeventlist : outputs) {
+    if (!opeventlist)
+      continue;
     opeventlist->clear();
     opeventlist->setDetectorIDs(this->getDetectorIDs());
     opeventlist->setHistogram(m_histogram);
@@ -4528,8 +4918,12 @@ std::string EventList::splitByFullTimeMatrixSplitter(
   // Do nothing if there are no entries
   if (vecgroups.empty()) {
     // Copy all events to group workspace = -1
-    (*vec_outputEventList[-1]) = (*this);
-    // this->duplicate(outputs[-1]);
+    EventList *unfiltered = outputOfGroup(outputs, -1);
+    if (!unfiltered)
+      throw std::invalid_argument(
+          "EventList::splitByFullTimeMatrixSplitter() needs an output for "
+          "group -1 when there are no splitters.");
+    *unfiltered = *this;
   } else {
     // Split
 
@@ -4541,22 +4935,22 @@ std::string EventList::splitByFullTimeMatrixSplitter(
     case TOF:
       if (sparse_splitter)
         debugmessage = splitByFullTimeSparseVectorSplitterHelper(
-            vec_splitters_time, vecgroups, vec_outputEventList, this->events,
-            docorrection, toffactor, tofshift);
+            vec_splitters_time, vecgroups, outputs, this->events, docorrection,
+            toffactor, tofshift);
       else
         debugmessage = splitByFullTimeVectorSplitterHelper(
-            vec_splitters_time, vecgroups, vec_outputEventList, this->events,
-            docorrection, toffactor, tofshift);
+            vec_splitters_time, vecgroups, outputs, this->events, docorrection,
+            toffactor, tofshift);
       break;
     case WEIGHTED:
       if (sparse_splitter)
         debugmessage = splitByFullTimeSparseVectorSplitterHelper(
-            vec_splitters_time, vecgroups, vec_outputEventList,
-            this->weightedEvents, docorrection, toffactor, tofshift);
+            vec_splitters_time, vecgroups, outputs, this->weightedEvents,
+            docorrection, toffactor, tofshift);
       else
         debugmessage = splitByFullTimeVectorSplitterHelper(
-            vec_splitters_time, vecgroups, vec_outputEventList,
-            this->weightedEvents, docorrection, toffactor, tofshift);
+            vec_splitters_time, vecgroups, outputs, this->weightedEvents,
+            docorrection, toffactor, tofshift);
       break;
     case WEIGHTED_NOTIME:
       debugmessage = "TOF type is weighted no time.  Impossible to split. ";
@@ -4635,6 +5029,7 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
                                  std::map<int, EventList *> outputs) const {
+  this->switchToRowStorage();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4680,6 +5075,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
 void EventList::splitByPulseTimeWithMatrix(
     const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
     std::map<int, EventList *> outputs) const {
+  this->switchToRowStorage();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4859,6 +5255,7 @@ void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
  */
 void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
                                    Mantid::Kernel::Unit *toUnit) {
+  this->switchToRowStorage();
   // Check for initialized
   if (!fromUnit || !toUnit)
     throw std::runtime_error(
@@ -4907,6 +5304,7 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  this->switchToRowStorage();
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
@@ -0,0 +1,322 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/EventPager.h"
+#include "MantidDataObjects/EventList.h"
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// A page held by a thread
+struct Hold {
+  std::weak_ptr<std::vector<std::atomic<std::size_t>>> holders;
+  std::size_t page;
+};
+
+/// The pages held by a thread, one per pager, released when the thread ends
+struct ThreadHolds {
+  ~ThreadHolds() {
+    for (const auto &hold : holds) {
+      if (auto holders = hold.holders.lock())
+        --(*holders)[hold.page];
+    }
+  }
+  std::vector<Hold> holds;
+};
+
+thread_local ThreadHolds threadHolds;
+} // namespace
+
+/** Constructor. No page is loaded.
+ * @param loader :: source of the events of each page
+ * @param numberOfSpectra :: number of spectra in the workspace
+ * @param maxResidentEvents :: number of events held above which pages are
+ * dropped
+ * @throw std::invalid_argument if a spectrum is in more than one page, or is
+ * not in the workspace
+ */
+EventPager::EventPager(std::shared_ptr<EventPageLoader> loader,
+                       std::size_t numberOfSpectra,
+                       std::size_t maxResidentEvents)
+    : m_loader(std::move(loader)), m_pageOfSpectrum(numberOfSpectra, NO_PAGE),
+      m_spectraOfPage(m_loader->numberOfPages()),
+      m_pages(m_loader->numberOfPages()), m_residentEvents(0),
+      m_maxResidentEvents(maxResidentEvents),
+      m_holders(std::make_shared<std::vector<std::atomic<std::size_t>>>(
+          m_pages.size())),
+      m_tick(0) {
+  for (std::size_t page = 0; page < m_pages.size(); ++page) {
+    m_spectraOfPage[page] = m_loader->workspaceIndices(page);
+    for (const auto index : m_spectraOfPage[page]) {
+      if (index >= numberOfSpectra)
+        throw std::invalid_argument(
+            "EventPager: page holds a spectrum outside the workspace");
+      if (m_pageOfSpectrum[index] != NO_PAGE)
+        throw std::invalid_argument(
+            "EventPager: spectrum " + std::to_string(index) +
+            " is in more than one page");
+      m_pageOfSpectrum[index] = page;
+    }
+  }
+}
+
+/** Copy constructor, for a copy of the workspace holding the same pages. No
+ * page of the copy is held. The caller must keep the pages of other from
+ * changing while the spectra are copied too, see freeze().
+ */
+EventPager::EventPager(const EventPager &other)
+    : m_loader(other.m_loader), m_pageOfSpectrum(other.m_pageOfSpectrum),
+      m_spectraOfPage(other.m_spectraOfPage), m_pages(other.m_pages.size()),
+      m_residentEvents(other.m_residentEvents),
+      m_maxResidentEvents(other.m_maxResidentEvents),
+      m_holders(std::make_shared<std::vector<std::atomic<std::size_t>>>(
+          m_pages.size())),
+      m_tick(other.m_tick.load()) {
+  for (std::size_t page = 0; page < m_pages.size(); ++page) {
+    m_pages[page].resident = other.m_pages[page].resident;
+    m_pages[page].pinned = other.m_pages[page].pinned;
+    m_pages[page].events = other.m_pages[page].events;
+    m_pages[page].lastUse = other.m_pages[page].lastUse.load();
+  }
+}
+
+/** Make sure that the events of a spectrum are in memory, and hold its page
+ * for the calling thread until it accesses a spectrum of another page
+ * @param index :: workspace index of the spectrum, which must be valid
+ * @param spectra :: the spectra of the workspace
+ * @param pin :: keep the page in memory from now on, as it may be modified
+ */
+void EventPager::require(std::size_t index, const Spectra &spectra, bool pin) {
+  const auto page = m_pageOfSpectrum[index];
+  if (page == NO_PAGE)
+    return;
+  auto &state = m_pages[page];
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (state.resident && (state.pinned || !pin)) {
+      hold(page);
+      state.lastUse.store(++m_tick, std::memory_order_relaxed);
+      return;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  if (!state.resident)
+    load(page, spectra);
+  state.pinned = state.pinned || pin;
+  hold(page);
+  state.lastUse.store(++m_tick, std::memory_order_relaxed);
+}
+
+/** Load and pin every page, e.g. before modifying all of the spectra. The
+ * memory limit no longer applies.
+ * @param spectra :: the spectra of the workspace
+ */
+void EventPager::pinAll(const Spectra &spectra) {
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  for (std::size_t page = 0; page < m_pages.size(); ++page) {
+    if (!m_pages[page].resident)
+      load(page, spectra);
+    m_pages[page].pinned = true;
+  }
+}
+
+/** Keep every page as it is, resident or not, while the returned lock is
+ * held, e.g. while looking at the spectra without requiring them. The
+ * calling thread must not require spectra meanwhile.
+ * @return a lock on the pages
+ */
+std::shared_lock<std::shared_mutex> EventPager::freeze() const {
+  return std::shared_lock<std::shared_mutex>(m_mutex);
+}
+
+/// @return true if the events of a spectrum are in memory
+bool EventPager::isResident(std::size_t index) const {
+  const auto page = m_pageOfSpectrum.at(index);
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  return page == NO_PAGE || m_pages[page].resident;
+}
+
+/// @return true if the events of a spectrum are never dropped
+bool EventPager::isPinned(std::size_t index) const {
+  const auto page = m_pageOfSpectrum.at(index);
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  return page == NO_PAGE || m_pages[page].pinned;
+}
+
+/// @return the number of events in the pages that are not in memory
+std::size_t EventPager::numberOfAbsentEvents() const {
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  std::size_t events = 0;
+  for (std::size_t page = 0; page < m_pages.size(); ++page) {
+    if (!m_pages[page].resident)
+      events += m_loader->numberOfEvents(page);
+  }
+  return events;
+}
+
+/** @param spectra :: the spectra of the workspace
+ * @return the number of events of the spectra, in memory or not
+ */
+std::size_t EventPager::numberOfEvents(const Spectra &spectra) const {
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  std::size_t events = 0;
+  for (std::size_t page = 0; page < m_pages.size(); ++page) {
+    if (!m_pages[page].resident)
+      events += m_loader->numberOfEvents(page);
+  }
+  return std::accumulate(spectra.cbegin(), spectra.cend(), events,
+                         [](std::size_t total, const auto &list) {
+                           return total + list->getNumberEvents();
+                         });
+}
+
+/** The most specialized event type of the spectra. The spectra of pages
+ * that are not in memory are not loaded, as they hold TofEvents.
+ * @param spectra :: the spectra of the workspace
+ * @return the event type of the spectra
+ */
+API::EventType EventPager::eventType(const Spectra &spectra) const {
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  API::EventType type = API::TOF;
+  for (std::size_t index = 0; index < spectra.size(); ++index) {
+    const auto page = m_pageOfSpectrum[index];
+    if (page == NO_PAGE || m_pages[page].resident)
+      type = std::max(type, spectra[index]->getEventType());
+  }
+  return type;
+}
+
+/** The sort order shared by the spectra, or UNSORTED if they differ. The
+ * spectra of pages that are not in memory are not loaded, as they have the
+ * sort order of the loader.
+ * @param spectra :: the spectra of the workspace
+ * @return the sort order of the spectra
+ */
+EventSortType EventPager::sortType(const Spectra &spectra) const {
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  bool first = true;
+  EventSortType order = UNSORTED;
+  auto merge = [&first, &order](const EventSortType other) {
+    if (first)
+      order = other;
+    else if (order != other)
+      order = UNSORTED;
+    first = false;
+  };
+  if (std::any_of(m_pages.cbegin(), m_pages.cend(),
+                  [](const Page &page) { return !page.resident; }))
+    merge(m_loader->sortOrder());
+  for (std::size_t index = 0;
+       index < spectra.size() && (first || order != UNSORTED); ++index) {
+    const auto page = m_pageOfSpectrum[index];
+    if (page == NO_PAGE || m_pages[page].resident)
+      merge(spectra[index]->getSortType());
+  }
+  return order;
+}
+
+/// @return the number of events held by the pages in memory
+std::size_t EventPager::numberOfResidentEvents() const {
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  return m_residentEvents;
+}
+
+/** Hold a page for the calling thread, releasing the page it held before.
+ * Must hold a lock, so that the page cannot be dropped meanwhile.
+ * @param page :: the page
+ */
+void EventPager::hold(std::size_t page) {
+  auto &holds = threadHolds.holds;
+  auto found =
+      std::find_if(holds.begin(), holds.end(), [this](const Hold &hold) {
+        return !hold.holders.owner_before(m_holders) &&
+               !m_holders.owner_before(hold.holders);
+      });
+  if (found != holds.end()) {
+    if (found->page == page)
+      return;
+    ++(*m_holders)[page];
+    --(*m_holders)[found->page];
+    found->page = page;
+    return;
+  }
+  // Forget the pagers that are gone
+  holds.erase(std::remove_if(holds.begin(), holds.end(),
+                             [](const Hold &hold) {
+                               return hold.holders.expired();
+                             }),
+              holds.end());
+  ++(*m_holders)[page];
+  holds.push_back({m_holders, page});
+}
+
+/** Load a page, dropping others first if needed. Must hold the unique lock.
+ * @param page :: the page to load
+ * @param spectra :: the spectra of the workspace
+ */
+void EventPager::load(std::size_t page, const Spectra &spectra) {
+  makeRoom(page, spectra);
+
+  std::vector<EventList *> lists(spectra.size());
+  std::transform(spectra.cbegin(), spectra.cend(), lists.begin(),
+                 [](const std::unique_ptr<EventList> &list) {
+                   return list.get();
+                 });
+  try {
+    m_loader->loadPage(page, lists);
+  } catch (...) {
+    for (const auto index : m_spectraOfPage[page])
+      spectra[index]->clear(false);
+    throw;
+  }
+
+  std::size_t events = 0;
+  for (const auto index : m_spectraOfPage[page])
+    events += spectra[index]->getNumberEvents();
+  auto &state = m_pages[page];
+  state.resident = true;
+  state.events = events;
+  m_residentEvents += events;
+}
+
+/** Drop the least recently used pages that are neither pinned nor held,
+ * until the events of a page fit within the limit. Must hold the unique lock.
+ * @param page :: the page about to be loaded
+ * @param spectra :: the spectra of the workspace
+ */
+void EventPager::makeRoom(std::size_t page, const Spectra &spectra) {
+  const auto incoming = m_loader->numberOfEvents(page);
+  if (m_residentEvents + incoming <= m_maxResidentEvents)
+    return;
+
+  std::vector<std::pair<uint64_t, std::size_t>> candidates;
+  for (std::size_t i = 0; i < m_pages.size(); ++i) {
+    if (m_pages[i].resident && !m_pages[i].pinned && (*m_holders)[i] == 0)
+      candidates.emplace_back(
+          m_pages[i].lastUse.load(std::memory_order_relaxed), i);
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  for (const auto &candidate : candidates) {
+    if (m_residentEvents + incoming <= m_maxResidentEvents)
+      break;
+    auto &state = m_pages[candidate.second];
+    for (const auto index : m_spectraOfPage[candidate.second])
+      spectra[index]->clear(false);
+    m_residentEvents -= state.events;
+    state.events = 0;
+    state.resident = false;
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
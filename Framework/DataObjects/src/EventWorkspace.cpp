@@ -13,6 +13,7 @@
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataObjects/EventPager.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
@@ -27,6 +28,7 @@
 #include "tbb/parallel_for.h"
 #include <limits>
 #include <numeric>
+#include <shared_mutex>
 
 using namespace boost::posix_time;
 using Mantid::Types::Core::DateAndTime;
@@ -50,6 +52,13 @@ EventWorkspace::EventWorkspace(const Parallel::StorageMode storageMode)
 
 EventWorkspace::EventWorkspace(const EventWorkspace &other)
     : IEventWorkspace(other), mru(std::make_unique<EventWorkspaceMRU>()) {
+  // Keep the pages of other as they are while their state and events are
+  // copied
+  std::shared_lock<std::shared_mutex> frozen;
+  if (other.m_pager) {
+    frozen = other.m_pager->freeze();
+    m_pager = std::make_unique<EventPager>(*other.m_pager);
+  }
   for (const auto &el : other.data) {
     // Create a new event list, copying over the events
     auto newel = std::make_unique<EventList>(*el);
@@ -172,6 +181,9 @@ size_t EventWorkspace::getNumberHistograms() const { return this->data.size(); }
 EventList &EventWorkspace::getSpectrumWithoutInvalidation(const size_t index) {
   auto &spec = const_cast<EventList &>(
       static_cast<const EventWorkspace &>(*this).getSpectrum(index));
+  // The events may be modified, so they must not be dropped any more
+  if (m_pager)
+    m_pager->require(index, data, true);
   spec.setMatrixWorkspace(this, index);
   return spec;
 }
@@ -181,6 +193,8 @@ const EventList &EventWorkspace::getSpectrum(const size_t index) const {
   if (index >= data.size())
     throw std::range_error(
         "EventWorkspace::getSpectrum, workspace index out of range");
+  if (m_pager)
+    m_pager->require(index, data, false);
   return *data[index];
 }
 
@@ -191,6 +205,7 @@ const EventList &EventWorkspace::getSpectrum(const size_t index) const {
  * should only be used in tight loops where getSpectrum is too costly.
  *
  * See the implementation of the non-const getSpectrum to see what is missing.
+ * In particular, the events of a lazy workspace are not loaded.
  *
  * @param index Workspace index
  * @return Pointer to EventList
@@ -417,6 +432,9 @@ void EventWorkspace::getEventXMinMax(double &xmin, double &xmax) const {
 /// The total number of events across all of the spectra.
 /// @returns The total number of events
 size_t EventWorkspace::getNumberEvents() const {
+  // The events of a lazy workspace that are not loaded are counted too
+  if (m_pager)
+    return m_pager->numberOfEvents(data);
   return std::accumulate(
       data.begin(), data.end(), size_t{0},
       [](size_t total, auto &list) { return total + list->getNumberEvents(); });
@@ -427,9 +445,12 @@ size_t EventWorkspace::getNumberEvents() const {
  * @return the EventType of the most-specialized EventList in the workspace
  */
 Mantid::API::EventType EventWorkspace::getEventType() const {
+  // The spectra of a lazy workspace that are not loaded are left so
+  if (m_pager)
+    return m_pager->eventType(data);
   Mantid::API::EventType out = Mantid::API::TOF;
-  for (auto &list : this->data) {
-    Mantid::API::EventType thisType = list->getEventType();
+  for (size_t i = 0; i < this->data.size(); ++i) {
+    Mantid::API::EventType thisType = getSpectrum(i).getEventType();
     if (static_cast<int>(out) < static_cast<int>(thisType)) {
       out = thisType;
       // This is the most-specialized it can get.
@@ -445,10 +466,41 @@ Mantid::API::EventType EventWorkspace::getEventType() const {
  * @param type :: EventType to switch to
  */
 void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
+  if (m_pager)
+    m_pager->pinAll(data);
   for (auto &eventList : this->data)
     eventList->switchTo(type);
 }
 
+/** Set how the events of all event lists are laid out in memory.
+ * @see EventList::setStorageType
+ *
+ * @param storage :: EventStorageType to switch to
+ */
+void EventWorkspace::setStorageType(const EventStorageType storage) {
+  if (m_pager)
+    m_pager->pinAll(data);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < static_cast<int>(this->data.size()); ++i)
+    this->data[i]->setStorageType(storage);
+}
+
+/** Load the events lazily. The events of a page of spectra are read from the
+ * loader when one of its spectra is first accessed, and dropped again when
+ * the number of events in memory exceeds the limit. Spectra accessed through
+ * the non-const getSpectrum() are kept in memory from then on.
+ * @see EventPager
+ *
+ * @param loader :: source of the events. Its spectra must be empty.
+ * @param maxResidentEvents :: number of events held above which pages that
+ * have not been modified are dropped
+ */
+void EventWorkspace::setPageLoader(std::shared_ptr<EventPageLoader> loader,
+                                   const std::size_t maxResidentEvents) {
+  m_pager = std::make_unique<EventPager>(std::move(loader), data.size(),
+                                         maxResidentEvents);
+}
+
 /// Returns true always - an EventWorkspace always represents histogramm-able
 /// data
 /// @returns If the data is a histogram - always true for an eventWorkspace
@@ -467,10 +519,16 @@ void EventWorkspace::clearMRU() const { mru->clear(); }
 size_t EventWorkspace::getMemorySize() const {
   // TODO: Add the MRU buffer
 
-  // Add the memory from all the event lists
+  // Add the memory from all the event lists. Only the events of a lazy
+  // workspace that are loaded use memory.
+  std::shared_lock<std::shared_mutex> frozen;
+  if (m_pager)
+    frozen = m_pager->freeze();
   size_t total = std::accumulate(
       data.begin(), data.end(), size_t{0},
       [](size_t total, auto &list) { return total + list->getMemorySize(); });
+  if (frozen)
+    frozen.unlock();
 
   total += run().getMemorySize();
 
@@ -547,7 +605,11 @@ const MantidVec &EventWorkspace::dataE(const std::size_t index) const {
  * @param index :: workspace index   */
 Kernel::cow_ptr<HistogramData::HistogramX>
 EventWorkspace::refX(const std::size_t index) const {
-  return getSpectrum(index).ptrX();
+  if (index >= data.size())
+    throw std::range_error(
+        "EventWorkspace::refX, workspace index out of range");
+  // The X data of a lazy workspace is never dropped: no events are loaded
+  return data[index]->ptrX();
 }
 
 /** Using the event data in the event list, generate a histogram of it w.r.t
@@ -566,7 +628,7 @@ void EventWorkspace::generateHistogram(const std::size_t index,
   if (index >= data.size())
     throw std::range_error(
         "EventWorkspace::generateHistogram, histogram number out of range");
-  this->data[index]->generateHistogram(X, Y, E, skipError);
+  this->getSpectrum(index).generateHistogram(X, Y, E, skipError);
 }
 
 /** Using the event data in the event list, generate a histogram of it w.r.t
@@ -586,7 +648,7 @@ void EventWorkspace::generateHistogramPulseTime(const std::size_t index,
   if (index >= data.size())
     throw std::range_error("EventWorkspace::generateHistogramPulseTime, "
                            "histogram number out of range");
-  this->data[index]->generateHistogramPulseTime(X, Y, E, skipError);
+  this->getSpectrum(index).generateHistogramPulseTime(X, Y, E, skipError);
 }
 
 /** Set all histogram X vectors.
@@ -655,10 +717,13 @@ private:
  * If any 2 have different order type, then be unsorted
  */
 EventSortType EventWorkspace::getSortType() const {
+  // The spectra of a lazy workspace that are not loaded are left so
+  if (m_pager)
+    return m_pager->sortType(data);
   size_t size = this->data.size();
-  EventSortType order = data[0]->getSortType();
+  EventSortType order = getSpectrum(0).getSortType();
   for (size_t i = 1; i < size; i++) {
-    if (order != data[i]->getSortType())
+    if (order != getSpectrum(i).getSortType())
       return UNSORTED;
   }
   return order;
@@ -706,10 +771,10 @@ void EventWorkspace::getIntegratedSpectra(std::vector<double> &out,
   for (int wksp_index = 0; wksp_index < int(this->getNumberHistograms());
        wksp_index++) {
     // Get Handle to data
-    EventList *el = this->data[wksp_index].get();
+    const EventList &el = this->getSpectrum(wksp_index);
 
     // Let the eventList do the integration
-    out[wksp_index] = el->integrate(minX, maxX, entireRange);
+    out[wksp_index] = el.integrate(minX, maxX, entireRange);
   }
 }
 
@@ -19,6 +19,7 @@
 
 #include <boost/optional.hpp>
 #include <boost/scoped_array.hpp>
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <memory>
@@ -29,6 +30,26 @@ using namespace Mantid::API;
 
 namespace Mantid {
 namespace DataObjects {
+
+namespace {
+/// Number of bins in the blocks that are skipped when they would not change.
+/// The values of a block of doubles fill a page of memory.
+constexpr size_t BLOCK_SIZE = 512;
+
+/// @return true if all the values are 0
+bool allZero(const signal_t *values, const size_t size) {
+  return std::all_of(values, values + size,
+                     [](const signal_t value) { return value == 0.; });
+}
+
+/// @return true if all the values are finite
+bool allFinite(const signal_t *values, const size_t size) {
+  return std::all_of(values, values + size, [](const signal_t value) {
+    return std::isfinite(value);
+  });
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor given the 4 dimensions
  * @param dimX :: X dimension binning parameters
@@ -64,14 +85,17 @@ MDHistoWorkspace::MDHistoWorkspace(
  * @param dimensions :: vector of MDHistoDimension; no limit to how many.
  * @param displayNormalization :: optional display normalization to use as the
  * default.
+ * @param initialisation :: the values of the bins. Bins set to zero take no
+ * memory until they are written.
  */
 MDHistoWorkspace::MDHistoWorkspace(
     std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
-    Mantid::API::MDNormalization displayNormalization)
+    Mantid::API::MDNormalization displayNormalization,
+    Initialisation initialisation)
     : IMDHistoWorkspace(), numDimensions(0),
       m_nEventsContributed(std::numeric_limits<uint64_t>::quiet_NaN()),
       m_coordSystem(None), m_displayNormalization(displayNormalization) {
-  this->init(dimensions);
+  this->init(dimensions, initialisation);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -79,18 +103,22 @@ MDHistoWorkspace::MDHistoWorkspace(
  * @param dimensions :: vector of MDHistoDimension; no limit to how many.
  * @param displayNormalization :: optional display normalization to use as the
  * default.
+ * @param initialisation :: the values of the bins. Bins set to zero take no
+ * memory until they are written.
  */
 MDHistoWorkspace::MDHistoWorkspace(
     std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
-    Mantid::API::MDNormalization displayNormalization)
+    Mantid::API::MDNormalization displayNormalization,
+    Initialisation initialisation)
     : IMDHistoWorkspace(), numDimensions(0),
       m_nEventsContributed(std::numeric_limits<uint64_t>::quiet_NaN()),
       m_coordSystem(None), m_displayNormalization(displayNormalization) {
-  this->init(dimensions);
+  this->init(dimensions, initialisation);
 }
 
 //----------------------------------------------------------------------------------------------
-/** Copy constructor
+/** Copy constructor. Blocks of empty bins are not copied, so they take no
+ * memory in the copy.
  *
  * @param other :: MDHistoWorkspace to copy from.
  */
@@ -102,53 +130,77 @@ MDHistoWorkspace::MDHistoWorkspace(const MDHistoWorkspace &other)
   // Dimensions are copied by the copy constructor of MDGeometry
   this->cacheValues();
   // Allocate the linear arrays
-  m_signals = std::vector<signal_t>(m_length);
-  m_errorsSquared = std::vector<signal_t>(m_length);
-  m_numEvents = std::vector<signal_t>(m_length);
-  m_masks = std::make_unique<bool[]>(m_length);
+  this->allocateArrays();
   // Now copy all the data
-  std::copy_n(other.m_signals.begin(), m_length, m_signals.begin());
-  std::copy_n(other.m_errorsSquared.begin(), m_length, m_errorsSquared.begin());
-  std::copy_n(other.m_numEvents.begin(), m_length, m_numEvents.begin());
-  std::copy_n(other.m_masks.get(), m_length, m_masks.get());
+  for (size_t begin = 0; begin < m_length; begin += BLOCK_SIZE) {
+    const size_t size = std::min(BLOCK_SIZE, m_length - begin);
+    if (allZero(other.m_signals.data() + begin, size) &&
+        allZero(other.m_errorsSquared.data() + begin, size) &&
+        allZero(other.m_numEvents.data() + begin, size) &&
+        std::find(other.m_masks.get() + begin,
+                  other.m_masks.get() + begin + size,
+                  true) == other.m_masks.get() + begin + size)
+      continue;
+    std::copy_n(other.m_signals.begin() + begin, size,
+                m_signals.begin() + begin);
+    std::copy_n(other.m_errorsSquared.begin() + begin, size,
+                m_errorsSquared.begin() + begin);
+    std::copy_n(other.m_numEvents.begin() + begin, size,
+                m_numEvents.begin() + begin);
+    std::copy_n(other.m_masks.get() + begin, size, m_masks.get() + begin);
+  }
 }
 
 //----------------------------------------------------------------------------------------------
 /** Constructor helper method
  * @param dimensions :: vector of MDHistoDimension; no limit to how many.
+ * @param initialisation :: the values of the bins
  */
 void MDHistoWorkspace::init(
-    std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions) {
+    std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
+    Initialisation initialisation) {
   std::vector<IMDDimension_sptr> dim2;
   dim2.reserve(dimensions.size());
   std::transform(dimensions.cbegin(), dimensions.cend(),
                  std::back_inserter(dim2), [](const auto dimension) {
                    return std::dynamic_pointer_cast<IMDDimension>(dimension);
                  });
-  this->init(dim2);
+  this->init(dim2, initialisation);
   m_nEventsContributed = 0;
 }
 
 //----------------------------------------------------------------------------------------------
 /** Constructor helper method
  * @param dimensions :: vector of IMDDimension; no limit to how many.
+ * @param initialisation :: the values of the bins
  */
 void MDHistoWorkspace::init(
-    std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions) {
+    std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
+    Initialisation initialisation) {
   MDGeometry::initGeometry(dimensions);
   this->cacheValues();
 
-  // Allocate the linear arrays
-  m_signals = std::vector<signal_t>(m_length);
-  m_errorsSquared = std::vector<signal_t>(m_length);
-  m_numEvents = std::vector<signal_t>(m_length);
-  m_masks = std::make_unique<bool[]>(m_length);
-  // Initialize them to NAN (quickly)
-  signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
-  this->setTo(nan, nan, nan);
+  // Allocate the linear arrays, set to zero
+  this->allocateArrays();
+  if (initialisation == Initialisation::NaN) {
+    // Initialize them to NAN (quickly)
+    signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+    this->setTo(nan, nan, nan);
+  }
   m_nEventsContributed = 0;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Allocate the linear arrays, with all the bins set to zero and not masked.
+ * The memory of the bins is only taken when they are written.
+ */
+void MDHistoWorkspace::allocateArrays() {
+  m_signals = BinArray(m_length);
+  m_errorsSquared = BinArray(m_length);
+  m_numEvents = BinArray(m_length);
+  m_masks = Kernel::makeZeroedArray<bool>(m_length);
+}
+
 //----------------------------------------------------------------------------------------------
 /** When all dimensions have been initialized, this caches all the necessary
  * values for later use.
@@ -239,7 +291,8 @@ void MDHistoWorkspace::initVertexesArray() {
 }
 
 //----------------------------------------------------------------------------------------------
-/** Sets all signals/errors in the workspace to the given values
+/** Sets all signals/errors in the workspace to the given values. When setting
+ * everything to zero, blocks that are already zero are not written.
  *
  * @param signal :: signal value to set
  * @param errorSquared :: error (squared) value to set
@@ -247,6 +300,20 @@ void MDHistoWorkspace::initVertexesArray() {
  */
 void MDHistoWorkspace::setTo(signal_t signal, signal_t errorSquared,
                              signal_t numEvents) {
+  if (signal == 0. && errorSquared == 0. && numEvents == 0.) {
+    for (size_t begin = 0; begin < m_length; begin += BLOCK_SIZE) {
+      const size_t size = std::min(BLOCK_SIZE, m_length - begin);
+      for (auto *values : {m_signals.data(), m_errorsSquared.data(),
+                           m_numEvents.data()})
+        if (!allZero(values + begin, size))
+          std::fill_n(values + begin, size, 0.);
+      auto *masks = m_masks.get() + begin;
+      if (std::find(masks, masks + size, true) != masks + size)
+        std::fill_n(masks, size, false);
+    }
+    m_nEventsContributed = 0;
+    return;
+  }
   std::fill_n(m_signals.begin(), m_length, signal);
   std::fill_n(m_errorsSquared.begin(), m_length, errorSquared);
   std::fill_n(m_numEvents.begin(), m_length, numEvents);
@@ -765,10 +832,18 @@ MDHistoWorkspace &MDHistoWorkspace::operator+=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "add");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] += b.m_signals[i];
-    m_errorsSquared[i] += b.m_errorsSquared[i];
-    m_numEvents[i] += b.m_numEvents[i];
+  for (size_t begin = 0; begin < m_length; begin += BLOCK_SIZE) {
+    const size_t end = std::min(begin + BLOCK_SIZE, m_length);
+    // Adding empty bins changes nothing
+    if (allZero(b.m_signals.data() + begin, end - begin) &&
+        allZero(b.m_errorsSquared.data() + begin, end - begin) &&
+        allZero(b.m_numEvents.data() + begin, end - begin))
+      continue;
+    for (size_t i = begin; i < end; ++i) {
+      m_signals[i] += b.m_signals[i];
+      m_errorsSquared[i] += b.m_errorsSquared[i];
+      m_numEvents[i] += b.m_numEvents[i];
+    }
   }
   m_nEventsContributed += b.m_nEventsContributed;
 }
@@ -804,10 +879,18 @@ MDHistoWorkspace &MDHistoWorkspace::operator-=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "subtract");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] -= b.m_signals[i];
-    m_errorsSquared[i] += b.m_errorsSquared[i];
-    m_numEvents[i] += b.m_numEvents[i];
+  for (size_t begin = 0; begin < m_length; begin += BLOCK_SIZE) {
+    const size_t end = std::min(begin + BLOCK_SIZE, m_length);
+    // Subtracting empty bins changes nothing
+    if (allZero(b.m_signals.data() + begin, end - begin) &&
+        allZero(b.m_errorsSquared.data() + begin, end - begin) &&
+        allZero(b.m_numEvents.data() + begin, end - begin))
+      continue;
+    for (size_t i = begin; i < end; ++i) {
+      m_signals[i] -= b.m_signals[i];
+      m_errorsSquared[i] += b.m_errorsSquared[i];
+      m_numEvents[i] += b.m_numEvents[i];
+    }
   }
   m_nEventsContributed += b.m_nEventsContributed;
 }
@@ -852,18 +935,27 @@ MDHistoWorkspace &MDHistoWorkspace::operator*=(const MDHistoWorkspace &b_ws) {
  * */
 void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
   checkWorkspaceSize(b_ws, "multiply");
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-
-    signal_t b = b_ws.m_signals[i];
-    signal_t db2 = b_ws.m_errorsSquared[i];
-
-    signal_t f = a * b;
-    signal_t df2 = da2 * b * b + db2 * a * a;
-
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
+  for (size_t begin = 0; begin < m_length; begin += BLOCK_SIZE) {
+    const size_t end = std::min(begin + BLOCK_SIZE, m_length);
+    // Empty bins stay empty when multiplied by finite values
+    if (allZero(m_signals.data() + begin, end - begin) &&
+        allZero(m_errorsSquared.data() + begin, end - begin) &&
+        allFinite(b_ws.m_signals.data() + begin, end - begin) &&
+        allFinite(b_ws.m_errorsSquared.data() + begin, end - begin))
+      continue;
+    for (size_t i = begin; i < end; ++i) {
+      signal_t a = m_signals[i];
+      signal_t da2 = m_errorsSquared[i];
+
+      signal_t b = b_ws.m_signals[i];
+      signal_t db2 = b_ws.m_errorsSquared[i];
+
+      signal_t f = a * b;
+      signal_t df2 = da2 * b * b + db2 * a * a;
+
+      m_signals[i] = f;
+      m_errorsSquared[i] = df2;
+    }
   }
 }
 
@@ -921,18 +1013,31 @@ MDHistoWorkspace &MDHistoWorkspace::operator/=(const MDHistoWorkspace &b_ws) {
  **/
 void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
   checkWorkspaceSize(b_ws, "divide");
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-
-    signal_t b = b_ws.m_signals[i];
-    signal_t db2 = b_ws.m_errorsSquared[i];
-
-    signal_t f = a / b;
-    signal_t df2 = da2 / (b * b) + db2 * f * f / (b * b);
-
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
+  for (size_t begin = 0; begin < m_length; begin += BLOCK_SIZE) {
+    const size_t end = std::min(begin + BLOCK_SIZE, m_length);
+    // Empty bins stay empty when divided by finite, non-zero values
+    if (allZero(m_signals.data() + begin, end - begin) &&
+        allZero(m_errorsSquared.data() + begin, end - begin) &&
+        std::none_of(b_ws.m_signals.data() + begin,
+                     b_ws.m_signals.data() + end,
+                     [](const signal_t b) {
+                       return b == 0. || !std::isfinite(b);
+                     }) &&
+        allFinite(b_ws.m_errorsSquared.data() + begin, end - begin))
+      continue;
+    for (size_t i = begin; i < end; ++i) {
+      signal_t a = m_signals[i];
+      signal_t da2 = m_errorsSquared[i];
+
+      signal_t b = b_ws.m_signals[i];
+      signal_t db2 = b_ws.m_errorsSquared[i];
+
+      signal_t f = a / b;
+      signal_t df2 = da2 / (b * b) + db2 * f * f / (b * b);
+
+      m_signals[i] = f;
+      m_errorsSquared[i] = df2;
+    }
   }
 }
 
@@ -1312,7 +1417,9 @@ void MDHistoWorkspace::setMDMaskAt(const size_t &index, bool mask) {
  */
 void MDHistoWorkspace::clearMDMasking() {
   for (size_t i = 0; i < this->getNPoints(); ++i) {
-    m_masks[i] = false;
+    // Only write the masked bins, leaving untouched memory untouched
+    if (m_masks[i])
+      m_masks[i] = false;
   }
 }
 
@@ -233,6 +233,44 @@ public:
 
   void test_WriteFloatReadDouble() { this->WriteReadRead<float, double>(); }
 
+  void test_WriteCompressedRead() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    TS_ASSERT(!pSaver->getCompression());
+    pSaver->setCompression(true);
+    TS_ASSERT(pSaver->getCompression());
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string FullPathFile = pSaver->getFileName();
+
+    // Blocks written in any order and across chunks are read back
+    const size_t nColumns = pSaver->getNDataColums();
+    const size_t nEvents = 15000;
+    std::vector<float> toWrite(nColumns * nEvents);
+    for (size_t i = 0; i < toWrite.size(); i++)
+      toWrite[i] = static_cast<float>(i % 97);
+    const std::vector<float> second(toWrite.begin() + 9000 * nColumns,
+                                    toWrite.end());
+    const std::vector<float> first(toWrite.begin(),
+                                   toWrite.begin() + 9000 * nColumns);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(second, 9000));
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(first, 0));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    pSaver->setCompression(false);
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    std::vector<float> toRead;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 8000, 3000));
+    TS_ASSERT_EQUALS(toRead.size(), 3000 * nColumns);
+    for (size_t i = 0; i < toRead.size(); i++)
+      TS_ASSERT_EQUALS(toRead[i], toWrite[8000 * nColumns + i]);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    pSaver.reset();
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
 private:
   /// Create a test box controller. Ownership is passed to the caller
   Mantid::DataObjects::BoxControllerNeXusIO *createTestBoxController() {
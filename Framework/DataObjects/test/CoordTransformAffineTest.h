@@ -164,6 +164,39 @@ public:
     compare(3, out, expected);
   }
 
+  /** Apply to a block of points, with and without the kernels specialised
+   * for the number of dimensions, with the points spaced out like the
+   * centers of events */
+  void test_applyBatch_matches_apply() {
+    for (size_t inD = 1; inD <= 5; ++inD) {
+      for (size_t outD = 1; outD <= inD; ++outD) {
+        CoordTransformAffine ct(inD, outD);
+        Mantid::Kernel::Matrix<coord_t> matrix(outD + 1, inD + 1);
+        for (size_t row = 0; row < outD; ++row)
+          for (size_t col = 0; col <= inD; ++col)
+            matrix[row][col] = static_cast<coord_t>(row + 1) -
+                               static_cast<coord_t>(col) * 0.5f;
+        matrix[outD][inD] = 1;
+        ct.setMatrix(matrix);
+
+        const size_t numPoints = 7;
+        const size_t stride = inD + 2;
+        std::vector<coord_t> in(numPoints * stride);
+        for (size_t i = 0; i < in.size(); ++i)
+          in[i] = static_cast<coord_t>(i) * 0.25f - 3;
+        std::vector<coord_t> out(numPoints * outD);
+        ct.applyBatch(in.data(), stride, out.data(), numPoints);
+
+        std::vector<coord_t> expected(outD);
+        for (size_t i = 0; i < numPoints; ++i) {
+          ct.apply(in.data() + i * stride, expected.data());
+          for (size_t d = 0; d < outD; ++d)
+            TS_ASSERT_DELTA(out[i * outD + d], expected[d], 1e-5);
+        }
+      }
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test a case of a rotation 0.1 radians around +Z,
    * and a projection into the XY plane */
@@ -423,4 +456,19 @@ public:
       ct.apply(in, out);
     }
   }
+
+  void test_applyBatch_4D_events_performance() {
+    CoordTransformAffine ct(4, 3);
+    coord_t translation[3] = {2.0, 3.0, 4.0};
+    ct.addTranslation(translation);
+    coord_t center[4] = {1.5, 2.5, 3.5, 4.5};
+    std::vector<MDLeanEvent<4>> events(1000, MDLeanEvent<4>(1.0, 1.0, center));
+    std::vector<coord_t> out(events.size() * 3);
+
+    for (size_t i = 0; i < 1000 * 10; ++i) {
+      ct.applyBatch(events.front().getCenter(),
+                    sizeof(MDLeanEvent<4>) / sizeof(coord_t), out.data(),
+                    events.size());
+    }
+  }
 };
@@ -138,6 +138,40 @@ public:
     TS_ASSERT_DELTA(out, 16.0, 1e-5);
   }
 
+  void test_applyBatch_matches_apply() {
+    coord_t center[3] = {1, 2, 3};
+    bool used[3] = {true, false, true};
+    std::vector<Kernel::V3D> eigenvects{
+        Kernel::V3D(1.0, 0.0, 0.0), Kernel::V3D(0.0, M_SQRT1_2, M_SQRT1_2),
+        Kernel::V3D(0.0, -M_SQRT1_2, M_SQRT1_2)};
+    std::vector<double> eigenvals{4, 1, 2};
+    // sphere, ellipsoid and cylinder
+    std::vector<std::unique_ptr<CoordTransformDistance>> transforms;
+    transforms.emplace_back(
+        std::make_unique<CoordTransformDistance>(3, center, used));
+    transforms.emplace_back(std::make_unique<CoordTransformDistance>(
+        3, center, used, 1, eigenvects, eigenvals));
+    transforms.emplace_back(
+        std::make_unique<CoordTransformDistance>(3, center, used, 2));
+
+    // The points are 4 coordinates apart
+    const size_t numPoints = 5;
+    std::vector<coord_t> in(numPoints * 4);
+    for (size_t i = 0; i < in.size(); ++i)
+      in[i] = static_cast<coord_t>(i % 7) * 0.5f;
+    for (const auto &ct : transforms) {
+      const size_t outD = ct->getOutD();
+      std::vector<coord_t> out(numPoints * outD);
+      ct->applyBatch(in.data(), 4, out.data(), numPoints);
+      std::vector<coord_t> expected(outD);
+      for (size_t i = 0; i < numPoints; ++i) {
+        ct->apply(in.data() + i * 4, expected.data());
+        for (size_t d = 0; d < outD; ++d)
+          TS_ASSERT_DELTA(out[i * outD + d], expected[d], 1e-5);
+      }
+    }
+  }
+
   /** Test serialization */
   void test_to_xml_string() {
     std::string expectedResult =
@@ -0,0 +1,176 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/EventColumns.h"
+#include <cxxtest/TestSuite.h>
+
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using Mantid::Types::Event::TofEvent;
+
+class EventColumnsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventColumnsTest *createSuite() { return new EventColumnsTest(); }
+  static void destroySuite(EventColumnsTest *suite) { delete suite; }
+
+  void test_default_constructor_is_empty_tof() {
+    EventColumns columns;
+    TS_ASSERT_EQUALS(columns.getEventType(), TOF);
+    TS_ASSERT(columns.empty());
+    TS_ASSERT_EQUALS(columns.size(), 0);
+    TS_ASSERT(columns.hasPulseTimes());
+    TS_ASSERT(!columns.hasWeights());
+  }
+
+  void test_assign_and_copy_tof_events() {
+    std::vector<TofEvent> events{TofEvent(3.5, 100), TofEvent(1.5, 200),
+                                 TofEvent(2.5, 50)};
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT_EQUALS(columns.size(), 3);
+    TS_ASSERT_EQUALS(columns.tofs()[1], 1.5);
+    TS_ASSERT_EQUALS(columns.pulseTimes()[1], 200);
+    TS_ASSERT(columns.weights().empty());
+
+    std::vector<TofEvent> out;
+    columns.copyTo(out);
+    TS_ASSERT_EQUALS(out, events);
+  }
+
+  void test_assign_and_copy_weighted_events() {
+    std::vector<WeightedEvent> events{WeightedEvent(3.5, 100, 2.0, 4.0),
+                                      WeightedEvent(1.5, 200, 3.0, 9.0)};
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT_EQUALS(columns.getEventType(), WEIGHTED);
+    TS_ASSERT_EQUALS(columns.weights()[1], 3.0);
+    TS_ASSERT_EQUALS(columns.errorSquareds()[1], 9.0);
+
+    std::vector<WeightedEvent> out;
+    columns.copyTo(out);
+    TS_ASSERT_EQUALS(out, events);
+  }
+
+  void test_assign_and_copy_weighted_no_time_events() {
+    std::vector<WeightedEventNoTime> events{WeightedEventNoTime(3.5, 2.0, 4.0),
+                                            WeightedEventNoTime(1.5, 3.0, 9.0)};
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT_EQUALS(columns.getEventType(), WEIGHTED_NOTIME);
+    TS_ASSERT(!columns.hasPulseTimes());
+    TS_ASSERT(columns.pulseTimes().empty());
+
+    std::vector<WeightedEventNoTime> out;
+    columns.copyTo(out);
+    TS_ASSERT_EQUALS(out, events);
+  }
+
+  void test_switchTo_adds_unit_weights_and_drops_pulse_times() {
+    EventColumns columns;
+    columns.append(TofEvent(1.0, 10));
+    columns.append(TofEvent(2.0, 20));
+
+    columns.switchTo(WEIGHTED);
+    TS_ASSERT_EQUALS(columns.weights(), std::vector<float>(2, 1.0f));
+    TS_ASSERT_EQUALS(columns.errorSquareds(), std::vector<float>(2, 1.0f));
+    TS_ASSERT_EQUALS(columns.pulseTimes()[1], 20);
+
+    columns.switchTo(WEIGHTED_NOTIME);
+    TS_ASSERT(columns.pulseTimes().empty());
+    TS_ASSERT_EQUALS(columns.size(), 2);
+  }
+
+  void test_switchTo_cannot_lose_information() {
+    EventColumns weighted(WEIGHTED);
+    TS_ASSERT_THROWS(weighted.switchTo(TOF), const std::runtime_error &);
+    EventColumns noTime(WEIGHTED_NOTIME);
+    TS_ASSERT_THROWS(noTime.switchTo(WEIGHTED), const std::runtime_error &);
+    TS_ASSERT_THROWS(noTime.switchTo(TOF), const std::runtime_error &);
+  }
+
+  void test_sortByTof_permutes_every_column() {
+    EventColumns columns(WEIGHTED);
+    columns.append(WeightedEvent(3.0, 30, 3.0, 9.0));
+    columns.append(WeightedEvent(1.0, 10, 1.0, 1.0));
+    columns.append(WeightedEvent(2.0, 20, 2.0, 4.0));
+
+    columns.sortByTof();
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({1.0, 2.0, 3.0}));
+    TS_ASSERT_EQUALS(columns.pulseTimes(),
+                     std::vector<int64_t>({10, 20, 30}));
+    TS_ASSERT_EQUALS(columns.weights(), std::vector<float>({1.f, 2.f, 3.f}));
+    TS_ASSERT_EQUALS(columns.errorSquareds(),
+                     std::vector<float>({1.f, 4.f, 9.f}));
+  }
+
+  void test_sortByPulseTime() {
+    EventColumns columns;
+    columns.append(TofEvent(1.0, 30));
+    columns.append(TofEvent(2.0, 10));
+    columns.append(TofEvent(3.0, 20));
+
+    columns.sortByPulseTime();
+    TS_ASSERT_EQUALS(columns.pulseTimes(),
+                     std::vector<int64_t>({10, 20, 30}));
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({2.0, 3.0, 1.0}));
+  }
+
+  void test_sortByPulseTime_without_pulse_times_does_nothing() {
+    EventColumns columns(WEIGHTED_NOTIME);
+    columns.append(WeightedEventNoTime(2.0, 1.0, 1.0));
+    columns.append(WeightedEventNoTime(1.0, 1.0, 1.0));
+    columns.sortByPulseTime();
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({2.0, 1.0}));
+  }
+
+  void test_reverse_erase_move_resize() {
+    EventColumns columns;
+    for (int i = 0; i < 5; ++i)
+      columns.append(TofEvent(static_cast<double>(i), i * 10));
+
+    columns.reverse();
+    TS_ASSERT_EQUALS(columns.tofs(),
+                     std::vector<double>({4.0, 3.0, 2.0, 1.0, 0.0}));
+    TS_ASSERT_EQUALS(columns.pulseTimes()[0], 40);
+
+    columns.erase(1, 3);
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({4.0, 1.0, 0.0}));
+    TS_ASSERT_EQUALS(columns.pulseTimes(), std::vector<int64_t>({40, 10, 0}));
+
+    columns.move(2, 0);
+    TS_ASSERT_EQUALS(columns.tofs()[0], 0.0);
+    TS_ASSERT_EQUALS(columns.pulseTimes()[0], 0);
+
+    columns.resize(2);
+    TS_ASSERT_EQUALS(columns.size(), 2);
+    TS_ASSERT_EQUALS(columns.pulseTimes().size(), 2);
+  }
+
+  void test_equality() {
+    EventColumns lhs, rhs;
+    lhs.append(TofEvent(1.0, 10));
+    rhs.append(TofEvent(1.0, 10));
+    TS_ASSERT(lhs == rhs);
+    rhs.append(TofEvent(2.0, 10));
+    TS_ASSERT(lhs != rhs);
+    lhs.append(TofEvent(2.0, 10));
+    lhs.switchTo(WEIGHTED);
+    TS_ASSERT(lhs != rhs);
+  }
+
+  void test_clear_keeps_type() {
+    EventColumns columns(WEIGHTED);
+    columns.append(WeightedEvent(1.0, 10, 2.0, 4.0));
+    columns.clear();
+    TS_ASSERT(columns.empty());
+    TS_ASSERT(columns.weights().empty());
+    TS_ASSERT_EQUALS(columns.getEventType(), WEIGHTED);
+  }
+};
@@ -13,11 +13,13 @@
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/Unit.h"
+#include "MantidKernel/VectorHelper.h"
 
 #include <cxxtest/TestSuite.h>
 
 #include <boost/scoped_ptr.hpp>
 #include <cmath>
+#include <numeric>
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -1211,6 +1213,60 @@ public:
     }
   }
 
+  void test_histogram_linear_bins_does_not_sort() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      MantidVec X;
+      Mantid::Kernel::VectorHelper::createAxisFromRebinParams(
+          {0.0, BIN_DELTA, MAX_TOF}, X);
+      MantidVec Y, E;
+      el.generateHistogram(X, Y, E);
+      TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+
+      // Same result once sorted
+      EventList sorted(el);
+      sorted.sortTof();
+      MantidVec sortedY, sortedE;
+      sorted.generateHistogram(X, sortedY, sortedE);
+      TSM_ASSERT_EQUALS(this_type, Y, sortedY);
+      TSM_ASSERT_EQUALS(this_type, E, sortedE);
+      TS_ASSERT_DELTA(std::accumulate(Y.cbegin(), Y.cend(), 0.0),
+                      el.integrate(0, MAX_TOF, false), 1e-6);
+    }
+  }
+
+  void test_histogram_log_bins_does_not_sort() {
+    this->fake_data();
+    MantidVec X;
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams(
+        {100.0, -0.01, MAX_TOF}, X);
+    MantidVec Y, E;
+    el.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+    TS_ASSERT_EQUALS(std::accumulate(Y.cbegin(), Y.cend(), 0.0),
+                     el.integrate(100.0, X.back(), false));
+  }
+
+  void test_histogram_arbitrary_bins_sorts() {
+    this->fake_data();
+    const MantidVec X{0.0, 10.0, 1000.0, 5000.0, 5001.0, MAX_TOF};
+    MantidVec Y, E;
+    el.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(el.getSortType(), TOF_SORT);
+    TS_ASSERT_EQUALS(std::accumulate(Y.cbegin(), Y.cend(), 0.0),
+                     el.integrate(0, MAX_TOF, false));
+  }
+
+  void test_histogram_reused_output_is_reset() {
+    this->fake_uniform_data();
+    this->test_setX();
+    MantidVec Y(NUMBINS, 10.0), E;
+    el.generateHistogram(el.readX(), Y, E);
+    for (std::size_t i = 0; i < Y.size(); i++)
+      TS_ASSERT_EQUALS(Y[i], 2.0);
+  }
+
   void test_histogram_const_call() {
     this->fake_uniform_data();
     this->test_setX(); // Set it up WITH THE default binning
@@ -1964,6 +2020,78 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  /** Split to many outputs given as a vector indexed by group + 1, with
+   * splitters of very different lengths
+   */
+  void test_splitByFullTimeVectorSplitter_vectorOutputs() {
+    fake_uniform_time_sns_data();
+
+    // 200 short splitters followed by 200 long ones
+    std::vector<int64_t> vec_splitTimes;
+    for (int64_t i = 0; i <= 400; ++i)
+      vec_splitTimes.emplace_back(i < 200 ? 500000 + i * 1000
+                                          : 700000 + (i - 200) * 1700000);
+    std::vector<int> vec_splitGroup;
+    for (int i = 0; i < 400; ++i)
+      vec_splitGroup.emplace_back(i % 5 == 0 ? -1 : i % 37);
+
+    std::vector<EventList> lists(38);
+    std::vector<EventList *> outputs;
+    for (auto &list : lists)
+      outputs.emplace_back(&list);
+    el.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_splitGroup, outputs,
+                                     false, 1.0, 0.0);
+
+    // Events outside of the splitters are dropped
+    std::vector<size_t> expected(38, 0);
+    for (size_t i = 0; i < el.getNumberEvents(); ++i) {
+      const auto &event = el.getEvent(i);
+      const int64_t time = event.pulseTime().totalNanoseconds() +
+                           static_cast<int64_t>(event.tof() * 1000);
+      const auto splitter = std::upper_bound(vec_splitTimes.cbegin(),
+                                             vec_splitTimes.cend(), time) -
+                            vec_splitTimes.cbegin() - 1;
+      if (splitter >= 0 && splitter < 400)
+        ++expected[vec_splitGroup[splitter] + 1];
+    }
+    size_t total(0);
+    for (size_t i = 0; i < lists.size(); ++i) {
+      TS_ASSERT_EQUALS(lists[i].getNumberEvents(), expected[i]);
+      total += expected[i];
+    }
+    TS_ASSERT_LESS_THAN(0, total);
+    TS_ASSERT_LESS_THAN(total, el.getNumberEvents());
+
+    // The same split with a map of outputs
+    std::vector<EventList> mapLists(38);
+    std::map<int, EventList *> mapOutputs;
+    for (int i = -1; i < 37; ++i)
+      mapOutputs.emplace(i, &mapLists[i + 1]);
+    el.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_splitGroup,
+                                     mapOutputs, false, 1.0, 0.0);
+    for (size_t i = 0; i < lists.size(); ++i)
+      TS_ASSERT(mapLists[i] == lists[i]);
+  }
+
+  void test_splitByFullTimeVectorSplitter_vectorOutputs_no_splitters() {
+    fake_uniform_time_sns_data();
+    const std::vector<int64_t> vec_splitTimes;
+    const std::vector<int> vec_splitGroup;
+    TS_ASSERT_THROWS(
+        el.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_splitGroup,
+                                         std::vector<EventList *>(), false,
+                                         1.0, 0.0),
+        const std::invalid_argument &);
+
+    // Everything goes to group -1
+    EventList unfiltered;
+    el.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_splitGroup,
+                                     std::vector<EventList *>{&unfiltered},
+                                     false, 1.0, 0.0);
+    TS_ASSERT_EQUALS(unfiltered.getNumberEvents(), el.getNumberEvents());
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_splitByTime_allTypes() {
     // Go through each possible EventType as the input
@@ -2109,6 +2237,145 @@ public:
     TS_ASSERT_THROWS(el.filterInPlace(split), const std::runtime_error &)
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_setStorageType_round_trip() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      const EventList original(el);
+
+      el.setStorageType(COLUMN_STORAGE);
+      TS_ASSERT_EQUALS(el.getStorageType(), COLUMN_STORAGE);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), original.getNumberEvents());
+      TS_ASSERT_EQUALS(el.getEventType(), original.getEventType());
+
+      el.setStorageType(ROW_STORAGE);
+      TS_ASSERT_EQUALS(el.getStorageType(), ROW_STORAGE);
+      TSM_ASSERT(this_type, el == original);
+    }
+  }
+
+  void test_column_storage_histogram_matches_row_storage() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data_changing_weights();
+      if (this_type == TOF)
+        this->fake_uniform_data();
+      else
+        el.switchTo(static_cast<EventType>(this_type));
+      this->test_setX();
+      EventList columns(el);
+      columns.setStorageType(COLUMN_STORAGE);
+
+      MantidVec X = el.readX(), Y, E, columnsY, columnsE;
+      el.generateHistogram(X, Y, E);
+      columns.generateHistogram(X, columnsY, columnsE);
+      TSM_ASSERT_EQUALS(this_type, Y, columnsY);
+      TSM_ASSERT_EQUALS(this_type, E, columnsE);
+      TS_ASSERT_EQUALS(columns.getStorageType(), COLUMN_STORAGE);
+    }
+  }
+
+  void test_column_storage_integrate_matches_row_storage() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data_weights(this_type == TOF ? TOF : WEIGHTED);
+      if (this_type == WEIGHTED_NOTIME)
+        el.switchTo(WEIGHTED_NOTIME);
+      EventList columns(el);
+      columns.setStorageType(COLUMN_STORAGE);
+      TS_ASSERT_EQUALS(columns.integrate(0, MAX_TOF, false),
+                       el.integrate(0, MAX_TOF, false));
+      TS_ASSERT_EQUALS(columns.integrate(BIN_DELTA * 10, BIN_DELTA * 20, false),
+                       el.integrate(BIN_DELTA * 10, BIN_DELTA * 20, false));
+      TS_ASSERT_EQUALS(columns.integrate(1000, 100, false), 0);
+    }
+  }
+
+  void test_column_storage_convertTof_and_maskTof() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      el.setStorageType(COLUMN_STORAGE);
+
+      el.convertTof(2.5, 1.);
+      TS_ASSERT_EQUALS(el.getTofMin(), 251.0);
+      el.maskTof(MAX_TOF * 0.25, MAX_TOF * 0.5);
+      TS_ASSERT_EQUALS(el.getStorageType(), COLUMN_STORAGE);
+
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      el.convertTof(2.5, 1.);
+      el.maskTof(MAX_TOF * 0.25, MAX_TOF * 0.5);
+      std::vector<double> expected, tofs;
+      el.getTofs(expected);
+      el.setStorageType(COLUMN_STORAGE);
+      el.getTofs(tofs);
+      TSM_ASSERT_EQUALS(this_type, tofs, expected);
+    }
+  }
+
+  void test_shrinkToFit() {
+    for (const auto storage : {ROW_STORAGE, COLUMN_STORAGE}) {
+      EventList list;
+      list.setStorageType(storage);
+      list.reserve(1000);
+      list += TofEvent(10.0, 20);
+      const size_t reserved = list.getMemorySize();
+      list.shrinkToFit();
+      TS_ASSERT_LESS_THAN(list.getMemorySize(), reserved);
+      TS_ASSERT_EQUALS(list.getNumberEvents(), 1);
+      TS_ASSERT_EQUALS(list.getStorageType(), storage);
+    }
+  }
+
+  void test_column_storage_filterInPlace() {
+    this->fake_uniform_time_data();
+    EventList rows(el);
+    el.setStorageType(COLUMN_STORAGE);
+
+    TimeSplitterType split;
+    split.emplace_back(SplittingInterval(100, 200, 0));
+    split.emplace_back(SplittingInterval(150, 250, 1));
+    split.emplace_back(SplittingInterval(300, 350, 0));
+    rows.filterInPlace(split);
+    el.filterInPlace(split);
+
+    TS_ASSERT_EQUALS(el.getStorageType(), COLUMN_STORAGE);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 200);
+    TS_ASSERT(el == rows);
+  }
+
+  void test_column_storage_falls_back_to_rows() {
+    this->fake_uniform_data();
+    const EventList original(el);
+    el.setStorageType(COLUMN_STORAGE);
+    // No column implementation: the list is converted back transparently
+    TS_ASSERT_EQUALS(el.getEvents(), original.getEvents());
+    TS_ASSERT_EQUALS(el.getStorageType(), ROW_STORAGE);
+  }
+
+  void test_column_storage_add_events() {
+    el.setStorageType(COLUMN_STORAGE);
+    el.addEventQuickly(TofEvent(10.0, 20));
+    el += TofEvent(5.0, 30);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 5);
+    TS_ASSERT_EQUALS(el.getStorageType(), COLUMN_STORAGE);
+    TS_ASSERT_EQUALS(el.getTofMin(), 5.0);
+    el.switchTo(WEIGHTED);
+    el.addEventQuickly(WeightedEvent(1.0, 40, 2.0, 4.0));
+    TS_ASSERT_EQUALS(el.getEventType(), WEIGHTED);
+    TS_ASSERT_EQUALS(el.getWeightedEvents().back().weight(), 2.0);
+  }
+
+  void test_EventWorkspace_setStorageType() {
+    auto ws = std::make_shared<EventWorkspace>();
+    ws->initialize(2, 1, 1);
+    ws->getSpectrum(0) += TofEvent(1.0, 0);
+    ws->setStorageType(COLUMN_STORAGE);
+    TS_ASSERT_EQUALS(ws->getSpectrum(0).getStorageType(), COLUMN_STORAGE);
+    TS_ASSERT_EQUALS(ws->getSpectrum(1).getStorageType(), COLUMN_STORAGE);
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), 1);
+  }
+
   //----------------------------------------------------------------------------------------------
   void test_ParallelizedSorting() {
     for (int this_type = 0; this_type < 3; this_type++) {
@@ -2969,6 +3236,11 @@ public:
     el_sorted_weighted.generateHistogram(fineX, Y, E);
   }
 
+  void test_histogram_unsorted() {
+    MantidVec Y, E;
+    el_random.generateHistogram(fineX, Y, E);
+  }
+
   void test_histogram_coarse() {
     MantidVec Y, E;
     el_sorted.generateHistogram(coarseX, Y, E);
@@ -0,0 +1,298 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventPager.h"
+#include "MantidDataObjects/EventWorkspace.h"
+
+#include <cxxtest/TestSuite.h>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace Mantid::DataObjects;
+using Mantid::Types::Event::TofEvent;
+
+namespace {
+/** Loader of pages of consecutive spectra. Spectrum i holds i + 1 events of
+ * time-of-flight i. */
+class FakePageLoader : public EventPageLoader {
+public:
+  FakePageLoader(std::size_t numberOfPages, std::size_t spectraPerPage)
+      : m_numberOfPages(numberOfPages), m_spectraPerPage(spectraPerPage),
+        m_loads(numberOfPages, 0) {}
+
+  std::size_t numberOfPages() const override { return m_numberOfPages; }
+  std::vector<std::size_t> workspaceIndices(std::size_t page) const override {
+    std::vector<std::size_t> indices(m_spectraPerPage);
+    for (std::size_t i = 0; i < m_spectraPerPage; ++i)
+      indices[i] = page * m_spectraPerPage + i;
+    return indices;
+  }
+  std::size_t numberOfEvents(std::size_t page) const override {
+    std::size_t events = 0;
+    for (const auto index : workspaceIndices(page))
+      events += index + 1;
+    return events;
+  }
+  void loadPage(std::size_t page,
+                const std::vector<EventList *> &spectra) override {
+    if (m_fail)
+      throw std::runtime_error("cannot read page");
+    ++m_loads[page];
+    for (const auto index : workspaceIndices(page)) {
+      for (std::size_t i = 0; i <= index; ++i)
+        spectra[index]->addEventQuickly(
+            TofEvent(static_cast<double>(index), 0));
+      spectra[index]->setSortOrder(PULSETIME_SORT);
+    }
+  }
+
+  EventSortType sortOrder() const override { return PULSETIME_SORT; }
+
+  std::size_t loads(std::size_t page) const { return m_loads[page]; }
+  void fail(bool fail) { m_fail = fail; }
+
+private:
+  std::size_t m_numberOfPages;
+  std::size_t m_spectraPerPage;
+  std::vector<std::size_t> m_loads;
+  bool m_fail = false;
+};
+
+EventPager::Spectra makeSpectra(std::size_t size) {
+  EventPager::Spectra spectra;
+  for (std::size_t i = 0; i < size; ++i)
+    spectra.emplace_back(std::make_unique<EventList>());
+  return spectra;
+}
+} // namespace
+
+class EventPagerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventPagerTest *createSuite() { return new EventPagerTest(); }
+  static void destroySuite(EventPagerTest *suite) { delete suite; }
+
+  void test_page_is_loaded_on_first_access() {
+    auto loader = std::make_shared<FakePageLoader>(3, 2);
+    auto spectra = makeSpectra(6);
+    EventPager pager(loader, 6, 1000);
+    TS_ASSERT(!pager.isResident(2));
+    TS_ASSERT_EQUALS(pager.numberOfAbsentEvents(), 21);
+    TS_ASSERT_EQUALS(pager.numberOfResidentEvents(), 0);
+
+    pager.require(2, spectra, false);
+    TS_ASSERT(pager.isResident(2));
+    TS_ASSERT(pager.isResident(3));
+    TS_ASSERT(!pager.isResident(0));
+    TS_ASSERT_EQUALS(spectra[2]->getNumberEvents(), 3);
+    TS_ASSERT_EQUALS(spectra[3]->getNumberEvents(), 4);
+    TS_ASSERT_EQUALS(spectra[0]->getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(pager.numberOfAbsentEvents(), 14);
+    TS_ASSERT_EQUALS(pager.numberOfResidentEvents(), 7);
+
+    pager.require(3, spectra, false);
+    TS_ASSERT_EQUALS(loader->loads(1), 1);
+  }
+
+  void test_least_recently_used_page_is_dropped() {
+    auto loader = std::make_shared<FakePageLoader>(3, 2);
+    auto spectra = makeSpectra(6);
+    // Pages hold 3, 7 and 11 events: any two fit, but not all three
+    EventPager pager(loader, 6, 18);
+    pager.require(0, spectra, false);
+    pager.require(2, spectra, false);
+    pager.require(1, spectra, false);
+    pager.require(4, spectra, false);
+    // Page 1 was used least recently
+    TS_ASSERT(pager.isResident(0));
+    TS_ASSERT(!pager.isResident(2));
+    TS_ASSERT(pager.isResident(4));
+    TS_ASSERT_EQUALS(spectra[2]->getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(pager.numberOfResidentEvents(), 14);
+    TS_ASSERT_EQUALS(pager.numberOfAbsentEvents(), 7);
+
+    // Reloading page 1 drops page 0
+    pager.require(3, spectra, false);
+    TS_ASSERT_EQUALS(loader->loads(1), 2);
+    TS_ASSERT(!pager.isResident(0));
+    TS_ASSERT_EQUALS(spectra[3]->getNumberEvents(), 4);
+  }
+
+  void test_held_page_is_kept_above_the_limit() {
+    auto loader = std::make_shared<FakePageLoader>(3, 2);
+    auto spectra = makeSpectra(6);
+    EventPager pager(loader, 6, 1);
+    pager.require(0, spectra, false);
+    // This thread still holds page 0 while page 1 is loaded
+    pager.require(2, spectra, false);
+    TS_ASSERT(pager.isResident(0));
+    TS_ASSERT(pager.isResident(2));
+    pager.require(4, spectra, false);
+    TS_ASSERT(!pager.isResident(0));
+    TS_ASSERT(pager.isResident(2));
+    TS_ASSERT(pager.isResident(4));
+  }
+
+  void test_page_held_by_another_thread_is_not_dropped() {
+    auto loader = std::make_shared<FakePageLoader>(4, 2);
+    auto spectra = makeSpectra(8);
+    EventPager pager(loader, 8, 1);
+    std::promise<void> held, done;
+    auto isHeld = held.get_future();
+    auto isDone = done.get_future();
+    std::thread reader([&]() {
+      pager.require(0, spectra, false);
+      held.set_value();
+      isDone.wait();
+    });
+    isHeld.wait();
+    pager.require(2, spectra, false);
+    pager.require(4, spectra, false);
+    pager.require(6, spectra, false);
+    TS_ASSERT(pager.isResident(0));
+    TS_ASSERT_EQUALS(spectra[1]->getNumberEvents(), 2);
+    TS_ASSERT(!pager.isResident(2));
+
+    // The hold ends with the thread
+    done.set_value();
+    reader.join();
+    pager.require(2, spectra, false);
+    TS_ASSERT(!pager.isResident(0));
+    TS_ASSERT_EQUALS(loader->loads(0), 1);
+  }
+
+  void test_pinned_page_is_never_dropped() {
+    auto loader = std::make_shared<FakePageLoader>(3, 2);
+    auto spectra = makeSpectra(6);
+    EventPager pager(loader, 6, 1);
+    pager.require(0, spectra, true);
+    TS_ASSERT(pager.isPinned(1));
+    spectra[0]->addEventQuickly(TofEvent(100., 0));
+    pager.require(2, spectra, false);
+    pager.require(4, spectra, false);
+    TS_ASSERT(pager.isResident(0));
+    TS_ASSERT_EQUALS(spectra[0]->getNumberEvents(), 2);
+    TS_ASSERT_EQUALS(loader->loads(0), 1);
+  }
+
+  void test_pin_all() {
+    auto loader = std::make_shared<FakePageLoader>(3, 2);
+    auto spectra = makeSpectra(6);
+    EventPager pager(loader, 6, 1);
+    pager.pinAll(spectra);
+    for (std::size_t i = 0; i < 6; ++i) {
+      TS_ASSERT(pager.isResident(i));
+      TS_ASSERT(pager.isPinned(i));
+      TS_ASSERT_EQUALS(spectra[i]->getNumberEvents(), i + 1);
+    }
+    TS_ASSERT_EQUALS(pager.numberOfAbsentEvents(), 0);
+  }
+
+  void test_failed_load_leaves_page_absent() {
+    auto loader = std::make_shared<FakePageLoader>(2, 2);
+    auto spectra = makeSpectra(4);
+    EventPager pager(loader, 4, 100);
+    loader->fail(true);
+    TS_ASSERT_THROWS(pager.require(0, spectra, false),
+                     const std::runtime_error &);
+    TS_ASSERT(!pager.isResident(0));
+    loader->fail(false);
+    pager.require(0, spectra, false);
+    TS_ASSERT_EQUALS(spectra[1]->getNumberEvents(), 2);
+  }
+
+  void test_spectrum_in_no_page_is_always_resident() {
+    auto loader = std::make_shared<FakePageLoader>(1, 2);
+    auto spectra = makeSpectra(3);
+    EventPager pager(loader, 3, 100);
+    TS_ASSERT(pager.isResident(2));
+    TS_ASSERT_THROWS_NOTHING(pager.require(2, spectra, true));
+    TS_ASSERT(!pager.isResident(0));
+  }
+
+  void test_spectra_outside_the_workspace_throw() {
+    auto loader = std::make_shared<FakePageLoader>(2, 2);
+    TS_ASSERT_THROWS(EventPager(loader, 3, 100), const std::invalid_argument &);
+  }
+
+  void test_copy_keeps_resident_pages() {
+    auto loader = std::make_shared<FakePageLoader>(2, 2);
+    auto spectra = makeSpectra(4);
+    EventPager pager(loader, 4, 100);
+    pager.require(0, spectra, true);
+    EventPager copy(pager);
+    TS_ASSERT(copy.isResident(0));
+    TS_ASSERT(copy.isPinned(0));
+    TS_ASSERT(!copy.isResident(2));
+    TS_ASSERT_EQUALS(copy.numberOfResidentEvents(), 3);
+    TS_ASSERT_EQUALS(copy.maxResidentEvents(), 100);
+  }
+
+  void test_lazy_event_workspace() {
+    EventWorkspace ws;
+    ws.initialize(6, 2, 1);
+    auto loader = std::make_shared<FakePageLoader>(3, 2);
+    ws.setPageLoader(loader, 1000);
+    TS_ASSERT(ws.isLazy());
+    TS_ASSERT_EQUALS(ws.getNumberEvents(), 21);
+    TS_ASSERT(!ws.pager()->isResident(4));
+
+    const auto &constWs = ws;
+    TS_ASSERT_EQUALS(constWs.getSpectrum(4).getNumberEvents(), 5);
+    TS_ASSERT(ws.pager()->isResident(4));
+    TS_ASSERT(!ws.pager()->isPinned(4));
+    TS_ASSERT_EQUALS(ws.getNumberEvents(), 21);
+
+    ws.getSpectrum(0).addEventQuickly(TofEvent(1., 0));
+    TS_ASSERT(ws.pager()->isPinned(0));
+    TS_ASSERT_EQUALS(ws.getNumberEvents(), 22);
+
+    auto copy = ws.clone();
+    TS_ASSERT(copy->isLazy());
+    TS_ASSERT_EQUALS(copy->getNumberEvents(), 22);
+    TS_ASSERT_EQUALS(copy->getSpectrum(2).getNumberEvents(), 3);
+  }
+
+  void test_lazy_event_workspace_histograms_events_not_loaded() {
+    EventWorkspace ws;
+    ws.initialize(6, 2, 1);
+    ws.setAllX(Mantid::HistogramData::BinEdges{0., 10.});
+    ws.setPageLoader(std::make_shared<FakePageLoader>(3, 2), 1);
+    TS_ASSERT_EQUALS(ws.getSortType(), PULSETIME_SORT);
+    TS_ASSERT_EQUALS(ws.getEventType(), Mantid::API::TOF);
+    // Without loading the events
+    TS_ASSERT(!ws.pager()->isResident(0));
+    TS_ASSERT_EQUALS(ws.pager()->numberOfResidentEvents(), 0);
+
+    Mantid::MantidVec Y, E;
+    ws.generateHistogram(5, ws.readX(5), Y, E);
+    TS_ASSERT_EQUALS(Y, Mantid::MantidVec{6.});
+    Mantid::MantidVec pulseY, pulseE;
+    ws.generateHistogramPulseTime(3, {-1., 1.}, pulseY, pulseE);
+    TS_ASSERT_EQUALS(pulseY, Mantid::MantidVec{4.});
+    // Only the pages held by this thread are in memory
+    TS_ASSERT(!ws.pager()->isResident(0));
+    TS_ASSERT_EQUALS(ws.getNumberEvents(), 21);
+  }
+
+  void test_lazy_event_workspace_types_of_loaded_spectra() {
+    EventWorkspace ws;
+    ws.initialize(6, 2, 1);
+    ws.setPageLoader(std::make_shared<FakePageLoader>(3, 2), 1000);
+    ws.getSpectrum(2).switchTo(Mantid::API::WEIGHTED);
+    TS_ASSERT_EQUALS(ws.getEventType(), Mantid::API::WEIGHTED);
+    TS_ASSERT_EQUALS(ws.getSortType(), PULSETIME_SORT);
+    ws.getSpectrum(3).setSortOrder(TOF_SORT);
+    TS_ASSERT_EQUALS(ws.getSortType(), UNSORTED);
+    TS_ASSERT(!ws.pager()->isResident(0));
+  }
+};
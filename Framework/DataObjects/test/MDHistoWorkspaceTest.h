@@ -263,6 +263,86 @@ public:
     checkWorkspace(b, 1.23, 3.234, 123.);
   }
 
+  //--------------------------------------------------------------------------------------
+  /// @return a 2D workspace of 40 x 40 bins, spanning several blocks, set to 0
+  MDHistoWorkspace_sptr makeZeroedWorkspace() {
+    Mantid::Geometry::GeneralFrame frame("m", "m");
+    std::vector<MDHistoDimension_sptr> dimensions{
+        std::make_shared<MDHistoDimension>("X", "x", frame, -10.f, 10.f, 40),
+        std::make_shared<MDHistoDimension>("Y", "y", frame, -10.f, 10.f, 40)};
+    return std::make_shared<MDHistoWorkspace>(
+        dimensions, NoNormalization, MDHistoWorkspace::Initialisation::Zero);
+  }
+
+  void test_constructor_zero_initialisation() {
+    auto ws = makeZeroedWorkspace();
+    TS_ASSERT_EQUALS(ws->getNPoints(), 1600);
+    TS_ASSERT_EQUALS(ws->getMemorySize(), 1600 * sizeOfElement());
+    checkWorkspace(ws, 0., 0., 0.);
+    for (size_t i = 0; i < ws->getNPoints(); i++)
+      TS_ASSERT(!ws->getIsMaskedAt(i));
+  }
+
+  void test_copy_and_setTo_zero_with_empty_blocks() {
+    auto a = makeZeroedWorkspace();
+    a->setSignalAt(3, 1.5);
+    a->setErrorSquaredAt(700, 2.5);
+    a->setNumEventsAt(1599, 3.);
+    a->setMDMaskAt(1100, true);
+    MDHistoWorkspace_sptr b(new TestableMDHistoWorkspace(*a));
+    for (size_t i = 0; i < a->getNPoints(); i++) {
+      TS_ASSERT_EQUALS(b->getSignalAt(i), a->getSignalAt(i));
+      TS_ASSERT_EQUALS(b->getErrorSquaredArray()[i],
+                       a->getErrorSquaredArray()[i]);
+      TS_ASSERT_EQUALS(b->getNumEventsAt(i), a->getNumEventsAt(i));
+      TS_ASSERT_EQUALS(b->getIsMaskedAt(i), a->getIsMaskedAt(i));
+    }
+    // The arrays stay where they are
+    const auto *signals = b->getSignalArray();
+    b->setTo(0., 0., 0.);
+    TS_ASSERT_EQUALS(b->getSignalArray(), signals);
+    checkWorkspace(b, 0., 0., 0.);
+    TS_ASSERT(!b->getIsMaskedAt(1100));
+  }
+
+  void test_binary_operations_with_empty_blocks() {
+    auto a = makeZeroedWorkspace();
+    auto b = makeZeroedWorkspace();
+    a->setSignalAt(10, 4.);
+    a->setErrorSquaredAt(10, 1.);
+    for (size_t i = 0; i < 1024; i++)
+      b->setSignalAt(i, 2.);
+    b->setErrorSquaredAt(1000, 1.);
+
+    auto sum = a->clone();
+    sum->add(*b);
+    TS_ASSERT_EQUALS(sum->getSignalAt(10), 6.);
+    TS_ASSERT_EQUALS(sum->getSignalAt(1000), 2.);
+    TS_ASSERT_EQUALS(sum->getErrorSquaredArray()[1000], 1.);
+    TS_ASSERT_EQUALS(sum->getSignalAt(1500), 0.);
+
+    auto difference = a->clone();
+    difference->subtract(*b);
+    TS_ASSERT_EQUALS(difference->getSignalAt(10), 2.);
+    TS_ASSERT_EQUALS(difference->getSignalAt(1000), -2.);
+    TS_ASSERT_EQUALS(difference->getSignalAt(1500), 0.);
+
+    auto product = a->clone();
+    product->multiply(*b);
+    TS_ASSERT_EQUALS(product->getSignalAt(10), 8.);
+    TS_ASSERT_EQUALS(product->getErrorSquaredArray()[10], 4.);
+    TS_ASSERT_EQUALS(product->getSignalAt(1000), 0.);
+    TS_ASSERT_EQUALS(product->getSignalAt(1500), 0.);
+
+    // Dividing by the empty bins of b gives NaN, empty or not
+    auto quotient = a->clone();
+    quotient->divide(*b);
+    TS_ASSERT_EQUALS(quotient->getSignalAt(10), 2.);
+    TS_ASSERT_EQUALS(quotient->getErrorSquaredArray()[10], 0.25);
+    TS_ASSERT_EQUALS(quotient->getSignalAt(1000), 0.);
+    TS_ASSERT(std::isnan(quotient->getSignalAt(1500)));
+  }
+
   //--------------------------------------------------------------------------------------
   void test_clone_clear_workspace_name() {
     auto ws =
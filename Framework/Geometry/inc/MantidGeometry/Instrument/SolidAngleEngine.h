@@ -0,0 +1,68 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/LRUCache.h"
+#include "MantidKernel/V3D.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class ComponentInfo;
+class DetectorInfo;
+
+/** SolidAngleEngine : Computes the solid angles of all the detectors of an
+  instrument seen from a point, normally the sample, and keeps them so that
+  workspaces sharing the geometry of the instrument do not compute them again.
+
+  The detectors are computed in parallel. The shapes of the detectors are
+  examined once, and CSG spheres, cuboids and cylinders which are not scaled
+  are given a kernel: the analytic solid angle of the sphere, or the triangles
+  of the surface of the cuboid or cylinder transformed to the frame of the
+  shape once for all the detectors sharing it. These give the same values as
+  IObject::solidAngle without building the triangles again for each detector.
+  Other shapes, and points inside the bounding box of a shape, are computed
+  by ComponentInfo::solidAngle.
+
+  Tables are kept in a Kernel::LRUCache, found by the Kernel::HashBuilder hash
+  of the point, and the positions, rotations, scale factors and shapes of the
+  detectors. The process wide instance() takes its limit in MiB from the
+  SolidAngle.CacheSize configuration key. Instruments with shapes which cannot
+  be hashed, such as CSG shapes built without XML, are never kept.
+*/
+class MANTID_GEOMETRY_DLL SolidAngleEngine {
+public:
+  /// The solid angle of each detector, by detector index
+  using Table = std::vector<double>;
+
+  explicit SolidAngleEngine(const size_t memoryLimit);
+  static SolidAngleEngine &instance();
+
+  std::shared_ptr<const Table> solidAngles(const ComponentInfo &componentInfo,
+                                           const DetectorInfo &detectorInfo,
+                                           const Kernel::V3D &observer);
+  void clear();
+  size_t size() const;
+  size_t memory() const;
+
+  static Table calculate(const ComponentInfo &componentInfo,
+                         const DetectorInfo &detectorInfo,
+                         const Kernel::V3D &observer);
+  static bool geometryHash(const ComponentInfo &componentInfo,
+                           const DetectorInfo &detectorInfo,
+                           const Kernel::V3D &observer, uint64_t &hash);
+
+private:
+  Kernel::LRUCache<Table> m_tables;
+};
+
+} // namespace Geometry
+} // namespace Mantid
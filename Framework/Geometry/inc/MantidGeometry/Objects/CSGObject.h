@@ -32,6 +32,7 @@ class V3D;
 namespace Geometry {
 class CompGrp;
 class GeometryHandler;
+struct RayBatch;
 class Rule;
 class Surface;
 class Track;
@@ -130,6 +131,7 @@ public:
   // INTERSECTION
   int interceptSurface(Geometry::Track &track) const override;
   double distance(const Track &track) const override;
+  void pathLengths(const RayBatch &rays, std::vector<double> &lengths) const;
 
   // Solid angle - uses triangleSolidAngle unless many (>30000) triangles
   double solidAngle(const Kernel::V3D &observer) const override;
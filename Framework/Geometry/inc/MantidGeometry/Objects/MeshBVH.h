@@ -0,0 +1,67 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/** MeshBVH : A bounding volume hierarchy of the triangles of a mesh, to find
+  the triangles a ray may cross without testing every one of them.
+
+  Each node holds an axis aligned box around its triangles. A node is split
+  at the median of the centres of its triangles along the longest side of
+  their bounds, until a node has a few triangles. The nodes are stored depth
+  first, so the left child of a node directly follows it. The boxes are
+  padded by a small fraction of the size of the mesh so that no triangle
+  accepted by MeshObjectCommon::rayIntersectsTriangle is left out.
+
+  The hierarchy refers to the vertices it was built from by position only,
+  so it must be built again when the mesh is moved.
+*/
+class MANTID_GEOMETRY_DLL MeshBVH {
+public:
+  MeshBVH(const std::vector<uint32_t> &triangles,
+          const std::vector<Kernel::V3D> &vertices);
+
+  void findCandidates(const Kernel::V3D &start, const Kernel::V3D &direction,
+                      std::vector<uint32_t> &candidates) const;
+
+  /// @return the number of nodes of the hierarchy
+  size_t numberOfNodes() const { return m_nodes.size(); }
+
+private:
+  struct Node {
+    std::array<double, 3> min;
+    std::array<double, 3> max;
+    /// The first triangle of a leaf, or the index of the right child
+    uint32_t first;
+    /// The number of triangles of a leaf, 0 for a node with children
+    uint32_t count;
+  };
+
+  void build(uint32_t begin, uint32_t end,
+             const std::vector<std::array<double, 6>> &bounds,
+             const std::vector<std::array<double, 3>> &centres);
+  bool intersects(const Node &node, const std::array<double, 3> &start,
+                  const std::array<double, 3> &direction) const;
+
+  std::vector<Node> m_nodes;
+  /// The indexes of the triangles, ordered so each leaf holds a range
+  std::vector<uint32_t> m_triangles;
+  /// Padding of the boxes
+  double m_padding{0.};
+};
+
+} // namespace Geometry
+} // namespace Mantid
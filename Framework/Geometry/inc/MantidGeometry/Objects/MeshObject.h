@@ -12,12 +12,15 @@
 #include "BoundingBox.h"
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/Objects/IObject.h"
+#include "MantidGeometry/Objects/MeshBVH.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/Rendering/ShapeInfo.h"
 #include "MantidKernel/Material.h"
 #include "MantidKernel/Matrix.h"
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 
 namespace Mantid {
 //----------------------------------------------------------------------
@@ -46,6 +49,9 @@ Mesh Object of Triangles assumed to form one or more
 non-intersecting closed surfaces enclosing separate volumes.
 The number of vertices is limited to 2^32 based on index type. For 2D Meshes see
 Mesh2DObject
+
+Rays are only tested against the triangles found by a MeshBVH, built on first
+use and dropped when the mesh is moved.
 */
 class MANTID_GEOMETRY_DLL MeshObject : public IObject {
 public:
@@ -162,10 +168,21 @@ private:
                    Kernel::V3D &v3) const;
   /// Search object for valid point
   bool searchForObject(Kernel::V3D &point) const;
+  /// Get the hierarchy of the triangles, building it if needed
+  const MeshBVH &getBVH() const;
+  /// Drop what is cached about the position of the mesh
+  void clearCache();
 
   /// Cache for object's bounding box
   mutable BoundingBox m_boundingBox;
 
+  /// Cache for the hierarchy of the triangles
+  mutable std::unique_ptr<MeshBVH> m_bvh;
+  /// Whether m_bvh is built
+  mutable std::atomic<bool> m_bvhBuilt{false};
+  /// Lock to build m_bvh from one thread only
+  mutable std::mutex m_bvhMutex;
+
   /// Tolerence distance
   const double M_TOLERANCE = 0.000001;
 
@@ -0,0 +1,60 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/V3D.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/** RayBatch : The start points and unit directions of many rays, stored as
+  one array per component so that a surface can be intersected with all of
+  them in a loop the compiler can vectorise. See CSGObject::pathLengths.
+*/
+struct RayBatch {
+  /// Reserve space for a number of rays
+  void reserve(const size_t n) {
+    for (auto *values : {&startX, &startY, &startZ, &directionX, &directionY,
+                         &directionZ})
+      values->reserve(n);
+  }
+
+  /** Add a ray
+   * @param start :: the start point of the ray
+   * @param direction :: the unit direction of the ray
+   */
+  void add(const Kernel::V3D &start, const Kernel::V3D &direction) {
+    startX.emplace_back(start.X());
+    startY.emplace_back(start.Y());
+    startZ.emplace_back(start.Z());
+    directionX.emplace_back(direction.X());
+    directionY.emplace_back(direction.Y());
+    directionZ.emplace_back(direction.Z());
+  }
+
+  /// Remove every ray
+  void clear() {
+    for (auto *values : {&startX, &startY, &startZ, &directionX, &directionY,
+                         &directionZ})
+      values->clear();
+  }
+
+  /// @return the number of rays
+  size_t size() const { return startX.size(); }
+
+  std::vector<double> startX;
+  std::vector<double> startY;
+  std::vector<double> startZ;
+  std::vector<double> directionX;
+  std::vector<double> directionY;
+  std::vector<double> directionZ;
+};
+
+} // namespace Geometry
+} // namespace Mantid
@@ -0,0 +1,355 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Instrument/SolidAngleEngine.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/MeshObject.h"
+#include "MantidGeometry/Objects/MeshObject2D.h"
+#include "MantidGeometry/Objects/MeshObjectCommon.h"
+#include "MantidGeometry/Rendering/ShapeInfo.h"
+#include "MantidGeometry/Surfaces/Cylinder.h"
+#include "MantidKernel/HashBuilder.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Quat.h"
+#include "MantidKernel/Tolerance.h"
+
+#include <array>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace Mantid {
+namespace Geometry {
+
+namespace {
+/// Default limit of the process wide cache in MiB
+constexpr size_t DEFAULT_CACHE_SIZE = 256;
+
+using Kernel::V3D;
+using Triangle = std::array<V3D, 3>;
+
+/**
+ * The solid angle of a shape seen from points outside its bounding box. The
+ * triangles are those of the surface built by CSGObject::solidAngle, in the
+ * same order, so that the sums are the same.
+ */
+class ShapeKernel {
+public:
+  /**
+   * Build the kernel of a shape, if it has one
+   * @param shape :: the shape of a detector
+   * @return the kernel, or null if the shape must be computed by
+   * IObject::solidAngle
+   */
+  static std::unique_ptr<const ShapeKernel> create(const IObject &shape) {
+    if (!dynamic_cast<const CSGObject *>(&shape))
+      return nullptr;
+    detail::ShapeInfo::GeometryShape type;
+    std::vector<V3D> vectors;
+    double innerRadius(0.), radius(0.), height(0.);
+    shape.GetObjectGeom(type, vectors, innerRadius, radius, height);
+    std::unique_ptr<ShapeKernel> kernel(new ShapeKernel(shape));
+    switch (type) {
+    case detail::ShapeInfo::GeometryShape::SPHERE:
+      kernel->m_centre = vectors[0];
+      kernel->m_radius = radius;
+      break;
+    case detail::ShapeInfo::GeometryShape::CUBOID:
+      kernel->addCuboid(vectors);
+      break;
+    case detail::ShapeInfo::GeometryShape::CYLINDER:
+      kernel->addCylinder(vectors[0], vectors[1], radius, height);
+      break;
+    default:
+      return nullptr;
+    }
+    return kernel;
+  }
+
+  /// @return true if the point is outside the bounding box of the shape
+  bool canCompute(const V3D &observer) const {
+    return !(m_boundingBox.isNonNull() &&
+             m_boundingBox.isPointInside(observer));
+  }
+
+  /**
+   * @param observer :: a point outside the bounding box, in the frame of the
+   * shape
+   * @return the solid angle of the shape
+   */
+  double solidAngle(const V3D &observer) const {
+    if (m_triangles.empty()) {
+      const double distance = (observer - m_centre).norm();
+      if (distance > m_radius + Kernel::Tolerance)
+        return 2.0 * M_PI * (1.0 - cos(asin(m_radius / distance)));
+      else if (distance < m_radius - Kernel::Tolerance)
+        return 4.0 * M_PI;
+      return 2.0 * M_PI;
+    }
+    // Triangles facing away from the observer are not counted
+    double solidAngle(0.);
+    for (const auto &triangle : m_triangles) {
+      const double sa = MeshObjectCommon::getTriangleSolidAngle(
+          triangle[0], triangle[1], triangle[2], observer);
+      if (sa > 0.)
+        solidAngle += sa;
+    }
+    return solidAngle;
+  }
+
+private:
+  explicit ShapeKernel(const IObject &shape)
+      : m_boundingBox(shape.getBoundingBox()) {}
+
+  /// Add the 12 triangles of the faces of a cuboid given by 4 corners
+  void addCuboid(const std::vector<V3D> &vectors) {
+    const V3D dx = vectors[1] - vectors[0];
+    const V3D dz = vectors[3] - vectors[0];
+    const std::array<V3D, 8> pts{
+        {vectors[2], vectors[2] + dx, vectors[1], vectors[0], vectors[2] + dz,
+         vectors[2] + dz + dx, vectors[1] + dz, vectors[0] + dz}};
+    constexpr std::array<std::array<int, 3>, 12> triMap{
+        {{{1, 4, 3}},
+         {{3, 2, 1}},
+         {{5, 6, 7}},
+         {{7, 8, 5}},
+         {{1, 2, 6}},
+         {{6, 5, 1}},
+         {{2, 3, 7}},
+         {{7, 6, 2}},
+         {{3, 4, 8}},
+         {{8, 7, 3}},
+         {{1, 5, 8}},
+         {{8, 4, 1}}}};
+    for (const auto &tri : triMap)
+      m_triangles.push_back({{pts[tri[0] - 1], pts[tri[1] - 1],
+                              pts[tri[2] - 1]}});
+  }
+
+  /// Add the triangles of the side of a cylinder, without its end caps
+  void addCylinder(const V3D &centre, const V3D &axis, const double radius,
+                   const double height) {
+    const Kernel::Quat transform(V3D(0., 0., 1.), axis);
+    const double angleStep =
+        2 * M_PI / static_cast<double>(Cylinder::g_nslices);
+    const double zStep = height / Cylinder::g_nstacks;
+    const auto point = [&](const int slice, const double z) {
+      V3D pt(radius * std::cos(angleStep * slice),
+             radius * std::sin(angleStep * slice), z);
+      transform.rotate(pt);
+      return pt + centre;
+    };
+    double z0(0.), z1(zStep);
+    for (int st = 1; st <= Cylinder::g_nstacks; ++st) {
+      if (st == Cylinder::g_nstacks)
+        z1 = height;
+      for (int sl = 0; sl < Cylinder::g_nslices; ++sl) {
+        const int next = (sl + 1) % Cylinder::g_nslices;
+        const V3D pt1 = point(sl, z0), pt2 = point(sl, z1);
+        const V3D pt3 = point(next, z0), pt4 = point(next, z1);
+        m_triangles.push_back({{pt1, pt4, pt3}});
+        m_triangles.push_back({{pt1, pt2, pt4}});
+      }
+      z0 = z1;
+      z1 += zStep;
+    }
+  }
+
+  BoundingBox m_boundingBox;
+  /// The triangles of the surface, or none for a sphere
+  std::vector<Triangle> m_triangles;
+  V3D m_centre;
+  double m_radius{0.};
+};
+
+/**
+ * Hash what the solid angle of a shape depends on
+ * @param shape :: the shape
+ * @param[out] hash :: the hash of the shape
+ * @return false if the shape cannot be told apart from others
+ */
+bool hashShape(const IObject &shape, uint64_t &hash) {
+  Kernel::HashBuilder builder;
+  builder.add(std::string(typeid(shape).name()));
+  if (const auto *csgObject = dynamic_cast<const CSGObject *>(&shape)) {
+    const auto shapeXML = csgObject->getShapeXML();
+    hash = builder.add(shapeXML).value();
+    return !shapeXML.empty() || !csgObject->hasValidShape();
+  }
+  std::vector<uint32_t> triangles;
+  if (const auto *mesh = dynamic_cast<const MeshObject *>(&shape)) {
+    builder.add(mesh->getVertices());
+    triangles = mesh->getTriangles();
+  } else if (const auto *mesh2D = dynamic_cast<const MeshObject2D *>(&shape)) {
+    builder.add(mesh2D->getVertices());
+    triangles = mesh2D->getTriangles();
+  } else {
+    return false;
+  }
+  builder.add(static_cast<uint64_t>(triangles.size()));
+  hash = builder.add(triangles.data(), triangles.size() * sizeof(uint32_t))
+             .value();
+  return true;
+}
+} // namespace
+
+/** Constructor
+ * @param memoryLimit :: the maximum number of bytes held by the tables
+ */
+SolidAngleEngine::SolidAngleEngine(const size_t memoryLimit)
+    : m_tables(memoryLimit) {}
+
+/// @return the engine shared by all algorithms
+SolidAngleEngine &SolidAngleEngine::instance() {
+  static SolidAngleEngine engine(
+      Kernel::cacheMemoryLimit("SolidAngle.CacheSize", DEFAULT_CACHE_SIZE));
+  return engine;
+}
+
+/**
+ * Get the solid angles of all the detectors, computing them if no table is
+ * kept for the same geometry
+ * @param componentInfo :: the components of the instrument
+ * @param detectorInfo :: the detectors of the instrument
+ * @param observer :: the point the detectors are seen from
+ * @return the solid angle of each detector, NaN for detectors without a shape
+ */
+std::shared_ptr<const SolidAngleEngine::Table>
+SolidAngleEngine::solidAngles(const ComponentInfo &componentInfo,
+                              const DetectorInfo &detectorInfo,
+                              const Kernel::V3D &observer) {
+  uint64_t hash(0);
+  if (!geometryHash(componentInfo, detectorInfo, observer, hash)) {
+    return std::make_shared<const Table>(
+        calculate(componentInfo, detectorInfo, observer));
+  }
+  if (auto table = m_tables.find(hash))
+    return table;
+  auto table = std::make_shared<const Table>(
+      calculate(componentInfo, detectorInfo, observer));
+  // Another thread may have computed the same table meanwhile
+  if (auto existing = m_tables.find(hash))
+    return existing;
+  m_tables.insert(hash, table, table->size() * sizeof(double));
+  return table;
+}
+
+/// Drop all the tables
+void SolidAngleEngine::clear() { m_tables.clear(); }
+
+/// @return the number of tables
+size_t SolidAngleEngine::size() const { return m_tables.size(); }
+
+/// @return the number of bytes held by the tables
+size_t SolidAngleEngine::memory() const { return m_tables.memory(); }
+
+/**
+ * Compute the solid angles of all the detectors in parallel
+ * @param componentInfo :: the components of the instrument
+ * @param detectorInfo :: the detectors of the instrument
+ * @param observer :: the point the detectors are seen from
+ * @return the solid angle of each detector, NaN for detectors without a shape
+ */
+SolidAngleEngine::Table
+SolidAngleEngine::calculate(const ComponentInfo &componentInfo,
+                            const DetectorInfo &detectorInfo,
+                            const Kernel::V3D &observer) {
+  const auto ndets = static_cast<int64_t>(detectorInfo.size());
+  // Examine each shape once, before the parallel loop
+  std::vector<const ShapeKernel *> kernels(ndets, nullptr);
+  std::unordered_map<const IObject *, std::unique_ptr<const ShapeKernel>>
+      shapeKernels;
+  const V3D unitScale(1., 1., 1.);
+  for (int64_t i = 0; i < ndets; ++i) {
+    const auto index = static_cast<size_t>(i);
+    if (!componentInfo.hasValidShape(index) ||
+        (componentInfo.scaleFactor(index) - unitScale).norm() >= 1e-12)
+      continue;
+    const auto &shape = componentInfo.shape(index);
+    auto found = shapeKernels.find(&shape);
+    if (found == shapeKernels.end())
+      found = shapeKernels.emplace(&shape, ShapeKernel::create(shape)).first;
+    kernels[index] = found->second.get();
+  }
+
+  Table solidAngles(ndets, std::numeric_limits<double>::quiet_NaN());
+  std::exception_ptr error;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < ndets; ++i) {
+    const auto index = static_cast<size_t>(i);
+    try {
+      if (const auto *kernel = kernels[index]) {
+        // The observer in the frame of the shape
+        V3D relative = observer - componentInfo.position(index);
+        auto rotation = componentInfo.rotation(index);
+        rotation.inverse();
+        rotation.rotate(relative);
+        if (kernel->canCompute(relative)) {
+          solidAngles[index] = kernel->solidAngle(relative);
+          continue;
+        }
+      }
+      if (componentInfo.hasValidShape(index))
+        solidAngles[index] = componentInfo.solidAngle(index, observer);
+    } catch (...) {
+      PARALLEL_CRITICAL(SolidAngleEngine_calculate) {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+  return solidAngles;
+}
+
+/**
+ * Hash the point and the positions, rotations, scale factors and shapes of
+ * the detectors
+ * @param componentInfo :: the components of the instrument
+ * @param detectorInfo :: the detectors of the instrument
+ * @param observer :: the point the detectors are seen from
+ * @param[out] hash :: the hash of the geometry
+ * @return false if a shape cannot be told apart from others, so the solid
+ * angles must not be kept
+ */
+bool SolidAngleEngine::geometryHash(const ComponentInfo &componentInfo,
+                                    const DetectorInfo &detectorInfo,
+                                    const Kernel::V3D &observer,
+                                    uint64_t &hash) {
+  Kernel::HashBuilder builder;
+  builder.add(observer).add(static_cast<uint64_t>(detectorInfo.size()));
+  std::unordered_map<const IObject *, uint64_t> shapeHashes;
+  for (size_t i = 0; i < detectorInfo.size(); ++i) {
+    builder.add(componentInfo.position(i));
+    const auto rotation = componentInfo.rotation(i);
+    for (int j = 0; j < 4; ++j)
+      builder.add(rotation[j]);
+    builder.add(componentInfo.scaleFactor(i));
+    if (!componentInfo.hasValidShape(i)) {
+      builder.add(uint64_t(0));
+      continue;
+    }
+    const auto &shape = componentInfo.shape(i);
+    auto found = shapeHashes.find(&shape);
+    if (found == shapeHashes.end()) {
+      uint64_t shapeHash(0);
+      if (!hashShape(shape, shapeHash))
+        return false;
+      found = shapeHashes.emplace(&shape, shapeHash).first;
+    }
+    builder.add(found->second);
+  }
+  hash = builder.value();
+  return true;
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -5,6 +5,7 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/RayBatch.h"
 
 #include "MantidGeometry/Objects/Rules.h"
 #include "MantidGeometry/Objects/Track.h"
@@ -16,6 +17,7 @@
 #include "MantidGeometry/Surfaces/Cone.h"
 #include "MantidGeometry/Surfaces/Cylinder.h"
 #include "MantidGeometry/Surfaces/LineIntersectVisit.h"
+#include "MantidGeometry/Surfaces/Quadratic.h"
 #include "MantidGeometry/Surfaces/Surface.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
@@ -34,8 +36,10 @@
 #include <boost/accumulators/statistics/stats.hpp>
 #include <memory>
 
+#include <algorithm>
 #include <array>
 #include <deque>
+#include <limits>
 #include <random>
 #include <stack>
 #include <utility>
@@ -48,6 +52,55 @@ namespace {
 /// A shift to add/subtract to a point to test if it is an entry/exit point
 constexpr double VALID_INTERCEPT_POINT_SHIFT{2.5e-05};
 
+/// The number of rays of a batch crossed with the surfaces at a time
+constexpr size_t RAY_CHUNK_SIZE{256};
+
+/**
+ * Find the distances along a range of rays at which they cross a quadratic
+ * surface. The loop has no branches so that it can be vectorised.
+ * @param eqn :: the 10 coefficients of the equation of the surface
+ * @param rays :: the batch of rays
+ * @param begin :: the first ray of the range
+ * @param count :: the number of rays in the range
+ * @param[out] first :: the distance to a crossing of each ray, negative or not
+ * finite if there is none
+ * @param[out] second :: the distance to the other crossing of each ray
+ */
+void quadraticCrossings(const std::vector<double> &eqn, const RayBatch &rays,
+                        const size_t begin, const size_t count, double *first,
+                        double *second) {
+  std::array<double, 10> e;
+  std::copy(eqn.cbegin(), eqn.cbegin() + e.size(), e.begin());
+  const double *startX = rays.startX.data() + begin;
+  const double *startY = rays.startY.data() + begin;
+  const double *startZ = rays.startZ.data() + begin;
+  const double *directionX = rays.directionX.data() + begin;
+  const double *directionY = rays.directionY.data() + begin;
+  const double *directionZ = rays.directionZ.data() + begin;
+  for (size_t i = 0; i < count; ++i) {
+    const double x(startX[i]), y(startY[i]), z(startZ[i]);
+    const double dx(directionX[i]), dy(directionY[i]), dz(directionZ[i]);
+    // a t^2 + b t + c = 0 at the points start + t * direction on the surface
+    const double a = e[0] * dx * dx + e[1] * dy * dy + e[2] * dz * dz +
+                     e[3] * dx * dy + e[4] * dx * dz + e[5] * dy * dz;
+    const double b = 2. * (e[0] * x * dx + e[1] * y * dy + e[2] * z * dz) +
+                     e[3] * (x * dy + y * dx) + e[4] * (x * dz + z * dx) +
+                     e[5] * (y * dz + z * dy) + e[6] * dx + e[7] * dy +
+                     e[8] * dz;
+    const double c = e[0] * x * x + e[1] * y * y + e[2] * z * z +
+                     e[3] * x * y + e[4] * x * z + e[5] * y * z + e[6] * x +
+                     e[7] * y + e[8] * z + e[9];
+    const double discriminant = b * b - 4. * a * c;
+    // The stable form of the roots, which also gives the single crossing of
+    // a plane (a = 0) as c / q
+    const double q =
+        -0.5 * (b + std::copysign(std::sqrt(std::max(discriminant, 0.)), b));
+    const bool real = discriminant >= 0.;
+    first[i] = real ? q / a : -1.;
+    second[i] = real ? c / q : -1.;
+  }
+}
+
 /**
  * Find the solid angle of a triangle defined by vectors a,b,c from point
  *"observer"
@@ -1151,6 +1204,72 @@ double CSGObject::distance(const Geometry::Track &track) const {
   }
 }
 
+/**
+ * Find the lengths of the paths of many rays inside the object. The quadratic
+ * surfaces are crossed with a chunk of the rays at a time, then each part of
+ * a ray between consecutive crossings is inside the object if its midpoint
+ * is. An object with other surfaces traces each ray with interceptSurface.
+ * @param rays :: the start points and unit directions of the rays
+ * @param[out] lengths :: the total length of each ray inside the object
+ */
+void CSGObject::pathLengths(const RayBatch &rays,
+                            std::vector<double> &lengths) const {
+  lengths.assign(rays.size(), 0.);
+  std::vector<const Quadratic *> quadratics;
+  quadratics.reserve(m_SurList.size());
+  for (const auto *surface : m_SurList) {
+    const auto *quadratic = dynamic_cast<const Quadratic *>(surface);
+    if (!quadratic) {
+      for (size_t i = 0; i < rays.size(); ++i) {
+        Track track(V3D(rays.startX[i], rays.startY[i], rays.startZ[i]),
+                    V3D(rays.directionX[i], rays.directionY[i],
+                        rays.directionZ[i]));
+        interceptSurface(track);
+        for (auto link = track.cbegin(); link != track.cend(); ++link)
+          lengths[i] += link->distInsideObject;
+      }
+      return;
+    }
+    quadratics.emplace_back(quadratic);
+  }
+
+  const size_t numRows = 2 * quadratics.size();
+  std::vector<double> crossings(numRows * RAY_CHUNK_SIZE);
+  std::vector<double> distances;
+  distances.reserve(numRows);
+  for (size_t begin = 0; begin < rays.size(); begin += RAY_CHUNK_SIZE) {
+    const size_t count = std::min(RAY_CHUNK_SIZE, rays.size() - begin);
+    for (size_t i = 0; i < quadratics.size(); ++i) {
+      double *first = crossings.data() + 2 * i * RAY_CHUNK_SIZE;
+      quadraticCrossings(quadratics[i]->copyBaseEqn(), rays, begin, count,
+                         first, first + RAY_CHUNK_SIZE);
+    }
+    for (size_t i = 0; i < count; ++i) {
+      distances.clear();
+      for (size_t row = 0; row < numRows; ++row) {
+        const double distance = crossings[row * RAY_CHUNK_SIZE + i];
+        if (distance > 0. && distance < std::numeric_limits<double>::max())
+          distances.emplace_back(distance);
+      }
+      std::sort(distances.begin(), distances.end());
+      const size_t ray = begin + i;
+      const V3D start(rays.startX[ray], rays.startY[ray], rays.startZ[ray]);
+      const V3D direction(rays.directionX[ray], rays.directionY[ray],
+                          rays.directionZ[ray]);
+      double previous(0.), length(0.);
+      for (const auto distance : distances) {
+        // Crossings closer than the tolerance are taken as one
+        if (distance - previous < Tolerance)
+          continue;
+        if (isValid(start + direction * (0.5 * (previous + distance))))
+          length += distance - previous;
+        previous = distance;
+      }
+      lengths[ray] = length;
+    }
+  }
+}
+
 /**
  * Calculate if a point PT is a valid point on the track
  * @param point :: Point to calculate from.
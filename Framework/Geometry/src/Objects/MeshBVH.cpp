@@ -0,0 +1,187 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/MeshBVH.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace Mantid {
+namespace Geometry {
+
+namespace {
+/// Nodes with no more than this many triangles are not split
+constexpr uint32_t LEAF_SIZE = 4;
+/// Padding of the boxes, as a fraction of the diagonal of the mesh
+constexpr double PADDING = 1e-6;
+/// Larger than the depth of any hierarchy of 2^32 triangles
+constexpr size_t MAX_DEPTH = 64;
+} // namespace
+
+/**
+ * Build the hierarchy of the triangles of a mesh
+ * @param triangles :: the indexes of the three vertices of each triangle
+ * @param vertices :: the vertices of the mesh
+ */
+MeshBVH::MeshBVH(const std::vector<uint32_t> &triangles,
+                 const std::vector<Kernel::V3D> &vertices) {
+  const auto numTriangles = static_cast<uint32_t>(triangles.size() / 3);
+  if (numTriangles == 0)
+    return;
+
+  std::vector<std::array<double, 6>> bounds(numTriangles);
+  std::vector<std::array<double, 3>> centres(numTriangles);
+  std::array<double, 3> low, high;
+  low.fill(std::numeric_limits<double>::max());
+  high.fill(std::numeric_limits<double>::lowest());
+  for (uint32_t i = 0; i < numTriangles; ++i) {
+    const auto &v1 = vertices[triangles[3 * i]];
+    const auto &v2 = vertices[triangles[3 * i + 1]];
+    const auto &v3 = vertices[triangles[3 * i + 2]];
+    for (size_t d = 0; d < 3; ++d) {
+      bounds[i][d] = std::min({v1[d], v2[d], v3[d]});
+      bounds[i][d + 3] = std::max({v1[d], v2[d], v3[d]});
+      centres[i][d] = 0.5 * (bounds[i][d] + bounds[i][d + 3]);
+      low[d] = std::min(low[d], bounds[i][d]);
+      high[d] = std::max(high[d], bounds[i][d + 3]);
+    }
+  }
+  double diagonalSquared = 0.;
+  for (size_t d = 0; d < 3; ++d)
+    diagonalSquared += (high[d] - low[d]) * (high[d] - low[d]);
+  m_padding = PADDING * std::sqrt(diagonalSquared);
+
+  m_triangles.resize(numTriangles);
+  std::iota(m_triangles.begin(), m_triangles.end(), 0);
+  m_nodes.reserve(2 * (numTriangles / LEAF_SIZE + 1));
+  build(0, numTriangles, bounds, centres);
+}
+
+/**
+ * Find the triangles whose boxes are crossed by a ray. The triangles crossed
+ * by the ray are among them.
+ * @param start :: the start of the ray
+ * @param direction :: the unit direction of the ray
+ * @param[out] candidates :: the indexes of the triangles, in increasing order
+ */
+void MeshBVH::findCandidates(const Kernel::V3D &start,
+                             const Kernel::V3D &direction,
+                             std::vector<uint32_t> &candidates) const {
+  candidates.clear();
+  if (m_nodes.empty())
+    return;
+  const std::array<double, 3> origin{{start.X(), start.Y(), start.Z()}};
+  const std::array<double, 3> dir{
+      {direction.X(), direction.Y(), direction.Z()}};
+
+  std::array<uint32_t, MAX_DEPTH> stack;
+  size_t stackSize = 0;
+  stack[stackSize++] = 0;
+  while (stackSize > 0) {
+    const auto index = stack[--stackSize];
+    const auto &node = m_nodes[index];
+    if (!intersects(node, origin, dir))
+      continue;
+    if (node.count > 0) {
+      candidates.insert(candidates.end(), m_triangles.begin() + node.first,
+                        m_triangles.begin() + node.first + node.count);
+    } else {
+      stack[stackSize++] = node.first;
+      stack[stackSize++] = index + 1;
+    }
+  }
+  // Keep the order of the triangles in the mesh, so the intersections are
+  // found in the same order as by testing every triangle
+  std::sort(candidates.begin(), candidates.end());
+}
+
+/**
+ * Add the node of a range of triangles, then the nodes below it
+ * @param begin :: the first triangle of the range in m_triangles
+ * @param end :: one past the last triangle of the range
+ * @param bounds :: the minimum and maximum of each triangle on each axis
+ * @param centres :: the centre of the box of each triangle
+ */
+void MeshBVH::build(uint32_t begin, uint32_t end,
+                    const std::vector<std::array<double, 6>> &bounds,
+                    const std::vector<std::array<double, 3>> &centres) {
+  Node node;
+  node.min.fill(std::numeric_limits<double>::max());
+  node.max.fill(std::numeric_limits<double>::lowest());
+  std::array<double, 3> centreMin = node.min, centreMax = node.max;
+  for (auto i = begin; i < end; ++i) {
+    const auto triangle = m_triangles[i];
+    for (size_t d = 0; d < 3; ++d) {
+      node.min[d] = std::min(node.min[d], bounds[triangle][d]);
+      node.max[d] = std::max(node.max[d], bounds[triangle][d + 3]);
+      centreMin[d] = std::min(centreMin[d], centres[triangle][d]);
+      centreMax[d] = std::max(centreMax[d], centres[triangle][d]);
+    }
+  }
+  for (size_t d = 0; d < 3; ++d) {
+    node.min[d] -= m_padding;
+    node.max[d] += m_padding;
+  }
+  const auto index = m_nodes.size();
+  if (end - begin <= LEAF_SIZE) {
+    node.first = begin;
+    node.count = end - begin;
+    m_nodes.emplace_back(node);
+    return;
+  }
+  node.count = 0;
+  m_nodes.emplace_back(node);
+
+  size_t axis = 0;
+  for (size_t d = 1; d < 3; ++d)
+    if (centreMax[d] - centreMin[d] > centreMax[axis] - centreMin[axis])
+      axis = d;
+  const auto middle = begin + (end - begin) / 2;
+  std::nth_element(m_triangles.begin() + begin, m_triangles.begin() + middle,
+                   m_triangles.begin() + end,
+                   [&centres, axis](uint32_t a, uint32_t b) {
+                     return centres[a][axis] < centres[b][axis];
+                   });
+  build(begin, middle, bounds, centres);
+  m_nodes[index].first = static_cast<uint32_t>(m_nodes.size());
+  build(middle, end, bounds, centres);
+}
+
+/**
+ * Check if a ray crosses the box of a node, by the slab method
+ * @param node :: the node to check
+ * @param start :: the start of the ray
+ * @param direction :: the direction of the ray
+ * @return true if the ray crosses the box in front of its start, or starts
+ * inside it
+ */
+bool MeshBVH::intersects(const Node &node, const std::array<double, 3> &start,
+                         const std::array<double, 3> &direction) const {
+  double tEnter = std::numeric_limits<double>::lowest();
+  double tExit = std::numeric_limits<double>::max();
+  for (size_t d = 0; d < 3; ++d) {
+    if (direction[d] == 0.) {
+      if (start[d] < node.min[d] || start[d] > node.max[d])
+        return false;
+      continue;
+    }
+    const double inverse = 1. / direction[d];
+    double entry = (node.min[d] - start[d]) * inverse;
+    double leave = (node.max[d] - start[d]) * inverse;
+    if (entry > leave)
+      std::swap(entry, leave);
+    tEnter = std::max(tEnter, entry);
+    tExit = std::min(tExit, leave);
+    if (tEnter > tExit)
+      return false;
+  }
+  return tExit >= 0.;
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -182,7 +182,10 @@ int MeshObject::interceptSurface(Geometry::Track &UT) const {
 double MeshObject::distance(const Track &track) const {
   Kernel::V3D vertex1, vertex2, vertex3, intersection;
   TrackDirection unused;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  std::vector<uint32_t> candidates;
+  getBVH().findCandidates(track.startPoint(), track.direction(), candidates);
+  for (const auto index : candidates) {
+    getTriangle(index, vertex1, vertex2, vertex3);
     if (MeshObjectCommon::rayIntersectsTriangle(
             track.startPoint(), track.direction(), vertex1, vertex2, vertex3,
             intersection, unused)) {
@@ -196,7 +199,8 @@ double MeshObject::distance(const Track &track) const {
 }
 
 /**
- * Get intersection points and their in out directions on the given ray
+ * Get intersection points and their in out directions on the given ray. Only
+ * the triangles whose boxes in the hierarchy are crossed are tested.
  * @param start :: Start point of ray
  * @param direction :: Direction of ray
  * @param intersectionPoints :: Intersection points (not sorted)
@@ -209,7 +213,10 @@ void MeshObject::getIntersections(
 
   Kernel::V3D vertex1, vertex2, vertex3, intersection;
   TrackDirection entryExit;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  std::vector<uint32_t> candidates;
+  getBVH().findCandidates(start, direction, candidates);
+  for (const auto index : candidates) {
+    getTriangle(index, vertex1, vertex2, vertex3);
     if (MeshObjectCommon::rayIntersectsTriangle(start, direction, vertex1,
                                                 vertex2, vertex3, intersection,
                                                 entryExit)) {
@@ -220,6 +227,32 @@ void MeshObject::getIntersections(
   // still need to deal with edge cases
 }
 
+/**
+ * Get the bounding volume hierarchy of the triangles. It is built by the
+ * first call after the mesh is created or moved, from one thread only.
+ * @returns the hierarchy of the triangles
+ */
+const MeshBVH &MeshObject::getBVH() const {
+  if (!m_bvhBuilt.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(m_bvhMutex);
+    if (!m_bvh)
+      m_bvh = std::make_unique<MeshBVH>(m_triangles, m_vertices);
+    m_bvhBuilt.store(true, std::memory_order_release);
+  }
+  return *m_bvh;
+}
+
+/**
+ * Drop the bounding box and the hierarchy of the triangles, so they are
+ * computed again for the new position of the vertices
+ */
+void MeshObject::clearCache() {
+  m_boundingBox = BoundingBox();
+  std::lock_guard<std::mutex> lock(m_bvhMutex);
+  m_bvh.reset();
+  m_bvhBuilt.store(false, std::memory_order_release);
+}
+
 /*
  * Get a triangle - useful for iterating over triangles
  * @param index :: Index of triangle in MeshObject
@@ -499,6 +532,7 @@ void MeshObject::rotate(const Kernel::Matrix<double> &rotationMatrix) {
   for (Kernel::V3D &vertex : m_vertices) {
     vertex.rotate(rotationMatrix);
   }
+  clearCache();
 }
 
 /**
@@ -509,6 +543,7 @@ void MeshObject::translate(const Kernel::V3D &translationVector) {
   for (Kernel::V3D &vertex : m_vertices) {
     vertex += translationVector;
   }
+  clearCache();
 }
 
 /**
@@ -519,6 +554,7 @@ void MeshObject::scale(const double scaleFactor) {
   for (Kernel::V3D &vertex : m_vertices) {
     vertex *= scaleFactor;
   }
+  clearCache();
 }
 
 /**
@@ -544,6 +580,7 @@ void MeshObject::multiply(const Kernel::Matrix<double> &matrix) {
     Kernel::V3D newvertex(vertexout[0], vertexout[1], vertexout[2]);
     vertex = newvertex;
   }
+  clearCache();
 }
 
 /**
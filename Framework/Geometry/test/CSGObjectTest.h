@@ -9,6 +9,7 @@
 #include "MantidGeometry/Objects/CSGObject.h"
 
 #include "MantidGeometry/Math/Algebra.h"
+#include "MantidGeometry/Objects/RayBatch.h"
 #include "MantidGeometry/Objects/Rules.h"
 #include "MantidGeometry/Objects/ShapeFactory.h"
 #include "MantidGeometry/Objects/Track.h"
@@ -30,6 +31,9 @@
 #include <Poco/DOM/AutoPtr.h>
 #include <Poco/DOM/Document.h>
 
+#include <limits>
+#include <random>
+
 using namespace Mantid;
 using namespace Geometry;
 using detail::ShapeInfo;
@@ -441,6 +445,66 @@ public:
     TS_ASSERT_THROWS(geom_obj->distance(track), const std::runtime_error &)
   }
 
+  void testPathLengthsFromInsideAndOutside() {
+    auto geom_obj = createCappedCylinder();
+    RayBatch rays;
+    rays.add(V3D(0, 0, 0), V3D(0, 1, 0));
+    rays.add(V3D(-10, 0, 0), V3D(1, 0, 0));
+    rays.add(V3D(-10, 0, 0), V3D(-1, 0, 0));
+    std::vector<double> lengths;
+    geom_obj->pathLengths(rays, lengths);
+    TS_ASSERT_EQUALS(lengths.size(), 3);
+    TS_ASSERT_DELTA(lengths[0], 3.0, 1e-8);
+    TS_ASSERT_DELTA(lengths[1], 4.4, 1e-8);
+    TS_ASSERT_DELTA(lengths[2], 0.0, 1e-8);
+  }
+
+  void testPathLengthsOfManyRays() {
+    auto sphere = ComponentCreationHelper::createSphere(1.0);
+    auto shell = ComponentCreationHelper::createHollowShell(0.5, 1.0);
+    auto cuboid = ComponentCreationHelper::createCuboid(0.5, 1.0, 1.5);
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> position(-2., 2.);
+    std::normal_distribution<double> normal;
+    RayBatch rays;
+    // More rays than are crossed with the surfaces at a time
+    for (size_t i = 0; i < 1000; ++i) {
+      V3D direction(normal(gen), normal(gen), normal(gen));
+      direction.normalize();
+      rays.add(V3D(position(gen), position(gen), position(gen)), direction);
+    }
+    std::vector<double> sphereLengths, shellLengths, cuboidLengths;
+    sphere->pathLengths(rays, sphereLengths);
+    shell->pathLengths(rays, shellLengths);
+    cuboid->pathLengths(rays, cuboidLengths);
+    TS_ASSERT_EQUALS(sphereLengths.size(), rays.size());
+    TS_ASSERT_EQUALS(shellLengths.size(), rays.size());
+    TS_ASSERT_EQUALS(cuboidLengths.size(), rays.size());
+
+    size_t numCrossing(0);
+    for (size_t i = 0; i < rays.size(); ++i) {
+      const V3D start(rays.startX[i], rays.startY[i], rays.startZ[i]);
+      const V3D direction(rays.directionX[i], rays.directionY[i],
+                          rays.directionZ[i]);
+      const double inSphere = chordAhead(start, direction, 1.0);
+      TS_ASSERT_DELTA(sphereLengths[i], inSphere, 1e-8);
+      TS_ASSERT_DELTA(shellLengths[i],
+                      inSphere - chordAhead(start, direction, 0.5), 1e-8);
+      double enter(0.), exit(std::numeric_limits<double>::max());
+      const V3D halfSides(0.5, 1.0, 1.5);
+      for (size_t d = 0; d < 3; ++d) {
+        const double a = (-halfSides[d] - start[d]) / direction[d];
+        const double b = (halfSides[d] - start[d]) / direction[d];
+        enter = std::max(enter, std::min(a, b));
+        exit = std::min(exit, std::max(a, b));
+      }
+      TS_ASSERT_DELTA(cuboidLengths[i], std::max(exit - enter, 0.), 1e-8);
+      if (inSphere > 0.)
+        ++numCrossing;
+    }
+    TS_ASSERT_LESS_THAN(100, numCrossing);
+  }
+
   void testTrackTwoIsolatedCubes()
   /**
   Test a track going through an object
@@ -1316,6 +1380,18 @@ private:
 
   STYPE SMap; ///< Surface Map
 
+  /// The length of a ray inside a sphere of the given radius at the origin
+  double chordAhead(const V3D &start, const V3D &direction,
+                    const double radius) {
+    const double b = start.scalar_prod(direction);
+    const double discriminant =
+        b * b - start.scalar_prod(start) + radius * radius;
+    if (discriminant <= 0.)
+      return 0.;
+    const double exit = -b + std::sqrt(discriminant);
+    return std::max(exit - std::max(-b - std::sqrt(discriminant), 0.), 0.);
+  }
+
   std::shared_ptr<CSGObject> createCappedCylinder() {
     std::string C31 = "cx 3.0"; // cylinder x-axis radius 3
     std::string C32 = "px 1.2";
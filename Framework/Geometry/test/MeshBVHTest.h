@@ -0,0 +1,110 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/Objects/MeshBVH.h"
+#include "MantidGeometry/Objects/MeshObjectCommon.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <random>
+
+using Mantid::Geometry::MeshBVH;
+using Mantid::Geometry::TrackDirection;
+using Mantid::Kernel::V3D;
+
+class MeshBVHTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MeshBVHTest *createSuite() { return new MeshBVHTest(); }
+  static void destroySuite(MeshBVHTest *suite) { delete suite; }
+
+  void test_empty_mesh_has_no_candidates() {
+    const MeshBVH bvh({}, {});
+    std::vector<uint32_t> candidates{1};
+    bvh.findCandidates(V3D(0, 0, 0), V3D(1, 0, 0), candidates);
+    TS_ASSERT(candidates.empty());
+    TS_ASSERT_EQUALS(bvh.numberOfNodes(), 0);
+  }
+
+  void test_candidates_include_every_crossed_triangle() {
+    std::vector<uint32_t> triangles;
+    std::vector<V3D> vertices;
+    makeGrid(triangles, vertices);
+    const MeshBVH bvh(triangles, vertices);
+    TS_ASSERT_LESS_THAN(1, bvh.numberOfNodes());
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> position(-1., 21.);
+    std::normal_distribution<double> normal;
+    std::vector<uint32_t> candidates;
+    size_t numCandidates = 0, numCrossed = 0;
+    for (int ray = 0; ray < 200; ++ray) {
+      const V3D start(position(gen), position(gen), position(gen));
+      V3D direction(normal(gen), normal(gen), normal(gen));
+      direction.normalize();
+      bvh.findCandidates(start, direction, candidates);
+      TS_ASSERT(std::is_sorted(candidates.begin(), candidates.end()));
+      numCandidates += candidates.size();
+
+      V3D intersection;
+      TrackDirection entryExit;
+      for (uint32_t i = 0; i < triangles.size() / 3; ++i) {
+        if (Mantid::Geometry::MeshObjectCommon::rayIntersectsTriangle(
+                start, direction, vertices[triangles[3 * i]],
+                vertices[triangles[3 * i + 1]], vertices[triangles[3 * i + 2]],
+                intersection, entryExit)) {
+          ++numCrossed;
+          TS_ASSERT(std::binary_search(candidates.begin(), candidates.end(),
+                                       i));
+        }
+      }
+    }
+    TS_ASSERT_LESS_THAN(0, numCrossed);
+    // Far fewer triangles than the whole mesh are tested
+    TS_ASSERT_LESS_THAN(numCandidates, 200 * triangles.size() / 3 / 10);
+  }
+
+  void test_ray_along_face_finds_its_triangles() {
+    std::vector<uint32_t> triangles;
+    std::vector<V3D> vertices;
+    makeGrid(triangles, vertices);
+    const MeshBVH bvh(triangles, vertices);
+    std::vector<uint32_t> candidates;
+    // Along the plane z = 0 of the first layer, with zero direction components
+    bvh.findCandidates(V3D(-5, 0.5, 0), V3D(1, 0, 0), candidates);
+    TS_ASSERT(!candidates.empty());
+    bvh.findCandidates(V3D(-5, 0.5, 0), V3D(-1, 0, 0), candidates);
+    TS_ASSERT(candidates.empty());
+  }
+
+private:
+  /// Make a 20x20x20 grid of unit squares in planes of constant z
+  static void makeGrid(std::vector<uint32_t> &triangles,
+                       std::vector<V3D> &vertices) {
+    const uint32_t n = 20;
+    for (uint32_t z = 0; z < n; ++z)
+      for (uint32_t y = 0; y <= n; ++y)
+        for (uint32_t x = 0; x <= n; ++x)
+          vertices.emplace_back(V3D(x, y, z));
+    const auto vertex = [n](uint32_t x, uint32_t y, uint32_t z) {
+      return (z * (n + 1) + y) * (n + 1) + x;
+    };
+    for (uint32_t z = 0; z < n; ++z)
+      for (uint32_t y = 0; y < n; ++y)
+        for (uint32_t x = 0; x < n; ++x) {
+          triangles.insert(triangles.end(),
+                           {vertex(x, y, z), vertex(x + 1, y, z),
+                            vertex(x + 1, y + 1, z)});
+          triangles.insert(triangles.end(),
+                           {vertex(x, y, z), vertex(x + 1, y + 1, z),
+                            vertex(x, y + 1, z)});
+        }
+  }
+};
@@ -984,6 +984,24 @@ public:
     auto moved = octahedron->getVertices();
     TS_ASSERT_DELTA(moved, checkVector, 1e-8);
   }
+
+  void testInterceptAfterTranslation() {
+    auto cube = createCube(1.0);
+    Track before(V3D(-10, 0.5, 0.5), V3D(1, 0, 0));
+    TS_ASSERT_EQUALS(cube->interceptSurface(before), 1);
+    TS_ASSERT(cube->isValid(V3D(0.5, 0.5, 0.5)));
+
+    // The cached bounding box and triangle hierarchy follow the mesh
+    cube->translate(V3D(0, 5, 0));
+    TS_ASSERT_DELTA(cube->getBoundingBox().yMin(), 5.0, 1e-10);
+    Track missed(V3D(-10, 0.5, 0.5), V3D(1, 0, 0));
+    TS_ASSERT_EQUALS(cube->interceptSurface(missed), 0);
+    Track after(V3D(-10, 5.5, 0.5), V3D(1, 0, 0));
+    TS_ASSERT_EQUALS(cube->interceptSurface(after), 1);
+    TS_ASSERT_DELTA(after.cbegin()->distInsideObject, 1.0, 1e-10);
+    TS_ASSERT(!cube->isValid(V3D(0.5, 0.5, 0.5)));
+    TS_ASSERT(cube->isValid(V3D(0.5, 5.5, 0.5)));
+  }
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,153 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/InstrumentVisitor.h"
+#include "MantidGeometry/Instrument/SolidAngleEngine.h"
+#include "MantidKernel/Quat.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <cmath>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::Quat;
+using Mantid::Kernel::V3D;
+
+class SolidAngleEngineTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SolidAngleEngineTest *createSuite() {
+    return new SolidAngleEngineTest();
+  }
+  static void destroySuite(SolidAngleEngineTest *suite) { delete suite; }
+
+  void test_solid_angles_match_those_of_the_shapes() {
+    const auto instrument = createInstrument();
+    const auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    const auto &componentInfo = *wrappers.first;
+    const auto &detectorInfo = *wrappers.second;
+    const auto observer = detectorInfo.samplePosition();
+
+    const auto solidAngles =
+        SolidAngleEngine::calculate(componentInfo, detectorInfo, observer);
+    TS_ASSERT_EQUALS(solidAngles.size(), detectorInfo.size());
+    for (size_t i = 0; i < detectorInfo.size(); ++i) {
+      if (!componentInfo.hasValidShape(i)) {
+        TS_ASSERT(std::isnan(solidAngles[i]));
+        continue;
+      }
+      const double expected = componentInfo.solidAngle(i, observer);
+      TS_ASSERT_LESS_THAN(0., expected);
+      TS_ASSERT_DELTA(solidAngles[i], expected, 1e-12 * expected);
+    }
+    // Inside the bounding box of the first detector
+    const auto inside =
+        SolidAngleEngine::calculate(componentInfo, detectorInfo, V3D(1, 0, 2));
+    TS_ASSERT_DELTA(inside[0], 4. * M_PI, 1e-12);
+  }
+
+  void test_tables_are_kept_for_the_same_geometry() {
+    const auto instrument = createInstrument();
+    const auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    auto &componentInfo = *wrappers.first;
+    const auto &detectorInfo = *wrappers.second;
+    const V3D observer(0, 0, 0);
+
+    SolidAngleEngine engine(1 << 20);
+    const auto first =
+        engine.solidAngles(componentInfo, detectorInfo, observer);
+    TS_ASSERT_EQUALS(engine.size(), 1);
+    TS_ASSERT_EQUALS(engine.memory(), detectorInfo.size() * sizeof(double));
+    TS_ASSERT_EQUALS(engine.solidAngles(componentInfo, detectorInfo, observer),
+                     first);
+
+    // The same geometry in another instrument shares the table
+    const auto other = createInstrument();
+    const auto otherWrappers = InstrumentVisitor::makeWrappers(*other);
+    TS_ASSERT_EQUALS(engine.solidAngles(*otherWrappers.first,
+                                        *otherWrappers.second, observer),
+                     first);
+
+    TS_ASSERT_DIFFERS(
+        engine.solidAngles(componentInfo, detectorInfo, V3D(0, 0, 0.1)),
+        first);
+    componentInfo.setPosition(1, V3D(0, 2, 2));
+    const auto moved =
+        engine.solidAngles(componentInfo, detectorInfo, observer);
+    TS_ASSERT_DIFFERS(moved, first);
+    TS_ASSERT_DELTA((*moved)[1], componentInfo.solidAngle(1, observer),
+                    1e-12);
+    TS_ASSERT_EQUALS(engine.size(), 3);
+    engine.clear();
+    TS_ASSERT_EQUALS(engine.size(), 0);
+    TS_ASSERT_EQUALS(engine.memory(), 0);
+  }
+
+  void test_least_recently_used_tables_are_dropped() {
+    const auto instrument = createInstrument();
+    const auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+    const auto &componentInfo = *wrappers.first;
+    const auto &detectorInfo = *wrappers.second;
+
+    SolidAngleEngine engine(2 * detectorInfo.size() * sizeof(double));
+    const auto first =
+        engine.solidAngles(componentInfo, detectorInfo, V3D(0, 0, 0));
+    engine.solidAngles(componentInfo, detectorInfo, V3D(0, 0, 0.1));
+    engine.solidAngles(componentInfo, detectorInfo, V3D(0, 0, 0));
+    engine.solidAngles(componentInfo, detectorInfo, V3D(0, 0, 0.2));
+    TS_ASSERT_EQUALS(engine.size(), 2);
+    TS_ASSERT_EQUALS(
+        engine.solidAngles(componentInfo, detectorInfo, V3D(0, 0, 0)), first);
+
+    SolidAngleEngine tooSmall(0);
+    tooSmall.solidAngles(componentInfo, detectorInfo, V3D(0, 0, 0));
+    TS_ASSERT_EQUALS(tooSmall.size(), 0);
+  }
+
+private:
+  /// An instrument with rotated detectors of each shape with a kernel, one
+  /// of a shape without and one with no shape
+  static Instrument_sptr createInstrument() {
+    auto instrument = std::make_shared<Instrument>("SolidAngleEngineTest");
+    auto source = new ObjComponent("source");
+    source->setPos(V3D(0, 0, -10));
+    instrument->add(source);
+    instrument->markAsSource(source);
+    auto sample = new ObjComponent("sample");
+    instrument->add(sample);
+    instrument->markAsSamplePos(sample);
+
+    const std::vector<std::pair<IObject_sptr, V3D>> shapes{
+        {ComponentCreationHelper::createCuboid(0.01, 0.02, 0.03),
+         V3D(1, 0, 2)},
+        {ComponentCreationHelper::createCappedCylinder(
+             0.004, 0.05, V3D(0, -0.025, 0), V3D(0, 1, 0), "tube"),
+         V3D(-1, 0.5, 2)},
+        {ComponentCreationHelper::createSphere(0.02, V3D(0.01, 0, 0)),
+         V3D(0, -1, 3)},
+        {ComponentCreationHelper::createHollowShell(0.01, 0.02),
+         V3D(0.5, 0.5, -2)},
+        {nullptr, V3D(-0.5, 0.5, -2)}};
+    int id(1);
+    for (const auto &shape : shapes) {
+      auto detector = new Detector("pixel", id, shape.first, nullptr);
+      detector->setPos(shape.second);
+      detector->setRot(Quat(10. * id, V3D(1, 2, 3)));
+      instrument->add(detector);
+      instrument->markAsDetector(detector);
+      ++id;
+    }
+    return instrument;
+  }
+};
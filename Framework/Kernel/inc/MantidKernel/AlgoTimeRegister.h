@@ -0,0 +1,104 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MantidKernel/DllConfig.h"
+
+namespace Mantid {
+namespace Instrumentation {
+
+/** AlgoTimeRegister : simple class to dump information about executed
+ * algorithms and the tasks they run.
+ *
+ * Each Dump records a span from its construction to its destruction. Spans
+ * opened on the same thread nest, so child algorithms and thread pool tasks
+ * appear within their parent. Recording is off until enable() is called, which
+ * is done when Mantid is built with PROFILE_ALGORITHM_LINUX.
+ *
+ * On destruction the register writes the spans to ./algotimeregister.out, as
+ * plain text, and to ./algotimeregister.json, in the Chrome trace event
+ * format that chrome://tracing and Perfetto can open.
+ */
+class MANTID_KERNEL_DLL AlgoTimeRegister {
+public:
+  using clock = std::chrono::steady_clock;
+
+  static AlgoTimeRegister globalAlgoTimeRegister;
+
+  struct Info {
+    std::string m_name;
+    std::string m_category;
+    std::thread::id m_threadId;
+    clock::time_point m_begin;
+    clock::time_point m_end;
+    /// Bytes read from file within the span
+    uint64_t m_bytes;
+    /// Events processed within the span
+    uint64_t m_events;
+
+    Info(const std::string &nm, const std::string &cat,
+         const std::thread::id &id, const clock::time_point &be,
+         const clock::time_point &en, uint64_t bytes, uint64_t events)
+        : m_name(nm), m_category(cat), m_threadId(id), m_begin(be), m_end(en),
+          m_bytes(bytes), m_events(events) {}
+  };
+
+  class MANTID_KERNEL_DLL Dump {
+    AlgoTimeRegister &m_algoTimeRegister;
+    clock::time_point m_regStart;
+    const std::string m_name;
+    const std::string m_category;
+    /// The enclosing span on this thread, if any
+    Dump *m_parent;
+    uint64_t m_bytes;
+    uint64_t m_events;
+    bool m_active;
+
+  public:
+    Dump(AlgoTimeRegister &atr, const std::string &nm,
+         const std::string &cat = "algorithm");
+    Dump(const Dump &) = delete;
+    Dump &operator=(const Dump &) = delete;
+    ~Dump();
+
+    friend class AlgoTimeRegister;
+  };
+
+  AlgoTimeRegister();
+  ~AlgoTimeRegister();
+
+  void enable(bool on = true);
+  /// @return true if spans are being recorded
+  bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+  static void addBytesRead(uint64_t bytes);
+  static void addEventsProcessed(uint64_t events);
+
+  std::vector<Info> info();
+  void clear();
+  void writeTrace(std::ostream &os);
+  void writeText(std::ostream &os);
+
+private:
+  std::atomic<bool> m_enabled;
+  std::mutex m_mutex;
+  std::vector<Info> m_info;
+  clock::time_point m_hstart;
+  std::chrono::system_clock::time_point m_start;
+};
+
+} // namespace Instrumentation
+} // namespace Mantid
@@ -0,0 +1,65 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** BinEdgeLookup : Finds the bin containing a value for a given set of bin
+  edges.
+
+  On construction the edges are inspected once. Edges produced from linear or
+  logarithmic rebin parameters (see VectorHelper::createAxisFromRebinParams)
+  let the bin index be computed arithmetically; any other edges are searched.
+  The arithmetic index is always checked against the edges themselves, so the
+  result is identical to a search whatever rounding went into the edges.
+
+  Bin i covers [edges[i], edges[i+1]); values outside [edges.front(),
+  edges.back()) have no bin. The edges must outlive the lookup.
+*/
+class MANTID_KERNEL_DLL BinEdgeLookup {
+public:
+  /// How the bin edges are spaced
+  enum class Spacing { Linear, Logarithmic, Arbitrary };
+  /// Returned for values outside the edges
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  explicit BinEdgeLookup(const std::vector<double> &edges);
+
+  /// @return how the edges are spaced
+  Spacing spacing() const { return m_spacing; }
+  /// @return true if the bin index is computed rather than searched for
+  bool isArithmetic() const { return m_spacing != Spacing::Arbitrary; }
+  /// @return the number of bins
+  std::size_t numberOfBins() const { return m_numBins; }
+
+  std::size_t bin(const double x) const;
+  void bins(const double *x, const std::size_t n, std::size_t *indices) const;
+
+private:
+  std::size_t correct(const double x, std::size_t guess) const;
+  std::size_t search(const double x, const std::size_t hint) const;
+
+  /// The bin edges, not owned
+  const std::vector<double> &m_edges;
+  /// Number of bins, one less than the number of edges (or 0)
+  std::size_t m_numBins;
+  /// Spacing found on construction
+  Spacing m_spacing;
+  /// First edge, or its log for logarithmic spacing
+  double m_origin;
+  /// Inverse bin width, or inverse log of the bin ratio
+  double m_inverseStep;
+};
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,45 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+class V3D;
+
+/** HashBuilder : Builds a 64 bit FNV-1a hash of the values added to it, in
+  order. The hash depends only on the bytes of the values, so it is the same
+  on every run and can name data kept between sessions. Strings and vectors
+  are added with their length, so that consecutive values do not run into
+  each other.
+
+  It is the key of the caches kept in a Kernel::LRUCache, which are found by
+  the hash of everything their values depend on.
+*/
+class MANTID_KERNEL_DLL HashBuilder {
+public:
+  HashBuilder &add(const void *data, const size_t size);
+  HashBuilder &add(const double value) { return add(&value, sizeof(value)); }
+  HashBuilder &add(const uint64_t value) { return add(&value, sizeof(value)); }
+  HashBuilder &add(const std::string &value);
+  HashBuilder &add(const V3D &value);
+  HashBuilder &add(const std::vector<double> &values);
+  /// @return the hash of the values added so far
+  uint64_t value() const { return m_value; }
+
+private:
+  uint64_t m_value{14695981039346656037ull};
+};
+
+} // namespace Kernel
+} // namespace Mantid
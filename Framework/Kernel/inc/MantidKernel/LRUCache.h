@@ -0,0 +1,144 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Mantid {
+namespace Kernel {
+
+/** LRUCache : A thread safe cache of values found by a key, normally the
+  Kernel::HashBuilder hash of everything a value depends on. The values are
+  given their size in bytes when inserted, and the least recently used are
+  dropped when the total exceeds the memory limit. A value larger than the
+  limit is not kept.
+
+  The values are held by shared pointers, so a value dropped from the cache
+  stays valid for those still using it.
+*/
+template <typename Value, typename Key = uint64_t> class LRUCache {
+public:
+  /** Constructor
+   * @param memoryLimit :: the maximum number of bytes held by the values
+   */
+  explicit LRUCache(const size_t memoryLimit) : m_memoryLimit(memoryLimit) {}
+
+  /** Find a value, making it the most recently used
+   * @param key :: the key of the value
+   * @return the value, or null if it is not kept
+   */
+  std::shared_ptr<const Value> find(const Key &key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto found = m_entries.find(key);
+    if (found == m_entries.end())
+      return nullptr;
+    m_recent.splice(m_recent.begin(), m_recent, found->second.recent);
+    return found->second.value;
+  }
+
+  /** Keep a value as the most recently used, replacing any with the same key
+   * and dropping the least recently used values beyond the memory limit
+   * @param key :: the key of the value
+   * @param value :: the value
+   * @param memory :: the number of bytes held by the value
+   */
+  void insert(const Key &key, std::shared_ptr<const Value> value,
+              const size_t memory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    erase(key);
+    if (memory > m_memoryLimit)
+      return;
+    m_recent.emplace_front(key);
+    m_entries.emplace(key, Stored{std::move(value), memory, m_recent.begin()});
+    m_memory += memory;
+    evict();
+  }
+
+  /// Drop all the values
+  void clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_recent.clear();
+    m_memory = 0;
+  }
+
+  /** Set the memory limit, dropping the least recently used values beyond it
+   * @param bytes :: the maximum number of bytes held by the values
+   */
+  void setMemoryLimit(const size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_memoryLimit = bytes;
+    evict();
+  }
+
+  /// @return the maximum number of bytes held by the values
+  size_t memoryLimit() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memoryLimit;
+  }
+
+  /// @return the number of values kept
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+  }
+
+  /// @return the number of bytes held by the values
+  size_t memory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memory;
+  }
+
+private:
+  using Recent = std::list<Key>;
+  struct Stored {
+    std::shared_ptr<const Value> value;
+    size_t memory;
+    typename Recent::iterator recent;
+  };
+
+  /// Drop the value of a key, if any. The mutex must be held.
+  void erase(const Key &key) {
+    const auto found = m_entries.find(key);
+    if (found == m_entries.end())
+      return;
+    m_memory -= found->second.memory;
+    m_recent.erase(found->second.recent);
+    m_entries.erase(found);
+  }
+
+  /// Drop the least recently used values until they fit in the limit. The
+  /// mutex must be held.
+  void evict() {
+    while (m_memory > m_memoryLimit) {
+      const Key oldest = m_recent.back();
+      erase(oldest);
+    }
+  }
+
+  mutable std::mutex m_mutex;
+  std::unordered_map<Key, Stored> m_entries;
+  /// The keys of the values, the most recently used first
+  Recent m_recent;
+  size_t m_memory{0};
+  size_t m_memoryLimit;
+};
+
+/// The memory limit of a process wide cache, from a configuration key in MiB
+MANTID_KERNEL_DLL size_t cacheMemoryLimit(const std::string &configKey,
+                                          const size_t defaultMiB);
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,122 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** MemoryPool : A thread-safe pool of memory carved from large slabs, for
+  temporaries that are allocated and freed many times while an algorithm
+  runs.
+
+  Blocks are rounded up to a power of two of at least MinBlockSize bytes and
+  returned to a free list of their size when deallocated, so the memory is
+  reused without going back to the system allocator. Each size has its own
+  lock, so threads allocating different sizes do not contend. Blocks larger
+  than MaxBlockSize are passed on to the global operator new. All the slabs
+  are released at once when the pool is destroyed.
+*/
+class MANTID_KERNEL_DLL MemoryPool {
+public:
+  /// The smallest block handed out, which is also the alignment of blocks
+  static constexpr size_t MinBlockSize = alignof(std::max_align_t) < 16
+                                             ? 16
+                                             : alignof(std::max_align_t);
+  /// The largest block taken from the slabs
+  static constexpr size_t MaxBlockSize = size_t(1) << 20;
+
+  explicit MemoryPool(const size_t slabSize = size_t(16) << 20);
+  MemoryPool(const MemoryPool &) = delete;
+  MemoryPool &operator=(const MemoryPool &) = delete;
+  ~MemoryPool();
+
+  void *allocate(const size_t bytes);
+  void deallocate(void *block, const size_t bytes) noexcept;
+  void reserve(const size_t bytes);
+  size_t capacity() const;
+
+private:
+  /// A free block, linking to the next one of the same size
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+  struct SizeClass {
+    std::mutex mutex;
+    FreeBlock *free{nullptr};
+  };
+  static constexpr size_t NumSizeClasses = 17;
+
+  static size_t sizeClass(const size_t bytes);
+  void *carve(const size_t bytes);
+  void addSlab(const size_t bytes);
+
+  const size_t m_slabSize;
+  std::array<SizeClass, NumSizeClasses> m_sizeClasses;
+  /// Guards the slabs and the unused end of the current one
+  mutable std::mutex m_slabMutex;
+  std::vector<std::unique_ptr<char[]>> m_slabs;
+  size_t m_capacity{0};
+  char *m_next{nullptr};
+  char *m_end{nullptr};
+};
+
+/** PoolAllocator : A standard allocator taking its memory from a shared
+  MemoryPool, e.g. std::vector<double, PoolAllocator<double>>. Copies of an
+  allocator share the pool, which lives as long as any of them.
+*/
+template <class T> class PoolAllocator {
+public:
+  static_assert(alignof(T) <= MemoryPool::MinBlockSize,
+                "PoolAllocator does not support over-aligned types");
+  using value_type = T;
+
+  explicit PoolAllocator(std::shared_ptr<MemoryPool> pool) noexcept
+      : m_pool(std::move(pool)) {}
+  template <class U>
+  PoolAllocator(const PoolAllocator<U> &other) noexcept
+      : m_pool(other.pool()) {}
+
+  T *allocate(const size_t n) {
+    if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+      throw std::bad_array_new_length();
+    return static_cast<T *>(m_pool->allocate(n * sizeof(T)));
+  }
+  void deallocate(T *p, const size_t n) noexcept {
+    m_pool->deallocate(p, n * sizeof(T));
+  }
+
+  /// @return the pool this allocates from
+  const std::shared_ptr<MemoryPool> &pool() const noexcept { return m_pool; }
+
+private:
+  std::shared_ptr<MemoryPool> m_pool;
+};
+
+template <class T, class U>
+bool operator==(const PoolAllocator<T> &lhs,
+                const PoolAllocator<U> &rhs) noexcept {
+  return lhs.pool() == rhs.pool();
+}
+
+template <class T, class U>
+bool operator!=(const PoolAllocator<T> &lhs,
+                const PoolAllocator<U> &rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,113 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "MantidKernel/PseudoRandomNumberGenerator.h"
+
+#include <array>
+#include <cstdint>
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+  This implements the Philox-4x32-10 counter based pseudo-random number
+  generator of Salmon et al., "Parallel random numbers: as easy as 1, 2, 3",
+  SC11 (2011), as a specialization of the PseudoRandomNumberGenerator
+  interface.
+
+  Each block of four 32 bit values is a keyed bijection of a 128 bit counter,
+  so the generator has no state beyond the counter. The counter holds a 64 bit
+  stream, a 32 bit substream and the 32 bit position within the substream, and
+  the key is the seed. Every (seed, stream, substream) therefore gives an
+  independent sequence, which can be started anywhere without generating the
+  values before it. Giving each spectrum, wavelength or event of a Monte Carlo
+  simulation its own stream makes the results independent of the order in
+  which they are simulated, and hence of the number of threads.
+*/
+class MANTID_KERNEL_DLL Philox final : public PseudoRandomNumberGenerator {
+public:
+  /// Construct the generator with an initial seed
+  explicit Philox(const size_t seedValue);
+  /// Construct the generator with an initial seed and range
+  Philox(const size_t seedValue, const double start, const double end);
+  Philox(const Philox &) = delete;
+  Philox &operator=(const Philox &) = delete;
+
+  /// Set the random number seed, restarting the current stream
+  void setSeed(const size_t seedValue) override;
+  /// Start the given stream and substream from the beginning
+  void setStream(const uint64_t stream, const uint32_t substream = 0);
+  /// Sets the range of the subsequent calls to nextValue
+  void setRange(const double start, const double end) override;
+  /// Generate the next random number in the sequence within the default
+  /// range
+  inline double nextValue() override {
+    return m_start + (m_end - m_start) * nextUnit();
+  }
+  /// Generate the next random number in the sequence within the given range
+  inline double nextValue(double start, double end) override {
+    return start + (end - start) * nextUnit();
+  }
+  /// Return the next integer in the sequence within the given range
+  int nextInt(int start, int end) override;
+  /// Resets the generator to the start of the current stream
+  void restart() override;
+  /// Saves the current state of the generator
+  void save() override;
+  /// Restores the generator to the last saved point, or the beginning if
+  /// nothing has been saved
+  void restore() override;
+  /// Return the minimum value of the range
+  double min() const override { return m_start; }
+  /// Return the maximum value of the range
+  double max() const override { return m_end; }
+
+  using Block = std::array<uint32_t, 4>;
+  using Key = std::array<uint32_t, 2>;
+  /// The Philox-4x32-10 bijection of a counter for a key
+  static Block generateBlock(Block counter, Key key);
+
+private:
+  /// Return the next 32 bit value of the sequence
+  inline uint32_t nextUInt32() {
+    if (m_index == m_block.size()) {
+      m_block = generateBlock(m_counter, m_key);
+      ++m_counter[0];
+      m_index = 0;
+    }
+    return m_block[m_index++];
+  }
+  /// Return the next value in [0, 1), from 53 random bits
+  inline double nextUnit() {
+    const uint64_t high = nextUInt32() >> 5;
+    const uint64_t low = nextUInt32() >> 6;
+    return static_cast<double>((high << 26) + low) * (1.0 / 9007199254740992.0);
+  }
+
+  /// The seed
+  Key m_key;
+  /// The stream, substream and position of the next block
+  Block m_counter;
+  /// The values of the current block
+  Block m_block;
+  /// The index of the next value of the current block
+  size_t m_index;
+  /// Minimum in range
+  double m_start;
+  /// Maximum in range
+  double m_end;
+  /// The counter and index when save was called
+  Block m_savedCounter;
+  size_t m_savedIndex;
+};
+
+} // namespace Kernel
+} // namespace Mantid
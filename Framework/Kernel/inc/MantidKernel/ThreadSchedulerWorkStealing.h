@@ -0,0 +1,99 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : A scheduler that keeps a separate queue of
+ * tasks for each thread, so that threads do not all contend for one lock.
+ *
+ * Each thread runs the tasks of its own queue, largest cost first. A thread
+ * whose queue is empty steals from the other queues, starting with the one
+ * holding the largest total cost, and again takes the largest task it finds.
+ * Tasks pushed from within a running task go onto the queue of the thread
+ * running it; other tasks are dealt out to the queues in turn.
+ *
+ * As in ThreadSchedulerMutexes, a task whose mutex is held by a running task
+ * is only handed out when every remaining task is waiting on a mutex. Each
+ * queue keeps the tasks sharing a mutex together, and whether a mutex is held
+ * is an atomic count shared by those groups, so that a pop looks at one task
+ * per mutex and takes no global lock whatever the number of queued tasks.
+ */
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  explicit ThreadSchedulerWorkStealing(size_t numQueues = 0);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(std::shared_ptr<Task> newTask) override;
+  std::shared_ptr<Task> pop(size_t threadnum) override;
+  void finished(Task *task, size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+
+  /// @return the number of per-thread queues
+  size_t numQueues() const { return m_queues.size(); }
+  size_t queueSize(size_t queue);
+
+private:
+  /// The state of one mutex, shared by the queues holding tasks using it
+  struct MutexState {
+    /// Number of handed out tasks holding the mutex
+    std::atomic<size_t> running{0};
+    /// Number of queued and handed out tasks using it, guarded by m_queueLock
+    size_t users{0};
+  };
+
+  /// Tasks of a queue sharing one mutex, sorted by cost
+  struct MutexGroup {
+    std::shared_ptr<MutexState> state;
+    std::multimap<double, std::shared_ptr<Task>> tasks;
+  };
+
+  /// The tasks of one thread
+  struct Queue {
+    std::mutex lock;
+    /// Tasks without a mutex, sorted by cost
+    std::multimap<double, std::shared_ptr<Task>> tasks;
+    /// Tasks with a mutex
+    std::map<std::shared_ptr<std::mutex>, MutexGroup> groups;
+    /// Total cost of the tasks, readable without the lock
+    std::atomic<double> cost{0.};
+    /// Number of tasks, readable without the lock
+    std::atomic<size_t> count{0};
+  };
+
+  std::shared_ptr<Task> take(Queue &queue, bool runnableOnly);
+  std::shared_ptr<Task> steal(size_t own, bool runnableOnly);
+  std::shared_ptr<MutexState> acquireState(std::shared_ptr<std::mutex> mutex);
+
+  /// Unique ID, used to recognise the threads running tasks of this scheduler
+  const size_t m_id;
+  /// One queue per thread
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  /// Number of queued tasks, so that empty() takes no lock
+  std::atomic<size_t> m_size;
+  /// Queue that the next task pushed from outside the pool goes to
+  std::atomic<size_t> m_nextQueue;
+  /// State of the mutexes of queued and running tasks, guarded by m_queueLock
+  std::map<std::shared_ptr<std::mutex>, std::shared_ptr<MutexState>>
+      m_mutexStates;
+};
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,96 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** TimeSeriesColumns : Compact storage for the entries of a time series,
+  sorted by time, used by TimeSeriesProperty.
+
+  Times are nanoseconds, as in DateAndTime, and are delta encoded. The entries
+  are grouped in blocks of BLOCK_SIZE. The first entry of a block keeps its
+  absolute time and every other entry stores the difference to the previous
+  one as a variable length integer. A log recorded at a steady rate then needs
+  2 to 4 bytes per time instead of 8. The values are held in a separate vector.
+
+  Looking up a time is a binary search over the blocks followed by a scan of
+  at most one block.
+*/
+template <typename TYPE> class DLLExport TimeSeriesColumns {
+public:
+  /// Number of entries sharing one absolute time
+  static constexpr std::size_t BLOCK_SIZE = 64;
+
+  /// Reads the times of consecutive entries
+  class DLLExport TimeCursor {
+  public:
+    TimeCursor(const TimeSeriesColumns &columns, std::size_t index);
+    /// @return the index of the current entry
+    std::size_t index() const { return m_index; }
+    /// @return the time of the current entry, which must exist
+    int64_t time() const { return m_time; }
+    void next();
+
+  private:
+    const TimeSeriesColumns *m_columns;
+    std::size_t m_index;
+    /// Position of the delta of the next entry
+    std::size_t m_offset;
+    int64_t m_time;
+  };
+
+  void clear();
+  void reserve(std::size_t size);
+  void shrinkToFit();
+  bool append(int64_t time, const TYPE &value);
+
+  /// @return the number of entries
+  std::size_t size() const { return m_values.size(); }
+  /// @return true if there are no entries
+  bool empty() const { return m_values.empty(); }
+  int64_t time(std::size_t index) const;
+  /// @return the value of an entry
+  TYPE value(std::size_t index) const { return m_values[index]; }
+  /// @return the time of the first entry, which must exist
+  int64_t firstTime() const { return m_blocks.front().time; }
+  /// @return the time of the last entry, which must exist
+  int64_t lastTime() const { return m_lastTime; }
+  /// @return the values of every entry
+  const std::vector<TYPE> &values() const { return m_values; }
+  std::vector<int64_t> times() const;
+
+  std::size_t lowerBound(int64_t time) const;
+  std::size_t upperBound(int64_t time) const;
+  std::size_t memorySize() const;
+
+private:
+  struct Block {
+    /// Absolute time of the first entry
+    int64_t time;
+    /// Position in m_deltas of the delta of the second entry
+    std::size_t offset;
+  };
+
+  template <typename Before>
+  std::size_t search(int64_t time, Before before) const;
+
+  std::vector<Block> m_blocks;
+  /// Time differences as variable length integers, 7 bits per byte
+  std::vector<uint8_t> m_deltas;
+  std::vector<TYPE> m_values;
+  int64_t m_lastTime = 0;
+};
+
+} // namespace Kernel
+} // namespace Mantid
@@ -14,6 +14,7 @@
 #include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
+#include "MantidKernel/TimeSeriesColumns.h"
 #include <cstdint>
 #include <utility>
 
@@ -29,6 +30,9 @@ class SplittingInterval;
 
 enum TimeSeriesSortStatus { TSUNKNOWN, TSUNSORTED, TSSORTED };
 
+/// How a TimeSeriesProperty holds its entries
+enum TimeSeriesStorageType { TSROWS, TSCOLUMNS };
+
 //=========================================================================
 /** Struct holding some useful statistics for a TimeSeriesProperty
  *
@@ -101,6 +105,13 @@ public:
 
 /**
    A specialised Property class for holding a series of time-value pairs.
+
+   The entries are held as a vector of TimeValueUnit by default. Long logs can
+   be switched to TimeSeriesColumns with setStorageType(TSCOLUMNS), which keeps
+   the entries sorted with delta encoded times and finds a time with a binary
+   search. Adding an entry out of order, filtering with filterWith() or
+   calling a method that edits the entries in place switches the property
+   back to rows.
  */
 template <typename TYPE>
 class DLLExport TimeSeriesProperty : public Property,
@@ -311,7 +322,12 @@ public:
   /**Reserve memory for efficient adding values to existing property
    * makes sense only when you have reasonably precise estimate of the
    * total size you'll need easily available in advance.  */
-  void reserve(size_t size) { m_values.reserve(size); };
+  void reserve(size_t size);
+
+  /// Set how the entries are held
+  void setStorageType(TimeSeriesStorageType storage);
+  /// @return how the entries are held
+  TimeSeriesStorageType getStorageType() const { return m_storage; }
 
   /// If filtering by log, get the time intervals for splitting
   std::vector<Mantid::Kernel::SplittingInterval> getSplittingIntervals() const;
@@ -322,6 +338,13 @@ private:
   void saveTimeVector(::NeXus::File *file);
   /// Sort the property into increasing times, if not already sorted
   void sortIfNecessary() const;
+  /// Move the entries from the columns back to m_values
+  void toRows() const;
+  /// Index of the first entry not earlier than t
+  size_t lowerBoundIndex(const Types::Core::DateAndTime &t) const;
+  /// Call f(time, value) for the entries in [begin, end)
+  template <typename Func>
+  void forEachEntry(size_t begin, size_t end, Func &&f) const;
   ///  Find the index of the entry of time t in the mP vector (sorted)
   int findIndex(Types::Core::DateAndTime t) const;
   ///  Find the upper_bound of time t in container.
@@ -333,6 +356,8 @@ private:
   size_t findNthIndexFromQuickRef(int n) const;
   /// Set a value from another property
   std::string setValueFromProperty(const Property &right) override;
+  /// Filter the columns by a range of times
+  bool filterColumnsByTimes(const std::vector<SplittingInterval> &splittervec);
   /// Find if time lies in a filtered region
   bool isTimeFiltered(const Types::Core::DateAndTime &time) const;
   /// Time weighted mean and standard deviation
@@ -340,6 +365,8 @@ private:
 
   /// Holds the time series data
   mutable std::vector<TimeValueUnit<TYPE>> m_values;
+  /// Holds the time series data when the storage type is TSCOLUMNS
+  mutable TimeSeriesColumns<TYPE> m_columns;
 
   /// The number of values (or time intervals) in the time series. It can be
   /// different from m_propertySeries.size()
@@ -354,6 +381,8 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+  /// Whether the entries are in m_values or m_columns
+  mutable TimeSeriesStorageType m_storage;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
@@ -0,0 +1,84 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ZeroedAllocator : Allocator of zero-filled memory for large arrays of
+  trivial types, most of which may never be written.
+
+  The memory comes from calloc, which takes large blocks straight from the
+  operating system as pages of zeros that use no physical memory until they
+  are written. Elements are default-initialised, so filling a container does
+  not write them either: a std::vector<double, ZeroedAllocator<double>> of
+  a billion elements costs nothing until parts of it are used. As a
+  consequence, growing a container within its capacity does not clear the
+  elements that were removed before.
+*/
+template <typename T> class ZeroedAllocator {
+  static_assert(std::is_trivially_default_constructible<T>::value &&
+                    std::is_trivially_destructible<T>::value,
+                "ZeroedAllocator relies on zero bytes being a valid value");
+
+public:
+  using value_type = T;
+
+  ZeroedAllocator() noexcept = default;
+  template <typename U>
+  ZeroedAllocator(const ZeroedAllocator<U> &) noexcept {} // NOLINT
+
+  T *allocate(const std::size_t n) {
+    // calloc may return null for no elements
+    if (auto *p = static_cast<T *>(std::calloc(n > 0 ? n : 1, sizeof(T))))
+      return p;
+    throw std::bad_alloc();
+  }
+  void deallocate(T *p, std::size_t) noexcept { std::free(p); }
+
+  /// Default-initialise, leaving the zeros from calloc untouched
+  template <typename U> void construct(U *p) noexcept {
+    ::new (static_cast<void *>(p)) U;
+  }
+  template <typename U, typename... Args>
+  void construct(U *p, Args &&... args) {
+    ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const ZeroedAllocator<T> &, const ZeroedAllocator<U> &) {
+  return true;
+}
+template <typename T, typename U>
+bool operator!=(const ZeroedAllocator<T> &, const ZeroedAllocator<U> &) {
+  return false;
+}
+
+/// Deleter of single arrays allocated by a ZeroedAllocator
+template <typename T> struct ZeroedDeleter {
+  void operator()(T *p) const noexcept {
+    ZeroedAllocator<T>().deallocate(p, 0);
+  }
+};
+
+/// @return a zero-filled array of n elements
+template <typename T>
+std::unique_ptr<T[], ZeroedDeleter<T>> makeZeroedArray(const std::size_t n) {
+  return std::unique_ptr<T[], ZeroedDeleter<T>>(
+      ZeroedAllocator<T>().allocate(n));
+}
+
+} // namespace Kernel
+} // namespace Mantid
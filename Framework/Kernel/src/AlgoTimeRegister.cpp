@@ -0,0 +1,210 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/AlgoTimeRegister.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <ostream>
+
+namespace Mantid {
+namespace Instrumentation {
+
+AlgoTimeRegister AlgoTimeRegister::globalAlgoTimeRegister;
+
+namespace {
+/// The innermost span open on this thread
+thread_local AlgoTimeRegister::Dump *currentDump = nullptr;
+
+/// @return the nanoseconds from start to time
+int64_t since(const AlgoTimeRegister::clock::time_point &start,
+              const AlgoTimeRegister::clock::time_point &time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time - start)
+      .count();
+}
+
+/// Write a string as a JSON string literal
+void writeJsonString(std::ostream &os, const std::string &str) {
+  os << '"';
+  for (const char c : str) {
+    switch (c) {
+    case '"':
+      os << "\\\"";
+      break;
+    case '\\':
+      os << "\\\\";
+      break;
+    case '\n':
+      os << "\\n";
+      break;
+    case '\t':
+      os << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) >= 0x20)
+        os << c;
+    }
+  }
+  os << '"';
+}
+
+/// Write a duration in ns as microseconds, the unit of the trace format
+void writeMicroseconds(std::ostream &os, int64_t ns) {
+  os << ns / 1000 << '.' << static_cast<char>('0' + (ns % 1000) / 100)
+     << static_cast<char>('0' + (ns % 100) / 10)
+     << static_cast<char>('0' + ns % 10);
+}
+} // namespace
+
+AlgoTimeRegister::Dump::Dump(AlgoTimeRegister &atr, const std::string &nm,
+                             const std::string &cat)
+    : m_algoTimeRegister(atr), m_name(nm), m_category(cat),
+      m_parent(currentDump), m_bytes(0), m_events(0),
+      m_active(atr.isEnabled()) {
+  if (m_active) {
+    currentDump = this;
+    m_regStart = clock::now();
+  }
+}
+
+AlgoTimeRegister::Dump::~Dump() {
+  if (!m_active)
+    return;
+  const auto regFinish = clock::now();
+  currentDump = m_parent;
+  {
+    std::lock_guard<std::mutex> lock(m_algoTimeRegister.m_mutex);
+    m_algoTimeRegister.m_info.emplace_back(m_name, m_category,
+                                           std::this_thread::get_id(),
+                                           m_regStart, regFinish, m_bytes,
+                                           m_events);
+  }
+}
+
+AlgoTimeRegister::AlgoTimeRegister()
+    : m_enabled(false), m_hstart(clock::now()),
+      m_start(std::chrono::system_clock::now()) {}
+
+/// Write out the recorded spans, if there are any
+AlgoTimeRegister::~AlgoTimeRegister() {
+  if (m_info.empty())
+    return;
+  std::ofstream text("./algotimeregister.out");
+  writeText(text);
+  std::ofstream trace("./algotimeregister.json");
+  writeTrace(trace);
+}
+
+/** Turn recording on or off. Spans already open are unaffected.
+ * @param on :: true to record spans
+ */
+void AlgoTimeRegister::enable(bool on) {
+  m_enabled.store(on, std::memory_order_relaxed);
+}
+
+/** Attribute bytes read from file to the innermost span open on this thread.
+ * Does nothing if there is none.
+ * @param bytes :: number of bytes read
+ */
+void AlgoTimeRegister::addBytesRead(uint64_t bytes) {
+  if (currentDump)
+    currentDump->m_bytes += bytes;
+}
+
+/** Attribute processed events to the innermost span open on this thread.
+ * Does nothing if there is none.
+ * @param events :: number of events processed
+ */
+void AlgoTimeRegister::addEventsProcessed(uint64_t events) {
+  if (currentDump)
+    currentDump->m_events += events;
+}
+
+/// @return a copy of the spans recorded so far
+std::vector<AlgoTimeRegister::Info> AlgoTimeRegister::info() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_info;
+}
+
+/// Forget the spans recorded so far
+void AlgoTimeRegister::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_info.clear();
+}
+
+/** Write the spans in the Chrome trace event format. Each span is a complete
+ * ("X") event; threads are numbered in the order they first started a span.
+ * @param os :: stream to write the JSON document to
+ */
+void AlgoTimeRegister::writeTrace(std::ostream &os) {
+  auto spans = info();
+  // Parents start no later than their children, and end no earlier, so this
+  // order lets viewers nest spans with equal start times correctly
+  std::stable_sort(spans.begin(), spans.end(),
+                   [](const Info &lhs, const Info &rhs) {
+                     return lhs.m_begin < rhs.m_begin ||
+                            (lhs.m_begin == rhs.m_begin &&
+                             lhs.m_end > rhs.m_end);
+                   });
+  std::map<std::thread::id, size_t> threads;
+  for (const auto &span : spans)
+    threads.emplace(span.m_threadId, threads.size());
+
+  os << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"START_POINT\":"
+     << std::chrono::duration_cast<std::chrono::nanoseconds>(
+            m_start.time_since_epoch())
+            .count()
+     << ",\"MAX_THREAD\":" << PARALLEL_GET_MAX_THREADS
+     << "},\n\"traceEvents\":[";
+  const char *separator = "\n";
+  for (const auto &thread : threads) {
+    os << separator
+       << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+       << thread.second << ",\"args\":{\"name\":\"Thread " << thread.second
+       << "\"}}";
+    separator = ",\n";
+  }
+  for (const auto &span : spans) {
+    os << separator << "{\"name\":";
+    writeJsonString(os, span.m_name);
+    os << ",\"cat\":";
+    writeJsonString(os, span.m_category);
+    os << ",\"ph\":\"X\",\"ts\":";
+    writeMicroseconds(os, since(m_hstart, span.m_begin));
+    os << ",\"dur\":";
+    writeMicroseconds(os, since(span.m_begin, span.m_end));
+    os << ",\"pid\":1,\"tid\":" << threads[span.m_threadId]
+       << ",\"args\":{\"bytes\":" << span.m_bytes
+       << ",\"events\":" << span.m_events << "}}";
+    separator = ",\n";
+  }
+  os << "\n]}\n";
+}
+
+/** Write the algorithm spans as text, one line per span with times in ns.
+ * Other spans are left out as the format only describes algorithms.
+ * @param os :: stream to write to
+ */
+void AlgoTimeRegister::writeText(std::ostream &os) {
+  const auto spans = info();
+  os << "START_POINT: "
+     << std::chrono::duration_cast<std::chrono::nanoseconds>(
+            m_start.time_since_epoch())
+            .count()
+     << " MAX_THREAD: " << PARALLEL_GET_MAX_THREADS << "\n";
+  for (const auto &elem : spans) {
+    if (elem.m_category != "algorithm")
+      continue;
+    os << "ThreadID=" << elem.m_threadId << ", AlgorithmName=" << elem.m_name
+       << ", StartTime=" << since(m_hstart, elem.m_begin)
+       << ", EndTime=" << since(m_hstart, elem.m_end) << "\n";
+  }
+}
+
+} // namespace Instrumentation
+} // namespace Mantid
@@ -0,0 +1,198 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/BinEdgeLookup.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Relative tolerance on the bin width (or ratio) to accept a spacing
+constexpr double TOLERANCE = 1e-6;
+/// Number of values whose bin is guessed in one go by bins()
+constexpr std::size_t BLOCK_SIZE = 256;
+
+/** Check every bin step matches the first one. The last bin may be narrower,
+ * or up to twice as wide, as createAxisFromRebinParams truncates it to the
+ * upper limit and merges a very small last bin into the previous one.
+ * @param edges :: bin edges, at least 3
+ * @param step :: function giving the step (width or ratio) of bin i
+ * @param reference :: step of the first bin
+ * @return true if the steps are uniform
+ */
+template <typename Step>
+bool hasUniformSteps(const std::vector<double> &edges, Step step,
+                     const double reference) {
+  const std::size_t numBins = edges.size() - 1;
+  const double tolerance = TOLERANCE * std::fabs(reference);
+  for (std::size_t i = 1; i + 1 < numBins; ++i) {
+    if (!(std::fabs(step(i) - reference) <= tolerance))
+      return false;
+  }
+  const double last = step(numBins - 1);
+  return last > 0. && last <= 2. * reference + tolerance;
+}
+} // namespace
+
+/** Constructor, inspecting the spacing of the edges
+ * @param edges :: bin edges, sorted in ascending order
+ */
+BinEdgeLookup::BinEdgeLookup(const std::vector<double> &edges)
+    : m_edges(edges), m_numBins(edges.size() > 1 ? edges.size() - 1 : 0),
+      m_spacing(Spacing::Arbitrary), m_origin(0.), m_inverseStep(0.) {
+  if (m_numBins < 2)
+    return;
+
+  const double width = edges[1] - edges[0];
+  if (width > 0. &&
+      hasUniformSteps(
+          edges, [&edges](std::size_t i) { return edges[i + 1] - edges[i]; },
+          width)) {
+    m_spacing = Spacing::Linear;
+    m_origin = edges[0];
+    m_inverseStep = 1. / width;
+    return;
+  }
+
+  if (edges[0] > 0.) {
+    // Logarithmic bins have a constant ratio between consecutive edges, which
+    // is better conditioned than comparing the log of the edges.
+    const double ratio = edges[1] / edges[0];
+    if (ratio > 1. &&
+        hasUniformSteps(
+            edges,
+            [&edges](std::size_t i) { return edges[i + 1] / edges[i] - 1.; },
+            ratio - 1.)) {
+      m_spacing = Spacing::Logarithmic;
+      m_origin = std::log(edges[0]);
+      m_inverseStep = 1. / std::log(ratio);
+    }
+  }
+}
+
+/** Find the bin containing a value
+ * @param x :: the value
+ * @return the index of the bin, or npos if x is outside the edges
+ */
+std::size_t BinEdgeLookup::bin(const double x) const {
+  if (m_numBins == 0 || !(x >= m_edges.front() && x < m_edges.back()))
+    return npos;
+
+  switch (m_spacing) {
+  case Spacing::Linear:
+    return correct(x, static_cast<std::size_t>((x - m_origin) * m_inverseStep));
+  case Spacing::Logarithmic:
+    return correct(
+        x, static_cast<std::size_t>((std::log(x) - m_origin) * m_inverseStep));
+  default:
+    return search(x, 0);
+  }
+}
+
+/** Find the bins containing a batch of values. The guesses for linear and
+ * logarithmic edges are computed in a separate branch-free pass over blocks
+ * of values so that the compiler can vectorise it. For arbitrary edges the
+ * search starts from the previous result, which is close to optimal for
+ * sorted values.
+ * @param x :: the values
+ * @param n :: number of values
+ * @param indices :: output, the bin of each value or npos
+ */
+void BinEdgeLookup::bins(const double *x, const std::size_t n,
+                         std::size_t *indices) const {
+  if (m_numBins == 0) {
+    std::fill(indices, indices + n, npos);
+    return;
+  }
+  const double lowest = m_edges.front();
+  const double highest = m_edges.back();
+
+  if (m_spacing == Spacing::Arbitrary) {
+    std::size_t hint = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      if (!(x[i] >= lowest && x[i] < highest)) {
+        indices[i] = npos;
+        continue;
+      }
+      hint = search(x[i], hint);
+      indices[i] = hint;
+    }
+    return;
+  }
+
+  const double maxGuess = static_cast<double>(m_numBins - 1);
+  const bool logarithmic = m_spacing == Spacing::Logarithmic;
+  double guesses[BLOCK_SIZE];
+  for (std::size_t start = 0; start < n; start += BLOCK_SIZE) {
+    const std::size_t count = std::min(BLOCK_SIZE, n - start);
+    const double *block = x + start;
+    // Clamp into range so that out of range values give a valid guess
+    if (logarithmic) {
+      for (std::size_t i = 0; i < count; ++i) {
+        const double value = std::max(block[i], lowest);
+        guesses[i] = (std::log(value) - m_origin) * m_inverseStep;
+      }
+    } else {
+      for (std::size_t i = 0; i < count; ++i)
+        guesses[i] = (block[i] - m_origin) * m_inverseStep;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+      guesses[i] = std::min(std::max(guesses[i], 0.), maxGuess);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const double value = block[i];
+      indices[start + i] =
+          (value >= lowest && value < highest)
+              ? correct(value, static_cast<std::size_t>(guesses[i]))
+              : npos;
+    }
+  }
+}
+
+/** Move a computed bin index to the bin actually containing the value. This
+ * takes at most a step or two as the edges differ from the arithmetic
+ * sequence only by rounding.
+ * @param x :: the value, within the edges
+ * @param guess :: computed bin index
+ * @return the bin containing x
+ */
+std::size_t BinEdgeLookup::correct(const double x, std::size_t guess) const {
+  guess = std::min(guess, m_numBins - 1);
+  while (guess > 0 && x < m_edges[guess])
+    --guess;
+  while (guess + 1 < m_numBins && !(x < m_edges[guess + 1]))
+    ++guess;
+  return guess;
+}
+
+/** Search the edges for the bin containing a value
+ * @param x :: the value, within the edges
+ * @param hint :: a bin to start looking from
+ * @return the bin containing x
+ */
+std::size_t BinEdgeLookup::search(const double x,
+                                  const std::size_t hint) const {
+  const auto begin = m_edges.cbegin();
+  const auto last = begin + m_numBins;
+  if (x < begin[hint]) {
+    return std::upper_bound(begin, begin + hint, x) - begin - 1;
+  }
+  // Gallop forwards from the hint
+  std::size_t step = 1;
+  std::size_t low = hint;
+  while (low + step < m_numBins && !(x < begin[low + step])) {
+    low += step;
+    step *= 2;
+  }
+  const auto high = std::min(begin + low + step, last);
+  return std::upper_bound(begin + low, high, x) - begin - 1;
+}
+
+} // namespace Kernel
+} // namespace Mantid
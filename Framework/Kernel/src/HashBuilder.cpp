@@ -0,0 +1,58 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/HashBuilder.h"
+#include "MantidKernel/V3D.h"
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+ * Add bytes to the hash
+ * @param data :: the start of the bytes
+ * @param size :: the number of bytes
+ * @return this hash
+ */
+HashBuilder &HashBuilder::add(const void *data, const size_t size) {
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    m_value ^= bytes[i];
+    m_value *= 1099511628211ull;
+  }
+  return *this;
+}
+
+/**
+ * Add a string to the hash, with its length
+ * @param value :: the string
+ * @return this hash
+ */
+HashBuilder &HashBuilder::add(const std::string &value) {
+  add(static_cast<uint64_t>(value.size()));
+  return add(value.data(), value.size());
+}
+
+/**
+ * Add the components of a vector to the hash
+ * @param value :: the vector
+ * @return this hash
+ */
+HashBuilder &HashBuilder::add(const V3D &value) {
+  return add(value.X()).add(value.Y()).add(value.Z());
+}
+
+/**
+ * Add values to the hash, with their number
+ * @param values :: the values
+ * @return this hash
+ */
+HashBuilder &HashBuilder::add(const std::vector<double> &values) {
+  add(static_cast<uint64_t>(values.size()));
+  return add(values.data(), values.size() * sizeof(double));
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,29 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/LRUCache.h"
+#include "MantidKernel/ConfigService.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+ * Get the memory limit of a process wide cache from the configuration
+ * @param configKey :: the configuration key holding the limit in MiB
+ * @param defaultMiB :: the limit in MiB if the key is not set
+ * @return the limit in bytes, zero if the key is negative
+ */
+size_t cacheMemoryLimit(const std::string &configKey, const size_t defaultMiB) {
+  const auto size = ConfigService::Instance().getValue<int>(configKey);
+  if (!size)
+    return defaultMiB << 20;
+  return static_cast<size_t>(std::max(size.get(), 0)) << 20;
+}
+
+} // namespace Kernel
+} // namespace Mantid
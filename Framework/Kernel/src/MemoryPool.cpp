@@ -0,0 +1,106 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/MemoryPool.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Kernel {
+
+/** Constructor. No memory is taken until the first allocation.
+ * @param slabSize :: the number of bytes taken from the system at a time
+ */
+MemoryPool::MemoryPool(const size_t slabSize)
+    : m_slabSize(std::max(slabSize, MaxBlockSize)) {}
+
+/// Release all the slabs. Blocks still allocated become invalid.
+MemoryPool::~MemoryPool() = default;
+
+/** Allocate a block
+ * @param bytes :: the size of the block
+ * @return a block of at least the given size, aligned for any type
+ */
+void *MemoryPool::allocate(const size_t bytes) {
+  if (bytes > MaxBlockSize)
+    return ::operator new(bytes);
+  auto &sizeClass = m_sizeClasses[MemoryPool::sizeClass(bytes)];
+  {
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    if (auto *block = sizeClass.free) {
+      sizeClass.free = block->next;
+      return block;
+    }
+  }
+  return carve(MinBlockSize << MemoryPool::sizeClass(bytes));
+}
+
+/** Return a block to the pool
+ * @param block :: a block from allocate(), may be null
+ * @param bytes :: the size the block was allocated with
+ */
+void MemoryPool::deallocate(void *block, const size_t bytes) noexcept {
+  if (!block)
+    return;
+  if (bytes > MaxBlockSize) {
+    ::operator delete(block);
+    return;
+  }
+  auto &sizeClass = m_sizeClasses[MemoryPool::sizeClass(bytes)];
+  auto *freeBlock = static_cast<FreeBlock *>(block);
+  std::lock_guard<std::mutex> lock(sizeClass.mutex);
+  freeBlock->next = sizeClass.free;
+  sizeClass.free = freeBlock;
+}
+
+/** Make sure the given number of bytes can be allocated without taking more
+ * memory from the system, e.g. before processing a bank of events.
+ * @param bytes :: the number of bytes to have ready
+ */
+void MemoryPool::reserve(const size_t bytes) {
+  std::lock_guard<std::mutex> lock(m_slabMutex);
+  if (static_cast<size_t>(m_end - m_next) < bytes)
+    addSlab(bytes);
+}
+
+/// @return the number of bytes taken from the system for the slabs
+size_t MemoryPool::capacity() const {
+  std::lock_guard<std::mutex> lock(m_slabMutex);
+  return m_capacity;
+}
+
+/// @return the index of the size class of blocks of the given size
+size_t MemoryPool::sizeClass(const size_t bytes) {
+  size_t index = 0;
+  for (size_t size = MinBlockSize; size < bytes; size <<= 1)
+    ++index;
+  return index;
+}
+
+/// Take a new block from the unused end of the current slab
+void *MemoryPool::carve(const size_t bytes) {
+  std::lock_guard<std::mutex> lock(m_slabMutex);
+  if (static_cast<size_t>(m_end - m_next) < bytes)
+    addSlab(bytes);
+  auto *block = m_next;
+  m_next += bytes;
+  return block;
+}
+
+/// Start a new slab with room for at least the given number of bytes. The
+/// rest of the current slab is not used again.
+void MemoryPool::addSlab(const size_t bytes) {
+  auto size = std::max(bytes, m_slabSize);
+  // Keep the blocks carved from the slab aligned
+  size = (size + MinBlockSize - 1) / MinBlockSize * MinBlockSize;
+  m_slabs.emplace_back(new char[size]);
+  m_capacity += size;
+  m_next = m_slabs.back().get();
+  m_end = m_next + size;
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,164 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "MantidKernel/Philox.h"
+
+#include <stdexcept>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// The multipliers of the rounds
+constexpr uint64_t PHILOX_M0 = 0xD2511F53;
+constexpr uint64_t PHILOX_M1 = 0xCD9E8D57;
+/// The increments of the key between rounds
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9;
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85;
+/// The number of rounds
+constexpr int PHILOX_ROUNDS = 10;
+} // namespace
+
+//------------------------------------------------------------------------------
+// Public member functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor taking a seed value. Sets the range to [0.0,1.0]
+ * @param seedValue :: The initial seed
+ */
+Philox::Philox(const size_t seedValue) : Philox(seedValue, 0.0, 1.0) {}
+
+/**
+ * Constructor taking a seed value and a range. The generator starts at the
+ * beginning of stream 0.
+ * @param seedValue :: The initial seed
+ * @param start :: The minimum value a generated number should take
+ * @param end :: The maximum value a generated number should take
+ */
+Philox::Philox(const size_t seedValue, const double start, const double end)
+    : m_key(), m_counter(), m_block(), m_index(m_block.size()),
+      m_start(start), m_end(end), m_savedCounter(), m_savedIndex(m_index) {
+  setSeed(seedValue);
+}
+
+/**
+ * (Re-)seed the generator. The current stream is started from the beginning
+ * and the saved state is reset.
+ * @param seedValue :: A seed for the generator
+ */
+void Philox::setSeed(const size_t seedValue) {
+  const auto seed = static_cast<uint64_t>(seedValue);
+  m_key = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+  restart();
+  save();
+}
+
+/**
+ * Start a stream from the beginning. Streams are independent of each other,
+ * and the values of a stream depend only on the seed, the stream and the
+ * substream. The saved state is reset.
+ * @param stream :: The stream, e.g. the index of a spectrum
+ * @param substream :: The substream, e.g. the index of an event
+ */
+void Philox::setStream(const uint64_t stream, const uint32_t substream) {
+  m_counter[1] = substream;
+  m_counter[2] = static_cast<uint32_t>(stream);
+  m_counter[3] = static_cast<uint32_t>(stream >> 32);
+  restart();
+  save();
+}
+
+/**
+ * Sets the range of the subsequent calls to nextValue()
+ * @param start :: The lowest value a call to nextValue() will produce
+ * @param end :: The largest value a call to nextValue() will produce
+ */
+void Philox::setRange(const double start, const double end) {
+  m_start = start;
+  m_end = end;
+}
+
+/**
+ * Returns the next integer in the sequence, without bias towards any value
+ * of the range
+ * @param start Start of the requested range
+ * @param end End of the requested range
+ * @return An integer in the defined range
+ */
+int Philox::nextInt(int start, int end) {
+  if (end < start) {
+    throw std::invalid_argument(
+        "Philox::nextInt - the end of the range is before the start");
+  }
+  const uint64_t range =
+      static_cast<uint64_t>(static_cast<int64_t>(end) - start) + 1;
+  // Reject the values of the last, incomplete, copy of the range
+  const uint64_t limit = (uint64_t(1) << 32) - (uint64_t(1) << 32) % range;
+  uint64_t value;
+  do {
+    value = nextUInt32();
+  } while (value >= limit);
+  return static_cast<int>(static_cast<int64_t>(start) +
+                          static_cast<int64_t>(value % range));
+}
+
+/**
+ * Resets the generator to the beginning of the current stream
+ */
+void Philox::restart() {
+  m_counter[0] = 0;
+  m_index = m_block.size();
+}
+
+/// Saves the current state of the generator
+void Philox::save() {
+  m_savedCounter = m_counter;
+  m_savedIndex = m_index;
+}
+
+/// Restores the generator to the last saved point, or the beginning of the
+/// stream if nothing has been saved since it was set
+void Philox::restore() {
+  m_counter = m_savedCounter;
+  m_index = m_savedIndex;
+  if (m_index < m_block.size()) {
+    // Regenerate the block the saved point is in
+    auto counter = m_counter;
+    --counter[0];
+    m_block = generateBlock(counter, m_key);
+  }
+}
+
+/**
+ * Encrypt a counter with 10 rounds of Philox-4x32. The result is a bijection
+ * of the counter for each key, and is statistically independent of the
+ * results for other counters.
+ * @param counter :: The 128 bit counter
+ * @param key :: The 64 bit key
+ * @return The four 32 bit random values of the counter
+ */
+Philox::Block Philox::generateBlock(Block counter, Key key) {
+  for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+    if (round > 0) {
+      key[0] += PHILOX_W0;
+      key[1] += PHILOX_W1;
+    }
+    const uint64_t product0 = PHILOX_M0 * counter[0];
+    const uint64_t product1 = PHILOX_M1 * counter[2];
+    counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+               static_cast<uint32_t>(product1),
+               static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+               static_cast<uint32_t>(product0)};
+  }
+  return counter;
+}
+
+} // namespace Kernel
+} // namespace Mantid
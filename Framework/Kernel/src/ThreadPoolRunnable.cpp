@@ -5,15 +5,39 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidKernel/ThreadPoolRunnable.h"
+#include "MantidKernel/AlgoTimeRegister.h"
 #include "MantidKernel/ProgressBase.h"
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadScheduler.h"
 
 #include <Poco/Thread.h>
+#include <typeinfo>
+
+#ifdef __GNUC__
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
 
 namespace Mantid {
 namespace Kernel {
 
+namespace {
+/// @return a readable name for the type of a task, for profiling
+std::string taskName(const Task &task) {
+  const char *mangled = typeid(task).name();
+#ifdef __GNUC__
+  int status = 0;
+  char *demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+  if (demangled) {
+    std::string name(demangled);
+    std::free(demangled);
+    return name;
+  }
+#endif
+  return mangled;
+}
+} // namespace
+
 //-----------------------------------------------------------------------------------
 /** Constructor
  *
@@ -65,6 +89,12 @@ void ThreadPoolRunnable::run() {
 
       try {
         // Run the task (synchronously within this thread)
+        auto &timeRegister =
+            Instrumentation::AlgoTimeRegister::globalAlgoTimeRegister;
+        Instrumentation::AlgoTimeRegister::Dump span(
+            timeRegister,
+            timeRegister.isEnabled() ? taskName(*task) : std::string(),
+            "task");
         task->run();
       } catch (std::exception &e) {
         // The task threw an exception!
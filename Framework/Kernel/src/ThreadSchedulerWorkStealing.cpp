@@ -0,0 +1,264 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Source of unique scheduler IDs. 0 is never used.
+std::atomic<size_t> nextSchedulerId(1);
+/// ID of the scheduler whose pop() was last called from this thread
+thread_local size_t currentScheduler = 0;
+/// Queue of that scheduler belonging to this thread
+thread_local size_t currentQueue = 0;
+} // namespace
+
+/** Constructor
+ * @param numQueues :: number of per-thread queues. Threads share queues if
+ * there are more threads than this. Default = 0, meaning one per core.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numQueues)
+    : ThreadScheduler(), m_id(nextSchedulerId++), m_size(0), m_nextQueue(0) {
+  if (numQueues == 0)
+    numQueues = std::max(ThreadPool::getNumPhysicalCores(), size_t{1});
+  m_queues.reserve(numQueues);
+  for (size_t i = 0; i < numQueues; ++i)
+    m_queues.emplace_back(std::make_unique<Queue>());
+}
+
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+//-------------------------------------------------------------------------------
+/** Add a task. It goes to the queue of the calling thread if that is running
+ * a task of this scheduler, otherwise to the next queue in turn.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(std::shared_ptr<Task> newTask) {
+  const size_t index =
+      (currentScheduler == m_id)
+          ? currentQueue % m_queues.size()
+          : m_nextQueue.fetch_add(1, std::memory_order_relaxed) %
+                m_queues.size();
+  Queue &queue = *m_queues[index];
+  const double cost = newTask->cost();
+  auto mutex = newTask->getMutex();
+  std::shared_ptr<MutexState> state;
+  if (mutex)
+    state = acquireState(mutex);
+  std::lock_guard<std::mutex> lock(queue.lock);
+  // Count the task before it can be taken so that m_size never underflows
+  ++m_size;
+  if (mutex) {
+    auto &group = queue.groups[std::move(mutex)];
+    if (!group.state)
+      group.state = std::move(state);
+    group.tasks.emplace(cost, std::move(newTask));
+  } else {
+    queue.tasks.emplace(cost, std::move(newTask));
+  }
+  queue.cost.store(queue.cost.load(std::memory_order_relaxed) + cost,
+                   std::memory_order_relaxed);
+  queue.count.store(queue.count.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------
+/** Retrieve the next task for a thread: the largest runnable task of its own
+ * queue, else one stolen from another queue.
+ * @param threadnum :: ID of the calling thread
+ * @return a Task to run, or NULL if there are none left
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  const size_t own = threadnum % m_queues.size();
+  currentScheduler = m_id;
+  currentQueue = own;
+
+  if (auto task = take(*m_queues[own], true))
+    return task;
+  if (auto task = steal(own, true))
+    return task;
+  // Every task left waits for the mutex of a running task. Hand one out anyway
+  // so that the thread blocks on the mutex instead of polling.
+  if (auto task = take(*m_queues[own], false))
+    return task;
+  return steal(own, false);
+}
+
+//-------------------------------------------------------------------------------
+/** Signal that a task is complete, releasing its mutex.
+ * @param task :: the Task that was completed.
+ * @param threadnum :: unused argument
+ */
+void ThreadSchedulerWorkStealing::finished(Task *task, size_t threadnum) {
+  UNUSED_ARG(threadnum);
+  auto mutex = task->getMutex();
+  if (!mutex)
+    return;
+  std::lock_guard<std::mutex> lock(m_queueLock);
+  auto it = m_mutexStates.find(mutex);
+  if (it == m_mutexStates.end())
+    return;
+  auto &state = *it->second;
+  if (state.running.load() > 0)
+    --state.running;
+  if (--state.users == 0)
+    m_mutexStates.erase(it);
+}
+
+//-------------------------------------------------------------------------------
+/// @return the number of queued tasks
+size_t ThreadSchedulerWorkStealing::size() { return m_size.load(); }
+
+/// @return true if no tasks are queued
+bool ThreadSchedulerWorkStealing::empty() { return m_size.load() == 0; }
+
+//-------------------------------------------------------------------------------
+/// Empty out every queue
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    m_size -= queue->count.load();
+    queue->tasks.clear();
+    for (const auto &group : queue->groups) {
+      // Lock order is always queue then m_queueLock
+      std::lock_guard<std::mutex> stateLock(m_queueLock);
+      auto &state = *group.second.state;
+      state.users -= group.second.tasks.size();
+      if (state.users == 0)
+        m_mutexStates.erase(group.first);
+    }
+    queue->groups.clear();
+    queue->cost.store(0.);
+    queue->count.store(0);
+  }
+}
+
+//-------------------------------------------------------------------------------
+/// @return the total cost of the queued tasks
+double ThreadSchedulerWorkStealing::totalCost() {
+  return std::accumulate(m_queues.cbegin(), m_queues.cend(), 0.,
+                         [](double total, const std::unique_ptr<Queue> &queue) {
+                           return total + queue->cost.load();
+                         });
+}
+
+//-------------------------------------------------------------------------------
+/** @param queue :: index of a queue
+ * @return the number of tasks in that queue
+ */
+size_t ThreadSchedulerWorkStealing::queueSize(size_t queue) {
+  return m_queues.at(queue)->count.load();
+}
+
+//-------------------------------------------------------------------------------
+/** Take the largest cost task out of a queue. Only the largest task of each
+ * mutex is looked at, so the time taken does not grow with the number of
+ * tasks waiting on a mutex.
+ * @param queue :: the queue
+ * @param runnableOnly :: skip tasks whose mutex is held by a running task
+ * @return the task, or NULL if none was found
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::take(Queue &queue,
+                                                        bool runnableOnly) {
+  if (queue.count.load(std::memory_order_relaxed) == 0)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(queue.lock);
+  for (;;) {
+    auto *from = queue.tasks.empty() ? nullptr : &queue.tasks;
+    auto group = queue.groups.end();
+    for (auto it = queue.groups.begin(); it != queue.groups.end(); ++it) {
+      const auto &tasks = it->second.tasks;
+      if (runnableOnly && it->second.state->running.load() > 0)
+        continue;
+      if (!from || tasks.rbegin()->first > from->rbegin()->first) {
+        from = &it->second.tasks;
+        group = it;
+      }
+    }
+    if (!from)
+      return nullptr;
+    if (group != queue.groups.end()) {
+      auto &running = group->second.state->running;
+      size_t idle(0);
+      // Another queue may have handed out a task of the mutex since it was
+      // looked at. Look again, now that the mutex is seen as held.
+      if (!runnableOnly)
+        ++running;
+      else if (!running.compare_exchange_strong(idle, 1))
+        continue;
+    }
+
+    const auto last = std::prev(from->end());
+    const double cost = last->first;
+    auto task = std::move(last->second);
+    from->erase(last);
+    if (group != queue.groups.end() && from->empty())
+      queue.groups.erase(group);
+    const size_t count = queue.count.load(std::memory_order_relaxed) - 1;
+    // Reset to exactly zero once empty so rounding does not accumulate
+    queue.cost.store(
+        count == 0 ? 0. : queue.cost.load(std::memory_order_relaxed) - cost,
+        std::memory_order_relaxed);
+    queue.count.store(count, std::memory_order_relaxed);
+    --m_size;
+    return task;
+  }
+}
+
+//-------------------------------------------------------------------------------
+/** Take a task from the queues of other threads, visiting them from the
+ * largest total cost down.
+ * @param own :: the queue of the calling thread, which is skipped
+ * @param runnableOnly :: skip tasks whose mutex is held by a running task
+ * @return the task, or NULL if none was found
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::steal(size_t own,
+                                                         bool runnableOnly) {
+  if (empty())
+    return nullptr;
+  std::vector<std::pair<double, size_t>> victims;
+  victims.reserve(m_queues.size());
+  for (size_t i = 0; i < m_queues.size(); ++i) {
+    if (i != own)
+      victims.emplace_back(m_queues[i]->cost.load(std::memory_order_relaxed),
+                           i);
+  }
+  std::sort(victims.begin(), victims.end(),
+            [](const std::pair<double, size_t> &lhs,
+               const std::pair<double, size_t> &rhs) {
+              return lhs.first > rhs.first;
+            });
+  for (const auto &victim : victims) {
+    if (auto task = take(*m_queues[victim.second], runnableOnly))
+      return task;
+  }
+  return nullptr;
+}
+
+//-------------------------------------------------------------------------------
+/** Find or create the shared state of a mutex and count a new user of it.
+ * @param mutex :: the mutex of a task being pushed
+ * @return the state of the mutex
+ */
+std::shared_ptr<ThreadSchedulerWorkStealing::MutexState>
+ThreadSchedulerWorkStealing::acquireState(std::shared_ptr<std::mutex> mutex) {
+  std::lock_guard<std::mutex> lock(m_queueLock);
+  auto &state = m_mutexStates[std::move(mutex)];
+  if (!state)
+    state = std::make_shared<MutexState>();
+  ++state->users;
+  return state;
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,211 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/TimeSeriesColumns.h"
+
+#include <algorithm>
+#include <string>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Append an unsigned integer, 7 bits per byte, lowest bits first
+void encode(uint64_t value, std::vector<uint8_t> &out) {
+  while (value >= 0x80) {
+    out.emplace_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.emplace_back(static_cast<uint8_t>(value));
+}
+
+/// Read an unsigned integer written by encode(), moving offset past it
+uint64_t decode(const std::vector<uint8_t> &in, std::size_t &offset) {
+  uint64_t value = 0;
+  unsigned shift = 0;
+  uint8_t byte;
+  do {
+    byte = in[offset++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return value;
+}
+
+/// @return the bytes used by a vector of values
+template <typename TYPE>
+std::size_t valueBytes(const std::vector<TYPE> &values) {
+  return values.capacity() * sizeof(TYPE);
+}
+
+template <> std::size_t valueBytes(const std::vector<bool> &values) {
+  return values.capacity() / 8;
+}
+} // namespace
+
+/** Constructor
+ * @param columns :: the entries to read
+ * @param index :: index of the first entry to read. If it is past the last
+ * entry the cursor is at the end.
+ */
+template <typename TYPE>
+TimeSeriesColumns<TYPE>::TimeCursor::TimeCursor(
+    const TimeSeriesColumns &columns, std::size_t index)
+    : m_columns(&columns), m_index(index), m_offset(0), m_time(0) {
+  if (index >= columns.size()) {
+    m_index = columns.size();
+    return;
+  }
+  const auto &block = columns.m_blocks[index / BLOCK_SIZE];
+  m_time = block.time;
+  m_offset = block.offset;
+  for (std::size_t i = 0; i < index % BLOCK_SIZE; ++i)
+    m_time = static_cast<int64_t>(static_cast<uint64_t>(m_time) +
+                                  decode(columns.m_deltas, m_offset));
+}
+
+/// Move to the next entry
+template <typename TYPE> void TimeSeriesColumns<TYPE>::TimeCursor::next() {
+  if (++m_index >= m_columns->size()) {
+    m_index = m_columns->size();
+    return;
+  }
+  if (m_index % BLOCK_SIZE == 0) {
+    const auto &block = m_columns->m_blocks[m_index / BLOCK_SIZE];
+    m_time = block.time;
+    m_offset = block.offset;
+  } else {
+    m_time = static_cast<int64_t>(static_cast<uint64_t>(m_time) +
+                                  decode(m_columns->m_deltas, m_offset));
+  }
+}
+
+/// Remove every entry
+template <typename TYPE> void TimeSeriesColumns<TYPE>::clear() {
+  m_blocks.clear();
+  m_deltas.clear();
+  m_values.clear();
+  m_lastTime = 0;
+}
+
+/** Reserve memory for a number of entries, assuming that a time difference
+ * takes 4 bytes
+ * @param size :: the number of entries
+ */
+template <typename TYPE>
+void TimeSeriesColumns<TYPE>::reserve(std::size_t size) {
+  m_blocks.reserve(size / BLOCK_SIZE + 1);
+  m_deltas.reserve(4 * size);
+  m_values.reserve(size);
+}
+
+/// Release the memory reserved but not used
+template <typename TYPE> void TimeSeriesColumns<TYPE>::shrinkToFit() {
+  m_blocks.shrink_to_fit();
+  m_deltas.shrink_to_fit();
+  m_values.shrink_to_fit();
+}
+
+/** Add an entry at the end
+ * @param time :: time in nanoseconds, no earlier than the last entry
+ * @param value :: the value
+ * @return false, leaving the entries unchanged, if time is earlier than the
+ * time of the last entry
+ */
+template <typename TYPE>
+bool TimeSeriesColumns<TYPE>::append(int64_t time, const TYPE &value) {
+  if (!empty() && time < m_lastTime)
+    return false;
+  if (size() % BLOCK_SIZE == 0)
+    m_blocks.push_back({time, m_deltas.size()});
+  else
+    encode(static_cast<uint64_t>(time) - static_cast<uint64_t>(m_lastTime),
+           m_deltas);
+  m_values.emplace_back(value);
+  m_lastTime = time;
+  return true;
+}
+
+/** @param index :: index of an entry, which must exist
+ * @return its time in nanoseconds
+ */
+template <typename TYPE>
+int64_t TimeSeriesColumns<TYPE>::time(std::size_t index) const {
+  return TimeCursor(*this, index).time();
+}
+
+/// @return the time of every entry in nanoseconds
+template <typename TYPE>
+std::vector<int64_t> TimeSeriesColumns<TYPE>::times() const {
+  std::vector<int64_t> out;
+  out.reserve(size());
+  for (TimeCursor cursor(*this, 0); cursor.index() < size(); cursor.next())
+    out.emplace_back(cursor.time());
+  return out;
+}
+
+/** @param time :: time in nanoseconds
+ * @return the index of the first entry not earlier than time, or size()
+ */
+template <typename TYPE>
+std::size_t TimeSeriesColumns<TYPE>::lowerBound(int64_t time) const {
+  return search(time, [](int64_t entry, int64_t t) { return entry < t; });
+}
+
+/** @param time :: time in nanoseconds
+ * @return the index of the first entry later than time, or size()
+ */
+template <typename TYPE>
+std::size_t TimeSeriesColumns<TYPE>::upperBound(int64_t time) const {
+  return search(time, [](int64_t entry, int64_t t) { return entry <= t; });
+}
+
+/// @return the memory used, in bytes
+template <typename TYPE>
+std::size_t TimeSeriesColumns<TYPE>::memorySize() const {
+  return m_blocks.capacity() * sizeof(Block) + m_deltas.capacity() +
+         valueBytes(m_values);
+}
+
+/** Find the first entry whose time is not before a given time
+ * @param time :: time in nanoseconds
+ * @param before :: comparison of the time of an entry with time
+ * @return the index of the entry, or size()
+ */
+template <typename TYPE>
+template <typename Before>
+std::size_t TimeSeriesColumns<TYPE>::search(int64_t time,
+                                            Before before) const {
+  // The entry is in the block before the first block starting after it, or
+  // is the first entry of that block
+  const auto block = std::partition_point(
+      m_blocks.cbegin(), m_blocks.cend(),
+      [&before, time](const Block &b) { return before(b.time, time); });
+  const auto blockIndex = static_cast<std::size_t>(block - m_blocks.cbegin());
+  if (blockIndex == 0)
+    return 0;
+  const std::size_t end = std::min(blockIndex * BLOCK_SIZE, size());
+  for (TimeCursor cursor(*this, (blockIndex - 1) * BLOCK_SIZE);
+       cursor.index() < end; cursor.next()) {
+    if (!before(cursor.time(), time))
+      return cursor.index();
+  }
+  return end;
+}
+
+/// @cond
+template class TimeSeriesColumns<int32_t>;
+template class TimeSeriesColumns<int64_t>;
+template class TimeSeriesColumns<uint32_t>;
+template class TimeSeriesColumns<uint64_t>;
+template class TimeSeriesColumns<float>;
+template class TimeSeriesColumns<double>;
+template class TimeSeriesColumns<std::string>;
+template class TimeSeriesColumns<bool>;
+/// @endcond
+
+} // namespace Kernel
+} // namespace Mantid
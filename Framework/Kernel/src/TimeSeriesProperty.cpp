@@ -14,6 +14,7 @@
 #include <nexus/NeXusFile.hpp>
 
 #include <boost/regex.hpp>
+#include <algorithm>
 #include <numeric>
 
 namespace Mantid {
@@ -31,7 +32,8 @@ Logger g_log("TimeSeriesProperty");
 template <typename TYPE>
 TimeSeriesProperty<TYPE>::TimeSeriesProperty(const std::string &name)
     : Property(name, typeid(std::vector<TimeValueUnit<TYPE>>)), m_values(),
-      m_size(), m_propSortedFlag(), m_filterApplied() {}
+      m_columns(), m_size(), m_propSortedFlag(), m_filterApplied(),
+      m_storage(TimeSeriesStorageType::TSROWS) {}
 
 /**
  * Constructor
@@ -90,6 +92,7 @@ TimeSeriesProperty<TYPE>::cloneWithTimeShift(const double timeShift) const {
 template <typename TYPE>
 std::unique_ptr<TimeSeriesProperty<double>>
 TimeSeriesProperty<TYPE>::getDerivative() const {
+  this->toRows();
 
   if (this->m_values.size() < 2) {
     throw std::runtime_error("Derivative is not defined for a time-series "
@@ -131,6 +134,8 @@ TimeSeriesProperty<std::string>::getDerivative() const {
  * */
 template <typename TYPE>
 size_t TimeSeriesProperty<TYPE>::getMemorySize() const {
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return m_columns.memorySize();
   // Rough estimate
   return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime));
 }
@@ -157,9 +162,14 @@ operator+=(Property const *right) {
 
   if (rhs) {
     if (this->operator!=(*rhs)) {
-      m_values.insert(m_values.end(), rhs->m_values.begin(),
-                      rhs->m_values.end());
-      m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      if (m_storage == TimeSeriesStorageType::TSCOLUMNS ||
+          rhs->m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+        addValues(rhs->timesAsVector(), rhs->valuesAsVector());
+      } else {
+        m_values.insert(m_values.end(), rhs->m_values.begin(),
+                        rhs->m_values.end());
+        m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      }
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
       // the same anyway
@@ -167,7 +177,7 @@ operator+=(Property const *right) {
     }
 
     // Count the REAL size.
-    m_size = static_cast<int>(m_values.size());
+    m_size = realSize();
 
   } else
     g_log.warning() << "TimeSeriesProperty " << this->name()
@@ -284,6 +294,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(
     const Types::Core::DateAndTime &start,
     const Types::Core::DateAndTime &stop) {
   // 0. Sort
+  toRows();
   sortIfNecessary();
 
   // 1. Do nothing for single (constant) value
@@ -345,10 +356,17 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   sortIfNecessary();
 
   // 2. Return for single value
-  if (m_values.size() <= 1) {
+  if (realSize() <= 1) {
     return;
   }
 
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    if (filterColumnsByTimes(splittervec))
+      return;
+    // The intervals overlap or are out of order
+    toRows();
+  }
+
   // 3. Prepare a copy
   std::vector<TimeValueUnit<TYPE>> mp_copy;
 
@@ -409,6 +427,48 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   m_size = static_cast<int>(m_values.size());
 }
 
+/**
+ * Filter the columns by a range of times, as filterByTimes()
+ * @param splittervec :: A list of intervals to split filter on
+ * @return false, leaving the columns unchanged, if the entries kept would not
+ * be in order of time
+ */
+template <typename TYPE>
+bool TimeSeriesProperty<TYPE>::filterColumnsByTimes(
+    const std::vector<SplittingInterval> &splittervec) {
+  const int numEntries = realSize();
+  TimeSeriesColumns<TYPE> filtered;
+  for (const auto &splitter : splittervec) {
+    // Clip the indices to the entries as the rows do
+    const int tstartindex =
+        std::min(std::max(findIndex(splitter.start()), 0), numEntries - 1);
+    int tstopindex = findIndex(splitter.stop());
+    if (tstopindex < 0) {
+      tstopindex = 0;
+    } else if (tstopindex >= numEntries) {
+      tstopindex = numEntries - 1;
+    } else if (tstopindex > 0 && splitter.stop().totalNanoseconds() ==
+                                     m_columns.time(tstopindex)) {
+      tstopindex--;
+    }
+
+    if (!filtered.append(splitter.start().totalNanoseconds(),
+                         m_columns.value(tstartindex)))
+      return false;
+    for (typename TimeSeriesColumns<TYPE>::TimeCursor cursor(m_columns,
+                                                             tstartindex + 1);
+         static_cast<int>(cursor.index()) <= tstopindex; cursor.next()) {
+      if (!filtered.append(cursor.time(), m_columns.value(cursor.index())))
+        return false;
+    }
+  }
+
+  filtered.shrinkToFit();
+  m_columns = std::move(filtered);
+  m_size = realSize();
+  return true;
+}
+
 /**
  * Split this time series property by time intervals to multiple time series
  * property according to number of distinct splitters' indexes, such as 0 and 1
@@ -428,6 +488,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(
     std::vector<SplittingInterval> &splitter, std::vector<Property *> outputs,
     bool isPeriodic) const {
   // 0. Sort if necessary
+  toRows();
   sortIfNecessary();
 
   if (outputs.empty())
@@ -441,6 +502,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(
     auto *myOutput = dynamic_cast<TimeSeriesProperty<TYPE> *>(outputs[i]);
     if (myOutput) {
       outputs_tsp.emplace_back(myOutput);
+      myOutput->toRows();
       if (this->m_values.size() == 1) {
         // Special case for TSP with a single entry = just copy.
         myOutput->m_values = this->m_values;
@@ -561,6 +623,14 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(
   if (output.empty())
     return;
 
+  // outputs with no entries yet are held as this property is
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    for (auto *tsp : output) {
+      if (tsp->realSize() == 0)
+        tsp->setStorageType(m_storage);
+    }
+  }
+
   sortIfNecessary();
 
   // work on m_values, m_size, and m_time
@@ -710,7 +780,7 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
   split.clear();
 
   // Do nothing if the log is empty.
-  if (m_values.empty())
+  if (realSize() == 0)
     return;
 
   // 1. Sort
@@ -723,11 +793,10 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
   DateAndTime t;
   DateAndTime start, stop;
 
-  for (size_t i = 0; i < m_values.size(); ++i) {
+  forEachEntry(0, realSize(), [&](const DateAndTime &time, const TYPE &val) {
     const DateAndTime lastTime = t;
     // The new entry
-    t = m_values[i].time();
-    TYPE val = m_values[i].value();
+    t = time;
 
     // A good value?
     const bool isGood = ((val >= min) && (val <= max));
@@ -752,7 +821,7 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
       }
       lastGood = isGood;
     }
-  }
+  });
 
   if (numgood > 0) {
     // The log ended on "good" so we need to close it using the last time we
@@ -873,7 +942,7 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
 
   // If there's just a single value in the log, return that.
   if (realSize() == 1) {
-    return static_cast<double>(m_values.front().value());
+    return static_cast<double>(firstValue());
   }
 
   sortIfNecessary();
@@ -889,14 +958,15 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
     double value = getSingleValue(time.start(), index);
     DateAndTime startTime = time.start();
 
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator +=
-          DateAndTime::secondsFromDuration(m_values[index].time() - startTime) *
-          value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-    }
+    // Add the entries up to the end of the filter range
+    forEachEntry(index + 1, lowerBoundIndex(time.stop()),
+                 [&](const DateAndTime &entryTime, const TYPE &entryValue) {
+                   numerator += DateAndTime::secondsFromDuration(entryTime -
+                                                                 startTime) *
+                                value;
+                   startTime = entryTime;
+                   value = static_cast<double>(entryValue);
+                 });
 
     // Now close off with the end of the current filter range
     numerator +=
@@ -958,16 +1028,15 @@ std::pair<double, double> TimeSeriesProperty<TYPE>::averageAndStdDevInFilter(
     double valuestddev = (value - mean) * (value - mean);
     DateAndTime startTime = time.start();
 
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-
-      numerator +=
-          DateAndTime::secondsFromDuration(m_values[index].time() - startTime) *
-          valuestddev;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-      valuestddev = (value - mean) * (value - mean);
-    }
+    forEachEntry(index + 1, lowerBoundIndex(time.stop()),
+                 [&](const DateAndTime &entryTime, const TYPE &entryValue) {
+                   numerator += DateAndTime::secondsFromDuration(entryTime -
+                                                                 startTime) *
+                                valuestddev;
+                   startTime = entryTime;
+                   value = static_cast<double>(entryValue);
+                   valuestddev = (value - mean) * (value - mean);
+                 });
 
     // Now close off with the end of the current filter range
     numerator +=
@@ -1013,10 +1082,10 @@ TimeSeriesProperty<TYPE>::valueAsCorrectMap() const {
   // 2. Data Strcture
   std::map<DateAndTime, TYPE> asMap;
 
-  if (!m_values.empty()) {
-    for (size_t i = 0; i < m_values.size(); i++)
-      asMap[m_values[i].time()] = m_values[i].value();
-  }
+  forEachEntry(0, realSize(), [&asMap](const DateAndTime &time,
+                                       const TYPE &value) {
+    asMap[time] = value;
+  });
 
   return asMap;
 }
@@ -1027,6 +1096,9 @@ TimeSeriesProperty<TYPE>::valueAsCorrectMap() const {
  */
 template <typename TYPE>
 std::vector<TYPE> TimeSeriesProperty<TYPE>::valuesAsVector() const {
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return m_columns.values();
+
   sortIfNecessary();
 
   std::vector<TYPE> out;
@@ -1049,11 +1121,10 @@ std::multimap<DateAndTime, TYPE>
 TimeSeriesProperty<TYPE>::valueAsMultiMap() const {
   std::multimap<DateAndTime, TYPE> asMultiMap;
 
-  if (!m_values.empty()) {
-    for (size_t i = 0; i < m_values.size(); i++)
-      asMultiMap.insert(
-          std::make_pair(m_values[i].time(), m_values[i].value()));
-  }
+  forEachEntry(0, realSize(),
+               [&asMultiMap](const DateAndTime &time, const TYPE &value) {
+                 asMultiMap.insert(std::make_pair(time, value));
+               });
 
   return asMultiMap;
 }
@@ -1064,9 +1135,15 @@ TimeSeriesProperty<TYPE>::valueAsMultiMap() const {
  */
 template <typename TYPE>
 std::vector<DateAndTime> TimeSeriesProperty<TYPE>::timesAsVector() const {
+  std::vector<DateAndTime> out;
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    const auto times = m_columns.times();
+    out.assign(times.cbegin(), times.cend());
+    return out;
+  }
+
   sortIfNecessary();
 
-  std::vector<DateAndTime> out;
   out.reserve(m_values.size());
 
   for (size_t i = 0; i < m_values.size(); i++) {
@@ -1113,13 +1190,15 @@ std::vector<double> TimeSeriesProperty<TYPE>::timesAsVectorSeconds() const {
 
   // 2. Output data structure
   std::vector<double> out;
-  out.reserve(m_values.size());
+  out.reserve(realSize());
+  if (realSize() == 0)
+    return out;
 
-  Types::Core::DateAndTime start = m_values[0].time();
-  for (size_t i = 0; i < m_values.size(); i++) {
-    out.emplace_back(
-        DateAndTime::secondsFromDuration(m_values[i].time() - start));
-  }
+  const Types::Core::DateAndTime start = firstTime();
+  forEachEntry(0, realSize(), [&out, &start](const DateAndTime &time,
+                                              const TYPE &) {
+    out.emplace_back(DateAndTime::secondsFromDuration(time - start));
+  });
 
   return out;
 }
@@ -1132,6 +1211,16 @@ std::vector<double> TimeSeriesProperty<TYPE>::timesAsVectorSeconds() const {
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time,
                                         const TYPE value) {
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    if (m_columns.append(time.totalNanoseconds(), value)) {
+      m_size++;
+      m_filterApplied = false;
+      return;
+    }
+    // Out of order: the rows are sorted when needed
+    toRows();
+  }
+
   TimeValueUnit<TYPE> newvalue(time, value);
   // Add the value to the back of the vector
   m_values.emplace_back(newvalue);
@@ -1194,7 +1283,17 @@ void TimeSeriesProperty<TYPE>::addValues(
     const std::vector<TYPE> &values) {
   size_t length = std::min(times.size(), values.size());
   m_size += static_cast<int>(length);
-  for (size_t i = 0; i < length; ++i) {
+  size_t i = 0;
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    while (i < length &&
+           m_columns.append(times[i].totalNanoseconds(), values[i]))
+      ++i;
+    if (i == length)
+      return;
+    // Out of order: keep the rest in rows
+    toRows();
+  }
+  for (; i < length; ++i) {
     m_values.emplace_back(times[i], values[i]);
   }
 
@@ -1221,13 +1320,16 @@ void TimeSeriesProperty<TYPE>::replaceValues(
  */
 template <typename TYPE>
 DateAndTime TimeSeriesProperty<TYPE>::lastTime() const {
-  if (m_values.empty()) {
+  if (realSize() == 0) {
     const std::string error("lastTime(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
     throw std::runtime_error(error);
   }
 
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return DateAndTime(m_columns.lastTime());
+
   sortIfNecessary();
 
   return m_values.rbegin()->time();
@@ -1237,13 +1339,16 @@ DateAndTime TimeSeriesProperty<TYPE>::lastTime() const {
  *  @return Value
  */
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::firstValue() const {
-  if (m_values.empty()) {
+  if (realSize() == 0) {
     const std::string error("firstValue(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
     throw std::runtime_error(error);
   }
 
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return m_columns.value(0);
+
   sortIfNecessary();
 
   return m_values[0].value();
@@ -1254,13 +1359,16 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::firstValue() const {
  */
 template <typename TYPE>
 DateAndTime TimeSeriesProperty<TYPE>::firstTime() const {
-  if (m_values.empty()) {
+  if (realSize() == 0) {
     const std::string error("firstTime(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
     throw std::runtime_error(error);
   }
 
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return DateAndTime(m_columns.firstTime());
+
   sortIfNecessary();
 
   return m_values[0].time();
@@ -1271,25 +1379,34 @@ DateAndTime TimeSeriesProperty<TYPE>::firstTime() const {
  *  @return Value
  */
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::lastValue() const {
-  if (m_values.empty()) {
+  if (realSize() == 0) {
     const std::string error("lastValue(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
     throw std::runtime_error(error);
   }
 
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return m_columns.value(m_columns.size() - 1);
+
   sortIfNecessary();
 
   return m_values.rbegin()->value();
 }
 
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::minValue() const {
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return *std::min_element(m_columns.values().cbegin(),
+                             m_columns.values().cend());
   return std::min_element(m_values.begin(), m_values.end(),
                           TimeValueUnit<TYPE>::valueCmp)
       ->value();
 }
 
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::maxValue() const {
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return *std::max_element(m_columns.values().cbegin(),
+                             m_columns.values().cend());
   return std::max_element(m_values.begin(), m_values.end(),
                           TimeValueUnit<TYPE>::valueCmp)
       ->value();
@@ -1312,6 +1429,8 @@ template <typename TYPE> int TimeSeriesProperty<TYPE>::size() const {
  * the number of entries, including repeated ones.
  */
 template <typename TYPE> int TimeSeriesProperty<TYPE>::realSize() const {
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return static_cast<int>(m_columns.size());
   return static_cast<int>(m_values.size());
 }
 
@@ -1323,17 +1442,18 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::value() const {
   sortIfNecessary();
 
   std::stringstream ins;
-  for (size_t i = 0; i < m_values.size(); i++) {
+  forEachEntry(0, realSize(), [&ins](const DateAndTime &time,
+                                     const TYPE &value) {
     try {
-      ins << m_values[i].time().toSimpleString();
-      ins << "  " << m_values[i].value() << "\n";
+      ins << time.toSimpleString();
+      ins << "  " << value << "\n";
     } catch (...) {
       // Some kind of error; for example, invalid year, can occur when
       // converting boost time.
       ins << "Error Error"
           << "\n";
     }
-  }
+  });
 
   return ins.str();
 }
@@ -1347,13 +1467,14 @@ std::vector<std::string> TimeSeriesProperty<TYPE>::time_tValue() const {
   sortIfNecessary();
 
   std::vector<std::string> values;
-  values.reserve(m_values.size());
+  values.reserve(realSize());
 
-  for (size_t i = 0; i < m_values.size(); i++) {
+  forEachEntry(0, realSize(), [&values](const DateAndTime &time,
+                                        const TYPE &value) {
     std::stringstream line;
-    line << m_values[i].time().toSimpleString() << " " << m_values[i].value();
+    line << time.toSimpleString() << " " << value;
     values.emplace_back(line.str());
-  }
+  });
 
   return values;
 }
@@ -1373,19 +1494,20 @@ std::map<DateAndTime, TYPE> TimeSeriesProperty<TYPE>::valueAsMap() const {
   // 2. Build map
 
   std::map<DateAndTime, TYPE> asMap;
-  if (m_values.empty())
+  if (realSize() == 0)
     return asMap;
 
-  TYPE d = m_values[0].value();
-  asMap[m_values[0].time()] = d;
+  TYPE d = firstValue();
+  asMap[firstTime()] = d;
 
-  for (size_t i = 1; i < m_values.size(); i++) {
-    if (m_values[i].value() != d) {
+  forEachEntry(1, realSize(), [&asMap, &d](const DateAndTime &time,
+                                           const TYPE &value) {
+    if (value != d) {
       // Only put entry with different value from last entry to map
-      asMap[m_values[i].time()] = m_values[i].value();
-      d = m_values[i].value();
+      asMap[time] = value;
+      d = value;
     }
-  }
+  });
   return asMap;
 }
 
@@ -1431,6 +1553,7 @@ std::string TimeSeriesProperty<TYPE>::setDataItem(
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
   m_size = 0;
   m_values.clear();
+  m_columns.clear();
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
@@ -1444,7 +1567,14 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
  * requirement.
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clearOutdated() {
-  if (realSize() > 1) {
+  if (realSize() > 1 && m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    // The columns are sorted so the last entry is the most recent
+    const auto time = m_columns.lastTime();
+    const TYPE value = lastValue();
+    clear();
+    m_columns.append(time, value);
+    m_size = 1;
+  } else if (realSize() > 1) {
     auto lastValue = m_values.back();
     clear();
     m_values.emplace_back(lastValue);
@@ -1493,6 +1623,10 @@ void TimeSeriesProperty<TYPE>::create(
                                 "for the time and values vectors.");
 
   clear();
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    addValues(new_times, new_values);
+    return;
+  }
   m_values.reserve(new_times.size());
 
   std::size_t num = new_values.size();
@@ -1519,13 +1653,18 @@ void TimeSeriesProperty<TYPE>::create(
 template <typename TYPE>
 TYPE TimeSeriesProperty<TYPE>::getSingleValue(
     const Types::Core::DateAndTime &t) const {
-  if (m_values.empty()) {
+  if (realSize() == 0) {
     const std::string error("getSingleValue(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
     throw std::runtime_error(error);
   }
 
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    const int index = std::min(std::max(findIndex(t), 0), realSize() - 1);
+    return m_columns.value(static_cast<size_t>(index));
+  }
+
   // 1. Get sorted
   sortIfNecessary();
 
@@ -1568,13 +1707,18 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(
 template <typename TYPE>
 TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t,
                                               int &index) const {
-  if (m_values.empty()) {
+  if (realSize() == 0) {
     const std::string error("getSingleValue(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
     throw std::runtime_error(error);
   }
 
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    index = std::min(std::max(findIndex(t), 0), realSize() - 1);
+    return m_columns.value(static_cast<size_t>(index));
+  }
+
   // 1. Get sorted
   sortIfNecessary();
 
@@ -1623,6 +1767,8 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t,
  */
 template <typename TYPE>
 TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
+  toRows();
+
   // 0. Throw exception
   if (m_values.empty()) {
     const std::string error("nthInterval(): TimeSeriesProperty '" + name() +
@@ -1743,7 +1889,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
   TYPE value;
 
   // 1. Throw error if property is empty
-  if (m_values.empty()) {
+  if (realSize() == 0) {
     const std::string error("nthValue(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
@@ -1755,7 +1901,10 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
 
   if (m_filter.empty()) {
     // 3. Situation 1:  No filter
-    if (static_cast<size_t>(n) < m_values.size()) {
+    if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+      value = m_columns.value(
+          std::min(static_cast<size_t>(n), m_columns.size() - 1));
+    } else if (static_cast<size_t>(n) < m_values.size()) {
       TimeValueUnit<TYPE> entry = m_values[static_cast<std::size_t>(n)];
       value = entry.value();
     } else {
@@ -1799,16 +1948,18 @@ template <typename TYPE>
 Types::Core::DateAndTime TimeSeriesProperty<TYPE>::nthTime(int n) const {
   sortIfNecessary();
 
-  if (m_values.empty()) {
+  if (realSize() == 0) {
     const std::string error("nthTime(): TimeSeriesProperty '" + name() +
                             "' is empty");
     g_log.debug(error);
     throw std::runtime_error(error);
   }
 
-  if (n < 0 || n >= static_cast<int>(m_values.size()))
-    n = static_cast<int>(m_values.size()) - 1;
+  if (n < 0 || n >= realSize())
+    n = realSize() - 1;
 
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return DateAndTime(m_columns.time(static_cast<size_t>(n)));
   return m_values[static_cast<size_t>(n)].time();
 }
 
@@ -1832,6 +1983,8 @@ Types::Core::DateAndTime TimeSeriesProperty<TYPE>::nthTime(int n) const {
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::filterWith(
     const TimeSeriesProperty<bool> *filter) {
+  // a filter needs the rows
+  toRows();
   // 1. Clear the current
   m_filter.clear();
   m_filterQuickRef.clear();
@@ -1912,7 +2065,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clearFilter() {
 template <typename TYPE> void TimeSeriesProperty<TYPE>::countSize() const {
   if (m_filter.empty()) {
     // 1. Not filter
-    m_size = int(m_values.size());
+    m_size = realSize();
   } else {
     // 2. With Filter
     if (!m_filterApplied) {
@@ -2009,6 +2162,7 @@ TimeSeriesPropertyStatistics TimeSeriesProperty<TYPE>::getStatistics() const {
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
   // 1. Sort if necessary
+  toRows();
   sortIfNecessary();
 
   // 2. Detect and Remove Duplicated
@@ -2051,12 +2205,54 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 template <typename TYPE>
 std::string TimeSeriesProperty<TYPE>::toString() const {
   std::stringstream ss;
-  for (size_t i = 0; i < m_values.size(); ++i)
-    ss << m_values[i].time() << "\t\t" << m_values[i].value() << "\n";
+  forEachEntry(0, realSize(), [&ss](const DateAndTime &time,
+                                    const TYPE &value) {
+    ss << time << "\t\t" << value << "\n";
+  });
 
   return ss.str();
 }
 
+/** Reserve memory for efficient adding values to existing property
+ * @param size :: the expected number of entries
+ */
+template <typename TYPE> void TimeSeriesProperty<TYPE>::reserve(size_t size) {
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    m_columns.reserve(size);
+  else
+    m_values.reserve(size);
+}
+
+/** Set how the entries are held. The entries are sorted when they are moved
+ * to columns. A property with a filter set by filterWith() stays in rows.
+ * @param storage :: TSROWS for a vector of TimeValueUnit, TSCOLUMNS for
+ * TimeSeriesColumns
+ */
+template <typename TYPE>
+void TimeSeriesProperty<TYPE>::setStorageType(TimeSeriesStorageType storage) {
+  if (storage == m_storage)
+    return;
+  if (storage == TimeSeriesStorageType::TSROWS) {
+    toRows();
+    return;
+  }
+  if (!m_filter.empty()) {
+    g_log.debug() << "TimeSeriesProperty " << name()
+                  << " has a filter and is kept in rows\n";
+    return;
+  }
+
+  sortIfNecessary();
+  m_columns.clear();
+  m_columns.reserve(m_values.size());
+  for (const auto &entry : m_values)
+    m_columns.append(entry.time().totalNanoseconds(), entry.value());
+  m_columns.shrinkToFit();
+  m_values.clear();
+  m_values.shrink_to_fit();
+  m_storage = storage;
+}
+
 //-------------------------------------------------------------------------
 // Private methods
 //-------------------------------------------------------------------------
@@ -2068,6 +2264,10 @@ std::string TimeSeriesProperty<TYPE>::toString() const {
  */
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
+  // the columns are always sorted
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return;
+
   if (m_propSortedFlag == TimeSeriesSortStatus::TSUNKNOWN) {
     bool sorted = is_sorted(m_values.begin(), m_values.end());
     if (sorted)
@@ -2084,6 +2284,65 @@ void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
   }
 }
 
+/*
+ * Move the entries from the columns to m_values and set the storage type to
+ * TSROWS. Does nothing if they are already in rows.
+ */
+template <typename TYPE> void TimeSeriesProperty<TYPE>::toRows() const {
+  if (m_storage == TimeSeriesStorageType::TSROWS)
+    return;
+
+  m_values.clear();
+  m_values.reserve(m_columns.size());
+  forEachEntry(0, m_columns.size(),
+               [this](const DateAndTime &time, const TYPE &value) {
+                 m_values.emplace_back(time, value);
+               });
+  m_columns.clear();
+  m_columns.shrinkToFit();
+  m_storage = TimeSeriesStorageType::TSROWS;
+  m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
+}
+
+/** Find the first entry not earlier than a time
+ * @param t :: the time
+ * @return the index of the entry, or realSize() if there is none
+ */
+template <typename TYPE>
+size_t TimeSeriesProperty<TYPE>::lowerBoundIndex(
+    const Types::Core::DateAndTime &t) const {
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS)
+    return m_columns.lowerBound(t.totalNanoseconds());
+
+  sortIfNecessary();
+  const auto entry = std::lower_bound(
+      m_values.cbegin(), m_values.cend(), t,
+      [](const TimeValueUnit<TYPE> &value, const DateAndTime &time) {
+        return value.time() < time;
+      });
+  return static_cast<size_t>(entry - m_values.cbegin());
+}
+
+/** Call a function with the time and value of a range of entries, in the order
+ * they are held. The caller sorts the entries first if it needs them sorted.
+ * @param begin :: index of the first entry
+ * @param end :: index after the last entry, at most realSize()
+ * @param f :: function taking a DateAndTime and a TYPE
+ */
+template <typename TYPE>
+template <typename Func>
+void TimeSeriesProperty<TYPE>::forEachEntry(size_t begin, size_t end,
+                                            Func &&f) const {
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    for (typename TimeSeriesColumns<TYPE>::TimeCursor cursor(m_columns, begin);
+         cursor.index() < end; cursor.next())
+      f(DateAndTime(cursor.time()), m_columns.value(cursor.index()));
+  } else {
+    for (size_t i = begin; i < end; ++i)
+      f(m_values[i].time(), m_values[i].value());
+  }
+}
+
 /** Find the index of the entry of time t in the mP vector (sorted)
  *  Return @ if t is within log.begin and log.end, then the index of the log
  * equal or just smaller than t
@@ -2092,6 +2351,20 @@ void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
  */
 template <typename TYPE>
 int TimeSeriesProperty<TYPE>::findIndex(Types::Core::DateAndTime t) const {
+  if (m_storage == TimeSeriesStorageType::TSCOLUMNS) {
+    if (m_columns.empty())
+      return 0;
+    const int64_t time = t.totalNanoseconds();
+    if (time <= m_columns.firstTime())
+      return -1;
+    else if (time >= m_columns.lastTime())
+      return static_cast<int>(m_columns.size());
+    auto index = m_columns.lowerBound(time);
+    if (m_columns.time(index) > time)
+      --index;
+    return static_cast<int>(index);
+  }
+
   // 0. Return with an empty container
   if (m_values.empty())
     return 0;
@@ -2300,14 +2573,25 @@ size_t TimeSeriesProperty<TYPE>::findNthIndexFromQuickRef(int n) const {
     // 2A.  Out side of boundary
     index = m_filterQuickRef.size();
   } else {
-    // 2B. Inside
-    for (size_t i = 0; i < m_filterQuickRef.size(); i += 4) {
-      if (static_cast<size_t>(n) >= m_filterQuickRef[i].second &&
-          static_cast<size_t>(n) < m_filterQuickRef[i + 3].second) {
-        index = i;
-        break;
+    // 2B. Inside. Each region takes 4 entries and the number of log entries
+    // before the end of a region does not decrease, so search for the first
+    // region ending after n.
+    size_t first = 0;
+    size_t count = m_filterQuickRef.size() / 4;
+    while (count > 0) {
+      const size_t step = count / 2;
+      const size_t i = 4 * (first + step);
+      if (m_filterQuickRef[i + 3].second <= static_cast<size_t>(n)) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
       }
     }
+    const size_t i = 4 * first;
+    if (i < m_filterQuickRef.size() &&
+        static_cast<size_t>(n) >= m_filterQuickRef[i].second)
+      index = i;
   }
 
   return index;
@@ -2328,6 +2612,8 @@ TimeSeriesProperty<TYPE>::setValueFromProperty(const Property &right) {
     return "Could not set value: properties have different type.";
   }
   m_values = prop->m_values;
+  m_columns = prop->m_columns;
+  m_storage = prop->m_storage;
   m_size = prop->m_size;
   m_propSortedFlag = prop->m_propSortedFlag;
   m_filter = prop->m_filter;
@@ -2455,13 +2741,14 @@ void TimeSeriesProperty<TYPE>::histogramData(
 
   double dt = (t1 - t0) / static_cast<double>(nPoints);
 
-  for (auto &ev : m_values) {
-    auto time = static_cast<double>(ev.time().totalNanoseconds());
+  forEachEntry(0, realSize(), [&](const DateAndTime &entryTime,
+                                   const TYPE &value) {
+    auto time = static_cast<double>(entryTime.totalNanoseconds());
     if (time < t0 || time >= t1)
-      continue;
+      return;
     auto ind = static_cast<size_t>((time - t0) / dt);
-    counts[ind] += static_cast<double>(ev.value());
-  }
+    counts[ind] += static_cast<double>(value);
+  });
 }
 
 template <>
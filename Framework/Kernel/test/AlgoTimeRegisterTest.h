@@ -0,0 +1,135 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/AlgoTimeRegister.h"
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/ThreadPoolRunnable.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <cxxtest/TestSuite.h>
+#include <sstream>
+
+using Mantid::Instrumentation::AlgoTimeRegister;
+
+class AlgoTimeRegisterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlgoTimeRegisterTest *createSuite() {
+    return new AlgoTimeRegisterTest();
+  }
+  static void destroySuite(AlgoTimeRegisterTest *suite) { delete suite; }
+
+  void test_nothing_is_recorded_until_enabled() {
+    AlgoTimeRegister atr;
+    TS_ASSERT(!atr.isEnabled());
+    { AlgoTimeRegister::Dump dump(atr, "Disabled"); }
+    TS_ASSERT(atr.info().empty());
+    atr.enable();
+    { AlgoTimeRegister::Dump dump(atr, "Enabled"); }
+    const auto info = atr.info();
+    TS_ASSERT_EQUALS(info.size(), 1);
+    TS_ASSERT_EQUALS(info[0].m_name, "Enabled");
+    TS_ASSERT_EQUALS(info[0].m_category, "algorithm");
+    TS_ASSERT(info[0].m_begin <= info[0].m_end);
+    atr.clear();
+  }
+
+  void test_nested_spans_and_counters() {
+    AlgoTimeRegister atr;
+    atr.enable();
+    {
+      AlgoTimeRegister::Dump parent(atr, "Parent");
+      AlgoTimeRegister::addEventsProcessed(5);
+      {
+        AlgoTimeRegister::Dump child(atr, "Child");
+        AlgoTimeRegister::addBytesRead(100);
+        AlgoTimeRegister::addEventsProcessed(10);
+      }
+      AlgoTimeRegister::addBytesRead(1);
+    }
+    // Outside any span the counts are dropped
+    TS_ASSERT_THROWS_NOTHING(AlgoTimeRegister::addBytesRead(1000));
+
+    const auto info = atr.info();
+    TS_ASSERT_EQUALS(info.size(), 2);
+    // The child finishes first
+    TS_ASSERT_EQUALS(info[0].m_name, "Child");
+    TS_ASSERT_EQUALS(info[0].m_bytes, 100);
+    TS_ASSERT_EQUALS(info[0].m_events, 10);
+    TS_ASSERT_EQUALS(info[1].m_name, "Parent");
+    TS_ASSERT_EQUALS(info[1].m_bytes, 1);
+    TS_ASSERT_EQUALS(info[1].m_events, 5);
+    TS_ASSERT(info[1].m_begin <= info[0].m_begin);
+    TS_ASSERT(info[0].m_end <= info[1].m_end);
+    atr.clear();
+  }
+
+  void test_writeTrace() {
+    AlgoTimeRegister atr;
+    atr.enable();
+    {
+      AlgoTimeRegister::Dump parent(atr, "Outer\"Alg");
+      AlgoTimeRegister::Dump child(atr, "Inner", "task");
+      AlgoTimeRegister::addBytesRead(42);
+    }
+    std::ostringstream os;
+    atr.writeTrace(os);
+    const auto trace = os.str();
+    TS_ASSERT_EQUALS(trace.front(), '{');
+    TS_ASSERT_DIFFERS(trace.find("\"traceEvents\":["), std::string::npos);
+    TS_ASSERT_DIFFERS(trace.find("\"name\":\"thread_name\",\"ph\":\"M\""),
+                      std::string::npos);
+    // Sorted by start time, so the parent comes first
+    const auto outer =
+        trace.find("{\"name\":\"Outer\\\"Alg\",\"cat\":\"algorithm\","
+                   "\"ph\":\"X\",\"ts\":");
+    const auto inner =
+        trace.find("{\"name\":\"Inner\",\"cat\":\"task\",\"ph\":\"X\"");
+    TS_ASSERT_DIFFERS(outer, std::string::npos);
+    TS_ASSERT_DIFFERS(inner, std::string::npos);
+    TS_ASSERT_LESS_THAN(outer, inner);
+    TS_ASSERT_DIFFERS(trace.find("\"args\":{\"bytes\":42,\"events\":0}"),
+                      std::string::npos);
+    TS_ASSERT_EQUALS(trace.substr(trace.size() - 4), "\n]}\n");
+
+    // The text format only lists algorithms
+    std::ostringstream text;
+    atr.writeText(text);
+    TS_ASSERT_DIFFERS(text.str().find("AlgorithmName=Outer\"Alg"),
+                      std::string::npos);
+    TS_ASSERT_EQUALS(text.str().find("Inner"), std::string::npos);
+    atr.clear();
+  }
+
+  void test_thread_pool_tasks_are_recorded() {
+    using namespace Mantid::Kernel;
+    auto &atr = AlgoTimeRegister::globalAlgoTimeRegister;
+    const bool wasEnabled = atr.isEnabled();
+    atr.enable();
+    const auto before = atr.info().size();
+    ThreadSchedulerFIFO scheduler;
+    size_t runs = 0;
+    for (int i = 0; i < 10; ++i)
+      scheduler.push(std::make_shared<FunctionTask>([&runs]() { ++runs; }));
+    // Run the tasks in this thread
+    ThreadPoolRunnable runnable(0, &scheduler);
+    runnable.run();
+    atr.enable(wasEnabled);
+    TS_ASSERT_EQUALS(runs, 10);
+
+    const auto info = atr.info();
+    TS_ASSERT_EQUALS(info.size(), before + 10);
+    for (size_t i = before; i < info.size(); ++i) {
+      TS_ASSERT_EQUALS(info[i].m_category, "task");
+      TS_ASSERT_EQUALS(info[i].m_name, "Mantid::Kernel::FunctionTask");
+    }
+    // Leave nothing for the destructor to write out
+    atr.clear();
+  }
+};
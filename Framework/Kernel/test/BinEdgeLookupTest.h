@@ -0,0 +1,166 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/BinEdgeLookup.h"
+#include "MantidKernel/VectorHelper.h"
+#include <algorithm>
+#include <cxxtest/TestSuite.h>
+#include <random>
+
+using Mantid::Kernel::BinEdgeLookup;
+
+class BinEdgeLookupTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BinEdgeLookupTest *createSuite() { return new BinEdgeLookupTest(); }
+  static void destroySuite(BinEdgeLookupTest *suite) { delete suite; }
+
+  void test_linear_edges_are_detected() {
+    const auto edges = makeEdges({0.0, 2.0, 100.0});
+    BinEdgeLookup lookup(edges);
+    TS_ASSERT_EQUALS(lookup.spacing(), BinEdgeLookup::Spacing::Linear);
+    TS_ASSERT(lookup.isArithmetic());
+    TS_ASSERT_EQUALS(lookup.numberOfBins(), 50);
+    TS_ASSERT_EQUALS(lookup.bin(0.0), 0);
+    TS_ASSERT_EQUALS(lookup.bin(1.999), 0);
+    TS_ASSERT_EQUALS(lookup.bin(2.0), 1);
+    TS_ASSERT_EQUALS(lookup.bin(99.9), 49);
+  }
+
+  void test_truncated_last_bin_is_still_linear() {
+    // The last bin is from 9 to 10
+    const auto edges = makeEdges({0.0, 3.0, 10.0});
+    BinEdgeLookup lookup(edges);
+    TS_ASSERT_EQUALS(lookup.spacing(), BinEdgeLookup::Spacing::Linear);
+    TS_ASSERT_EQUALS(lookup.bin(9.5), edges.size() - 2);
+  }
+
+  void test_logarithmic_edges_are_detected() {
+    const auto edges = makeEdges({1.0, -0.01, 1000.0});
+    BinEdgeLookup lookup(edges);
+    TS_ASSERT_EQUALS(lookup.spacing(), BinEdgeLookup::Spacing::Logarithmic);
+    TS_ASSERT(lookup.isArithmetic());
+  }
+
+  void test_mixed_edges_are_arbitrary() {
+    const auto edges = makeEdges({1.0, 1.0, 10.0, -0.1, 100.0});
+    BinEdgeLookup lookup(edges);
+    TS_ASSERT_EQUALS(lookup.spacing(), BinEdgeLookup::Spacing::Arbitrary);
+    TS_ASSERT(!lookup.isArithmetic());
+  }
+
+  void test_values_outside_edges_have_no_bin() {
+    const std::vector<double> edges{1.0, 2.0, 3.0};
+    BinEdgeLookup lookup(edges);
+    TS_ASSERT_EQUALS(lookup.bin(0.5), BinEdgeLookup::npos);
+    TS_ASSERT_EQUALS(lookup.bin(3.0), BinEdgeLookup::npos);
+    TS_ASSERT_EQUALS(lookup.bin(std::nan("")), BinEdgeLookup::npos);
+  }
+
+  void test_too_few_edges() {
+    const std::vector<double> edges{1.0};
+    BinEdgeLookup lookup(edges);
+    TS_ASSERT_EQUALS(lookup.numberOfBins(), 0);
+    TS_ASSERT_EQUALS(lookup.bin(1.0), BinEdgeLookup::npos);
+    const double x = 1.0;
+    std::size_t index = 0;
+    lookup.bins(&x, 1, &index);
+    TS_ASSERT_EQUALS(index, BinEdgeLookup::npos);
+  }
+
+  void test_bin_matches_search_for_every_spacing() {
+    checkAgainstSearch(makeEdges({-5.0, 0.1, 1000.0}));
+    checkAgainstSearch(makeEdges({100.0, 0.3, 20000.0}));
+    checkAgainstSearch(makeEdges({10.0, -0.004, 1e5}));
+    checkAgainstSearch(makeEdges({1.0, 1.0, 10.0, -0.1, 100.0}));
+    checkAgainstSearch({-3.0, -1.0, 0.0, 0.5, 7.0, 7.1, 200.0});
+  }
+
+private:
+  std::vector<double> makeEdges(const std::vector<double> &params) {
+    std::vector<double> edges;
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams(params, edges);
+    return edges;
+  }
+
+  /// Compare bin() and bins(), sorted and unsorted, with std::upper_bound
+  void checkAgainstSearch(const std::vector<double> &edges) {
+    BinEdgeLookup lookup(edges);
+    std::mt19937 generator(1234);
+    const double width = edges.back() - edges.front();
+    std::uniform_real_distribution<double> distribution(
+        edges.front() - 0.1 * width, edges.back() + 0.1 * width);
+    std::vector<double> values(1000);
+    for (auto &value : values)
+      value = distribution(generator);
+    // Values exactly on the edges are the most sensitive to rounding
+    values.insert(values.end(), edges.cbegin(), edges.cend());
+
+    for (int sorted = 0; sorted < 2; ++sorted) {
+      if (sorted)
+        std::sort(values.begin(), values.end());
+      std::vector<std::size_t> indices(values.size());
+      lookup.bins(values.data(), values.size(), indices.data());
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        const double x = values[i];
+        std::size_t expected = BinEdgeLookup::npos;
+        if (x >= edges.front() && x < edges.back())
+          expected = std::upper_bound(edges.cbegin(), edges.cend(), x) -
+                     edges.cbegin() - 1;
+        TS_ASSERT_EQUALS(lookup.bin(x), expected);
+        TS_ASSERT_EQUALS(indices[i], expected);
+      }
+    }
+  }
+};
+
+class BinEdgeLookupTestPerformance : public CxxTest::TestSuite {
+public:
+  static BinEdgeLookupTestPerformance *createSuite() {
+    return new BinEdgeLookupTestPerformance();
+  }
+  static void destroySuite(BinEdgeLookupTestPerformance *suite) {
+    delete suite;
+  }
+
+  BinEdgeLookupTestPerformance() : m_values(10000000), m_indices(10000000) {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<double> distribution(0., 100000.);
+    for (auto &value : m_values)
+      value = distribution(generator);
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams(
+        {100.0, 1.0, 99000.0}, m_linear);
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams(
+        {100.0, -0.0001, 99000.0}, m_logarithmic);
+  }
+
+  void test_linear() {
+    BinEdgeLookup lookup(m_linear);
+    lookup.bins(m_values.data(), m_values.size(), m_indices.data());
+  }
+
+  void test_logarithmic() {
+    BinEdgeLookup lookup(m_logarithmic);
+    lookup.bins(m_values.data(), m_values.size(), m_indices.data());
+  }
+
+  void test_arbitrary() {
+    auto edges = m_linear;
+    edges[1] += 0.5;
+    BinEdgeLookup lookup(edges);
+    TS_ASSERT(!lookup.isArithmetic());
+    lookup.bins(m_values.data(), m_values.size(), m_indices.data());
+  }
+
+private:
+  std::vector<double> m_values;
+  std::vector<std::size_t> m_indices;
+  std::vector<double> m_linear;
+  std::vector<double> m_logarithmic;
+};
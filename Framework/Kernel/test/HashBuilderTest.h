@@ -0,0 +1,55 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/HashBuilder.h"
+#include "MantidKernel/V3D.h"
+
+#include <string>
+#include <vector>
+
+using namespace Mantid::Kernel;
+
+class HashBuilderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static HashBuilderTest *createSuite() { return new HashBuilderTest(); }
+  static void destroySuite(HashBuilderTest *suite) { delete suite; }
+
+  void test_hash_of_nothing_is_the_offset_basis() {
+    TS_ASSERT_EQUALS(HashBuilder().value(), 14695981039346656037ull);
+    // The FNV-1a hash of "a"
+    TS_ASSERT_EQUALS(HashBuilder().add("a", 1).value(), 0xaf63dc4c8601ec8cull);
+  }
+
+  void test_hash_depends_on_values_and_their_order() {
+    const auto hash = [](double a, double b) {
+      return HashBuilder().add(a).add(b).value();
+    };
+    TS_ASSERT_EQUALS(hash(1., 2.), hash(1., 2.));
+    TS_ASSERT_DIFFERS(hash(1., 2.), hash(2., 1.));
+    TS_ASSERT_EQUALS(HashBuilder().add(V3D(1, 2, 3)).value(),
+                     HashBuilder().add(1.).add(2.).add(3.).value());
+  }
+
+  void test_lengths_keep_consecutive_values_apart() {
+    TS_ASSERT_DIFFERS(
+        HashBuilder().add(std::string("ab")).value(),
+        HashBuilder().add(std::string("a")).add(std::string("b")).value());
+    TS_ASSERT_DIFFERS(HashBuilder()
+                          .add(std::vector<double>{1., 2.})
+                          .add(std::vector<double>{})
+                          .value(),
+                      HashBuilder()
+                          .add(std::vector<double>{1.})
+                          .add(std::vector<double>{2.})
+                          .value());
+  }
+};
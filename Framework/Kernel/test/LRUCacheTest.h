@@ -0,0 +1,91 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/LRUCache.h"
+
+#include <memory>
+#include <string>
+
+using namespace Mantid::Kernel;
+
+class LRUCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LRUCacheTest *createSuite() { return new LRUCacheTest(); }
+  static void destroySuite(LRUCacheTest *suite) { delete suite; }
+
+  void test_find_returns_inserted_value() {
+    LRUCache<std::string> cache(100);
+    TS_ASSERT(!cache.find(1));
+    cache.insert(1, std::make_shared<const std::string>("one"), 10);
+    const auto found = cache.find(1);
+    TS_ASSERT(found);
+    TS_ASSERT_EQUALS(*found, "one");
+    TS_ASSERT(!cache.find(2));
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT_EQUALS(cache.memory(), 10);
+
+    cache.insert(1, std::make_shared<const std::string>("uno"), 20);
+    TS_ASSERT_EQUALS(*cache.find(1), "uno");
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT_EQUALS(cache.memory(), 20);
+    // A value dropped from the cache is still valid
+    TS_ASSERT_EQUALS(*found, "one");
+
+    cache.clear();
+    TS_ASSERT(!cache.find(1));
+    TS_ASSERT_EQUALS(cache.size(), 0);
+    TS_ASSERT_EQUALS(cache.memory(), 0);
+  }
+
+  void test_least_recently_used_values_are_dropped() {
+    LRUCache<int> cache(30);
+    cache.insert(1, std::make_shared<const int>(1), 10);
+    cache.insert(2, std::make_shared<const int>(2), 10);
+    cache.insert(3, std::make_shared<const int>(3), 10);
+    TS_ASSERT(cache.find(1));
+    cache.insert(4, std::make_shared<const int>(4), 10);
+    TS_ASSERT_EQUALS(cache.size(), 3);
+    TS_ASSERT(cache.find(1));
+    TS_ASSERT(!cache.find(2));
+    TS_ASSERT(cache.find(3));
+    TS_ASSERT(cache.find(4));
+
+    cache.setMemoryLimit(15);
+    TS_ASSERT_EQUALS(cache.memoryLimit(), 15);
+    TS_ASSERT_EQUALS(cache.size(), 1);
+    TS_ASSERT(cache.find(4));
+  }
+
+  void test_values_larger_than_the_limit_are_not_kept() {
+    LRUCache<int> cache(10);
+    cache.insert(1, std::make_shared<const int>(1), 5);
+    cache.insert(2, std::make_shared<const int>(2), 11);
+    TS_ASSERT(!cache.find(2));
+    TS_ASSERT(cache.find(1));
+    // Nor do they leave an older value with the same key
+    cache.insert(1, std::make_shared<const int>(1), 11);
+    TS_ASSERT(!cache.find(1));
+    TS_ASSERT_EQUALS(cache.memory(), 0);
+  }
+
+  void test_memory_limit_from_the_configuration() {
+    auto &config = ConfigService::Instance();
+    const std::string key("LRUCacheTest.CacheSize");
+    TS_ASSERT_EQUALS(cacheMemoryLimit(key, 2), size_t(2) << 20);
+    config.setString(key, "3");
+    TS_ASSERT_EQUALS(cacheMemoryLimit(key, 2), size_t(3) << 20);
+    config.setString(key, "-1");
+    TS_ASSERT_EQUALS(cacheMemoryLimit(key, 2), 0);
+    config.remove(key);
+  }
+};
@@ -0,0 +1,137 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/MemoryPool.h"
+
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace Mantid::Kernel;
+
+class MemoryPoolTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MemoryPoolTest *createSuite() { return new MemoryPoolTest(); }
+  static void destroySuite(MemoryPoolTest *suite) { delete suite; }
+
+  void test_no_memory_is_taken_until_used() {
+    MemoryPool pool;
+    TS_ASSERT_EQUALS(pool.capacity(), 0);
+    pool.deallocate(pool.allocate(1), 1);
+    TS_ASSERT_EQUALS(pool.capacity(), size_t(16) << 20);
+  }
+
+  void test_blocks_are_aligned() {
+    MemoryPool pool;
+    for (size_t bytes : {1, 7, 16, 17, 100, 4096, 5000}) {
+      auto *block = pool.allocate(bytes);
+      TS_ASSERT_EQUALS(reinterpret_cast<uintptr_t>(block) %
+                           MemoryPool::MinBlockSize,
+                       0);
+      pool.deallocate(block, bytes);
+    }
+  }
+
+  void test_freed_blocks_are_reused() {
+    MemoryPool pool;
+    auto *first = pool.allocate(100);
+    pool.deallocate(first, 100);
+    // Same size class
+    auto *second = pool.allocate(120);
+    TS_ASSERT_EQUALS(first, second);
+    // Different size class
+    auto *third = pool.allocate(20);
+    TS_ASSERT_DIFFERS(first, third);
+    pool.deallocate(second, 120);
+    pool.deallocate(third, 20);
+  }
+
+  void test_large_blocks_are_not_taken_from_slabs() {
+    MemoryPool pool;
+    const size_t bytes = MemoryPool::MaxBlockSize + 1;
+    auto *block = static_cast<char *>(pool.allocate(bytes));
+    block[bytes - 1] = 1;
+    pool.deallocate(block, bytes);
+    TS_ASSERT_EQUALS(pool.capacity(), 0);
+  }
+
+  void test_reserve() {
+    MemoryPool pool(MemoryPool::MaxBlockSize);
+    pool.reserve(100);
+    TS_ASSERT_EQUALS(pool.capacity(), MemoryPool::MaxBlockSize);
+    // Fits in the current slab
+    pool.reserve(1000);
+    TS_ASSERT_EQUALS(pool.capacity(), MemoryPool::MaxBlockSize);
+    pool.reserve(3 * MemoryPool::MaxBlockSize);
+    TS_ASSERT_EQUALS(pool.capacity(), 4 * MemoryPool::MaxBlockSize);
+    // Allocating what was reserved takes no more memory
+    for (size_t i = 0; i < 3; ++i)
+      pool.allocate(MemoryPool::MaxBlockSize);
+    TS_ASSERT_EQUALS(pool.capacity(), 4 * MemoryPool::MaxBlockSize);
+  }
+
+  void test_allocator_in_vector() {
+    auto pool = std::make_shared<MemoryPool>();
+    std::vector<double, PoolAllocator<double>> values{
+        PoolAllocator<double>(pool)};
+    for (size_t i = 0; i < 100000; ++i)
+      values.emplace_back(static_cast<double>(i));
+    TS_ASSERT_EQUALS(std::accumulate(values.begin(), values.end(), 0.0),
+                     4999950000.0);
+    auto copy = values;
+    TS_ASSERT(copy.get_allocator() == values.get_allocator());
+  }
+
+  void test_allocator_keeps_pool_alive() {
+    std::weak_ptr<MemoryPool> weakPool;
+    {
+      auto pool = std::make_shared<MemoryPool>();
+      weakPool = pool;
+      std::vector<int, PoolAllocator<int>> values{PoolAllocator<int>(pool)};
+      pool.reset();
+      values.assign(1000, 3);
+      TS_ASSERT(!weakPool.expired());
+      TS_ASSERT_EQUALS(values.back(), 3);
+    }
+    TS_ASSERT(weakPool.expired());
+  }
+
+  void test_allocators_of_different_pools_differ() {
+    PoolAllocator<int> a(std::make_shared<MemoryPool>());
+    PoolAllocator<char> b(std::make_shared<MemoryPool>());
+    TS_ASSERT(a != b);
+    TS_ASSERT(a == PoolAllocator<int>(PoolAllocator<char>(a)));
+  }
+
+  void test_threads() {
+    auto pool = std::make_shared<MemoryPool>(MemoryPool::MaxBlockSize);
+    std::vector<std::thread> threads;
+    std::vector<size_t> sums(8);
+    for (size_t t = 0; t < sums.size(); ++t)
+      threads.emplace_back([&pool, &sums, t] {
+        for (size_t round = 0; round < 50; ++round) {
+          std::vector<size_t, PoolAllocator<size_t>> values{
+              PoolAllocator<size_t>(pool)};
+          for (size_t i = 0; i < 1000 * (t + 1); ++i)
+            values.emplace_back(i);
+          sums[t] = std::accumulate(values.begin(), values.end(), size_t(0));
+        }
+      });
+    for (auto &thread : threads)
+      thread.join();
+    for (size_t t = 0; t < sums.size(); ++t) {
+      const size_t n = 1000 * (t + 1);
+      TS_ASSERT_EQUALS(sums[t], n * (n - 1) / 2);
+    }
+  }
+};
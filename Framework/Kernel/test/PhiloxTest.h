@@ -0,0 +1,120 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/Philox.h"
+#include <cxxtest/TestSuite.h>
+
+using Mantid::Kernel::Philox;
+
+class PhiloxTest : public CxxTest::TestSuite {
+
+public:
+  void test_Blocks_Match_Known_Answers() {
+    // The known answer tests of the reference implementation, Random123
+    TS_ASSERT_EQUALS(Philox::generateBlock({0, 0, 0, 0}, {0, 0}),
+                     Philox::Block({0x6627e8d5, 0xe169c58d, 0xbc57ac4c,
+                                    0x9b00dbd8}));
+    TS_ASSERT_EQUALS(Philox::generateBlock({0xffffffff, 0xffffffff,
+                                            0xffffffff, 0xffffffff},
+                                           {0xffffffff, 0xffffffff}),
+                     Philox::Block({0x408f276d, 0x41c83b0e, 0xa20bc7c6,
+                                    0x6d5451fd}));
+    TS_ASSERT_EQUALS(Philox::generateBlock({0x243f6a88, 0x85a308d3,
+                                            0x13198a2e, 0x03707344},
+                                           {0xa4093822, 0x299f31d0}),
+                     Philox::Block({0xd16cfe09, 0x94fdcceb, 0x5001e420,
+                                    0x24126ea1}));
+  }
+
+  void test_That_Next_For_Given_Seed_Returns_Same_Value() {
+    Philox gen_1(212437999), gen_2(212437999);
+    TS_ASSERT_EQUALS(gen_1.nextValue(), gen_2.nextValue());
+  }
+
+  void test_That_Next_For_Different_Seeds_Returns_Different_Values() {
+    Philox gen_1(212437999), gen_2(247021340);
+    TS_ASSERT_DIFFERS(gen_1.nextValue(), gen_2.nextValue());
+  }
+
+  void test_Streams_Do_Not_Depend_On_The_Order_They_Are_Used_In() {
+    Philox randGen(39857239);
+    randGen.setStream(7, 3);
+    const auto first = doNextValueCalls(10, randGen);
+    randGen.setStream(8);
+    const auto other = doNextValueCalls(10, randGen);
+    TS_ASSERT_DIFFERS(first, other);
+
+    Philox another(39857239);
+    doNextValueCalls(25, another);
+    another.setStream(7, 3);
+    TS_ASSERT_EQUALS(doNextValueCalls(10, another), first);
+    another.setStream(7, 4);
+    TS_ASSERT_DIFFERS(doNextValueCalls(10, another), first);
+  }
+
+  void test_That_A_Restart_Gives_Same_Sequence_Again_From_Start() {
+    Philox randGen(39857239);
+    randGen.setStream(12);
+    const auto first = doNextValueCalls(11, randGen);
+    randGen.restart();
+    TS_ASSERT_EQUALS(doNextValueCalls(11, randGen), first);
+  }
+
+  void
+  test_That_Save_Then_Call_Next_Value_And_Restore_Gives_Sequence_From_Saved_Point() {
+    Philox randGen(1);
+    doNextValueCalls(5, randGen);
+    randGen.save();
+    const auto first = doNextValueCalls(50, randGen);
+    randGen.restore();
+    TS_ASSERT_EQUALS(doNextValueCalls(50, randGen), first);
+    randGen.restore();
+    TS_ASSERT_EQUALS(doNextValueCalls(50, randGen), first);
+  }
+
+  void test_That_Values_Are_In_Range_And_Evenly_Spread() {
+    Philox randGen(1, 2.0, 3.0);
+    std::vector<int> counts(10, 0);
+    const int nvalues(100000);
+    for (int i = 0; i < nvalues; ++i) {
+      const double value = randGen.nextValue();
+      TS_ASSERT(value >= 2.0 && value < 3.0);
+      ++counts[static_cast<size_t>((value - 2.0) * 10)];
+    }
+    for (const auto count : counts) {
+      TS_ASSERT_DELTA(count, nvalues / 10, 500);
+    }
+    const double value = randGen.nextValue(-1.0, -0.5);
+    TS_ASSERT(value >= -1.0 && value < -0.5);
+  }
+
+  void test_That_Integers_Cover_The_Whole_Range() {
+    Philox randGen(1);
+    std::vector<int> counts(6, 0);
+    for (int i = 0; i < 6000; ++i) {
+      const int value = randGen.nextInt(-2, 3);
+      TS_ASSERT(value >= -2 && value <= 3);
+      ++counts[value + 2];
+    }
+    for (const auto count : counts) {
+      TS_ASSERT_DELTA(count, 1000, 150);
+    }
+    TS_ASSERT_EQUALS(randGen.nextInt(4, 4), 4);
+    TS_ASSERT_THROWS(randGen.nextInt(4, 3), const std::invalid_argument &);
+  }
+
+private:
+  std::vector<double> doNextValueCalls(const unsigned int ncalls,
+                                       Philox &randGen) {
+    std::vector<double> values(ncalls);
+    for (auto &value : values) {
+      value = randGen.nextValue();
+    }
+    return values;
+  }
+};
@@ -0,0 +1,273 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
+#include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/Timer.h"
+
+#include <atomic>
+#include <cxxtest/TestSuite.h>
+#include <iostream>
+#include <memory>
+
+using namespace Mantid::Kernel;
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadSchedulerWorkStealingTest *createSuite() {
+    return new ThreadSchedulerWorkStealingTest();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTest *suite) {
+    delete suite;
+  }
+
+  /// Task that does nothing, with a cost and an optional mutex
+  class EmptyTask : public Task {
+  public:
+    EmptyTask(double cost, std::shared_ptr<std::mutex> mutex = nullptr)
+        : Task(cost) {
+      m_mutex = std::move(mutex);
+    }
+    void run() override {}
+  };
+
+  void test_push_and_pop() {
+    ThreadSchedulerWorkStealing sc(4);
+    TS_ASSERT_EQUALS(sc.numQueues(), 4);
+    TS_ASSERT(sc.empty());
+    auto task = std::make_shared<EmptyTask>(2.5);
+    sc.push(task);
+    TS_ASSERT(!sc.empty());
+    TS_ASSERT_EQUALS(sc.size(), 1);
+    TS_ASSERT_EQUALS(sc.totalCost(), 2.5);
+    // Any thread finds it
+    TS_ASSERT_EQUALS(sc.pop(3), task);
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_EQUALS(sc.totalCost(), 0.0);
+    TS_ASSERT(!sc.pop(0));
+  }
+
+  void test_default_has_a_queue() {
+    ThreadSchedulerWorkStealing sc;
+    TS_ASSERT_LESS_THAN_EQUALS(1, sc.numQueues());
+  }
+
+  void test_tasks_are_dealt_to_queues_in_turn() {
+    ThreadSchedulerWorkStealing sc(2);
+    for (int i = 0; i < 5; ++i)
+      sc.push(std::make_shared<EmptyTask>(1.0));
+    TS_ASSERT_EQUALS(sc.queueSize(0), 3);
+    TS_ASSERT_EQUALS(sc.queueSize(1), 2);
+  }
+
+  void test_own_queue_largest_cost_first_then_steal() {
+    ThreadSchedulerWorkStealing sc(2);
+    std::vector<std::shared_ptr<Task>> tasks;
+    // Costs 1 and 3 go to queue 0; 2 and 4 to queue 1
+    for (int i = 1; i <= 4; ++i) {
+      tasks.emplace_back(std::make_shared<EmptyTask>(static_cast<double>(i)));
+      sc.push(tasks.back());
+    }
+    TS_ASSERT_EQUALS(sc.pop(1), tasks[3]);
+    TS_ASSERT_EQUALS(sc.pop(1), tasks[1]);
+    // Queue 1 is empty: steal the largest task of queue 0
+    TS_ASSERT_EQUALS(sc.pop(1), tasks[2]);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[0]);
+    TS_ASSERT(sc.empty());
+  }
+
+  void test_steal_from_largest_total_cost() {
+    ThreadSchedulerWorkStealing sc(3);
+    auto large = std::make_shared<EmptyTask>(5.0);
+    auto medium = std::make_shared<EmptyTask>(3.0);
+    sc.push(std::make_shared<EmptyTask>(1.0)); // queue 0
+    sc.push(large);                            // queue 1, total 5
+    sc.push(medium);                           // queue 2
+    sc.push(std::make_shared<EmptyTask>(1.0)); // queue 0
+    sc.push(std::make_shared<EmptyTask>(0.0)); // queue 1
+    sc.push(medium);                           // queue 2, total 6
+    // Empty queue 0
+    sc.pop(0);
+    sc.pop(0);
+    TS_ASSERT_EQUALS(sc.queueSize(0), 0);
+    // Queue 2 holds the most work, even though its tasks are smaller
+    TS_ASSERT_EQUALS(sc.pop(0), medium);
+    TS_ASSERT_EQUALS(sc.queueSize(2), 1);
+  }
+
+  void test_task_pushed_by_a_running_task_stays_on_its_thread() {
+    ThreadSchedulerWorkStealing sc(4);
+    sc.push(std::make_shared<EmptyTask>(1.0));
+    sc.push(std::make_shared<EmptyTask>(1.0));
+    // This thread now counts as thread 1 of the scheduler
+    TS_ASSERT(sc.pop(1));
+    sc.push(std::make_shared<EmptyTask>(1.0));
+    sc.push(std::make_shared<EmptyTask>(1.0));
+    TS_ASSERT_EQUALS(sc.queueSize(1), 2);
+  }
+
+  void test_mutexes_are_not_scheduled_twice() {
+    // Same sequence as ThreadSchedulerMutexesTest::test_queue
+    ThreadSchedulerWorkStealing sc(1);
+    auto mut1 = std::make_shared<std::mutex>();
+    auto mut2 = std::make_shared<std::mutex>();
+    auto mut3 = std::make_shared<std::mutex>();
+    auto task1 = std::make_shared<EmptyTask>(10.0, mut1);
+    auto task2 = std::make_shared<EmptyTask>(9.0, mut1);
+    auto task3 = std::make_shared<EmptyTask>(8.0, mut1);
+    auto task4 = std::make_shared<EmptyTask>(7.0, mut2);
+    auto task5 = std::make_shared<EmptyTask>(6.0, mut2);
+    auto task6 = std::make_shared<EmptyTask>(5.0, mut3);
+    auto task7 = std::make_shared<EmptyTask>(4.0);
+    sc.push(task1);
+    sc.push(task2);
+    sc.push(task3);
+
+    // Run the first task. mut1 becomes busy
+    TS_ASSERT_EQUALS(sc.pop(0), task1);
+    sc.push(task4);
+    sc.push(task5);
+    // mut1 is busy so task4 is next, mut2 becomes busy
+    TS_ASSERT_EQUALS(sc.pop(0), task4);
+    sc.push(task6);
+    TS_ASSERT_EQUALS(sc.pop(0), task6);
+    // This task has NO mutex, so it comes next
+    sc.push(task7);
+    TS_ASSERT_EQUALS(sc.pop(0), task7);
+
+    // Releasing mut1 lets task2 and then task3 through
+    sc.finished(task1.get(), 0);
+    TS_ASSERT_EQUALS(sc.pop(0), task2);
+    sc.finished(task2.get(), 0);
+    TS_ASSERT_EQUALS(sc.pop(0), task3);
+
+    // mut2 is still busy, but since it's the last one, task5 is returned
+    TS_ASSERT_EQUALS(sc.pop(0), task5);
+    TS_ASSERT(sc.empty());
+  }
+
+  void test_mutex_is_respected_when_stealing() {
+    ThreadSchedulerWorkStealing sc(2);
+    auto mut = std::make_shared<std::mutex>();
+    auto task1 = std::make_shared<EmptyTask>(2.0, mut);
+    auto task2 = std::make_shared<EmptyTask>(1.0);
+    auto task3 = std::make_shared<EmptyTask>(3.0, mut);
+    sc.push(task1); // queue 0
+    sc.push(task2); // queue 1
+    sc.push(task3); // queue 0
+    TS_ASSERT_EQUALS(sc.pop(0), task3);
+    // Queue 1 steals nothing with the busy mutex while it has other work
+    TS_ASSERT_EQUALS(sc.pop(1), task2);
+    TS_ASSERT_EQUALS(sc.pop(1), task1);
+  }
+
+  void test_many_tasks_waiting_on_a_busy_mutex() {
+    ThreadSchedulerWorkStealing sc(2);
+    auto mut = std::make_shared<std::mutex>();
+    std::vector<std::shared_ptr<Task>> waiting;
+    for (int i = 0; i < 1000; ++i) {
+      waiting.emplace_back(std::make_shared<EmptyTask>(10.0, mut));
+      sc.push(waiting.back());
+    }
+    auto running = sc.pop(0);
+    TS_ASSERT_EQUALS(running->getMutex(), mut);
+    // Runnable tasks pass the tasks waiting on the mutex
+    auto task1 = std::make_shared<EmptyTask>(1.0);
+    auto task2 = std::make_shared<EmptyTask>(1.0);
+    sc.push(task1);
+    sc.push(task2);
+    TS_ASSERT_EQUALS(sc.pop(0), task2);
+    TS_ASSERT_EQUALS(sc.pop(0), task1);
+    sc.finished(running.get(), 0);
+    running = sc.pop(1);
+    TS_ASSERT_EQUALS(running->getMutex(), mut);
+    TS_ASSERT_EQUALS(sc.size(), 998);
+    sc.finished(running.get(), 1);
+    sc.clear();
+    // The mutex is free once its tasks are finished or cleared
+    auto task3 = std::make_shared<EmptyTask>(2.0, mut);
+    sc.push(std::make_shared<EmptyTask>(1.0));
+    sc.push(task3);
+    TS_ASSERT_EQUALS(sc.pop(0), task3);
+  }
+
+  void test_clear() {
+    ThreadSchedulerWorkStealing sc(3);
+    for (int i = 0; i < 10; ++i)
+      sc.push(std::make_shared<EmptyTask>(1.0));
+    TS_ASSERT_EQUALS(sc.size(), 10);
+    TS_ASSERT_DELTA(sc.totalCost(), 10.0, 1e-10);
+    sc.clear();
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_EQUALS(sc.size(), 0);
+    TS_ASSERT_EQUALS(sc.totalCost(), 0.0);
+  }
+
+  void test_thread_pool_runs_every_task() {
+    std::atomic<size_t> total(0);
+    ThreadPool pool(new ThreadSchedulerWorkStealing(), 4);
+    for (size_t i = 1; i <= 1000; ++i)
+      pool.schedule(std::make_shared<FunctionTask>(
+          [&total, i]() { total += i; }, static_cast<double>(i % 7)));
+    TS_ASSERT_THROWS_NOTHING(pool.joinAll());
+    TS_ASSERT_EQUALS(total.load(), 500500);
+  }
+};
+
+class ThreadSchedulerWorkStealingTestPerformance : public CxxTest::TestSuite {
+public:
+  static ThreadSchedulerWorkStealingTestPerformance *createSuite() {
+    return new ThreadSchedulerWorkStealingTestPerformance();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTestPerformance *suite) {
+    delete suite;
+  }
+
+  /** Run many small tasks through a pool with 1 to 128 threads and print the
+   * time taken by each scheduler, to compare how they scale */
+  void test_scaling_small_tasks() {
+    std::cout << "\nthreads  FIFO(s)  Mutexes(s)  WorkStealing(s)\n";
+    for (size_t numThreads = 1; numThreads <= 128; numThreads *= 2) {
+      const double fifo = runTasks(new ThreadSchedulerFIFO(), numThreads);
+      const double mutexes =
+          runTasks(new ThreadSchedulerMutexes(), numThreads);
+      const double stealing = runTasks(
+          new ThreadSchedulerWorkStealing(numThreads), numThreads);
+      std::cout << numThreads << "  " << fifo << "  " << mutexes << "  "
+                << stealing << "\n";
+    }
+  }
+
+private:
+  /// @return the time to run the tasks with the given scheduler
+  double runTasks(ThreadScheduler *scheduler, size_t numThreads) {
+    const size_t numTasks = 200000;
+    std::atomic<size_t> total(0);
+    ThreadPool pool(scheduler, numThreads);
+    for (size_t i = 0; i < numTasks; ++i) {
+      pool.schedule(std::make_shared<FunctionTask>(
+          [&total]() {
+            // A little work, small compared to the cost of scheduling
+            size_t sum = 0;
+            for (size_t j = 0; j < 200; ++j)
+              sum += j * j;
+            total += sum;
+          },
+          static_cast<double>(i % 10)));
+    }
+    Timer timer;
+    pool.joinAll();
+    TS_ASSERT_EQUALS(total.load(), numTasks * 2646700);
+    return timer.elapsed();
+  }
+};
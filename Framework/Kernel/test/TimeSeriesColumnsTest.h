@@ -0,0 +1,142 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/TimeSeriesColumns.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <string>
+
+using namespace Mantid::Kernel;
+
+class TimeSeriesColumnsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TimeSeriesColumnsTest *createSuite() {
+    return new TimeSeriesColumnsTest();
+  }
+  static void destroySuite(TimeSeriesColumnsTest *suite) { delete suite; }
+
+  void test_append_and_read_back() {
+    TimeSeriesColumns<double> columns;
+    TS_ASSERT(columns.empty());
+    const auto times = makeTimes();
+    for (std::size_t i = 0; i < times.size(); ++i)
+      TS_ASSERT(columns.append(times[i], static_cast<double>(i)));
+
+    TS_ASSERT_EQUALS(columns.size(), times.size());
+    TS_ASSERT_EQUALS(columns.times(), times);
+    TS_ASSERT_EQUALS(columns.firstTime(), times.front());
+    TS_ASSERT_EQUALS(columns.lastTime(), times.back());
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      TS_ASSERT_EQUALS(columns.time(i), times[i]);
+      TS_ASSERT_EQUALS(columns.value(i), static_cast<double>(i));
+    }
+  }
+
+  void test_append_out_of_order_is_refused() {
+    TimeSeriesColumns<int> columns;
+    TS_ASSERT(columns.append(100, 1));
+    TS_ASSERT(columns.append(100, 2));
+    TS_ASSERT(!columns.append(99, 3));
+    TS_ASSERT_EQUALS(columns.size(), 2);
+    TS_ASSERT_EQUALS(columns.lastTime(), 100);
+  }
+
+  void test_bounds_match_std_algorithms() {
+    TimeSeriesColumns<int> columns;
+    const auto times = makeTimes();
+    for (const auto time : times)
+      columns.append(time, 0);
+
+    for (const auto time : times) {
+      for (int64_t shift = -1; shift <= 1; ++shift) {
+        const int64_t query = time + shift;
+        const auto lower =
+            std::lower_bound(times.cbegin(), times.cend(), query);
+        const auto upper =
+            std::upper_bound(times.cbegin(), times.cend(), query);
+        TS_ASSERT_EQUALS(columns.lowerBound(query),
+                         static_cast<std::size_t>(lower - times.cbegin()));
+        TS_ASSERT_EQUALS(columns.upperBound(query),
+                         static_cast<std::size_t>(upper - times.cbegin()));
+      }
+    }
+  }
+
+  void test_cursor_reads_consecutive_times() {
+    TimeSeriesColumns<int> columns;
+    const auto times = makeTimes();
+    for (const auto time : times)
+      columns.append(time, 0);
+
+    TimeSeriesColumns<int>::TimeCursor cursor(columns, 60);
+    for (std::size_t i = 60; i < times.size(); ++i, cursor.next()) {
+      TS_ASSERT_EQUALS(cursor.index(), i);
+      TS_ASSERT_EQUALS(cursor.time(), times[i]);
+    }
+    TS_ASSERT_EQUALS(cursor.index(), times.size());
+  }
+
+  void test_bool_and_string_values() {
+    TimeSeriesColumns<bool> flags;
+    flags.append(1, true);
+    flags.append(2, false);
+    TS_ASSERT(flags.value(0));
+    TS_ASSERT(!flags.value(1));
+
+    TimeSeriesColumns<std::string> strings;
+    strings.append(-5, "a");
+    strings.append(5, "b");
+    TS_ASSERT_EQUALS(strings.value(1), "b");
+    TS_ASSERT_EQUALS(strings.time(0), -5);
+  }
+
+  void test_clear() {
+    TimeSeriesColumns<double> columns;
+    columns.append(10, 1.);
+    columns.clear();
+    TS_ASSERT(columns.empty());
+    TS_ASSERT(columns.append(0, 2.));
+    TS_ASSERT_EQUALS(columns.firstTime(), 0);
+  }
+
+  void test_steady_log_is_smaller_than_rows() {
+    TimeSeriesColumns<double> columns;
+    const std::size_t numEntries = 10000;
+    columns.reserve(numEntries);
+    // 1 kHz, starting well after the epoch
+    const int64_t start = 1262304000000000000;
+    for (std::size_t i = 0; i < numEntries; ++i)
+      columns.append(start + static_cast<int64_t>(i) * 1000000, 0.);
+    columns.shrinkToFit();
+    TS_ASSERT_LESS_THAN(columns.memorySize(),
+                        numEntries * (sizeof(double) + sizeof(int64_t)) * 3 /
+                            4);
+    TS_ASSERT_EQUALS(columns.time(numEntries - 1),
+                     start + static_cast<int64_t>(numEntries - 1) * 1000000);
+  }
+
+private:
+  /// Times over several blocks with repeated times and large jumps
+  std::vector<int64_t> makeTimes() {
+    std::vector<int64_t> times;
+    int64_t time = -1000000000000;
+    for (int64_t i = 0; i < 200; ++i) {
+      // every seventh time repeats the one before
+      if (i % 31 == 0)
+        time += int64_t(1) << 40;
+      else if (i % 7 != 0)
+        time += 100 + i;
+      times.emplace_back(time);
+    }
+    return times;
+  }
+};
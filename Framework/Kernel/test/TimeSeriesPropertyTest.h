@@ -2470,6 +2470,106 @@ public:
     }
   }
 
+  void test_column_storage_keeps_values() {
+    auto log = getTestLog();
+    TS_ASSERT_EQUALS(log->getStorageType(), TimeSeriesStorageType::TSROWS);
+    const auto rows = std::unique_ptr<TimeSeriesProperty<double>>(log->clone());
+    log->setStorageType(TimeSeriesStorageType::TSCOLUMNS);
+    TS_ASSERT_EQUALS(log->getStorageType(), TimeSeriesStorageType::TSCOLUMNS);
+
+    TS_ASSERT_EQUALS(log->size(), 11);
+    TS_ASSERT_EQUALS(log->realSize(), 11);
+    TS_ASSERT(*log == *rows);
+    TS_ASSERT_EQUALS(log->firstTime(), rows->firstTime());
+    TS_ASSERT_EQUALS(log->lastTime(), rows->lastTime());
+    TS_ASSERT_EQUALS(log->firstValue(), 1.);
+    TS_ASSERT_EQUALS(log->lastValue(), 11.);
+    TS_ASSERT_EQUALS(log->minValue(), 1.);
+    TS_ASSERT_EQUALS(log->maxValue(), 11.);
+    TS_ASSERT_EQUALS(log->nthTime(3), rows->nthTime(3));
+    TS_ASSERT_EQUALS(log->nthValue(3), 4.);
+    TS_ASSERT_EQUALS(log->value(), rows->value());
+    TS_ASSERT_DELTA(log->timeAverageValue(), rows->timeAverageValue(), 1e-12);
+    TS_ASSERT(log->getMemorySize() < rows->getMemorySize());
+  }
+
+  void test_column_storage_getSingleValue() {
+    auto log = getTestLog();
+    const auto rows = std::unique_ptr<TimeSeriesProperty<double>>(log->clone());
+    log->setStorageType(TimeSeriesStorageType::TSCOLUMNS);
+
+    DateAndTime time("2007-11-30T16:16:50");
+    for (int i = 0; i < 30; ++i) {
+      int index, rowIndex;
+      TS_ASSERT_EQUALS(log->getSingleValue(time, index),
+                       rows->getSingleValue(time, rowIndex));
+      TS_ASSERT_EQUALS(index, rowIndex);
+      TS_ASSERT_EQUALS(log->getSingleValue(time), rows->getSingleValue(time));
+      time += 5.0;
+    }
+  }
+
+  void test_column_storage_filterByTimes() {
+    auto log = getTestLog();
+    auto rows = std::unique_ptr<TimeSeriesProperty<double>>(log->clone());
+    log->setStorageType(TimeSeriesStorageType::TSCOLUMNS);
+
+    TimeSplitterType splitters;
+    splitters.emplace_back(DateAndTime("2007-11-30T16:17:05"),
+                           DateAndTime("2007-11-30T16:17:30"), 0);
+    splitters.emplace_back(DateAndTime("2007-11-30T16:18:00"),
+                           DateAndTime("2007-11-30T16:18:25"), 0);
+    log->filterByTimes(splitters);
+    rows->filterByTimes(splitters);
+
+    TS_ASSERT_EQUALS(log->getStorageType(), TimeSeriesStorageType::TSCOLUMNS);
+    TS_ASSERT_EQUALS(log->size(), rows->size());
+    TS_ASSERT_EQUALS(log->timesAsVector(), rows->timesAsVector());
+    TS_ASSERT_EQUALS(log->valuesAsVector(), rows->valuesAsVector());
+  }
+
+  void test_column_storage_splitByTimeVector() {
+    auto log = getTestLog();
+    auto rows = std::unique_ptr<TimeSeriesProperty<double>>(log->clone());
+    log->setStorageType(TimeSeriesStorageType::TSCOLUMNS);
+    const std::vector<DateAndTime> splitTimes{
+        DateAndTime("2007-11-30T16:17:05"), DateAndTime("2007-11-30T16:17:35"),
+        DateAndTime("2007-11-30T16:18:15"), DateAndTime("2007-11-30T16:19:00")};
+    const std::vector<int> targets{0, 1, 0};
+    TimeSeriesProperty<double> out0("out0"), out1("out1");
+    log->splitByTimeVector(splitTimes, targets, {&out0, &out1});
+    TimeSeriesProperty<double> rowsOut0("out0"), rowsOut1("out1");
+    rows->splitByTimeVector(splitTimes, targets, {&rowsOut0, &rowsOut1});
+
+    TS_ASSERT_EQUALS(out0.getStorageType(), TimeSeriesStorageType::TSCOLUMNS);
+    TS_ASSERT_EQUALS(out1.getStorageType(), TimeSeriesStorageType::TSCOLUMNS);
+    TS_ASSERT(out0 == rowsOut0);
+    TS_ASSERT(out1 == rowsOut1);
+    const std::vector<double> values0{1., 2., 3., 4., 5., 8., 9., 10., 11.};
+    TS_ASSERT_EQUALS(out0.valuesAsVector(), values0);
+    const std::vector<double> values1{4., 5., 6., 7., 8., 9.};
+    TS_ASSERT_EQUALS(out1.valuesAsVector(), values1);
+  }
+
+  void test_column_storage_returns_to_rows_when_out_of_order() {
+    auto log = getTestLog();
+    log->setStorageType(TimeSeriesStorageType::TSCOLUMNS);
+    log->addValue("2007-11-30T16:20:00", 12.);
+    TS_ASSERT_EQUALS(log->getStorageType(), TimeSeriesStorageType::TSCOLUMNS);
+
+    log->addValue("2007-11-30T16:16:00", 0.);
+    TS_ASSERT_EQUALS(log->getStorageType(), TimeSeriesStorageType::TSROWS);
+    TS_ASSERT_EQUALS(log->size(), 13);
+    TS_ASSERT_EQUALS(log->firstValue(), 0.);
+    TS_ASSERT_EQUALS(log->lastValue(), 12.);
+  }
+
+  void test_column_storage_not_used_with_filter() {
+    auto log = getFilteredTestLog();
+    log->setStorageType(TimeSeriesStorageType::TSCOLUMNS);
+    TS_ASSERT_EQUALS(log->getStorageType(), TimeSeriesStorageType::TSROWS);
+  }
+
 private:
   /// Generate a test log
   std::unique_ptr<TimeSeriesProperty<double>> getTestLog() {
@@ -0,0 +1,52 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/ZeroedAllocator.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Mantid::Kernel;
+
+class ZeroedAllocatorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ZeroedAllocatorTest *createSuite() {
+    return new ZeroedAllocatorTest();
+  }
+  static void destroySuite(ZeroedAllocatorTest *suite) { delete suite; }
+
+  void test_vector_is_zero_filled() {
+    std::vector<double, ZeroedAllocator<double>> values(100000);
+    TS_ASSERT(std::all_of(values.begin(), values.end(),
+                          [](const double value) { return value == 0.; }));
+    // Memory given back and taken again is zero-filled again
+    values[5] = 3.;
+    values = std::vector<double, ZeroedAllocator<double>>(100000);
+    TS_ASSERT_EQUALS(values[5], 0.);
+  }
+
+  void test_values_are_kept_when_growing() {
+    std::vector<int, ZeroedAllocator<int>> values(10, 7);
+    values.resize(20);
+    TS_ASSERT_EQUALS(values[9], 7);
+    TS_ASSERT_EQUALS(values[10], 0);
+    values.emplace_back(3);
+    TS_ASSERT_EQUALS(values.back(), 3);
+  }
+
+  void test_makeZeroedArray() {
+    auto flags = makeZeroedArray<bool>(1000);
+    TS_ASSERT(std::none_of(flags.get(), flags.get() + 1000,
+                           [](const bool flag) { return flag; }));
+    TS_ASSERT(makeZeroedArray<bool>(0));
+  }
+};
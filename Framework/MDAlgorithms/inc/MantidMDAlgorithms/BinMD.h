@@ -72,6 +72,37 @@ private:
   void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin,
                 const size_t *const chunkMax);
 
+  /// Add the cached signal of a MDBox that lies within a single bin
+  template <typename MDE, size_t nd>
+  bool binWholeBox(DataObjects::MDBox<MDE, nd> *box,
+                   const size_t *const chunkMin, const size_t *const chunkMax);
+
+  /// Find the depth of the boxes binned from their totals
+  template <typename MDE, size_t nd>
+  size_t getLevelOfDetailDepth(DataObjects::MDEventWorkspace<MDE, nd> &ws,
+                               const double levelOfDetail) const;
+
+  /// Add the cached signal of a box at the bin of its centre
+  signal_t binBoxAtCentre(API::IMDNode *box, const size_t *const chunkMin,
+                          const size_t *const chunkMax,
+                          const size_t chunkDimension);
+
+  /// Bin the boxes of a file-backed workspace, reading them in file order
+  template <typename MDE, size_t nd>
+  void binFileBackedBoxes(const std::vector<API::IMDNode *> &boxes,
+                          API::IBoxControllerIO &fileIO,
+                          const size_t *const chunkMin,
+                          const size_t *const chunkMax);
+
+  /// Bin events, transforming their coordinates in blocks
+  template <typename MDE>
+  void binEvents(const MDE *events, const size_t eventCount,
+                 const size_t *const chunkMin, const size_t *const chunkMax,
+                 const bool parallel);
+
+  size_t getLinearIndex(const coord_t *outCenter, const size_t *const chunkMin,
+                        const size_t *const chunkMax) const;
+
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
   /// Progress reporting
@@ -8,6 +8,8 @@
 
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 #include "MantidMDAlgorithms/MDEventTreeBuilder.h"
+#include <algorithm>
+#include <limits>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -82,6 +84,17 @@ private:
   template <typename EventType, size_t ND, template <size_t> class MDEventType>
   std::vector<MDEventType<ND>> convertEvents();
 
+  // Add events sorted along the Morton curve to the existing box structure
+  template <size_t ND, template <size_t> class MDEventType>
+  void addToExistingTree(std::vector<MDEventType<ND>> &mdEvents,
+                         const API::BoxController_sptr &bc);
+
+  // Find the leaf of the tree the coordinates are in
+  template <size_t ND, template <size_t> class MDEventType>
+  static DataObjects::MDBox<MDEventType<ND>, ND> *
+  findLeaf(DataObjects::MDBoxBase<MDEventType<ND>, ND> *box,
+           const coord_t *coord);
+
   template <size_t ND, template <size_t> class MDEventType>
   struct MDEventMaker {
     static MDEventType<ND> makeMDEvent(const double &sig, const double &err,
@@ -174,11 +187,157 @@ std::vector<MDEventType<ND>> ConvToMDEventsWSIndexing::convertEvents() {
   return mdEvents;
 }
 
+/**
+ * Find the leaf of the tree the coordinates are in. On the boundary between
+ * boxes any of them may be returned; coordinates outside of every child,
+ * because of rounding, go to the closest one.
+ * @param box :: the box to search from
+ * @param coord :: the coordinates
+ * @return :: the leaf
+ */
+template <size_t ND, template <size_t> class MDEventType>
+DataObjects::MDBox<MDEventType<ND>, ND> *ConvToMDEventsWSIndexing::findLeaf(
+    DataObjects::MDBoxBase<MDEventType<ND>, ND> *box, const coord_t *coord) {
+  using BoxBase = DataObjects::MDBoxBase<MDEventType<ND>, ND>;
+  while (!box->isLeaf()) {
+    BoxBase *closest = nullptr;
+    coord_t closestDistance = std::numeric_limits<coord_t>::max();
+    for (size_t i = 0; i < box->getNumChildren() && closestDistance > 0; ++i) {
+      auto child = static_cast<BoxBase *>(box->getChild(i));
+      coord_t distance = 0;
+      for (size_t ax = 0; ax < ND; ++ax) {
+        const auto &extents = child->getExtents(ax);
+        distance += std::max(coord_t(0), extents.getMin() - coord[ax]) +
+                    std::max(coord_t(0), coord[ax] - extents.getMax());
+      }
+      if (distance < closestDistance) {
+        closest = child;
+        closestDistance = distance;
+      }
+    }
+    box = closest;
+  }
+  return static_cast<DataObjects::MDBox<MDEventType<ND>, ND> *>(box);
+}
+
+/**
+ * Add events to the existing box structure of the output workspace. As the
+ * events are sorted along the Morton curve, the events of a box are mostly
+ * consecutive, so the box is only searched for at the start of each run of
+ * events. Only the boxes that received events are split if needed, and
+ * their caches refreshed.
+ * @param mdEvents :: events sorted along the Morton curve
+ * @param bc :: box controller of the output workspace
+ */
+template <size_t ND, template <size_t> class MDEventType>
+void ConvToMDEventsWSIndexing::addToExistingTree(
+    std::vector<MDEventType<ND>> &mdEvents, const API::BoxController_sptr &bc) {
+  using MDEvent = MDEventType<ND>;
+  using Box = DataObjects::MDBox<MDEvent, ND>;
+  using GridBox = DataObjects::MDGridBox<MDEvent, ND>;
+  auto ws = dynamic_cast<DataObjects::MDEventWorkspace<MDEvent, ND> *>(
+      m_OutWSWrapper->pWorkspace().get());
+  auto root = dynamic_cast<GridBox *>(ws->getBox());
+  if (!root) {
+    // A single box: nothing to gain from the index
+    ws->getBox()->addEvents(mdEvents);
+    if (bc->willSplit(ws->getBox()->getNPoints(), 0))
+      ws->splitBox();
+    ws->splitAllIfNeeded(nullptr);
+    ws->refreshCache();
+    return;
+  }
+
+  struct Run {
+    Box *box;
+    size_t begin;
+    size_t end;
+  };
+  std::vector<Run> runs;
+  for (size_t begin = 0; begin < mdEvents.size();) {
+    auto box = findLeaf<ND, MDEventType>(root, mdEvents[begin].getCenter());
+    size_t end = begin + 1;
+    for (; end < mdEvents.size(); ++end) {
+      bool inside = true;
+      for (size_t ax = 0; ax < ND && inside; ++ax)
+        inside = !box->getExtents(ax).outside(mdEvents[end].getCenter(ax));
+      if (!inside)
+        break;
+    }
+    runs.emplace_back(Run{box, begin, end});
+    begin = end;
+  }
+  // A box may get several runs if the tree does not follow the Morton curve
+  std::stable_sort(runs.begin(), runs.end(), [](const Run &a, const Run &b) {
+    return a.box->getID() < b.box->getID();
+  });
+  std::vector<size_t> firstRuns;
+  for (size_t i = 0; i < runs.size(); ++i)
+    if (i == 0 || runs[i].box != runs[i - 1].box)
+      firstRuns.emplace_back(i);
+  firstRuns.emplace_back(runs.size());
+
+  const auto numBoxes = static_cast<int64_t>(firstRuns.size()) - 1;
+
+  // The boxes are located in their parents before any of them is replaced
+  struct Split {
+    GridBox *parent;
+    size_t index;
+  };
+  std::vector<Split> splits(numBoxes, Split{nullptr, 0});
+  for (int64_t i = 0; i < numBoxes; ++i) {
+    Box *box = runs[firstRuns[i]].box;
+    if (auto parent = dynamic_cast<GridBox *>(box->getParent()))
+      splits[i] = Split{parent, parent->getChildIndexFromID(box->getID())};
+  }
+
+  // Each box is filled by one thread and the tree is not modified
+  std::vector<char> willSplit(numBoxes, false);
+#pragma omp parallel for schedule(dynamic) num_threads(numWorkers())
+  for (int64_t i = 0; i < numBoxes; ++i) {
+    Box *box = runs[firstRuns[i]].box;
+    auto &events = box->getEvents();
+    for (size_t r = firstRuns[i]; r < firstRuns[i + 1]; ++r)
+      events.insert(events.end(), mdEvents.begin() + runs[r].begin,
+                    mdEvents.begin() + runs[r].end);
+    box->releaseEvents();
+    willSplit[i] = splits[i].parent &&
+                   bc->willSplit(box->getNPoints(), box->getDepth());
+    if (!willSplit[i])
+      box->refreshCache();
+  }
+
+  // The boxes with the same parent are split by the same thread, as splitting
+  // replaces the box among the children of the parent
+  std::vector<Split> toSplit;
+  for (int64_t i = 0; i < numBoxes; ++i)
+    if (willSplit[i])
+      toSplit.emplace_back(splits[i]);
+  std::stable_sort(toSplit.begin(), toSplit.end(),
+                   [](const Split &a, const Split &b) {
+                     return a.parent->getID() < b.parent->getID();
+                   });
+  std::vector<size_t> firstSplits;
+  for (size_t i = 0; i < toSplit.size(); ++i)
+    if (i == 0 || toSplit[i].parent != toSplit[i - 1].parent)
+      firstSplits.emplace_back(i);
+  firstSplits.emplace_back(toSplit.size());
+
+#pragma omp parallel for schedule(dynamic) num_threads(numWorkers())
+  for (int64_t i = 0; i < static_cast<int64_t>(firstSplits.size()) - 1; ++i) {
+    for (size_t s = firstSplits[i]; s < firstSplits[i + 1]; ++s) {
+      auto parent = toSplit[s].parent;
+      // Replaces the box with a grid box, split as far as needed
+      parent->splitContents(toSplit[s].index, nullptr);
+      parent->getChild(toSplit[s].index)->refreshCache();
+    }
+  }
+  root->calculateGridCaches();
+}
+
 template <typename EventType, size_t ND, template <size_t> class MDEventType>
 void ConvToMDEventsWSIndexing::appendEvents(API::Progress *pProgress,
                                             const API::BoxController_sptr &bc) {
-  bc->clearBoxesCounter(1);
-  bc->clearGridBoxesCounter(0);
   pProgress->resetNumSteps(2, 0, 1);
 
   std::vector<MDEventType<ND>> mdEvents =
@@ -200,12 +359,19 @@ void ConvToMDEventsWSIndexing::appendEvents(API::Progress *pProgress,
   EventDistributor distributor(nThreads, mdEvents.size() / nThreads / 10, bc,
                                space);
 
-  auto rootAndErr = distributor.distribute(mdEvents);
-  m_OutWSWrapper->pWorkspace()->setBox(rootAndErr.root);
-  rootAndErr.root->calculateGridCaches();
-
   std::stringstream ss;
-  ss << rootAndErr.err;
+  if (pws->getNPoints() > 0) {
+    // Appending to an existing workspace: only the new events are sorted
+    ss << distributor.sortByIndex(mdEvents);
+    addToExistingTree<ND, MDEventType>(mdEvents, bc);
+  } else {
+    bc->clearBoxesCounter(1);
+    bc->clearGridBoxesCounter(0);
+    auto rootAndErr = distributor.distribute(mdEvents);
+    m_OutWSWrapper->pWorkspace()->setBox(rootAndErr.root);
+    rootAndErr.root->calculateGridCaches();
+    ss << rootAndErr.err;
+  }
   g_Log.information("Error with using Morton indexes is:\n" + ss.str());
   pProgress->report(1);
 }
@@ -11,7 +11,9 @@
 #include "MantidKernel/Matrix.h"
 #include "MantidKernel/V3D.h"
 
+#include <array>
 #include <memory>
+#include <mutex>
 
 #include <tuple>
 #include <unordered_map>
@@ -45,6 +47,11 @@ struct IntegrationParameters {
  determined from the standard deviations in the directions of the
  principal axes.
 
+ The lists of events are split into shards by their key, each guarded by its
+ own mutex, so that events can be added from several threads at once. Once
+ all the events are added the lists are only read, so several peaks can be
+ integrated at once.
+
  @author Dennis Mikkelson
  @date   2012-12-19
 
@@ -73,7 +80,7 @@ public:
       double radius_m, double radius_s, int MaxO, const bool CrossT,
       const bool useOnePercentBackgroundCorrection = true);
 
-  /// Add event Q's to lists of events near peaks
+  /// Add event Q's to lists of events near peaks, from any thread
   void addEvents(std::vector<std::pair<std::pair<double, double>,
                                        Mantid::Kernel::V3D>> const &event_qs,
                  bool hkl_integ);
@@ -115,7 +122,11 @@ public:
 private:
   /// Get a list of events for a given Q
   const std::vector<std::pair<std::pair<double, double>, Mantid::Kernel::V3D>> *
-  getEvents(const Mantid::Kernel::V3D &peak_q);
+  getEvents(const Mantid::Kernel::V3D &peak_q) const;
+
+  /// Find the list of events for a map key
+  const std::vector<std::pair<std::pair<double, double>, Mantid::Kernel::V3D>> *
+  findEvents(int64_t key) const;
 
   bool correctForDetectorEdges(std::tuple<double, double, double> &radii,
                                const std::vector<Mantid::Kernel::V3D> &E1Vecs,
@@ -157,18 +168,21 @@ private:
   static int64_t getHklMnpKey(int h, int k, int l, int m, int n, int p);
 
   /// Form a map key for the specified q_vector.
-  int64_t getHklKey(Mantid::Kernel::V3D const &q_vector);
-  int64_t getHklMnpKey(Mantid::Kernel::V3D const &q_vector);
-  int64_t getHklKey2(Mantid::Kernel::V3D const &hkl);
-  int64_t getHklMnpKey2(Mantid::Kernel::V3D const &hkl);
-
-  /// Add an event to the vector of events for the closest h,k,l
-  void
-  addEvent(std::pair<std::pair<double, double>, Mantid::Kernel::V3D> event_Q,
-           bool hkl_integ);
-  void
-  addModEvent(std::pair<std::pair<double, double>, Mantid::Kernel::V3D> event_Q,
-              bool hkl_integ);
+  int64_t getHklKey(Mantid::Kernel::V3D const &q_vector) const;
+  int64_t getHklMnpKey(Mantid::Kernel::V3D const &q_vector) const;
+  int64_t getHklKey2(Mantid::Kernel::V3D const &hkl) const;
+  int64_t getHklMnpKey2(Mantid::Kernel::V3D const &hkl) const;
+
+  /// Find the key of the peak an event belongs to, and shift it to the peak
+  int64_t getEventKey(
+      std::pair<std::pair<double, double>, Mantid::Kernel::V3D> &event_Q,
+      bool hkl_integ) const;
+  int64_t getModEventKey(
+      std::pair<std::pair<double, double>, Mantid::Kernel::V3D> &event_Q,
+      bool hkl_integ) const;
+
+  /// The shard of the lists of events holding a map key
+  static size_t getShard(int64_t key);
 
   /// Find the net integrated intensity of a list of Q's using ellipsoids
   std::shared_ptr<const Mantid::DataObjects::PeakShapeEllipsoid>
@@ -192,8 +206,13 @@ private:
 
   // Private data members
 
-  PeakQMap m_peak_qs;         // hashtable with peak Q-vectors
-  EventListMap m_event_lists; // hashtable with lists of events for each peak
+  /// Number of shards the lists of events are split into
+  static constexpr size_t NUM_SHARDS = 64;
+
+  PeakQMap m_peak_qs; // hashtable with peak Q-vectors
+  // hashtables with lists of events for each peak, split by key
+  std::array<EventListMap, NUM_SHARDS> m_event_lists;
+  std::array<std::mutex, NUM_SHARDS> m_event_list_mutexes;
   Kernel::DblMatrix m_UBinv;  // matrix mapping from Q to h,k,l
   Kernel::DblMatrix m_ModHKL; // matrix mapping from Q to m,n,p
   double m_radius;            // size of sphere to use for events around a peak
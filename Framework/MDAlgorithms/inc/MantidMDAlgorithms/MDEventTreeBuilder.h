@@ -69,6 +69,14 @@ public:
    * @return :: pointer to the root node and error
    */
   TreeWithIndexError distribute(std::vector<MDEventType<ND>> &mdEvents);
+  /**
+   * Sort the events along the Morton curve without building a tree, e.g. to
+   * add them to the boxes of an existing tree
+   * @param mdEvents :: events to sort, left in the coordinates mode
+   * @return :: error of the coordinates
+   */
+  morton_index::MDCoordinate<ND>
+  sortByIndex(std::vector<MDEventType<ND>> &mdEvents);
 
 private:
   morton_index::MDCoordinate<ND>
@@ -125,6 +133,19 @@ MDEventTreeBuilder<ND, MDEventType, EventIterator>::distribute(
   return {root, err};
 }
 
+template <size_t ND, template <size_t> class MDEventType,
+          typename EventIterator>
+morton_index::MDCoordinate<ND>
+MDEventTreeBuilder<ND, MDEventType, EventIterator>::sortByIndex(
+    std::vector<MDEvent> &mdEvents) {
+  auto err = convertToIndex(mdEvents, m_space);
+  sortEvents(mdEvents);
+#pragma omp parallel for num_threads(m_numWorkers)
+  for (int64_t i = 0; i < static_cast<int64_t>(mdEvents.size()); ++i)
+    IndexCoordinateSwitcher::convertToCoordinates(mdEvents[i], m_space);
+  return err;
+}
+
 template <size_t ND, template <size_t> class MDEventType,
           typename EventIterator>
 DataObjects::MDBoxBase<MDEventType<ND>, ND> *
@@ -10,6 +10,7 @@
 #include "MantidGeometry/Crystal/SymmetryOperationFactory.h"
 #include "MantidMDAlgorithms/DllConfig.h"
 #include "MantidMDAlgorithms/SlicingAlgorithm.h"
+#include "MantidMDAlgorithms/TrajectoryIntersectionCache.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -46,16 +47,26 @@ private:
   getValuesFromOtherDimensions(bool &skipNormalization,
                                uint16_t expInfoIndex = 0) const;
   void cacheDimensionXValues();
-  void calculateNormalization(const std::vector<coord_t> &otherValues,
-                              const Geometry::SymmetryOperation &so,
-                              uint16_t expInfoIndex, size_t soIndex);
+  std::vector<std::array<double, 2>>
+  getDetectorAngles(uint16_t expInfoIndex) const;
+  void calculateNormalization(
+      const std::vector<coord_t> &otherValues,
+      const Geometry::SymmetryOperation &so, uint16_t expInfoIndex,
+      size_t soIndex,
+      const std::vector<std::array<double, 2>> &detectorAngles);
+  std::shared_ptr<const TrajectoryIntersectionCache::Intersections>
+  getIntersections(const std::vector<std::array<double, 2>> &detectorAngles,
+                   const Kernel::DblMatrix &transform,
+                   const std::vector<double> &lowValues,
+                   const std::vector<double> &highValues);
+  size_t estimateIntersectionsMemory(
+      const std::vector<std::array<double, 2>> &detectorAngles,
+      const Kernel::DblMatrix &transform, const std::vector<double> &lowValues,
+      const std::vector<double> &highValues);
   void calculateIntersections(std::vector<std::array<double, 4>> &intersections,
                               const double theta, const double phi,
                               const Kernel::DblMatrix &transform,
                               double lowvalue, double highvalue);
-  void calcIntegralsForIntersections(const std::vector<double> &xValues,
-                                     const API::MatrixWorkspace &integrFlux,
-                                     size_t sp, std::vector<double> &yValues);
 
   /// Normalization workspace
   DataObjects::MDHistoWorkspace_sptr m_normWS;
@@ -48,10 +48,6 @@ private:
   void calculateNormalization(const std::vector<coord_t> &otherValues,
                               const Kernel::Matrix<coord_t> &affineTrans,
                               uint16_t expInfoIndex);
-  void calcIntegralsForIntersections(const std::vector<double> &xValues,
-                                     const API::MatrixWorkspace &integrFlux,
-                                     size_t sp,
-                                     std::vector<double> &yValues) const;
   void calculateIntersections(std::vector<std::array<double, 4>> &intersections,
                               const double theta, const double phi);
 
@@ -47,6 +47,10 @@ public:
   }
 
 private:
+  /// Largest number of events merged in one range of boxes, unless a single
+  /// box has more, and largest number of unused events read between boxes
+  enum { MAX_RANGE_EVENTS = 1 << 20, MAX_GAP_EVENTS = 1 << 14 };
+
   /// Initialise the properties
   void init() override;
   /// Run the algorithm
@@ -59,7 +63,17 @@ private:
 
   void finalizeOutput(const std::string &outputFile);
 
-  uint64_t loadEventsFromSubBoxes(API::IMDNode *TargetBox);
+  std::vector<std::pair<size_t, size_t>>
+  partitionBoxes(const size_t numRanges);
+
+  void mergeBoxRange(const size_t begin, const size_t end);
+
+  void loadEventsOfBoxRange(const size_t iw, const size_t begin,
+                            const size_t end,
+                            std::vector<std::vector<coord_t>> &boxData);
+
+  void saveEventsOfBoxRange(const size_t begin, const size_t end,
+                            const std::vector<std::vector<coord_t>> &boxData);
 
   // the class which flatten the box structure and deal with it
   DataObjects::MDBoxFlatTree m_BoxStruct;
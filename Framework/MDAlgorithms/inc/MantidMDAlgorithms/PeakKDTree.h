@@ -0,0 +1,145 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** PeakKDTree : A k-d tree of the centres of peaks, in the dimensions of an
+  MDEventWorkspace, to find the peaks near a box or an event.
+
+  The tree is balanced and held in two arrays: the points are sorted so the
+  median of a range is the node splitting it, and ranges of a few points are
+  searched linearly. Unlike Kernel::NearestNeighbours, searching is thread
+  safe and finds every point within a radius.
+
+  @tparam nd :: the number of dimensions
+*/
+template <size_t nd> class PeakKDTree {
+public:
+  using Point = std::array<coord_t, nd>;
+
+  /** Constructor
+   * @param points :: the points to search
+   */
+  explicit PeakKDTree(const std::vector<Point> &points)
+      : m_points(points), m_indexes(points.size()),
+        m_splitDimensions(points.size()) {
+    std::iota(m_indexes.begin(), m_indexes.end(), size_t(0));
+    build(0, m_points.size());
+  }
+
+  /** Find the points within a radius of a position
+   * @param position :: the centre of the search
+   * @param radius :: the distance to search within (inclusive)
+   * @param[out] found :: the indexes of the points found are appended to this,
+   *in no particular order
+   */
+  void findWithinRadius(const coord_t *position, const coord_t radius,
+                        std::vector<size_t> &found) const {
+    find(0, m_points.size(), position, radius * radius, found);
+  }
+
+  /// @return the number of points
+  size_t size() const { return m_points.size(); }
+
+private:
+  /// Ranges of no more than this many points are searched linearly
+  static constexpr size_t LEAF_SIZE = 8;
+
+  /// Split a range at its median along the dimension of largest spread
+  void build(const size_t begin, const size_t end) {
+    if (end - begin <= LEAF_SIZE)
+      return;
+    size_t splitDimension = 0;
+    coord_t largestSpread = -1;
+    for (size_t d = 0; d < nd; ++d) {
+      const auto range = std::minmax_element(
+          m_points.begin() + begin, m_points.begin() + end,
+          [d](const Point &a, const Point &b) { return a[d] < b[d]; });
+      const coord_t spread = (*range.second)[d] - (*range.first)[d];
+      if (spread > largestSpread) {
+        largestSpread = spread;
+        splitDimension = d;
+      }
+    }
+    // Sort the points and their indexes together
+    std::vector<size_t> order(end - begin);
+    std::iota(order.begin(), order.end(), begin);
+    const size_t middle = (end - begin) / 2;
+    std::nth_element(order.begin(), order.begin() + middle, order.end(),
+                     [this, splitDimension](size_t a, size_t b) {
+                       return m_points[a][splitDimension] <
+                              m_points[b][splitDimension];
+                     });
+    std::vector<Point> points(order.size());
+    std::vector<size_t> indexes(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      points[i] = m_points[order[i]];
+      indexes[i] = m_indexes[order[i]];
+    }
+    std::copy(points.begin(), points.end(), m_points.begin() + begin);
+    std::copy(indexes.begin(), indexes.end(), m_indexes.begin() + begin);
+    m_splitDimensions[begin + middle] = splitDimension;
+    build(begin, begin + middle);
+    build(begin + middle + 1, end);
+  }
+
+  /// Find the points of a range within a squared radius of a position
+  void find(const size_t begin, const size_t end, const coord_t *position,
+            const coord_t radiusSquared, std::vector<size_t> &found) const {
+    if (end - begin <= LEAF_SIZE) {
+      for (size_t i = begin; i < end; ++i)
+        if (isWithin(m_points[i], position, radiusSquared))
+          found.emplace_back(m_indexes[i]);
+      return;
+    }
+    const size_t node = begin + (end - begin) / 2;
+    if (isWithin(m_points[node], position, radiusSquared))
+      found.emplace_back(m_indexes[node]);
+    const size_t d = m_splitDimensions[node];
+    const coord_t offset = position[d] - m_points[node][d];
+    // Search the side of the position first, the other one only if the
+    // sphere crosses the splitting plane
+    if (offset < 0) {
+      find(begin, node, position, radiusSquared, found);
+      if (offset * offset <= radiusSquared)
+        find(node + 1, end, position, radiusSquared, found);
+    } else {
+      find(node + 1, end, position, radiusSquared, found);
+      if (offset * offset <= radiusSquared)
+        find(begin, node, position, radiusSquared, found);
+    }
+  }
+
+  static bool isWithin(const Point &point, const coord_t *position,
+                       const coord_t radiusSquared) {
+    coord_t distanceSquared = 0;
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t offset = point[d] - position[d];
+      distanceSquared += offset * offset;
+    }
+    return distanceSquared <= radiusSquared;
+  }
+
+  /// The points, in the order of the tree
+  std::vector<Point> m_points;
+  /// The index given to the constructor of each point
+  std::vector<size_t> m_indexes;
+  /// The dimension along which each node splits its range
+  std::vector<size_t> m_splitDimensions;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
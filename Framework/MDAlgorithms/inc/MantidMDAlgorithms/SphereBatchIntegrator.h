@@ -0,0 +1,310 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/BoxController.h"
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDGridBox.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidMDAlgorithms/PeakKDTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** SphereBatchIntegrator : Integrates the signal of an MDEventWorkspace in
+  many spheres and spherical shells at once, e.g. around every peak of a
+  PeaksWorkspace.
+
+  MDBoxBase::integrateSphere descends the box tree from the root for each
+  sphere. Here the centres go into a PeakKDTree and the tree is descended
+  once: the children of the top box look up the spheres near them in the
+  k-d tree, and deeper boxes only keep the spheres of their parent that may
+  touch them. The events of each leaf box are then read once for all the
+  spheres touching it, in parallel over the leaves.
+
+  The boxes are classified as integrateSphere does, so the results are the
+  same, up to the order in which the signal is summed: a box with all its
+  vertexes inside a sphere adds its cached signal, a box that may touch it
+  has its events integrated, and the top 1% of the signal of the events of
+  each leaf box in a shell can be left out as a background correction.
+*/
+template <typename MDE, size_t nd> class SphereBatchIntegrator {
+public:
+  using Point = typename PeakKDTree<nd>::Point;
+
+  /** Add a sphere or a spherical shell to integrate
+   * @param center :: the centre of the sphere
+   * @param radiusSquared :: radius^2 below which to integrate
+   * @param innerRadiusSquared :: radius^2 above which to integrate, 0 for a
+   *sphere
+   * @param useOnePercentBackgroundCorrection :: leave out the top 1% of the
+   *signal of the events of each box in a shell
+   * @return the index of the sphere
+   */
+  size_t addSphere(const Point &center, const coord_t radiusSquared,
+                   const coord_t innerRadiusSquared = 0,
+                   const bool useOnePercentBackgroundCorrection = false) {
+    m_spheres.emplace_back(Sphere{center, radiusSquared, innerRadiusSquared,
+                                  useOnePercentBackgroundCorrection, 0., 0.});
+    return m_spheres.size() - 1;
+  }
+
+  /** Integrate every sphere
+   * @param root :: the top box of the workspace
+   */
+  void integrate(DataObjects::MDBoxBase<MDE, nd> &root) {
+    if (m_spheres.empty())
+      return;
+    std::vector<Point> centers;
+    centers.reserve(m_spheres.size());
+    coord_t maxRadiusSquared = 0;
+    for (auto &sphere : m_spheres) {
+      sphere.signal = 0.;
+      sphere.errorSquared = 0.;
+      centers.emplace_back(sphere.center);
+      maxRadiusSquared = std::max(maxRadiusSquared, sphere.radiusSquared);
+    }
+    const PeakKDTree<nd> tree(centers);
+    const auto maxRadius = std::sqrt(maxRadiusSquared);
+
+    std::vector<Leaf> leaves;
+    auto *gridBox = dynamic_cast<DataObjects::MDGridBox<MDE, nd> *>(&root);
+    if (gridBox) {
+      // Descend from each child of the top box in parallel, then gather the
+      // results in the order of the children
+      auto &children = gridBox->getBoxes();
+      std::vector<Descent> descents(children.size());
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int i = 0; i < static_cast<int>(children.size()); ++i) {
+        auto *child = children[i];
+        std::vector<size_t> nearby;
+        tree.findWithinRadius(getCenter(*child).data(),
+                              searchRadius(*child, maxRadius), nearby);
+        std::sort(nearby.begin(), nearby.end());
+        descend(*child, nearby, descents[i]);
+      }
+      for (auto &descent : descents) {
+        for (const auto &contained : descent.contained) {
+          m_spheres[contained.sphere].signal += contained.signal;
+          m_spheres[contained.sphere].errorSquared += contained.errorSquared;
+        }
+        std::move(descent.leaves.begin(), descent.leaves.end(),
+                  std::back_inserter(leaves));
+      }
+    } else if (auto *box = dynamic_cast<DataObjects::MDBox<MDE, nd> *>(&root)) {
+      std::vector<size_t> all(m_spheres.size());
+      for (size_t i = 0; i < all.size(); ++i)
+        all[i] = i;
+      leaves.emplace_back(Leaf{box, std::move(all), {}});
+    }
+    integrateLeaves(leaves, root.getBoxController()->isFileBacked());
+  }
+
+  /// @return the integrated signal of a sphere
+  signal_t getSignal(const size_t sphere) const {
+    return m_spheres[sphere].signal;
+  }
+
+  /// @return the integrated squared error of a sphere
+  signal_t getErrorSquared(const size_t sphere) const {
+    return m_spheres[sphere].errorSquared;
+  }
+
+private:
+  struct Sphere {
+    Point center;
+    coord_t radiusSquared;
+    coord_t innerRadiusSquared;
+    bool useOnePercentBackgroundCorrection;
+    signal_t signal;
+    signal_t errorSquared;
+  };
+
+  /// The signal of a box inside a sphere
+  struct Contained {
+    size_t sphere;
+    signal_t signal;
+    signal_t errorSquared;
+  };
+
+  /// A leaf box and the spheres whose events it must integrate
+  struct Leaf {
+    DataObjects::MDBox<MDE, nd> *box;
+    std::vector<size_t> spheres;
+    /// The signal and squared error of each of the spheres
+    std::vector<std::pair<signal_t, signal_t>> results;
+  };
+
+  /// What was found below a child of the top box
+  struct Descent {
+    std::vector<Contained> contained;
+    std::vector<Leaf> leaves;
+  };
+
+  enum class Contact { None, Partial, Contained };
+
+  static Point getCenter(const DataObjects::MDBoxBase<MDE, nd> &box) {
+    Point center;
+    box.getCenter(center.data());
+    return center;
+  }
+
+  static coord_t getDiagonalSquared(DataObjects::MDBoxBase<MDE, nd> &box) {
+    coord_t diagonalSquared = 0;
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t size = box.getExtents(d).getSize();
+      diagonalSquared += size * size;
+    }
+    return diagonalSquared;
+  }
+
+  /// @return the distance from the centre of a box beyond which no sphere of
+  /// the given radius is in contact with it, with a small margin
+  static coord_t searchRadius(DataObjects::MDBoxBase<MDE, nd> &box,
+                              const coord_t radius) {
+    const auto diagonalSquared = getDiagonalSquared(box);
+    const auto reach =
+        std::max(radius + std::sqrt(diagonalSquared) / 2,
+                 std::sqrt(diagonalSquared * 0.72f + radius * radius));
+    return reach * 1.001f;
+  }
+
+  static coord_t distanceSquared(const Point &center, const coord_t *point) {
+    coord_t distanceSquared = 0;
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t dist = point[d] - center[d];
+      distanceSquared += dist * dist;
+    }
+    return distanceSquared;
+  }
+
+  /// Classify a box as MDGridBox::integrateSphere does for its children
+  Contact getContact(DataObjects::MDBoxBase<MDE, nd> &box,
+                     const Sphere &sphere) const {
+    const size_t numVertexes = size_t(1) << nd;
+    size_t numContained = 0;
+    for (size_t i = 0; i < numVertexes; ++i) {
+      coord_t vertex[nd];
+      for (size_t d = 0; d < nd; ++d) {
+        const auto &extents = box.getExtents(d);
+        vertex[d] = (i >> d) & 1 ? extents.getMax() : extents.getMin();
+      }
+      const auto out = distanceSquared(sphere.center, vertex);
+      if (out < sphere.radiusSquared && out > sphere.innerRadiusSquared)
+        ++numContained;
+    }
+    if (numContained == numVertexes)
+      return Contact::Contained;
+    if (numContained > 0)
+      return Contact::Partial;
+    // There is a chance that part of the box is within the sphere, even if
+    // no vertex of it is
+    const auto diagonalSquared = getDiagonalSquared(box);
+    const auto out = distanceSquared(sphere.center, getCenter(box).data());
+    if (out < diagonalSquared * 0.72f + sphere.radiusSquared ||
+        out < diagonalSquared * 0.72f + sphere.innerRadiusSquared)
+      return Contact::Partial;
+    return Contact::None;
+  }
+
+  /// Find the boxes in contact with the given spheres below a box
+  void descend(DataObjects::MDBoxBase<MDE, nd> &box,
+               const std::vector<size_t> &spheres, Descent &descent) const {
+    std::vector<size_t> touching;
+    for (const auto index : spheres) {
+      const auto contact = getContact(box, m_spheres[index]);
+      if (contact == Contact::Contained)
+        descent.contained.emplace_back(
+            Contained{index, box.getSignal(), box.getErrorSquared()});
+      else if (contact == Contact::Partial)
+        touching.emplace_back(index);
+    }
+    if (touching.empty())
+      return;
+    if (auto *gridBox = dynamic_cast<DataObjects::MDGridBox<MDE, nd> *>(&box)) {
+      for (auto *child : gridBox->getBoxes())
+        descend(*child, touching, descent);
+    } else if (auto *leaf = dynamic_cast<DataObjects::MDBox<MDE, nd> *>(&box)) {
+      descent.leaves.emplace_back(Leaf{leaf, std::move(touching), {}});
+    }
+  }
+
+  /// Integrate the events of the leaves, each for all its spheres
+  void integrateLeaves(std::vector<Leaf> &leaves, const bool fileBacked) {
+    // Read the boxes of a file in order of their IDs, which is roughly the
+    // order they are stored in
+    if (fileBacked)
+      std::sort(leaves.begin(), leaves.end(),
+                [](const Leaf &a, const Leaf &b) {
+                  return a.box->getID() < b.box->getID();
+                });
+    PARALLEL_FOR_IF(!fileBacked)
+    for (int i = 0; i < static_cast<int>(leaves.size()); ++i) {
+      auto &leaf = leaves[i];
+      const auto &events = leaf.box->getConstEvents();
+      leaf.results.reserve(leaf.spheres.size());
+      for (const auto index : leaf.spheres)
+        leaf.results.emplace_back(integrateEvents(events, m_spheres[index]));
+      leaf.box->releaseEvents();
+    }
+    for (const auto &leaf : leaves) {
+      for (size_t i = 0; i < leaf.spheres.size(); ++i) {
+        auto &sphere = m_spheres[leaf.spheres[i]];
+        sphere.signal += leaf.results[i].first;
+        sphere.errorSquared += leaf.results[i].second;
+      }
+    }
+  }
+
+  /// Integrate events in a sphere as MDBox::integrateSphere does
+  static std::pair<signal_t, signal_t>
+  integrateEvents(const std::vector<MDE> &events, const Sphere &sphere) {
+    signal_t signal = 0;
+    signal_t errorSquared = 0;
+    if (sphere.innerRadiusSquared == 0.0) {
+      for (const auto &event : events) {
+        if (distanceSquared(sphere.center, event.getCenter()) <
+            sphere.radiusSquared) {
+          signal += static_cast<signal_t>(event.getSignal());
+          errorSquared += static_cast<signal_t>(event.getErrorSquared());
+        }
+      }
+      return {signal, errorSquared};
+    }
+    std::vector<std::pair<signal_t, signal_t>> values;
+    for (const auto &event : events) {
+      const auto out = distanceSquared(sphere.center, event.getCenter());
+      if (out < sphere.radiusSquared && out > sphere.innerRadiusSquared)
+        values.emplace_back(static_cast<signal_t>(event.getSignal()),
+                            static_cast<signal_t>(event.getErrorSquared()));
+    }
+    std::sort(values.begin(), values.end(),
+              [](const std::pair<signal_t, signal_t> &a,
+                 const std::pair<signal_t, signal_t> &b) {
+                return a.first < b.first;
+              });
+    // Remove top 1% of background
+    const size_t endIndex =
+        sphere.useOnePercentBackgroundCorrection
+            ? static_cast<size_t>(0.99 * static_cast<double>(values.size()))
+            : values.size();
+    for (size_t k = 0; k < endIndex; k++) {
+      signal += values[k].first;
+      errorSquared += values[k].second;
+    }
+    return {signal, errorSquared};
+  }
+
+  std::vector<Sphere> m_spheres;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
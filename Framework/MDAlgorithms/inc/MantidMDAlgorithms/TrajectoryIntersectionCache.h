@@ -0,0 +1,65 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidKernel/LRUCache.h"
+#include "MantidMDAlgorithms/DllConfig.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** TrajectoryIntersectionCache : Keeps the points where the trajectories of
+  the detectors cross the grid of a normalization workspace, as computed by
+  MDNorm, so that normalizing again with the same geometry and binning does
+  not compute them again. This is the case for a background run measured at
+  the same orientations, or when the flux or solid angle workspace changes.
+
+  The intersections are kept in a Kernel::LRUCache under the
+  Kernel::HashBuilder hash of every value they depend on. The values are kept
+  too and compared on a hit, so that intersections whose values only share
+  the hash are never used. The process wide instance() takes its limit in MiB
+  from the MDNorm.IntersectionCacheSize configuration key.
+*/
+class MANTID_MDALGORITHMS_DLL TrajectoryIntersectionCache {
+public:
+  /// The (h, k, l, momentum) points of each detector, sorted by momentum
+  using Intersections = std::vector<std::vector<std::array<double, 4>>>;
+
+  explicit TrajectoryIntersectionCache(const size_t memoryLimit);
+  static TrajectoryIntersectionCache &instance();
+  static size_t memoryOf(const Intersections &intersections);
+
+  std::shared_ptr<const Intersections> find(const std::vector<double> &inputs);
+  void insert(std::vector<double> inputs,
+              std::shared_ptr<const Intersections> intersections);
+  /// @return the maximum number of bytes held by the intersections
+  size_t memoryLimit() const { return m_entries.memoryLimit(); }
+  /// @return the number of intersections kept
+  size_t size() const { return m_entries.size(); }
+
+private:
+  struct Entry {
+    /// Every value the intersections depend on
+    std::vector<double> inputs;
+    std::shared_ptr<const Intersections> intersections;
+  };
+  Kernel::LRUCache<Entry> m_entries;
+};
+
+/// Interpolate the integrated flux at the momenta of the intersections
+MANTID_MDALGORITHMS_DLL void
+calcIntegralsForIntersections(const std::vector<double> &xValues,
+                              const API::MatrixWorkspace &integrFlux,
+                              size_t sp, std::vector<double> &yValues);
+
+} // namespace MDAlgorithms
+} // namespace Mantid
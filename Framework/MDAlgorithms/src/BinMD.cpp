@@ -16,6 +16,7 @@
 #include "MantidDataObjects/MDHistoWorkspace.h"
 #include "MantidGeometry/MDGeometry/MDBoxImplicitFunction.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
+#include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/Strings.h"
@@ -23,6 +24,9 @@
 #include "MantidKernel/Utils.h"
 #include <boost/algorithm/string.hpp>
 
+#include <cmath>
+#include <future>
+
 namespace Mantid {
 namespace MDAlgorithms {
 
@@ -34,6 +38,11 @@ using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::DataObjects;
 
+namespace {
+/// Number of events whose coordinates are transformed together
+constexpr size_t EVENT_BLOCK_SIZE = 1024;
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -75,9 +84,28 @@ void BinMD::init() {
                                                 Direction::Input),
       "Temporary parameter: true to run in parallel. This is ignored for "
       "file-backed workspaces, where running in parallel makes things slower "
-      "due to disk thrashing.");
+      "due to disk thrashing. Their events are instead read in the order of "
+      "the file, in the background, and transformed in parallel.");
   setPropertyGroup("Parallel", grp);
 
+  auto nonNegative = std::make_shared<BoundedValidator<double>>();
+  nonNegative->setLower(0.0);
+  declareProperty(
+      "LevelOfDetail", 0.0, nonNegative,
+      "For a quick preview: boxes spanning no more than this many output "
+      "bins along every output dimension are binned from their cached "
+      "totals, at the bin of their centre, without reading their events. "
+      "Bin again with a lower value to refine the preview. "
+      "0 bins every event exactly.");
+  setPropertyGroup("LevelOfDetail", grp);
+
+  declareProperty(std::make_unique<PropertyWithValue<double>>(
+                      "LevelOfDetailError", 0.0, Direction::Output),
+                  "An upper bound of the total absolute signal that "
+                  "LevelOfDetail may have put in the wrong bins: that of the "
+                  "boxes binned from their totals that are not within a "
+                  "single bin.");
+
   declareProperty(std::make_unique<WorkspaceProperty<IMDHistoWorkspace>>(
                       "TemporaryDataWorkspace", "", Direction::Input,
                       PropertyMode::Optional),
@@ -91,134 +119,367 @@ void BinMD::init() {
 }
 
 //----------------------------------------------------------------------------------------------
-/** Bin the contents of a MDBox
+/** Find the bin of a point
+ *
+ * @param outCenter :: the coordinates of the point in the output workspace
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ * @return the linear index of the bin, or size_t(-1) if the point is outside
+ *the range
+ */
+size_t BinMD::getLinearIndex(const coord_t *outCenter,
+                             const size_t *const chunkMin,
+                             const size_t *const chunkMax) const {
+  // To build up the linear index
+  size_t linearIndex = 0;
+  /// Loop through the dimensions on which we bin
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    // What is the bin index in that dimension
+    coord_t x = outCenter[bd];
+    auto ix = size_t(x);
+    // Within range (for this chunk)?
+    if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
+      // Build up the linear index
+      linearIndex += indexMultiplier[bd] * ix;
+    } else {
+      // Outside the range
+      return size_t(-1);
+    }
+  } // (for each dim in MDHisto)
+  return linearIndex;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Add the cached signal of a MDBox if the entire box is in the same bin
  *
  * @param box :: pointer to the MDBox to bin
  * @param chunkMin :: the minimum index in each dimension to consider "valid"
  *(inclusive)
  * @param chunkMax :: the maximum index in each dimension to consider "valid"
  *(exclusive)
+ * @return true if the box was binned, false if its events must be binned
  */
 template <typename MDE, size_t nd>
-inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                            const size_t *const chunkMax) {
-  // An array to hold the rotated/transformed coordinates
-  auto outCenter = std::vector<coord_t>(m_outD);
-
-  // Evaluate whether the entire box is in the same bin
-  if (box->getNPoints() > (1 << nd) * 2) {
-    // There is a check that the number of events is enough for it to make sense
-    // to do all this processing.
-    size_t numVertexes = 0;
-    auto vertexes = box->getVertexesArray(numVertexes);
-
-    // All vertexes have to be within THE SAME BIN = have the same linear index.
-    size_t lastLinearIndex = 0;
-    bool badOne = false;
-
-    for (size_t i = 0; i < numVertexes; i++) {
-      // Cache the center of the event (again for speed)
-      const coord_t *inCenter = vertexes.get() + i * nd;
-
-      // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter.data());
-
-      // To build up the linear index
-      size_t linearIndex = 0;
-      // To mark VERTEXES outside range
-      badOne = false;
+bool BinMD::binWholeBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
+                        const size_t *const chunkMax) {
+  // There is a check that the number of events is enough for it to make sense
+  // to do all this processing.
+  if (box->getNPoints() <= (1 << nd) * 2)
+    return false;
+
+  size_t numVertexes = 0;
+  auto vertexes = box->getVertexesArray(numVertexes);
+  // The rotated/transformed coordinates of the vertexes
+  std::vector<coord_t> outCenters(numVertexes * m_outD);
+  m_transform->applyBatch(vertexes.get(), nd, outCenters.data(), numVertexes);
+
+  // All vertexes have to be within THE SAME BIN = have the same linear index.
+  size_t lastLinearIndex = 0;
+  for (size_t i = 0; i < numVertexes; i++) {
+    const size_t linearIndex =
+        getLinearIndex(outCenters.data() + i * m_outD, chunkMin, chunkMax);
+    // Was the vertex completely outside the range, or is it at another place
+    // than the last one?
+    if (linearIndex == size_t(-1) || (i > 0 && linearIndex != lastLinearIndex))
+      return false;
+    lastLinearIndex = linearIndex;
+  } // (for each vertex)
+
+  // Yes, the entire box is within a single bin
+  // Add the CACHED signal from the entire box
+  signals[lastLinearIndex] += box->getSignal();
+  errors[lastLinearIndex] += box->getErrorSquared();
+  // TODO: If DataObjects get a weight, this would need to get the summed
+  // weight.
+  numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
+  return true;
+}
 
-      /// Loop through the dimensions on which we bin
-      for (size_t bd = 0; bd < m_outD; bd++) {
-        // What is the bin index in that dimension
-        coord_t x = outCenter[bd];
-        auto ix = size_t(x);
-        // Within range (for this chunk)?
-        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-          // Build up the linear index
-          linearIndex += indexMultiplier[bd] * ix;
-        } else {
-          // Outside the range
-          badOne = true;
-          break;
-        }
-      } // (for each dim in MDHisto)
-
-      // Is the vertex at the same place as the last one?
-      if (!badOne) {
-        if ((i > 0) && (linearIndex != lastLinearIndex)) {
-          // Change of index
-          badOne = true;
-          break;
-        }
-        lastLinearIndex = linearIndex;
+//----------------------------------------------------------------------------------------------
+/** Find the depth of the boxes binned from their totals for a preview at a
+ * lower level of detail: the shallowest depth at which a box spans no more
+ * than the given number of output bins along every output dimension. The
+ * boxes of a depth are all the same size, so one box of that size is enough.
+ *
+ * @param ws :: the workspace to bin
+ * @param levelOfDetail :: the largest span of a box, in output bins
+ * @return the depth, or one beyond the deepest box if no depth is small enough
+ */
+template <typename MDE, size_t nd>
+size_t BinMD::getLevelOfDetailDepth(MDEventWorkspace<MDE, nd> &ws,
+                                    const double levelOfDetail) const {
+  auto bc = ws.getBoxController();
+  auto *root = ws.getBox();
+  coord_t origin[nd];
+  coord_t size[nd];
+  for (size_t d = 0; d < nd; ++d) {
+    origin[d] = root->getExtents(d).getMin();
+    size[d] = root->getExtents(d).getSize();
+  }
+  const size_t numVertexes = size_t(1) << nd;
+  std::vector<coord_t> vertexes(numVertexes * nd);
+  std::vector<coord_t> outVertexes(numVertexes * m_outD);
+  const auto splitTopInto = bc->getSplitTopInto();
+  for (size_t depth = 0; depth <= bc->getMaxDepth(); ++depth) {
+    for (size_t i = 0; i < numVertexes; ++i)
+      for (size_t d = 0; d < nd; ++d)
+        vertexes[i * nd + d] = origin[d] + ((i >> d) & 1 ? size[d] : 0.f);
+    m_transform->applyBatch(vertexes.data(), nd, outVertexes.data(),
+                            numVertexes);
+    bool withinLevel = true;
+    for (size_t od = 0; od < m_outD && withinLevel; ++od) {
+      coord_t min = outVertexes[od];
+      coord_t max = outVertexes[od];
+      for (size_t i = 1; i < numVertexes; ++i) {
+        min = std::min(min, outVertexes[i * m_outD + od]);
+        max = std::max(max, outVertexes[i * m_outD + od]);
       }
-
-      // Was the vertex completely outside the range?
-      if (badOne)
-        break;
-    } // (for each vertex)
-
-    if (!badOne) {
-      // Yes, the entire box is within a single bin
-      //        std::cout << "Box at " << box->getExtentsStr() << " is within a
-      //        single bin.\n";
-      // Add the CACHED signal from the entire box
-      signals[lastLinearIndex] += box->getSignal();
-      errors[lastLinearIndex] += box->getErrorSquared();
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
-
-      // And don't bother looking at each event. This may save lots of time
-      // loading from disk.
-      return;
+      withinLevel = max - min <= levelOfDetail;
     }
+    if (withinLevel)
+      return depth;
+    for (size_t d = 0; d < nd; ++d)
+      size[d] /= static_cast<coord_t>(depth == 0 && splitTopInto
+                                          ? splitTopInto.get()[d]
+                                          : bc->getSplitInto(d));
   }
+  return bc->getMaxDepth() + 1;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Add the cached signal of a box at the bin of its centre, for a preview at a
+ * lower level of detail. A box touching several chunks is binned by the one
+ * holding its centre along the chunk dimension, clamped to the output.
+ *
+ * @param box :: the box to bin
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ * @param chunkDimension :: the dimension along which the output is chunked
+ * @return the absolute signal of the box if it may be in the wrong bin, i.e.
+ *its vertexes are not all in the bin of its centre, otherwise 0
+ */
+signal_t BinMD::binBoxAtCentre(API::IMDNode *box, const size_t *const chunkMin,
+                               const size_t *const chunkMax,
+                               const size_t chunkDimension) {
+  std::vector<coord_t> center(box->getNumDims());
+  box->getCenter(center.data());
+  std::vector<coord_t> outCenter(m_outD);
+  m_transform->apply(center.data(), outCenter.data());
+
+  const size_t numBins = m_binDimensions[chunkDimension]->getNBins();
+  const coord_t x = outCenter[chunkDimension];
+  const size_t chunkIndex =
+      x < 0 ? 0 : std::min(static_cast<size_t>(x), numBins - 1);
+  if (chunkIndex < chunkMin[chunkDimension] ||
+      chunkIndex >= chunkMax[chunkDimension])
+    return 0.;
+
+  std::vector<size_t> outputMin(m_outD, 0);
+  std::vector<size_t> outputMax(m_outD);
+  for (size_t bd = 0; bd < m_outD; ++bd)
+    outputMax[bd] = m_binDimensions[bd]->getNBins();
+  const size_t linearIndex =
+      getLinearIndex(outCenter.data(), outputMin.data(), outputMax.data());
+
+  size_t numVertexes = 0;
+  auto vertexes = box->getVertexesArray(numVertexes);
+  std::vector<coord_t> outVertexes(numVertexes * m_outD);
+  m_transform->applyBatch(vertexes.get(), box->getNumDims(),
+                          outVertexes.data(), numVertexes);
+  bool withinBin = linearIndex != size_t(-1);
+  for (size_t i = 0; i < numVertexes && withinBin; i++)
+    withinBin = getLinearIndex(outVertexes.data() + i * m_outD,
+                               outputMin.data(),
+                               outputMax.data()) == linearIndex;
+
+  if (linearIndex != size_t(-1)) {
+    signals[linearIndex] += box->getSignal();
+    errors[linearIndex] += box->getErrorSquared();
+    numEvents[linearIndex] += static_cast<signal_t>(box->getNPoints());
+  }
+  return withinBin ? 0. : std::abs(box->getSignal());
+}
+
+//----------------------------------------------------------------------------------------------
+/** Bin the contents of a MDBox
+ *
+ * @param box :: pointer to the MDBox to bin
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ */
+template <typename MDE, size_t nd>
+inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
+                            const size_t *const chunkMax) {
+  // Evaluate whether the entire box is in the same bin. If so, don't bother
+  // looking at each event. This may save lots of time loading from disk.
+  if (binWholeBox(box, chunkMin, chunkMax))
+    return;
 
   // If you get here, you could not determine that the entire box was in the
   // same bin.
   // So you need to iterate through events.
   const std::vector<MDE> &events = box->getConstEvents();
-  for (auto it = events.begin(); it != events.end(); ++it) {
-    // Cache the center of the event (again for speed)
-    const coord_t *inCenter = it->getCenter();
-
-    // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter.data());
-
-    // To build up the linear index
-    size_t linearIndex = 0;
-    // To mark events outside range
-    bool badOne = false;
-
-    /// Loop through the dimensions on which we bin
-    for (size_t bd = 0; bd < m_outD; bd++) {
-      // What is the bin index in that dimension
-      coord_t x = outCenter[bd];
-      auto ix = size_t(x);
-      // Within range (for this chunk)?
-      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-        // Build up the linear index
-        linearIndex += indexMultiplier[bd] * ix;
-      } else {
-        // Outside the range
-        badOne = true;
-        break;
-      }
-    } // (for each dim in MDHisto)
+  binEvents(events.data(), events.size(), chunkMin, chunkMax, false);
+  // Done with the events list
+  box->releaseEvents();
+}
 
-    if (!badOne) {
+//----------------------------------------------------------------------------------------------
+/** Bin events. The coordinates are transformed in blocks of events, straight
+ * from the array of events, then the events are added to the output.
+ *
+ * @param events :: the events to bin
+ * @param eventCount :: the number of events
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ * @param parallel :: transform the blocks in parallel
+ */
+template <typename MDE>
+void BinMD::binEvents(const MDE *events, const size_t eventCount,
+                      const size_t *const chunkMin,
+                      const size_t *const chunkMax, const bool parallel) {
+  static_assert(sizeof(MDE) % sizeof(coord_t) == 0,
+                "The centers of the events must be a whole number of "
+                "coordinates apart");
+  constexpr size_t stride = sizeof(MDE) / sizeof(coord_t);
+  std::vector<size_t> linearIndexes(eventCount);
+  auto indexBlock = [&](const size_t begin, std::vector<coord_t> &outCenters) {
+    const size_t size = std::min(EVENT_BLOCK_SIZE, eventCount - begin);
+    m_transform->applyBatch(events[begin].getCenter(), stride,
+                            outCenters.data(), size);
+    for (size_t i = 0; i < size; ++i)
+      linearIndexes[begin + i] =
+          getLinearIndex(outCenters.data() + i * m_outD, chunkMin, chunkMax);
+  };
+  const auto numBlocks =
+      static_cast<int64_t>((eventCount + EVENT_BLOCK_SIZE - 1) /
+                           EVENT_BLOCK_SIZE);
+  if (parallel) {
+    PRAGMA_OMP(parallel) {
+      std::vector<coord_t> outCenters(EVENT_BLOCK_SIZE * m_outD);
+      PRAGMA_OMP(for)
+      for (int64_t block = 0; block < numBlocks; ++block)
+        indexBlock(static_cast<size_t>(block) * EVENT_BLOCK_SIZE, outCenters);
+    }
+  } else {
+    std::vector<coord_t> outCenters(
+        std::min(EVENT_BLOCK_SIZE, eventCount) * m_outD);
+    for (size_t begin = 0; begin < eventCount; begin += EVENT_BLOCK_SIZE)
+      indexBlock(begin, outCenters);
+  }
+  for (size_t i = 0; i < eventCount; ++i) {
+    const size_t linearIndex = linearIndexes[i];
+    if (linearIndex != size_t(-1)) {
       // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
+      signals[linearIndex] += static_cast<signal_t>(events[i].getSignal());
+      errors[linearIndex] += static_cast<signal_t>(events[i].getErrorSquared());
       // TODO: If DataObjects get a weight, this would need to get the summed
       // weight.
       numEvents[linearIndex] += 1.0;
     }
   }
-  // Done with the events list
-  box->releaseEvents();
+}
+
+//----------------------------------------------------------------------------------------------
+/** Bin the boxes of a file-backed workspace. Boxes whose events are all on
+ * disk are not loaded through the disk buffer: they are sorted by position in
+ * the file and read in large contiguous blocks, the next block being read in
+ * the background while the current one is binned. Other boxes are binned as
+ * usual.
+ *
+ * @param boxes :: the boxes to bin
+ * @param fileIO :: the file the boxes are saved in
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ */
+template <typename MDE, size_t nd>
+void BinMD::binFileBackedBoxes(const std::vector<API::IMDNode *> &boxes,
+                               API::IBoxControllerIO &fileIO,
+                               const size_t *const chunkMin,
+                               const size_t *const chunkMax) {
+  std::vector<const Kernel::ISaveable *> onDisk;
+  for (auto *node : boxes) {
+    auto *box = dynamic_cast<MDBox<MDE, nd> *>(node);
+    if (box && !box->getIsMasked()) {
+      const auto *saveable = box->getISaveable();
+      if (!saveable || !saveable->wasSaved() || saveable->isLoaded() ||
+          box->getDataInMemorySize() > 0)
+        this->binMDBox(box, chunkMin, chunkMax);
+      else if (!this->binWholeBox(box, chunkMin, chunkMax))
+        onDisk.emplace_back(saveable);
+      else if (prog)
+        prog->report();
+    } else if (prog) {
+      prog->report();
+    }
+    if (this->m_cancel)
+      return;
+  }
+  std::sort(onDisk.begin(), onDisk.end(),
+            [](const Kernel::ISaveable *a, const Kernel::ISaveable *b) {
+              return a->getFilePosition() < b->getFilePosition();
+            });
+
+  // Group the boxes into blocks of consecutive events. Small gaps are read
+  // through rather than seeking over them.
+  struct Block {
+    uint64_t position;
+    uint64_t size;
+    size_t numBoxes;
+    /// Events of the boxes, as (offset in the block, number of events)
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;
+  };
+  const uint64_t maxBlockSize = 1 << 20;
+  const uint64_t maxGap = 1 << 14;
+  std::vector<Block> blocks;
+  for (const auto *saveable : onDisk) {
+    const auto position = saveable->getFilePosition();
+    const auto size = saveable->getFileSize();
+    if (size == 0)
+      continue;
+    if (blocks.empty() || position > blocks.back().position +
+                                         blocks.back().size + maxGap ||
+        blocks.back().size >= maxBlockSize)
+      blocks.push_back(Block{position, 0, 0, {}});
+    auto &block = blocks.back();
+    block.ranges.emplace_back(position - block.position, size);
+    block.size = std::max(block.size, position - block.position + size);
+    ++block.numBoxes;
+  }
+
+  auto readBlock = [&fileIO, &blocks](const size_t index) {
+    std::vector<coord_t> data;
+    fileIO.loadBlock(data, blocks[index].position,
+                     static_cast<size_t>(blocks[index].size));
+    return data;
+  };
+  std::future<std::vector<coord_t>> nextBlock;
+  if (!blocks.empty())
+    nextBlock = std::async(std::launch::async, readBlock, 0);
+  std::vector<MDE> events;
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    const auto data = nextBlock.get();
+    if (i + 1 < blocks.size())
+      nextBlock = std::async(std::launch::async, readBlock, i + 1);
+    MDE::dataToEvents(data, events);
+    for (const auto &range : blocks[i].ranges)
+      binEvents(events.data() + range.first, static_cast<size_t>(range.second),
+                chunkMin, chunkMax, true);
+    if (prog)
+      prog->reportIncrement(blocks[i].numBoxes);
+    if (this->m_cancel)
+      return;
+  }
 }
 
 //----------------------------------------------------------------------------------------------
@@ -265,6 +526,13 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   if (chunkNumBins < 1)
     chunkNumBins = 1;
 
+  // Boxes at this depth are binned from their totals, without their events
+  const double levelOfDetail = getProperty("LevelOfDetail");
+  size_t maxDepth = 1000;
+  if (levelOfDetail > 0.)
+    maxDepth = getLevelOfDetailDepth(*ws, levelOfDetail);
+  signal_t levelOfDetailError = 0.;
+
   // Do we actually do it in parallel?
   bool doParallel = getProperty("Parallel");
   // Not if file-backed!
@@ -311,8 +579,9 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
 
       // Use getBoxes() to get an array with a pointer to each box
       std::vector<API::IMDNode *> boxes;
-      // Leaf-only; no depth limit; with the implicit function passed to it.
-      ws->getBox()->getBoxes(boxes, 1000, true, function.get());
+      // Leaf-only, down to the level of detail; with the implicit function
+      // passed to it.
+      ws->getBox()->getBoxes(boxes, maxDepth, true, function.get());
 
       // Sort boxes by file position IF file backed. This reduces seeking time,
       // hopefully.
@@ -329,23 +598,42 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         }
       }
 
-      // Go through every box for this chunk.
-      for (auto &boxe : boxes) {
-        auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
-        // Perform the binning in this separate method.
-        if (box && !box->getIsMasked())
-          this->binMDBox(box, chunkMin.data(), chunkMax.data());
-
-        // Progress reporting
-        if (prog)
-          prog->report();
-        // For early cancelling of the loop
-        if (this->m_cancel)
-          break;
-      } // for each box in the vector
+      // Boxes still split are at the level of detail: the MDBox binning
+      // below skips them
+      signal_t chunkError = 0.;
+      for (auto *node : boxes) {
+        if (!node->isLeaf() && !node->getIsMasked())
+          chunkError += this->binBoxAtCentre(node, chunkMin.data(),
+                                             chunkMax.data(), chunkDimension);
+      }
+      if (chunkError > 0.) {
+        PARALLEL_CRITICAL(BinMD_levelOfDetail)
+        levelOfDetailError += chunkError;
+      }
+
+      if (bc->isFileBacked()) {
+        this->binFileBackedBoxes<MDE, nd>(boxes, *bc->getFileIO(),
+                                          chunkMin.data(), chunkMax.data());
+      } else {
+        // Go through every box for this chunk.
+        for (auto &boxe : boxes) {
+          auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
+          // Perform the binning in this separate method.
+          if (box && !box->getIsMasked())
+            this->binMDBox(box, chunkMin.data(), chunkMax.data());
+
+          // Progress reporting
+          if (prog)
+            prog->report();
+          // For early cancelling of the loop
+          if (this->m_cancel)
+            break;
+        } // for each box in the vector
+      }
       PARALLEL_END_INTERUPT_REGION
     } // for each chunk in parallel
     PARALLEL_CHECK_INTERUPT_REGION
+    setProperty("LevelOfDetailError", static_cast<double>(levelOfDetailError));
 
     // Now the implicit function
     if (implicitFunction) {
@@ -377,12 +665,15 @@ void BinMD::exec() {
   // This gets deleted by the thread pool; don't delete it in here.
   prog = std::make_unique<Progress>(this, 0.0, 1.0, 1);
 
-  // Create the dense histogram. This allocates the memory
+  // Create the dense histogram. The memory of its bins is only taken where
+  // events are binned
   std::shared_ptr<IMDHistoWorkspace> tmp =
       this->getProperty("TemporaryDataWorkspace");
   outWS = std::dynamic_pointer_cast<MDHistoWorkspace>(tmp);
   if (!outWS) {
-    outWS = std::make_shared<MDHistoWorkspace>(m_binDimensions);
+    outWS = std::make_shared<MDHistoWorkspace>(
+        m_binDimensions, API::NoNormalization,
+        MDHistoWorkspace::Initialisation::Zero);
   } else {
     m_accumulate = true;
   }
@@ -9,6 +9,7 @@
 #include "MantidDataObjects/PeakShapeEllipsoid.h"
 #include "MantidGeometry/Crystal/IndexingUtils.h"
 
+#include <algorithm>
 #include <boost/math/special_functions/round.hpp>
 #include <cmath>
 #include <fstream>
@@ -118,6 +119,11 @@ Integrate3DEvents::Integrate3DEvents(
  *       are centered around 0,0,0 and represent offsets in Q from the peak
  *       center.
  *
+ * This may be called from several threads at once. The peak of each event is
+ * found without locking, then the events are added to each shard of the lists
+ * with its lock held once. The events of a peak from one call are kept in
+ * order.
+ *
  * @param event_qs   List of event Q vectors to add to lists of Q's associated
  *                   with peaks.
  * @param hkl_integ
@@ -125,12 +131,32 @@ Integrate3DEvents::Integrate3DEvents(
 void Integrate3DEvents::addEvents(
     std::vector<std::pair<std::pair<double, double>, V3D>> const &event_qs,
     bool hkl_integ) {
-  if (!maxOrder)
-    for (const auto &event_q : event_qs)
-      addEvent(event_q, hkl_integ);
-  else
-    for (const auto &event_q : event_qs)
-      addModEvent(event_q, hkl_integ);
+  std::vector<std::pair<int64_t, std::pair<std::pair<double, double>, V3D>>>
+      keyed_events;
+  for (auto event_q : event_qs) {
+    const int64_t key = maxOrder ? getModEventKey(event_q, hkl_integ)
+                                 : getEventKey(event_q, hkl_integ);
+    if (key != 0)
+      keyed_events.emplace_back(key, event_q);
+  }
+  if (keyed_events.empty())
+    return;
+
+  std::stable_sort(keyed_events.begin(), keyed_events.end(),
+                   [](const auto &a, const auto &b) {
+                     return getShard(a.first) < getShard(b.first);
+                   });
+  auto begin = keyed_events.cbegin();
+  while (begin != keyed_events.cend()) {
+    const size_t shard = getShard(begin->first);
+    const auto end = std::find_if(
+        begin, keyed_events.cend(),
+        [shard](const auto &item) { return getShard(item.first) != shard; });
+    std::lock_guard<std::mutex> lock(m_event_list_mutexes[shard]);
+    auto &event_lists = m_event_lists[shard];
+    for (; begin != end; ++begin)
+      event_lists[begin->first].emplace_back(begin->second);
+  }
 }
 
 std::pair<std::shared_ptr<const Geometry::PeakShape>,
@@ -353,7 +379,7 @@ double Integrate3DEvents::estimateSignalToNoiseRatio(
 }
 
 const std::vector<std::pair<std::pair<double, double>, V3D>> *
-Integrate3DEvents::getEvents(const V3D &peak_q) {
+Integrate3DEvents::getEvents(const V3D &peak_q) const {
   auto hkl_key = getHklKey(peak_q);
   if (maxOrder)
     hkl_key = getHklMnpKey(peak_q);
@@ -361,17 +387,46 @@ Integrate3DEvents::getEvents(const V3D &peak_q) {
   if (hkl_key == 0)
     return nullptr;
 
-  const auto pos = m_event_lists.find(hkl_key);
+  const auto events = findEvents(hkl_key);
 
-  if (m_event_lists.end() == pos)
+  if (!events)
     return nullptr;
 
-  if (pos->second.size() < 3) // if there are not enough events
+  if (events->size() < 3) // if there are not enough events
     return nullptr;
 
+  return events;
+}
+
+/**
+ * Find the list of events stored for a map key. The lists must not be added
+ * to while this is called.
+ *
+ * @param key  The map key of a peak
+ * @return the events near the peak, or nullptr if there are none
+ */
+const std::vector<std::pair<std::pair<double, double>, V3D>> *
+Integrate3DEvents::findEvents(int64_t key) const {
+  const auto &event_lists = m_event_lists[getShard(key)];
+  const auto pos = event_lists.find(key);
+  if (event_lists.end() == pos)
+    return nullptr;
   return &(pos->second);
 }
 
+/**
+ * The lists of events are split by a multiplicative hash of their key, so that
+ * the events of nearby peaks are spread over the shards even though the keys
+ * are multiples of powers of ten.
+ *
+ * @param key  The map key of a peak
+ * @return the index of the shard holding the events of the peak
+ */
+size_t Integrate3DEvents::getShard(int64_t key) {
+  const auto hash = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+  return static_cast<size_t>(hash >> 32) % NUM_SHARDS;
+}
+
 bool Integrate3DEvents::correctForDetectorEdges(
     std::tuple<double, double, double> &radii, const std::vector<V3D> &E1Vecs,
     const V3D &peak_q, const std::vector<double> &axesRadii,
@@ -456,13 +511,12 @@ Integrate3DEvents::ellipseIntegrateEvents(
     return std::make_shared<NoShape>();
   }
 
-  auto pos = m_event_lists.find(hkl_key);
-  if (m_event_lists.end() == pos)
+  const auto events = findEvents(hkl_key);
+  if (!events)
     return std::make_shared<NoShape>();
-  ;
 
-  std::vector<std::pair<std::pair<double, double>, V3D>> &some_events =
-      pos->second;
+  const std::vector<std::pair<std::pair<double, double>, V3D>> &some_events =
+      *events;
 
   if (some_events.size() < 3) // if there are not enough events to
   {                           // find covariance matrix, return
@@ -515,13 +569,12 @@ Integrate3DEvents::ellipseIntegrateModEvents(
     return std::make_shared<NoShape>();
   }
 
-  auto pos = m_event_lists.find(hkl_key);
-  if (m_event_lists.end() == pos)
+  const auto events = findEvents(hkl_key);
+  if (!events)
     return std::make_shared<NoShape>();
-  ;
 
-  std::vector<std::pair<std::pair<double, double>, V3D>> &some_events =
-      pos->second;
+  const std::vector<std::pair<std::pair<double, double>, V3D>> &some_events =
+      *events;
 
   if (some_events.size() < 3) // if there are not enough events to
   {                           // find covariance matrix, return
@@ -776,7 +829,7 @@ int64_t Integrate3DEvents::getHklMnpKey(int h, int k, int l, int m, int n,
  *
  *  @param hkl  The q_vector to be mapped to h,k,l
  */
-int64_t Integrate3DEvents::getHklKey2(V3D const &hkl) {
+int64_t Integrate3DEvents::getHklKey2(V3D const &hkl) const {
   int h = boost::math::iround<double>(hkl[0]);
   int k = boost::math::iround<double>(hkl[1]);
   int l = boost::math::iround<double>(hkl[2]);
@@ -789,7 +842,7 @@ int64_t Integrate3DEvents::getHklKey2(V3D const &hkl) {
  *
  *  @param hkl  The q_vector to be mapped to h,k,l
  */
-int64_t Integrate3DEvents::getHklMnpKey2(V3D const &hkl) {
+int64_t Integrate3DEvents::getHklMnpKey2(V3D const &hkl) const {
   V3D modvec1 = V3D(m_ModHKL[0][0], m_ModHKL[1][0], m_ModHKL[2][0]);
   V3D modvec2 = V3D(m_ModHKL[0][1], m_ModHKL[1][1], m_ModHKL[2][1]);
   V3D modvec3 = V3D(m_ModHKL[0][2], m_ModHKL[1][2], m_ModHKL[2][2]);
@@ -880,7 +933,7 @@ int64_t Integrate3DEvents::getHklMnpKey2(V3D const &hkl) {
  *
  *  @param q_vector  The q_vector to be mapped to h,k,l
  */
-int64_t Integrate3DEvents::getHklKey(V3D const &q_vector) {
+int64_t Integrate3DEvents::getHklKey(V3D const &q_vector) const {
   V3D hkl = m_UBinv * q_vector;
   int h = boost::math::iround<double>(hkl[0]);
   int k = boost::math::iround<double>(hkl[1]);
@@ -896,7 +949,7 @@ int64_t Integrate3DEvents::getHklKey(V3D const &q_vector) {
  *
  *  @param q_vector  The q_vector to be mapped to h,k,l
  */
-int64_t Integrate3DEvents::getHklMnpKey(V3D const &q_vector) {
+int64_t Integrate3DEvents::getHklMnpKey(V3D const &q_vector) const {
   V3D hkl = m_UBinv * q_vector;
 
   V3D modvec1 = V3D(m_ModHKL[0][0], m_ModHKL[1][0], m_ModHKL[2][0]);
@@ -984,21 +1037,21 @@ int64_t Integrate3DEvents::getHklMnpKey(V3D const &q_vector) {
 }
 
 /**
- * Add an event to the appropriate vector of events for the closest h,k,l,
- * if it is within the required radius of the corresponding peak in the
- * PeakQMap.
+ * Find the key of the closest h,k,l to an event, if the event is within the
+ * required radius of the corresponding peak in the PeakQMap.
  *
  * NOTE: The event passed in may be modified by this method.  In particular,
  * if it corresponds to one of the specified peak_qs, the corresponding peak q
- * will be subtracted from the event and the event will be added to that
- * peak's vector in the event_lists map.
+ * will be subtracted from the event, ready to be added to that peak's vector
+ * in the event_lists map.
  *
  * @param event_Q      The Q-vector for the event that may be added to the
  *                     event_lists map, if it is close enough to some peak
  * @param hkl_integ
+ * @return the key of the peak, or 0 if the event is not kept
  */
-void Integrate3DEvents::addEvent(
-    std::pair<std::pair<double, double>, V3D> event_Q, bool hkl_integ) {
+int64_t Integrate3DEvents::getEventKey(
+    std::pair<std::pair<double, double>, V3D> &event_Q, bool hkl_integ) const {
   int64_t hkl_key;
   if (hkl_integ)
     hkl_key = getHklKey2(event_Q.second);
@@ -1006,7 +1059,7 @@ void Integrate3DEvents::addEvent(
     hkl_key = getHklKey(event_Q.second);
 
   if (hkl_key == 0) // don't keep events associated with 0,0,0
-    return;
+    return 0;
 
   auto peak_it = m_peak_qs.find(hkl_key);
   if (peak_it != m_peak_qs.end()) {
@@ -1016,28 +1069,29 @@ void Integrate3DEvents::addEvent(
       else
         event_Q.second = event_Q.second - peak_it->second;
       if (event_Q.second.norm() < m_radius) {
-        m_event_lists[hkl_key].emplace_back(event_Q);
+        return hkl_key;
       }
     }
   }
+  return 0;
 }
 
 /**
- * Add an event to the appropriate vector of events for the closest h,k,l,
- * if it is within the required radius of the corresponding peak in the
- * PeakQMap.
+ * Find the key of the closest h,k,l,m,n,p to an event, if the event is within
+ * the required radius of the corresponding peak in the PeakQMap.
  *
  * NOTE: The event passed in may be modified by this method.  In particular,
  * if it corresponds to one of the specified peak_qs, the corresponding peak q
- * will be subtracted from the event and the event will be added to that
- * peak's vector in the event_lists map.
+ * will be subtracted from the event, ready to be added to that peak's vector
+ * in the event_lists map.
  *
  * @param event_Q      The Q-vector for the event that may be added to the
  *                     event_lists map, if it is close enough to some peak
  * @param hkl_integ
+ * @return the key of the peak, or 0 if the event is not kept
  */
-void Integrate3DEvents::addModEvent(
-    std::pair<std::pair<double, double>, V3D> event_Q, bool hkl_integ) {
+int64_t Integrate3DEvents::getModEventKey(
+    std::pair<std::pair<double, double>, V3D> &event_Q, bool hkl_integ) const {
   int64_t hklmnp_key;
 
   if (hkl_integ)
@@ -1046,7 +1100,7 @@ void Integrate3DEvents::addModEvent(
     hklmnp_key = getHklMnpKey(event_Q.second);
 
   if (hklmnp_key == 0) // don't keep events associated with 0,0,0
-    return;
+    return 0;
 
   auto peak_it = m_peak_qs.find(hklmnp_key);
   if (peak_it != m_peak_qs.end()) {
@@ -1058,12 +1112,13 @@ void Integrate3DEvents::addModEvent(
 
       if (hklmnp_key % 10000 == 0) {
         if (event_Q.second.norm() < m_radius)
-          m_event_lists[hklmnp_key].emplace_back(event_Q);
+          return hklmnp_key;
       } else if (event_Q.second.norm() < s_radius) {
-        m_event_lists[hklmnp_key].emplace_back(event_Q);
+        return hklmnp_key;
       }
     }
   }
+  return 0;
 }
 
 /**
@@ -115,7 +115,7 @@ void IntegrateEllipsoids::qListFromEventWS(Integrate3DEvents &integrator,
                                                    raw_event.m_errorSquared),
                          qVec);
     } // end of loop over events in list
-    PARALLEL_CRITICAL(addEvents) { integrator.addEvents(qList, hkl_integ); }
+    integrator.addEvents(qList, hkl_integ);
 
     prog.report();
     PARALLEL_END_INTERUPT_REGION
@@ -193,7 +193,7 @@ void IntegrateEllipsoids::qListFromHistoWS(Integrate3DEvents &integrator,
         qList.emplace_back(std::pair<double, double>(yVal, esqVal), qVec);
       }
     }
-    PARALLEL_CRITICAL(addHisto) { integrator.addEvents(qList, hkl_integ); }
+    integrator.addEvents(qList, hkl_integ);
     prog.report();
     PARALLEL_END_INTERUPT_REGION
   } // end of loop over spectra
@@ -502,12 +502,13 @@ void IntegrateEllipsoids::exec() {
     qListFromHistoWS(integrator, prog, histoWS, UBinv, hkl_integ);
   }
 
-  double inti;
-  double sigi;
-  std::vector<double> principalaxis1, principalaxis2, principalaxis3;
-  std::vector<double> sateprincipalaxis1, sateprincipalaxis2,
-      sateprincipalaxis3;
-  for (size_t i = 0; i < n_peaks; i++) {
+  // The lists of events are only read from now on, so the peaks are
+  // integrated in parallel. The axes of each peak are kept in order of the
+  // peaks for the statistics.
+  std::vector<std::vector<double>> peakAxesRadii(n_peaks);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int index = 0; index < static_cast<int>(n_peaks); ++index) {
+    const auto i = static_cast<size_t>(index);
     const V3D hkl(peaks[i].getIntHKL());
     const V3D mnp(peaks[i].getIntMNP());
 
@@ -550,6 +551,8 @@ void IntegrateEllipsoids::exec() {
       BackgroundOuterRadiusVector[i] = adaptiveBack_outer_radius;
 
       std::vector<double> axes_radii;
+      double inti;
+      double sigi;
       Mantid::Geometry::PeakShape_const_sptr shape =
           integrator.ellipseIntegrateModEvents(
               E1Vec, peak_q, hkl, mnp, specify_size, adaptiveRadius,
@@ -560,15 +563,7 @@ void IntegrateEllipsoids::exec() {
       peaks[i].setPeakShape(shape);
       if (axes_radii.size() == 3) {
         if (inti / sigi > cutoffIsigI || cutoffIsigI == EMPTY_DBL()) {
-          if (mnp == V3D(0, 0, 0)) {
-            principalaxis1.emplace_back(axes_radii[0]);
-            principalaxis2.emplace_back(axes_radii[1]);
-            principalaxis3.emplace_back(axes_radii[2]);
-          } else {
-            sateprincipalaxis1.emplace_back(axes_radii[0]);
-            sateprincipalaxis2.emplace_back(axes_radii[1]);
-            sateprincipalaxis3.emplace_back(axes_radii[2]);
-          }
+          peakAxesRadii[i] = std::move(axes_radii);
         }
       }
     } else {
@@ -576,6 +571,23 @@ void IntegrateEllipsoids::exec() {
       peaks[i].setSigmaIntensity(0.0);
     }
   }
+  std::vector<double> principalaxis1, principalaxis2, principalaxis3;
+  std::vector<double> sateprincipalaxis1, sateprincipalaxis2,
+      sateprincipalaxis3;
+  for (size_t i = 0; i < n_peaks; i++) {
+    const auto &axes_radii = peakAxesRadii[i];
+    if (axes_radii.empty())
+      continue;
+    if (peaks[i].getIntMNP() == V3D(0, 0, 0)) {
+      principalaxis1.emplace_back(axes_radii[0]);
+      principalaxis2.emplace_back(axes_radii[1]);
+      principalaxis3.emplace_back(axes_radii[2]);
+    } else {
+      sateprincipalaxis1.emplace_back(axes_radii[0]);
+      sateprincipalaxis2.emplace_back(axes_radii[1]);
+      sateprincipalaxis3.emplace_back(axes_radii[2]);
+    }
+  }
   if (principalaxis1.size() > 1) {
     Statistics stats1 = getStatistics(principalaxis1);
     g_log.notice() << "principalaxis1: "
@@ -647,34 +659,44 @@ void IntegrateEllipsoids::exec() {
       back_outer_radius = peak_radius * 1.25992105; // A factor of 2 ^ (1/3)
       // will make the background
       // shell volume equal to the peak region volume.
-      for (size_t i = 0; i < n_peaks; i++) {
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int index = 0; index < static_cast<int>(n_peaks); ++index) {
+        const auto i = static_cast<size_t>(index);
         V3D hkl(peaks[i].getIntHKL());
         V3D mnp(peaks[i].getIntMNP());
+        peakAxesRadii[i].clear();
         if (Geometry::IndexingUtils::ValidIndex(hkl, 1.0) ||
             Geometry::IndexingUtils::ValidIndex(mnp, 1.0)) {
           const V3D peak_q = peaks[i].getQLabFrame();
           std::vector<double> axes_radii;
+          double inti;
+          double sigi;
           integrator.ellipseIntegrateModEvents(
               E1Vec, peak_q, hkl, mnp, specify_size, peak_radius,
               back_inner_radius, back_outer_radius, axes_radii, inti, sigi);
           peaks[i].setIntensity(inti);
           peaks[i].setSigmaIntensity(sigi);
-          if (axes_radii.size() == 3) {
-            if (mnp == V3D(0, 0, 0)) {
-              principalaxis1.emplace_back(axes_radii[0]);
-              principalaxis2.emplace_back(axes_radii[1]);
-              principalaxis3.emplace_back(axes_radii[2]);
-            } else {
-              sateprincipalaxis1.emplace_back(axes_radii[0]);
-              sateprincipalaxis2.emplace_back(axes_radii[1]);
-              sateprincipalaxis3.emplace_back(axes_radii[2]);
-            }
-          }
+          if (axes_radii.size() == 3)
+            peakAxesRadii[i] = std::move(axes_radii);
         } else {
           peaks[i].setIntensity(0.0);
           peaks[i].setSigmaIntensity(0.0);
         }
       }
+      for (size_t i = 0; i < n_peaks; i++) {
+        const auto &axes_radii = peakAxesRadii[i];
+        if (axes_radii.empty())
+          continue;
+        if (peaks[i].getIntMNP() == V3D(0, 0, 0)) {
+          principalaxis1.emplace_back(axes_radii[0]);
+          principalaxis2.emplace_back(axes_radii[1]);
+          principalaxis3.emplace_back(axes_radii[2]);
+        } else {
+          sateprincipalaxis1.emplace_back(axes_radii[0]);
+          sateprincipalaxis2.emplace_back(axes_radii[1]);
+          sateprincipalaxis3.emplace_back(axes_radii[2]);
+        }
+      }
       if (principalaxis1.size() > 1) {
         Workspace_sptr wsProfile2 = WorkspaceFactory::Instance().create(
             "Workspace2D", histogramNumber, principalaxis1.size(),
@@ -220,12 +220,24 @@ void IntegrateEllipsoidsTwoStep::exec() {
 
   std::vector<std::pair<int, V3D>> weakPeaks, strongPeaks;
 
+  // The lists of events are only read from now on, so the peaks are
+  // integrated in parallel
+  const auto numPeaks = static_cast<int>(qList.size());
+  std::vector<IntegrationParameters> parameters(qList.size());
+  for (int index = 0; index < numPeaks; ++index)
+    parameters[index] = makeIntegrationParameters(qList[index].second);
+
   // Compute signal to noise ratio for all peaks
-  for (int index = 0; static_cast<size_t>(index) < qList.size(); ++index) {
-    const auto &item = qList[index];
-    const auto center = item.second;
-    IntegrationParameters params = makeIntegrationParameters(center);
-    auto sig2noise = integrator.estimateSignalToNoiseRatio(params, center);
+  std::vector<double> signalToNoise(qList.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int index = 0; index < numPeaks; ++index) {
+    signalToNoise[index] = integrator.estimateSignalToNoiseRatio(
+        parameters[index], qList[index].second);
+  }
+
+  for (int index = 0; index < numPeaks; ++index) {
+    const auto center = qList[index].second;
+    const auto sig2noise = signalToNoise[index];
 
     auto &peak = peak_ws->getPeak(index);
     peak.setIntensity(0);
@@ -247,17 +259,19 @@ void IntegrateEllipsoidsTwoStep::exec() {
 
   std::vector<std::pair<std::shared_ptr<const Geometry::PeakShape>,
                         std::tuple<double, double, double>>>
-      shapeLibrary;
+      shapeLibrary(strongPeaks.size());
 
   // Integrate strong peaks
-  for (const auto &item : strongPeaks) {
-    const auto index = item.first;
-    const auto &q = item.second;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int strong = 0; strong < static_cast<int>(strongPeaks.size());
+       ++strong) {
+    const auto index = strongPeaks[strong].first;
+    const auto &q = strongPeaks[strong].second;
     double inti, sigi;
 
-    IntegrationParameters params = makeIntegrationParameters(q);
-    const auto result = integrator.integrateStrongPeak(params, q, inti, sigi);
-    shapeLibrary.emplace_back(result);
+    const auto result =
+        integrator.integrateStrongPeak(parameters[index], q, inti, sigi);
+    shapeLibrary[strong] = result;
 
     auto &peak = peak_ws->getPeak(index);
     peak.setIntensity(inti);
@@ -279,14 +293,21 @@ void IntegrateEllipsoidsTwoStep::exec() {
 
   NearestNeighbours<3> kdTree(points);
 
-  // Integrate weak peaks
-  for (const auto &item : weakPeaks) {
-    double inti, sigi;
-    const auto index = item.first;
-    const auto &q = item.second;
-
+  // Integrate weak peaks. The nearest strong peaks are found first, as
+  // searching the tree is not thread safe.
+  std::vector<int> nearestStrong(weakPeaks.size());
+  for (size_t weak = 0; weak < weakPeaks.size(); ++weak) {
+    const auto &q = weakPeaks[weak].second;
     const auto result = kdTree.findNearest(Eigen::Vector3d(q[0], q[1], q[2]));
-    const auto strongIndex = static_cast<int>(std::get<1>(result[0]));
+    nearestStrong[weak] = static_cast<int>(std::get<1>(result[0]));
+  }
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int weak = 0; weak < static_cast<int>(weakPeaks.size()); ++weak) {
+    double inti, sigi;
+    const auto index = weakPeaks[weak].first;
+    const auto &q = weakPeaks[weak].second;
+    const auto strongIndex = nearestStrong[weak];
 
     auto &peak = peak_ws->getPeak(index);
     auto &strongPeak = peak_ws->getPeak(strongIndex);
@@ -300,10 +321,8 @@ void IntegrateEllipsoidsTwoStep::exec() {
     const auto frac = std::get<0>(libShape.second);
 
     g_log.notice() << "Weak peak will be adjusted by " << frac << "\n";
-    IntegrationParameters params =
-        makeIntegrationParameters(strongPeak.getQLabFrame());
     const auto weakShape = integrator.integrateWeakPeak(
-        params, shape, libShape.second, q, inti, sigi);
+        parameters[strongIndex], shape, libShape.second, q, inti, sigi);
 
     peak.setIntensity(inti);
     peak.setSigmaIntensity(sigi);
@@ -425,7 +444,7 @@ void IntegrateEllipsoidsTwoStep::qListFromEventWS(Integrate3DEvents &integrator,
                                                    raw_event.m_errorSquared),
                          qVec);
     } // end of loop over events in list
-    PARALLEL_CRITICAL(addEvents) { integrator.addEvents(qList, hkl_integ); }
+    integrator.addEvents(qList, hkl_integ);
 
     prog.report();
     PARALLEL_END_INTERUPT_REGION
@@ -522,7 +541,7 @@ void IntegrateEllipsoidsTwoStep::qListFromHistoWS(Integrate3DEvents &integrator,
         qList.emplace_back(std::pair<double, double>(yVal, esqVal), qVec);
       }
     }
-    PARALLEL_CRITICAL(addHisto) { integrator.addEvents(qList, hkl_integ); }
+    integrator.addEvents(qList, hkl_integ);
     prog.report();
     PARALLEL_END_INTERUPT_REGION
   } // end of loop over spectra
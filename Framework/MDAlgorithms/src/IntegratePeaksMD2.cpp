@@ -33,6 +33,7 @@
 #include "MantidKernel/Utils.h"
 #include "MantidMDAlgorithms/GSLFunctions.h"
 #include "MantidMDAlgorithms/MDBoxMaskFunction.h"
+#include "MantidMDAlgorithms/SphereBatchIntegrator.h"
 
 #include <cmath>
 #include <fstream>
@@ -305,8 +306,70 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // 5-10% speedup.  Perhaps is should just be removed permanantly, but for
   // now it is commented out to avoid the seg faults.  Refs #5533
   // PRAGMA_OMP(parallel for schedule(dynamic, 10) )
-  // Initialize progress reporting
+  // Instead, without ellipsoids or cylinders, the spheres of all the peaks
+  // are integrated in one parallel pass over the boxes before the loop.
   int nPeaks = peakWS->getNumberPeaks();
+
+  // Get the peak center as a position in the dimensions of the workspace
+  auto getPeakPosition = [CoordinatesToUse](const IPeak &p) {
+    V3D pos;
+    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
+      pos = p.getQLabFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
+      pos = p.getQSampleFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
+      pos = p.getHKL();
+    return pos;
+  };
+  // modulus of Q
+  auto getLengthOfQ = [](const coord_t *center) {
+    coord_t lenQpeak = 0.0;
+    for (size_t d = 0; d < nd; ++d) {
+      lenQpeak += center[d] * center[d];
+    }
+    return std::sqrt(lenQpeak);
+  };
+
+  const bool integrateInBatch = !cylinderBool && !isEllipse;
+  SphereBatchIntegrator<MDE, nd> spheres;
+  std::vector<size_t> peakSpheres(static_cast<size_t>(nPeaks));
+  std::vector<size_t> backgroundSpheres(static_cast<size_t>(nPeaks));
+  if (integrateInBatch) {
+    for (int i = 0; i < nPeaks; ++i) {
+      const IPeak &p = peakWS->getPeak(i);
+      const V3D pos = getPeakPosition(p);
+      // The same peaks as in the loop below are left out
+      double edge = detectorQ(p.getQLabFrame(),
+                              std::max(BackgroundOuterRadius, PeakRadius));
+      if (edge < std::max(BackgroundOuterRadius, PeakRadius) &&
+          !integrateEdge)
+        continue;
+      typename SphereBatchIntegrator<MDE, nd>::Point center;
+      for (size_t d = 0; d < nd; ++d)
+        center[d] = static_cast<coord_t>(pos[d]);
+      coord_t lenQpeak = 0.0;
+      if (adaptiveQMultiplier != 0.0)
+        lenQpeak = getLengthOfQ(center.data());
+      double adaptiveRadius = adaptiveQMultiplier * lenQpeak + PeakRadius;
+      if (adaptiveRadius <= 0.0)
+        continue;
+      peakSpheres[i] = spheres.addSphere(
+          center, static_cast<coord_t>(adaptiveRadius * adaptiveRadius));
+      if (BackgroundOuterRadius > PeakRadius) {
+        const double outerRadius =
+            adaptiveQBackgroundMultiplier * lenQpeak + BackgroundOuterRadius;
+        const double innerRadius =
+            adaptiveQBackgroundMultiplier * lenQpeak + BackgroundInnerRadius;
+        backgroundSpheres[i] = spheres.addSphere(
+            center, static_cast<coord_t>(pow(outerRadius, 2)),
+            static_cast<coord_t>(pow(innerRadius, 2)),
+            useOnePercentBackgroundCorrection);
+      }
+    }
+    spheres.integrate(*ws->getBox());
+  }
+
+  // Initialize progress reporting
   Progress progress(this, 0., 1., nPeaks);
   for (int i = 0; i < nPeaks; ++i) {
     if (this->getCancel())
@@ -317,13 +380,7 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     IPeak &p = peakWS->getPeak(i);
 
     // Get the peak center as a position in the dimensions of the workspace
-    V3D pos;
-    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
-      pos = p.getQLabFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
-      pos = p.getQSampleFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
-      pos = p.getHKL();
+    V3D pos = getPeakPosition(p);
 
     // Do not integrate if sphere is off edge of detector
 
@@ -357,13 +414,8 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     if (!cylinderBool) {
       // modulus of Q
       coord_t lenQpeak = 0.0;
-      if (adaptiveQMultiplier != 0.0) {
-        lenQpeak = 0.0;
-        for (size_t d = 0; d < nd; ++d) {
-          lenQpeak += center[d] * center[d];
-        }
-        lenQpeak = std::sqrt(lenQpeak);
-      }
+      if (adaptiveQMultiplier != 0.0)
+        lenQpeak = getLengthOfQ(center);
       double adaptiveRadius = adaptiveQMultiplier * lenQpeak + PeakRadius;
       if (adaptiveRadius <= 0.0) {
         g_log.error() << "Error: Radius for integration sphere of peak " << i
@@ -397,12 +449,17 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       // Integrate spherical background shell if specified
       if (BackgroundOuterRadius > PeakRadius) {
         // Get the total signal inside background shell
-        ws->getBox()->integrateSphere(
-            getRadiusSq,
-            static_cast<coord_t>(pow(BackgroundOuterRadiusVector[i], 2)),
-            bgSignal, bgErrorSquared,
-            static_cast<coord_t>(pow(BackgroundInnerRadiusVector[i], 2)),
-            useOnePercentBackgroundCorrection);
+        if (integrateInBatch) {
+          bgSignal = spheres.getSignal(backgroundSpheres[i]);
+          bgErrorSquared = spheres.getErrorSquared(backgroundSpheres[i]);
+        } else {
+          ws->getBox()->integrateSphere(
+              getRadiusSq,
+              static_cast<coord_t>(pow(BackgroundOuterRadiusVector[i], 2)),
+              bgSignal, bgErrorSquared,
+              static_cast<coord_t>(pow(BackgroundInnerRadiusVector[i], 2)),
+              useOnePercentBackgroundCorrection);
+        }
         // correct bg signal by Vpeak/Vshell (same for sphere and ellipse)
         bgSignal *= scaleFactor;
         bgErrorSquared *= scaleFactor * scaleFactor;
@@ -461,10 +518,15 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         }
       }
       // spherical integration of signal
-      ws->getBox()->integrateSphere(
-          getRadiusSq, static_cast<coord_t>(adaptiveRadius * adaptiveRadius),
-          signal, errorSquared, 0.0 /* innerRadiusSquared */,
-          useOnePercentBackgroundCorrection);
+      if (integrateInBatch) {
+        signal = spheres.getSignal(peakSpheres[i]);
+        errorSquared = spheres.getErrorSquared(peakSpheres[i]);
+      } else {
+        ws->getBox()->integrateSphere(
+            getRadiusSq, static_cast<coord_t>(adaptiveRadius * adaptiveRadius),
+            signal, errorSquared, 0.0 /* innerRadiusSquared */,
+            useOnePercentBackgroundCorrection);
+      }
     } else {
       CoordTransformDistance cylinder(nd, center, dimensionsUsed, 2);
 
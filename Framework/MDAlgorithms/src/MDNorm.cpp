@@ -29,6 +29,7 @@
 #include "MantidKernel/UnitLabelTypes.h"
 #include "MantidKernel/VectorHelper.h"
 #include "MantidKernel/VisibleWhenProperty.h"
+#include "MantidKernel/ZeroedAllocator.h"
 #include <boost/lexical_cast.hpp>
 
 namespace Mantid {
@@ -488,9 +489,11 @@ void MDNorm::exec() {
     cacheDimensionXValues();
 
     if (!skipNormalization) {
+      const auto detectorAngles = getDetectorAngles(expInfoIndex);
       size_t symmOpsIndex = 0;
       for (const auto &so : symmetryOps) {
-        calculateNormalization(otherValues, so, expInfoIndex, symmOpsIndex);
+        calculateNormalization(otherValues, so, expInfoIndex, symmOpsIndex,
+                               detectorAngles);
         symmOpsIndex++;
       }
 
@@ -1132,6 +1135,32 @@ void MDNorm::cacheDimensionXValues() {
   }
 }
 
+/**
+ * Get the angles of the detectors, which are the same for every symmetry
+ * operation
+ * @param expInfoIndex - current experiment info index
+ * @return two theta and phi of each spectrum. Two theta is negative for
+ * spectra without detectors, monitors and masked spectra.
+ */
+std::vector<std::array<double, 2>>
+MDNorm::getDetectorAngles(uint16_t expInfoIndex) const {
+  const auto &spectrumInfo =
+      m_inputWS->getExperimentInfo(expInfoIndex)->spectrumInfo();
+  const auto ndets = static_cast<int64_t>(spectrumInfo.size());
+  std::vector<std::array<double, 2>> angles(spectrumInfo.size(), {{-1., 0.}});
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < ndets; i++) {
+    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) ||
+        spectrumInfo.isMasked(i)) {
+      continue;
+    }
+    const auto &detector = spectrumInfo.detector(i);
+    angles[i] = {{detector.getTwoTheta(m_samplePos, m_beamDir),
+                  detector.getPhi()}};
+  }
+  return angles;
+}
+
 /**
  * Computed the normalization for the input workspace. Results are stored in
  * m_normWS
@@ -1139,10 +1168,12 @@ void MDNorm::cacheDimensionXValues() {
  * @param so - symmetry operation
  * @param expInfoIndex - current experiment info index
  * @param soIndex - the index of symmetry operation (for progress purposes)
+ * @param detectorAngles - the angles of the detectors from getDetectorAngles
  */
-void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues,
-                                    const Geometry::SymmetryOperation &so,
-                                    uint16_t expInfoIndex, size_t soIndex) {
+void MDNorm::calculateNormalization(
+    const std::vector<coord_t> &otherValues,
+    const Geometry::SymmetryOperation &so, uint16_t expInfoIndex,
+    size_t soIndex, const std::vector<std::array<double, 2>> &detectorAngles) {
   const auto &currentExptInfo = *(m_inputWS->getExperimentInfo(expInfoIndex));
   std::vector<double> lowValues, highValues;
   auto *lowValuesLog = dynamic_cast<VectorDoubleProperty *>(
@@ -1182,9 +1213,15 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues,
       (m_diffraction) ? integrFlux->getDetectorIDToWorkspaceIndexMap()
                       : detid2index_map();
 
+  const auto detectorIntersections =
+      getIntersections(detectorAngles, Qtransform, lowValues, highValues);
+
   const size_t vmdDims = (m_diffraction) ? 3 : 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
-  std::vector<std::array<double, 4>> intersections;
+  // Only the parts of the grid the trajectories cross take memory
+  std::vector<std::atomic<signal_t>,
+              Kernel::ZeroedAllocator<std::atomic<signal_t>>>
+      signalArray(m_normWS->getNPoints());
+  std::vector<std::array<double, 4>> ownIntersections;
   std::vector<double> xValues, yValues;
   std::vector<coord_t> pos, posNew;
 
@@ -1198,20 +1235,26 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues,
     safe = Kernel::threadSafe(*integrFlux);
   }
   // cppcheck-suppress syntaxError
-PRAGMA_OMP(parallel for private(intersections, xValues, yValues, pos, posNew) if (safe))
+PRAGMA_OMP(parallel for private(ownIntersections, xValues, yValues, pos, posNew) if (safe))
 for (int64_t i = 0; i < ndets; i++) {
   PARALLEL_START_INTERUPT_REGION
 
-  if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) ||
-      spectrumInfo.isMasked(i)) {
-    continue;
+  // Intersections, which are empty for spectra without detectors, monitors
+  // and masked spectra
+  if (!detectorIntersections) {
+    ownIntersections.clear();
+    const auto &angles = detectorAngles[i];
+    if (angles[0] >= 0.)
+      calculateIntersections(ownIntersections, angles[0], angles[1], Qtransform,
+                             lowValues[i], highValues[i]);
   }
+  const auto &intersections =
+      detectorIntersections ? (*detectorIntersections)[i] : ownIntersections;
+  if (intersections.empty())
+    continue;
 
-  const auto &detector = spectrumInfo.detector(i);
-  double theta = detector.getTwoTheta(m_samplePos, m_beamDir);
-  double phi = detector.getPhi();
   // If the dtefctor is a group, this should be the ID of the first detector
-  const auto detID = detector.getID();
+  const auto detID = spectrumInfo.detector(i).getID();
 
   // get the flux spectrum number
   size_t wsIdx = 0;
@@ -1224,11 +1267,6 @@ for (int64_t i = 0; i < ndets; i++) {
     }
   }
 
-  // Intersections
-  this->calculateIntersections(intersections, theta, phi, Qtransform,
-                               lowValues[i], highValues[i]);
-  if (intersections.empty())
-    continue;
   // Get solid angle for this contribution
   double solid = protonCharge;
   if (haveSA) {
@@ -1305,18 +1343,135 @@ for (int64_t i = 0; i < ndets; i++) {
   PARALLEL_END_INTERUPT_REGION
 }
 PARALLEL_CHECK_INTERUPT_REGION
-if (m_accumulate) {
+// Add the normalization to the workspace, leaving the blocks of bins that
+// did not get any untouched. Without accumulating the workspace is all zeros.
+const size_t blockSize = 512;
+auto *normSignal = m_normWS->mutableSignalArray();
+for (size_t begin = 0; begin < signalArray.size(); begin += blockSize) {
+  const auto blockBegin = signalArray.cbegin() + begin;
+  const auto blockEnd =
+      signalArray.cbegin() + std::min(begin + blockSize, signalArray.size());
+  if (std::all_of(blockBegin, blockEnd,
+                  [](const std::atomic<signal_t> &a) { return a == 0.; }))
+    continue;
   std::transform(
-      signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(),
-      m_normWS->mutableSignalArray(),
+      blockBegin, blockEnd, normSignal + begin, normSignal + begin,
       [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
-} else {
-  std::copy(signalArray.cbegin(), signalArray.cend(),
-            m_normWS->mutableSignalArray());
 }
 m_accumulate = true;
 }
 
+/**
+ * Get the points of intersection of all the detectors with the cuboids of the
+ * normalization workspace. They are taken from the cache if they were computed
+ * before with the same geometry and binning. If the cache is disabled, or the
+ * intersections of all the detectors would not fit in it, they are not
+ * computed here but for one detector at a time while normalizing.
+ * @param detectorAngles Two theta and phi of each detector
+ * @param transform Matrix to convert frm Q_lab to HKL (2Pi*R *UB*W*SO)^{-1}
+ * @param lowValues The lowest momentum or energy transfer for each detector
+ * @param highValues The highest momentum or energy transfer for each detector
+ * @return the intersections of each detector, or null if they are to be
+ * computed one detector at a time
+ */
+std::shared_ptr<const TrajectoryIntersectionCache::Intersections>
+MDNorm::getIntersections(
+    const std::vector<std::array<double, 2>> &detectorAngles,
+    const Kernel::DblMatrix &transform, const std::vector<double> &lowValues,
+    const std::vector<double> &highValues) {
+  auto &cache = TrajectoryIntersectionCache::instance();
+  if (cache.memoryLimit() == 0)
+    return nullptr;
+
+  // Every value the intersections depend on. The vectors are preceded by
+  // their size, so that consecutive ones do not run into each other.
+  const auto &matrix = transform.getVector();
+  std::vector<double> inputs{static_cast<double>(m_diffraction),
+                             static_cast<double>(m_dEIntegrated),
+                             static_cast<double>(convention ==
+                                                 "Crystallography"),
+                             m_Ei};
+  inputs.reserve(inputs.size() + matrix.size() + m_hX.size() + m_kX.size() +
+                 m_lX.size() + m_eX.size() + 4 * detectorAngles.size() + 6);
+  auto append = [&inputs](const std::vector<double> &values) {
+    inputs.emplace_back(static_cast<double>(values.size()));
+    inputs.insert(inputs.end(), values.cbegin(), values.cend());
+  };
+  append(matrix);
+  for (const auto *xValues : {&m_hX, &m_kX, &m_lX, &m_eX})
+    append(*xValues);
+  inputs.emplace_back(static_cast<double>(detectorAngles.size()));
+  for (const auto &angles : detectorAngles)
+    inputs.insert(inputs.end(), angles.cbegin(), angles.cend());
+  inputs.insert(inputs.end(), lowValues.cbegin(), lowValues.cend());
+  inputs.insert(inputs.end(), highValues.cbegin(), highValues.cend());
+  if (auto intersections = cache.find(inputs)) {
+    g_log.debug("Using the cached intersections of the trajectories\n");
+    return intersections;
+  }
+  if (estimateIntersectionsMemory(detectorAngles, transform, lowValues,
+                                  highValues) +
+          inputs.size() * sizeof(double) >
+      cache.memoryLimit()) {
+    g_log.debug("The intersections of the trajectories are too large to be "
+                "cached\n");
+    return nullptr;
+  }
+
+  auto intersections =
+      std::make_shared<TrajectoryIntersectionCache::Intersections>(
+          detectorAngles.size());
+  const auto ndets = static_cast<int64_t>(detectorAngles.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < ndets; i++) {
+    const auto &angles = detectorAngles[i];
+    if (angles[0] < 0.)
+      continue;
+    auto &detectorIntersections = (*intersections)[i];
+    calculateIntersections(detectorIntersections, angles[0], angles[1],
+                           transform, lowValues[i], highValues[i]);
+    detectorIntersections.shrink_to_fit();
+  }
+  cache.insert(std::move(inputs), intersections);
+  return intersections;
+}
+
+/**
+ * Estimate the memory taken by the intersections of all the detectors from
+ * those of a few detectors spread over the instrument
+ * @param detectorAngles Two theta and phi of each detector
+ * @param transform Matrix to convert frm Q_lab to HKL (2Pi*R *UB*W*SO)^{-1}
+ * @param lowValues The lowest momentum or energy transfer for each detector
+ * @param highValues The highest momentum or energy transfer for each detector
+ * @return the estimated number of bytes
+ */
+size_t MDNorm::estimateIntersectionsMemory(
+    const std::vector<std::array<double, 2>> &detectorAngles,
+    const Kernel::DblMatrix &transform, const std::vector<double> &lowValues,
+    const std::vector<double> &highValues) {
+  constexpr size_t numSamples = 64;
+  const size_t ndets = detectorAngles.size();
+  const size_t step = std::max(ndets / numSamples, size_t(1));
+  std::vector<std::array<double, 4>> intersections;
+  size_t sampled(0), numPoints(0);
+  for (size_t i = 0; i < ndets; i += step) {
+    const auto &angles = detectorAngles[i];
+    if (angles[0] < 0.)
+      continue;
+    calculateIntersections(intersections, angles[0], angles[1], transform,
+                           lowValues[i], highValues[i]);
+    ++sampled;
+    numPoints += intersections.size();
+  }
+  const auto numDetectors = static_cast<size_t>(
+      std::count_if(detectorAngles.cbegin(), detectorAngles.cend(),
+                    [](const std::array<double, 2> &a) { return a[0] >= 0.; }));
+  size_t memory = ndets * sizeof(intersections);
+  if (sampled > 0)
+    memory += numDetectors * numPoints / sampled * sizeof(intersections[0]);
+  return memory;
+}
+
 /**
  * Calculate the points of intersection for the given detector with cuboid
  * surrounding the detector position in HKL
@@ -1463,81 +1618,5 @@ void MDNorm::calculateIntersections(
   std::stable_sort(intersections.begin(), intersections.end(), compareMomentum);
 }
 
-/**
- * Linearly interpolate between the points in integrFlux at xValues and save the
- * results in yValues.
- * @param xValues :: X-values at which to interpolate
- * @param integrFlux :: A workspace with the spectra to interpolate
- * @param sp :: A workspace index for a spectrum in integrFlux to interpolate.
- * @param yValues :: A vector to save the results.
- */
-void MDNorm::calcIntegralsForIntersections(
-    const std::vector<double> &xValues, const API::MatrixWorkspace &integrFlux,
-    size_t sp, std::vector<double> &yValues) {
-  assert(xValues.size() == yValues.size());
-
-  // the x-data from the workspace
-  const auto &xData = integrFlux.x(sp);
-  const double xStart = xData.front();
-  const double xEnd = xData.back();
-
-  // the values in integrFlux are expected to be integrals of a non-negative
-  // function
-  // ie they must make a non-decreasing function
-  const auto &yData = integrFlux.y(sp);
-  size_t spSize = yData.size();
-
-  const double yMin = 0.0;
-  const double yMax = yData.back();
-
-  size_t nData = xValues.size();
-  // all integrals below xStart must be 0
-  if (xValues[nData - 1] < xStart) {
-    std::fill(yValues.begin(), yValues.end(), yMin);
-    return;
-  }
-
-  // all integrals above xEnd must be equal tp yMax
-  if (xValues[0] > xEnd) {
-    std::fill(yValues.begin(), yValues.end(), yMax);
-    return;
-  }
-
-  size_t i = 0;
-  // integrals below xStart must be 0
-  while (i < nData - 1 && xValues[i] < xStart) {
-    yValues[i] = yMin;
-    i++;
-  }
-  size_t j = 0;
-  for (; i < nData; i++) {
-    // integrals above xEnd must be equal tp yMax
-    if (j >= spSize - 1) {
-      yValues[i] = yMax;
-    } else {
-      double xi = xValues[i];
-      while (j < spSize - 1 && xi > xData[j])
-        j++;
-      // if x falls onto an interpolation point return the corresponding y
-      if (xi == xData[j]) {
-        yValues[i] = yData[j];
-      } else if (j == spSize - 1) {
-        // if we get above xEnd it's yMax
-        yValues[i] = yMax;
-      } else if (j > 0) {
-        // interpolate between the consecutive points
-        double x0 = xData[j - 1];
-        double x1 = xData[j];
-        double y0 = yData[j - 1];
-        double y1 = yData[j];
-        yValues[i] = y0 + (y1 - y0) * (xi - x0) / (x1 - x0);
-      } else // j == 0
-      {
-        yValues[i] = yMin;
-      }
-    }
-  }
-}
-
 } // namespace MDAlgorithms
 } // namespace Mantid
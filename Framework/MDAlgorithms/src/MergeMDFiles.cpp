@@ -11,6 +11,7 @@
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/VectorHelper.h"
@@ -18,6 +19,8 @@
 #include <Poco/File.h>
 #include <boost/scoped_ptr.hpp>
 
+#include <algorithm>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
@@ -153,39 +156,191 @@ void MergeMDFiles::loadBoxData() {
                  << " files.\n";
 }
 
-/** Task that loads all of the events from corresponded boxes of all files
- * that is being merged into a particular box in the output workspace.
+/** Split the boxes of the target workspace into ranges of consecutive boxes
+ * with about the same number of events. The events of consecutive boxes are
+ * stored together in the input files and in the output file, so each range is
+ * read and written in a few large blocks and merged independently of the
+ * others.
+ *
+ * @param numRanges :: the number of ranges wanted
+ * @return the [begin, end) indexes of the boxes of each range
  */
+std::vector<std::pair<size_t, size_t>>
+MergeMDFiles::partitionBoxes(const size_t numRanges) {
+  const std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
+  const std::vector<uint64_t> &eventIndex = m_BoxStruct.getEventIndex();
+  // Limit the memory taken by the events of a range
+  const uint64_t rangeEvents = std::max(
+      std::min(m_totalEvents / std::max(numRanges, size_t(1)),
+               static_cast<uint64_t>(MAX_RANGE_EVENTS)),
+      uint64_t(1));
+
+  std::vector<std::pair<size_t, size_t>> ranges;
+  size_t begin = 0;
+  uint64_t nEvents = 0;
+  for (size_t ib = 0; ib < boxes.size(); ib++) {
+    nEvents += eventIndex[2 * boxes[ib]->getID() + 1];
+    if (nEvents >= rangeEvents) {
+      ranges.emplace_back(begin, ib + 1);
+      begin = ib + 1;
+      nEvents = 0;
+    }
+  }
+  if (begin < boxes.size())
+    ranges.emplace_back(begin, boxes.size());
+  return ranges;
+}
 
-uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
-  /// get rid of the events and averages which are in the memory erroneously
-  /// (from cloning)
-  TargetBox->clear();
-
-  uint64_t nBoxEvents(0);
-  std::vector<size_t> numFileEvents(m_EventLoader.size());
+/** Merge the events of all the files into a range of boxes of the target
+ * workspace. For a file-backed target the events are written straight to the
+ * output file, without creating the events in memory.
+ *
+ * @param begin :: the index of the first box of the range
+ * @param end :: the index after the last box of the range
+ */
+void MergeMDFiles::mergeBoxRange(const size_t begin, const size_t end) {
+  // The events of each box of the range, as stored in the files
+  std::vector<std::vector<coord_t>> boxData(end - begin);
+  for (size_t iw = 0; iw < m_EventLoader.size(); iw++)
+    this->loadEventsOfBoxRange(iw, begin, end, boxData);
 
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    numFileEvents[iw] = static_cast<size_t>(
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 1]);
-    nBoxEvents += numFileEvents[iw];
+  if (m_fileBasedTargetWS) {
+    this->saveEventsOfBoxRange(begin, end, boxData);
+  } else {
+    const std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
+    for (size_t ib = begin; ib < end; ib++) {
+      if (!boxData[ib - begin].empty())
+        boxes[ib]->setEventsData(boxData[ib - begin]);
+    }
   }
 
-  // At this point memory required is known, so it is reserved all in one go
-  TargetBox->reserveMemoryForLoad(nBoxEvents);
+  uint64_t nEvents = 0;
+  const std::vector<uint64_t> &eventIndex = m_BoxStruct.getEventIndex();
+  for (size_t ib = begin; ib < end; ib++)
+    nEvents += eventIndex[2 * m_BoxStruct.getBoxes()[ib]->getID() + 1];
+  std::lock_guard<std::mutex> lock(m_statsMutex);
+  m_totalLoaded += nEvents;
+}
+
+/** Load the events of a range of boxes from one of the files. The events of
+ * boxes that are close to each other in the file are read as one block.
+ *
+ * @param iw :: the index of the file
+ * @param begin :: the index of the first box of the range
+ * @param end :: the index after the last box of the range
+ * @param boxData :: the events of each box of the range, to which the events
+ * found in the file are added
+ */
+void MergeMDFiles::loadEventsOfBoxRange(
+    const size_t iw, const size_t begin, const size_t end,
+    std::vector<std::vector<coord_t>> &boxData) {
+  const std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
+  const std::vector<uint64_t> &fileIndex =
+      m_fileComponentsStructure[iw].getEventIndex();
+  auto position = [&](const size_t ib) {
+    return fileIndex[2 * boxes[ib]->getID()];
+  };
+  auto size = [&](const size_t ib) {
+    return fileIndex[2 * boxes[ib]->getID() + 1];
+  };
+
+  // The boxes of the range with events in this file, in the file order
+  std::vector<size_t> order;
+  for (size_t ib = begin; ib < end; ib++) {
+    if (boxes[ib]->isBox() && size(ib) > 0)
+      order.emplace_back(ib);
+  }
+  std::sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+    return position(a) < position(b);
+  });
+
+  std::vector<coord_t> block;
+  size_t first = 0;
+  while (first < order.size()) {
+    // Read small gaps between the boxes rather than seeking over them
+    const uint64_t blockStart = position(order[first]);
+    uint64_t blockEnd = blockStart + size(order[first]);
+    size_t last = first + 1;
+    for (; last < order.size(); last++) {
+      const uint64_t boxStart = position(order[last]);
+      const uint64_t boxEnd = boxStart + size(order[last]);
+      if (boxStart > blockEnd + MAX_GAP_EVENTS ||
+          boxEnd - blockStart > MAX_RANGE_EVENTS)
+        break;
+      blockEnd = std::max(blockEnd, boxEnd);
+    }
+    {
+      // NeXus is not thread safe, even for different files
+      std::lock_guard<std::mutex> lock(m_fileMutex);
+      m_EventLoader[iw]->loadBlock(block, blockStart,
+                                   static_cast<size_t>(blockEnd - blockStart));
+    }
+    const auto nColumns = block.size() / (blockEnd - blockStart);
+    for (size_t k = first; k < last; k++) {
+      const size_t ib = order[k];
+      auto from = block.cbegin() + (position(ib) - blockStart) * nColumns;
+      auto &data = boxData[ib - begin];
+      data.insert(data.end(), from, from + size(ib) * nColumns);
+    }
+    first = last;
+  }
+}
 
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    uint64_t fileLocation =
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 0];
-    if (numFileEvents[iw] == 0)
+/** Save the merged events of a range of boxes to the output file, where the
+ * boxes of the range take consecutive places, and make the boxes file-backed.
+ *
+ * @param begin :: the index of the first box of the range
+ * @param end :: the index after the last box of the range
+ * @param boxData :: the events of each box of the range
+ */
+void MergeMDFiles::saveEventsOfBoxRange(
+    const size_t begin, const size_t end,
+    const std::vector<std::vector<coord_t>> &boxData) {
+  const std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
+  auto *fileIO = m_OutIWS->getBoxController()->getFileIO();
+
+  std::vector<coord_t> block;
+  uint64_t blockStart = 0;
+  size_t nEvents = 0;
+  for (size_t ib = begin; ib < end; ib++) {
+    const auto &data = boxData[ib - begin];
+    if (data.empty())
       continue;
-    TargetBox->loadAndAddFrom(m_EventLoader[iw], fileLocation,
-                              numFileEvents[iw]);
+    const size_t ID = boxes[ib]->getID();
+    if (block.empty())
+      blockStart = targetEventIndexes[2 * ID];
+    nEvents += targetEventIndexes[2 * ID + 1];
+    block.insert(block.end(), data.begin(), data.end());
+  }
+  if (block.empty())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    fileIO->saveBlock(block, blockStart);
   }
 
-  return nBoxEvents;
+  // The boxes keep the signal of the events, as if they had been saved by
+  // the disk buffer
+  const size_t nColumns = block.size() / nEvents;
+  for (size_t ib = begin; ib < end; ib++) {
+    const auto &data = boxData[ib - begin];
+    if (data.empty())
+      continue;
+    double signal = 0, errorSquared = 0;
+    for (size_t i = 0; i < data.size(); i += nColumns) {
+      signal += data[i];
+      errorSquared += data[i + 1];
+    }
+    auto *box = boxes[ib];
+    const size_t ID = box->getID();
+    box->setFileBacked(targetEventIndexes[2 * ID],
+                       static_cast<size_t>(targetEventIndexes[2 * ID + 1]),
+                       true);
+    box->clearDataFromMemory();
+    box->setSignal(static_cast<signal_t>(signal));
+    box->setErrorSquared(static_cast<signal_t>(errorSquared));
+  }
 }
 
 //----------------------------------------------------------------------------------------------
@@ -203,8 +358,8 @@ void MergeMDFiles::doExecByCloning(
   m_OutIWS = ws;
   m_MDEventType = ws->getEventTypeName();
 
-  // Run the tasks in parallel? TODO: enable
-  // bool Parallel = this->getProperty("Parallel");
+  // Run the tasks in parallel?
+  const bool parallel = this->getProperty("Parallel");
 
   // Fix the box controller settings in the output workspace so that it splits
   // normally
@@ -236,70 +391,28 @@ void MergeMDFiles::doExecByCloning(
   // positions of the target workspace
   this->loadBoxData();
 
-  size_t numBoxes = m_BoxStruct.getNBoxes();
-  // Progress report based on events processed.
-  m_progress = std::make_unique<Progress>(this, 0.1, 0.9, size_t(numBoxes));
+  // Merge ranges of boxes independently of each other
+  const auto ranges = this->partitionBoxes(
+      parallel ? 4 * static_cast<size_t>(PARALLEL_GET_MAX_THREADS) : 1);
+  m_progress = std::make_unique<Progress>(this, 0.1, 0.9, ranges.size());
   m_progress->setNotifyStep(0.1);
 
-  // For tracking progress
-  // uint64_t m_totalEventsInTasks = 0;
-
-  // Prepare thread pool
   CPUTimer overallTime;
-
-  auto ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-
-  Kernel::DiskBuffer *DiskBuf(nullptr);
-  if (m_fileBasedTargetWS) {
-    DiskBuf = bc->getFileIO();
-  }
-
   this->m_totalLoaded = 0;
-  std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
-
-  for (size_t ib = 0; ib < numBoxes; ib++) {
-    auto box = boxes[ib];
-    if (!box->isBox())
-      continue;
-    // load all contributed events into current box;
-    this->loadEventsFromSubBoxes(boxes[ib]);
-
-    if (DiskBuf) {
-      if (box->getDataInMemorySize() >
-          0) { // data position has been already pre-calculated
-        box->getISaveable()->save();
-        box->clearDataFromMemory();
-        // Kernel::ISaveable *Saver = box->getISaveable();
-        // DiskBuf->toWrite(Saver);
-      }
-    }
-    // else
-    //{   size_t ID = box->getID();
-    //    uint64_t filePosition = targetEventIndexes[2*ID];
-    //    box->saveAt(saver.get(), filePosition);
-    //}
-    //
-    // if (!Parallel)
-    //{
-    //  // Run the task serially only
-    //  task->run();
-    //  delete task;
-    //}
-    // else
-    //{
-    //  // Enqueue to run in parallel (at the joinAll() call below).
-    //  ts->push(task);
-    //}
-
-    m_progress->reportIncrement(ib, "Loading and merging box data");
+  const auto numRanges = static_cast<int>(ranges.size());
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) if (parallel))
+  for (int i = 0; i < numRanges; i++) {
+    PARALLEL_START_INTERUPT_REGION
+    this->mergeBoxRange(ranges[i].first, ranges[i].second);
+    m_progress->report("Loading and merging box data");
+    PARALLEL_END_INTERUPT_REGION
   }
-  if (DiskBuf) {
-    DiskBuf->flushCache();
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  if (m_fileBasedTargetWS) {
+    bc->getFileIO()->flushCache();
     bc->getFileIO()->flushData();
   }
-  //// Run any final tasks
-  // tp.joinAll();
   g_log.information() << overallTime << " to do all the adding.\n";
 
   // Close any open file handle
@@ -82,6 +82,16 @@ void SaveMD::init() {
   setPropertySettings("MakeFileBacked",
                       std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd",
                                                             IS_EQUAL_TO, "0"));
+
+  declareProperty("CompressEvents", false,
+                  "Only for MDEventWorkspaces: compress the events in the new "
+                  "file.\n"
+                  "The file is smaller but slower to write. The events are "
+                  "still loaded box by box, so compressed files can be "
+                  "file-backed.");
+  setPropertySettings("CompressEvents",
+                      std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd",
+                                                            IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -165,9 +175,9 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     // the boxes file positions are unknown and we need to calculate it.
     BoxFlatStruct.initFlatStructure(ws, filename);
     // create saver class
-    auto Saver = std::shared_ptr<API::IBoxControllerIO>(
-        new DataObjects::BoxControllerNeXusIO(bc.get()));
+    auto Saver = std::make_shared<DataObjects::BoxControllerNeXusIO>(bc.get());
     Saver->setDataType(sizeof(coord_t), MDE::getTypeName());
+    Saver->setCompression(getProperty("CompressEvents"));
     if (makeFileBackend) {
       // store saver with box controller
       bc->setFileBacked(Saver, filename);
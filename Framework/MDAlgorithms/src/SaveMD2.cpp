@@ -70,6 +70,16 @@ void SaveMD2::init() {
   setPropertySettings("MakeFileBacked",
                       std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd",
                                                             IS_EQUAL_TO, "0"));
+
+  declareProperty("CompressEvents", false,
+                  "Only for MDEventWorkspaces: compress the events in the new "
+                  "file.\n"
+                  "The file is smaller but slower to write. The events are "
+                  "still loaded box by box, so compressed files can be "
+                  "file-backed.");
+  setPropertySettings("CompressEvents",
+                      std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd",
+                                                            IS_EQUAL_TO, "0"));
   declareProperty(
       "SaveHistory", true,
       "Option to not save the Mantid history in the file. Only for MDHisto");
@@ -236,6 +246,8 @@ void SaveMD2::exec() {
                                 getProperty("UpdateFileBackEnd"));
     saveMDv1->setProperty<bool>("MakeFileBacked",
                                 getProperty("MakeFileBacked"));
+    saveMDv1->setProperty<bool>("CompressEvents",
+                                getProperty("CompressEvents"));
     saveMDv1->execute();
   } else if (histoWS) {
     this->doSaveHisto(histoWS);
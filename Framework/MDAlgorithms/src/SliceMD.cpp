@@ -198,24 +198,34 @@ void SliceMD::slice(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   uint64_t totalAdded = outWS->getNEvents();
   uint64_t numSinceSplit = 0;
 
+  // The rotated/transformed coordinates of the events of a box
+  std::vector<coord_t> outCenters;
+
   // Go through every box for this chunk.
   // PARALLEL_FOR_IF( !bc->isFileBacked() )
   for (int i = 0; i < int(boxes.size()); i++) {
     auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
     // Perform the binning in this separate method.
     if (box && !box->getIsMasked()) {
-      // An array to hold the rotated/transformed coordinates
-      coord_t outCenter[ond];
-
       const std::vector<MDE> &events = box->getConstEvents();
 
+      // Transform all the events to the output dimensions in one go
+      static_assert(sizeof(MDE) % sizeof(coord_t) == 0,
+                    "The centers of the events must be a whole number of "
+                    "coordinates apart");
+      outCenters.resize(events.size() * ond);
+      if (!events.empty())
+        m_transformFromOriginal->applyBatch(events.front().getCenter(),
+                                            sizeof(MDE) / sizeof(coord_t),
+                                            outCenters.data(), events.size());
+
       for (auto it = events.cbegin(); it != events.cend(); ++it) {
         // Cache the center of the event (again for speed)
         const coord_t *inCenter = it->getCenter();
 
         if (function->isPointContained(inCenter)) {
-          // Now transform to the output dimensions
-          m_transformFromOriginal->apply(inCenter, outCenter);
+          const coord_t *outCenter =
+              outCenters.data() + (it - events.cbegin()) * ond;
 
           // Create the event
           OMDE newEvent(it->getSignal(), it->getErrorSquared(), outCenter);
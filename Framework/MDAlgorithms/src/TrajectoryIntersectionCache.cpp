@@ -0,0 +1,166 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidMDAlgorithms/TrajectoryIntersectionCache.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidKernel/HashBuilder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+namespace {
+/// Default limit of the process wide cache in MiB
+constexpr size_t DEFAULT_CACHE_SIZE = 512;
+} // namespace
+
+/** Constructor
+ * @param memoryLimit :: the maximum number of bytes held by the intersections
+ * and the values they depend on
+ */
+TrajectoryIntersectionCache::TrajectoryIntersectionCache(
+    const size_t memoryLimit)
+    : m_entries(memoryLimit) {}
+
+/// @return the cache shared by all algorithms
+TrajectoryIntersectionCache &TrajectoryIntersectionCache::instance() {
+  static TrajectoryIntersectionCache cache(Kernel::cacheMemoryLimit(
+      "MDNorm.IntersectionCacheSize", DEFAULT_CACHE_SIZE));
+  return cache;
+}
+
+/**
+ * @param intersections :: the intersections of every detector
+ * @return the number of bytes held by the intersections
+ */
+size_t
+TrajectoryIntersectionCache::memoryOf(const Intersections &intersections) {
+  size_t memory = intersections.capacity() * sizeof(intersections.front());
+  for (const auto &detector : intersections)
+    memory += detector.capacity() * sizeof(detector.front());
+  return memory;
+}
+
+/**
+ * Find the intersections computed from the same values
+ * @param inputs :: every value the intersections depend on
+ * @return the intersections, or null if they are not kept
+ */
+std::shared_ptr<const TrajectoryIntersectionCache::Intersections>
+TrajectoryIntersectionCache::find(const std::vector<double> &inputs) {
+  const auto entry =
+      m_entries.find(Kernel::HashBuilder().add(inputs).value());
+  // The values are compared as bytes, as they were hashed
+  if (!entry || entry->inputs.size() != inputs.size() ||
+      std::memcmp(entry->inputs.data(), inputs.data(),
+                  inputs.size() * sizeof(double)) != 0)
+    return nullptr;
+  return entry->intersections;
+}
+
+/**
+ * Keep intersections, with the values they were computed from
+ * @param inputs :: every value the intersections depend on
+ * @param intersections :: the intersections of every detector
+ */
+void TrajectoryIntersectionCache::insert(
+    std::vector<double> inputs,
+    std::shared_ptr<const Intersections> intersections) {
+  const auto key = Kernel::HashBuilder().add(inputs).value();
+  const auto memory =
+      memoryOf(*intersections) + inputs.capacity() * sizeof(double);
+  m_entries.insert(key,
+                   std::make_shared<const Entry>(
+                       Entry{std::move(inputs), std::move(intersections)}),
+                   memory);
+}
+
+/**
+ * Linearly interpolate between the points in integrFlux at xValues and save the
+ * results in yValues. The position in the spectrum of each value is found by
+ * a binary search starting from the previous one, so few intersections with a
+ * finely binned flux do not scan the whole spectrum.
+ * @param xValues :: X-values at which to interpolate, sorted
+ * @param integrFlux :: A workspace with the spectra to interpolate
+ * @param sp :: A workspace index for a spectrum in integrFlux to interpolate.
+ * @param yValues :: A vector to save the results.
+ */
+void calcIntegralsForIntersections(const std::vector<double> &xValues,
+                                   const API::MatrixWorkspace &integrFlux,
+                                   size_t sp, std::vector<double> &yValues) {
+  assert(xValues.size() == yValues.size());
+
+  // the x-data from the workspace
+  const auto &xData = integrFlux.x(sp);
+  const double xStart = xData.front();
+  const double xEnd = xData.back();
+
+  // the values in integrFlux are expected to be integrals of a non-negative
+  // function
+  // ie they must make a non-decreasing function
+  const auto &yData = integrFlux.y(sp);
+  size_t spSize = yData.size();
+
+  const double yMin = 0.0;
+  const double yMax = yData.back();
+
+  size_t nData = xValues.size();
+  // all integrals below xStart must be 0
+  if (xValues[nData - 1] < xStart) {
+    std::fill(yValues.begin(), yValues.end(), yMin);
+    return;
+  }
+
+  // all integrals above xEnd must be equal tp yMax
+  if (xValues[0] > xEnd) {
+    std::fill(yValues.begin(), yValues.end(), yMax);
+    return;
+  }
+
+  size_t i = 0;
+  // integrals below xStart must be 0
+  while (i < nData - 1 && xValues[i] < xStart) {
+    yValues[i] = yMin;
+    i++;
+  }
+  const auto xBegin = xData.begin();
+  const auto xLast = xBegin + (spSize - 1);
+  size_t j = 0;
+  for (; i < nData; i++) {
+    // integrals above xEnd must be equal tp yMax
+    if (j >= spSize - 1) {
+      yValues[i] = yMax;
+    } else {
+      double xi = xValues[i];
+      // the first point at or above xi, or the last one
+      j = static_cast<size_t>(
+          std::distance(xBegin, std::lower_bound(xBegin + j, xLast, xi)));
+      // if x falls onto an interpolation point return the corresponding y
+      if (xi == xData[j]) {
+        yValues[i] = yData[j];
+      } else if (j == spSize - 1) {
+        // if we get above xEnd it's yMax
+        yValues[i] = yMax;
+      } else if (j > 0) {
+        // interpolate between the consecutive points
+        double x0 = xData[j - 1];
+        double x1 = xData[j];
+        double y0 = yData[j - 1];
+        double y1 = yData[j];
+        yValues[i] = y0 + (y1 - y0) * (xi - x0) / (x1 - x0);
+      } else // j == 0
+      {
+        yValues[i] = yMin;
+      }
+    }
+  }
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
@@ -299,6 +299,58 @@ public:
                  true /*IterateEvents*/, 20 /*numEventsPerBox*/, VMD(0, 0, 1));
   }
 
+  void test_exec_LevelOfDetail() {
+    auto in_ws = MDEventsTestHelper::makeMDEW<2>(10, 0.0, 10.0, 0);
+    in_ws->getBoxController()->setSplitThreshold(100);
+    in_ws->splitAllIfNeeded(nullptr);
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_ws", in_ws);
+    FrameworkManager::Instance().exec("FakeMDEventData", 4, "InputWorkspace",
+                                      "BinMDTest_ws", "UniformParams",
+                                      "100000");
+    // The boxes of 1 x 1 are split further
+    TS_ASSERT(!in_ws->getBox()->getChild(0)->isLeaf());
+
+    auto bin = [](const double levelOfDetail, double &error) {
+      BinMD alg;
+      alg.initialize();
+      alg.setPropertyValue("InputWorkspace", "BinMDTest_ws");
+      alg.setPropertyValue("AlignedDim0", "Axis0,0,10,4");
+      alg.setPropertyValue("AlignedDim1", "Axis1,0,10,4");
+      alg.setProperty("LevelOfDetail", levelOfDetail);
+      alg.setPropertyValue("OutputWorkspace", "BinMDTest_ws_histo");
+      alg.execute();
+      TS_ASSERT(alg.isExecuted());
+      error = alg.getProperty("LevelOfDetailError");
+      return AnalysisDataService::Instance()
+          .retrieveWS<MDHistoWorkspace>("BinMDTest_ws_histo");
+    };
+    double exactError = -1.;
+    auto exact = bin(0., exactError);
+    TS_ASSERT_EQUALS(exactError, 0.);
+
+    // Boxes of 1 x 1 are 0.4 bins wide, so they are binned whole. Some of
+    // them straddle two bins
+    double error = 0.;
+    auto preview = bin(0.5, error);
+    TS_ASSERT_LESS_THAN(0., error);
+    double totalPreview = 0.;
+    double difference = 0.;
+    for (size_t i = 0; i < exact->getNPoints(); ++i) {
+      totalPreview += preview->getSignalAt(i);
+      difference += std::abs(preview->getSignalAt(i) - exact->getSignalAt(i));
+    }
+    TS_ASSERT_DELTA(totalPreview, 100000., 1e-6);
+    TS_ASSERT_LESS_THAN_EQUALS(difference, 2. * error);
+
+    // Finer than the boxes: every event is binned
+    auto refined = bin(0.01, error);
+    TS_ASSERT_EQUALS(error, 0.);
+    for (size_t i = 0; i < exact->getNPoints(); ++i)
+      TS_ASSERT_EQUALS(refined->getSignalAt(i), exact->getSignalAt(i));
+    AnalysisDataService::Instance().remove("BinMDTest_ws");
+    AnalysisDataService::Instance().remove("BinMDTest_ws_histo");
+  }
+
   bool etta(int x, int base) {
     int ii = x - base / 2;
     if (ii < 0)
@@ -1037,6 +1089,56 @@ public:
     runBinMDOnFileBackWorkspace(outWSName);
   }
 
+  void test_filebackend_gives_the_same_bins_as_in_memory() {
+    auto in_ws = MDEventsTestHelper::makeMDEW<2>(10, 0.0, 10.0, 0);
+    in_ws->getBoxController()->setSplitThreshold(100000);
+    in_ws->splitBox();
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_ws", in_ws);
+    FrameworkManager::Instance().exec("FakeMDEventData", 4, "InputWorkspace",
+                                      "BinMDTest_ws", "UniformParams",
+                                      "400000");
+    auto filename = saveWorkspace(in_ws);
+    auto fileBackedName = loadFileBackWorkspace(filename);
+
+    auto bin = [](const std::string &name) {
+      BinMD alg;
+      alg.setChild(true);
+      alg.setRethrows(true);
+      alg.initialize();
+      alg.setPropertyValue("InputWorkspace", name);
+      alg.setPropertyValue("AlignedDim0", "Axis0,2.2,4.8,3");
+      alg.setPropertyValue("AlignedDim1", "Axis1,0.5,9.5,9");
+      alg.setPropertyValue("OutputWorkspace", "BinMDTest_ws_binned");
+      alg.execute();
+      TS_ASSERT(alg.isExecuted());
+      MDHistoWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+      return out;
+    };
+    // The boxes straddle the bins, so their events are read. The boxes of
+    // each row are read together, and the rows are read separately as the
+    // ~28000 events between them are too many to read through
+    auto inMemory = bin("BinMDTest_ws");
+    auto fileBacked = bin(fileBackedName);
+    TS_ASSERT(AnalysisDataService::Instance()
+                  .retrieveWS<IMDEventWorkspace>(fileBackedName)
+                  ->isFileBacked());
+    TS_ASSERT_EQUALS(fileBacked->getNPoints(), 27);
+    double numEvents = 0.;
+    for (size_t i = 0; i < inMemory->getNPoints(); ++i) {
+      TS_ASSERT_DELTA(fileBacked->getSignalAt(i), inMemory->getSignalAt(i),
+                      1e-6);
+      TS_ASSERT_DELTA(fileBacked->getErrorAt(i), inMemory->getErrorAt(i),
+                      1e-6);
+      TS_ASSERT_DELTA(fileBacked->getNumEventsAt(i),
+                      inMemory->getNumEventsAt(i), 1e-6);
+      numEvents += inMemory->getNumEventsAt(i);
+    }
+    TS_ASSERT_LESS_THAN(80000., numEvents);
+
+    AnalysisDataService::Instance().remove(fileBackedName);
+    AnalysisDataService::Instance().remove("BinMDTest_ws");
+  }
+
   void runBinMDOnFileBackWorkspace(const std::string &outWSName) {
     BinMD alg;
     alg.setChild(true);
@@ -315,6 +315,67 @@ public:
                       Mantid::API::NoNormalization);
   }
 
+  void test_Indexed_appends_to_existing_workspace() {
+    auto alg = Mantid::API::AlgorithmManager::Instance().create(
+        "CreateSampleWorkspace");
+    alg->initialize();
+    alg->setChild(true);
+    alg->setProperty("WorkspaceType", "Event");
+    alg->setPropertyValue("OutputWorkspace", "dummy");
+    alg->execute();
+    Mantid::API::MatrixWorkspace_sptr ws = alg->getProperty("OutputWorkspace");
+    ws->mutableRun().addLogData(new PropertyWithValue<double>("Ei", 12.0));
+
+    auto convert = [&ws](const IMDEventWorkspace_sptr &existing) {
+      ConvertToMD convertAlg;
+      convertAlg.setChild(true);
+      convertAlg.initialize();
+      convertAlg.setProperty("InputWorkspace", ws);
+      convertAlg.setProperty("QDimensions", "Q3D");
+      convertAlg.setProperty("dEAnalysisMode", "Direct");
+      convertAlg.setPropertyValue("MinValues", "-10,-10,-10, 0");
+      convertAlg.setPropertyValue("MaxValues", " 10, 10, 10, 1");
+      convertAlg.setPropertyValue("SplitInto", "2");
+      convertAlg.setPropertyValue("SplitThreshold", "100");
+      convertAlg.setProperty("ConverterType", "Indexed");
+      if (existing) {
+        convertAlg.setProperty("OverwriteExisting", false);
+        convertAlg.setProperty("OutputWorkspace", existing);
+      } else {
+        convertAlg.setPropertyValue("OutputWorkspace", "dummy");
+      }
+      TS_ASSERT_THROWS_NOTHING(convertAlg.execute());
+      IMDEventWorkspace_sptr outWS = convertAlg.getProperty("OutputWorkspace");
+      return outWS;
+    };
+
+    // The number of events and the signal summed over the leaves
+    auto sumLeaves = [](const IMDEventWorkspace_sptr &mdWS) {
+      std::vector<Mantid::API::IMDNode *> boxes;
+      mdWS->getBoxes(boxes, 1000, true);
+      uint64_t numEvents = 0;
+      double signal = 0.;
+      for (const auto box : boxes) {
+        numEvents += box->getNPoints();
+        signal += box->getSignal();
+      }
+      return std::make_pair(numEvents, signal);
+    };
+
+    auto outWS = convert(nullptr);
+    TS_ASSERT(outWS);
+    const auto first = sumLeaves(outWS);
+    TS_ASSERT_LESS_THAN(0, first.first);
+    TS_ASSERT_EQUALS(outWS->getNPoints(), first.first);
+
+    auto appendedWS = convert(outWS);
+    TS_ASSERT_EQUALS(appendedWS, outWS);
+    const auto appended = sumLeaves(appendedWS);
+    TS_ASSERT_EQUALS(appendedWS->getNPoints(), 2 * first.first);
+    TS_ASSERT_EQUALS(appended.first, 2 * first.first);
+    TS_ASSERT_DELTA(appended.second, 2 * first.second, 1e-6 * first.second);
+  }
+
   void testInitialSplittingDisabled() {
     Mantid::API::MatrixWorkspace_sptr ws2D =
         AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(
@@ -7,10 +7,12 @@
 #pragma once
 
 #include "MantidDataObjects/PeakShapeEllipsoid.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/V3D.h"
 #include "MantidMDAlgorithms/Integrate3DEvents.h"
 
 #include <cxxtest/TestSuite.h>
+#include <algorithm>
 #include <random>
 
 using namespace Mantid;
@@ -131,6 +133,61 @@ public:
     }
   }
 
+  void test_addEventsFromSeveralThreads() {
+    // Events added in chunks from several threads are integrated as if they
+    // were added at once
+    std::vector<std::pair<std::pair<double, double>, V3D>> peak_q_list;
+    for (int h = 1; h <= 4; h++)
+      for (int k = 1; k <= 4; k++)
+        peak_q_list.emplace_back(std::make_pair(1., 1.), V3D(10 * h, 5 * k, 0));
+
+    DblMatrix UBinv(3, 3, false);
+    UBinv.setRow(0, V3D(.1, 0, 0));
+    UBinv.setRow(1, V3D(0, .2, 0));
+    UBinv.setRow(2, V3D(0, 0, .25));
+
+    std::mt19937 gen(12345);
+    std::normal_distribution<double> d(0, 0.3);
+    std::vector<std::pair<std::pair<double, double>, V3D>> event_Qs;
+    for (const auto &peak : peak_q_list)
+      for (int i = 0; i < 500; i++)
+        event_Qs.emplace_back(std::make_pair(1., 1.),
+                              peak.second + V3D(d(gen), d(gen), d(gen)));
+    std::shuffle(event_Qs.begin(), event_Qs.end(), gen);
+
+    const double radius = 1.3;
+    Integrate3DEvents serial(peak_q_list, UBinv, radius);
+    serial.addEvents(event_Qs, false);
+
+    Integrate3DEvents parallel(peak_q_list, UBinv, radius);
+    const int numChunks = 16;
+    const size_t chunkSize = event_Qs.size() / numChunks;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int chunk = 0; chunk < numChunks; ++chunk) {
+      const auto begin = event_Qs.begin() + chunk * chunkSize;
+      const auto end =
+          chunk == numChunks - 1 ? event_Qs.end() : begin + chunkSize;
+      parallel.addEvents({begin, end}, false);
+    }
+
+    // Fixed size spheres, so the order of the events does not change which
+    // of them are counted
+    std::vector<Kernel::V3D> E1Vec;
+    for (const auto &peak : peak_q_list) {
+      std::vector<double> serialRadii, parallelRadii;
+      double serialInti, serialSigi, parallelInti, parallelSigi;
+      serial.ellipseIntegrateEvents(E1Vec, peak.second, true, 0.6, 0.8, 1.0,
+                                    serialRadii, serialInti, serialSigi);
+      parallel.ellipseIntegrateEvents(E1Vec, peak.second, true, 0.6, 0.8, 1.0,
+                                      parallelRadii, parallelInti,
+                                      parallelSigi);
+      TS_ASSERT_LESS_THAN(0., serialInti);
+      TS_ASSERT_DELTA(parallelInti, serialInti, 1e-6);
+      TS_ASSERT_DELTA(parallelSigi, serialSigi, 1e-6);
+      TS_ASSERT_EQUALS(parallelRadii.size(), serialRadii.size());
+    }
+  }
+
   void test_satellites() {
     double inti_all[] = {161, 368.28, 273.28};
     double sigi_all[] = {12.6885, 21.558, 19.2287};
@@ -32,7 +32,14 @@ public:
 
   void test_exec_fileBacked() { do_test_exec("MergeMDFilesTest_OutputWS.nxs"); }
 
-  void do_test_exec(const std::string &OutputFilename) {
+  void test_exec_parallel() { do_test_exec("", true); }
+
+  void test_exec_fileBacked_parallel() {
+    do_test_exec("MergeMDFilesTest_OutputWS.nxs", true);
+  }
+
+  void do_test_exec(const std::string &OutputFilename,
+                    const bool parallel = false) {
     if (OutputFilename != "") {
       if (Poco::File(OutputFilename).exists())
         Poco::File(OutputFilename).remove();
@@ -68,6 +75,7 @@ public:
         alg.setPropertyValue("OutputFilename", OutputFilename));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputWorkspace", outWSName));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("Parallel", parallel));
 
     // clean up possible rubbish from previous runs
     std::string fullName = alg.getPropertyValue("OutputFilename");
@@ -98,6 +106,11 @@ public:
     // Check that each box has at least SOMETHING
     for (size_t i = 0; i < box->getNumChildren(); i++)
       TS_ASSERT_LESS_THAN(1, box->getChild(i)->getNPoints());
+    // The signal of every input is kept
+    double inputSignal = 0.;
+    for (const auto &inWorkspace : inWorkspaces)
+      inputSignal += inWorkspace->getBox()->getSignal();
+    TS_ASSERT_DELTA(box->getSignal(), inputSignal, 1e-3 * inputSignal);
 
     if (!OutputFilename.empty()) {
       TS_ASSERT(ws->isFileBacked());
@@ -0,0 +1,75 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidMDAlgorithms/PeakKDTree.h"
+
+#include <algorithm>
+#include <random>
+
+using Mantid::coord_t;
+using Mantid::MDAlgorithms::PeakKDTree;
+
+class PeakKDTreeTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PeakKDTreeTest *createSuite() { return new PeakKDTreeTest(); }
+  static void destroySuite(PeakKDTreeTest *suite) { delete suite; }
+
+  void test_empty_tree_finds_nothing() {
+    PeakKDTree<3> tree({});
+    std::vector<size_t> found;
+    const coord_t position[3] = {0.f, 0.f, 0.f};
+    tree.findWithinRadius(position, 100.f, found);
+    TS_ASSERT(found.empty());
+  }
+
+  void test_radius_is_inclusive() {
+    PeakKDTree<2> tree({{{0.f, 0.f}}, {{1.f, 0.f}}, {{3.f, 0.f}}});
+    std::vector<size_t> found;
+    const coord_t position[2] = {0.f, 0.f};
+    tree.findWithinRadius(position, 1.f, found);
+    std::sort(found.begin(), found.end());
+    TS_ASSERT_EQUALS(found, std::vector<size_t>({0, 1}));
+  }
+
+  void test_finds_the_same_points_as_a_linear_search() {
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<coord_t> distribution(-10.f, 10.f);
+    std::vector<PeakKDTree<3>::Point> points(1000);
+    for (auto &point : points)
+      for (auto &x : point)
+        x = distribution(generator);
+    // Some points in the same place
+    points[10] = points[20] = points[30];
+    PeakKDTree<3> tree(points);
+    TS_ASSERT_EQUALS(tree.size(), 1000);
+
+    for (size_t search = 0; search < 50; ++search) {
+      coord_t position[3];
+      for (auto &x : position)
+        x = distribution(generator);
+      const coord_t radius = static_cast<coord_t>(search) * 0.1f;
+      std::vector<size_t> found;
+      tree.findWithinRadius(position, radius, found);
+      std::sort(found.begin(), found.end());
+      std::vector<size_t> expected;
+      for (size_t i = 0; i < points.size(); ++i) {
+        coord_t distanceSquared = 0;
+        for (size_t d = 0; d < 3; ++d)
+          distanceSquared +=
+              (points[i][d] - position[d]) * (points[i][d] - position[d]);
+        if (distanceSquared <= radius * radius)
+          expected.emplace_back(i);
+      }
+      TS_ASSERT_EQUALS(found, expected);
+    }
+  }
+};
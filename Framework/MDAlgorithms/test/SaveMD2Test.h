@@ -46,6 +46,46 @@ public:
     do_test_exec(23, "SaveMD2Test_updating.nxs", true, true);
   }
 
+  void test_CompressEvents() {
+    MDEventWorkspace1Lean::sptr ws =
+        MDEventsTestHelper::makeMDEW<1>(10, 0.0, 10.0, 23);
+    ws->splitBox();
+    ws->refreshCache();
+    AnalysisDataService::Instance().addOrReplace("SaveMD2Test_ws", ws);
+
+    SaveMD2 alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT_THROWS_NOTHING(
+        alg.setPropertyValue("InputWorkspace", "SaveMD2Test_ws"));
+    TS_ASSERT_THROWS_NOTHING(
+        alg.setPropertyValue("Filename", "SaveMD2Test_compressed.nxs"));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("CompressEvents", true));
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+    std::string this_filename = alg.getProperty("Filename");
+
+    // The events are read back as they were written
+    LoadMD load;
+    TS_ASSERT_THROWS_NOTHING(load.initialize())
+    load.setPropertyValue("Filename", this_filename);
+    load.setPropertyValue("OutputWorkspace", "SaveMD2Test_loaded");
+    load.execute();
+    TS_ASSERT(load.isExecuted());
+    auto loaded = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(
+        "SaveMD2Test_loaded");
+    TS_ASSERT_EQUALS(loaded->getNPoints(), 230);
+    auto it = loaded->createIterator();
+    double totalSignal = 0.;
+    do {
+      totalSignal += it->getSignal();
+    } while (it->next());
+    TS_ASSERT_DELTA(totalSignal, 230., 1e-6);
+
+    AnalysisDataService::Instance().remove("SaveMD2Test_loaded");
+    if (Poco::File(this_filename).exists())
+      Poco::File(this_filename).remove();
+  }
+
   void do_test_exec(size_t numPerBox, const std::string &filename,
                     bool MakeFileBacked = false,
                     bool UpdateFileBackEnd = false) {
@@ -0,0 +1,107 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidDataObjects/CoordTransformDistance.h"
+#include "MantidMDAlgorithms/SphereBatchIntegrator.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using Mantid::MDAlgorithms::SphereBatchIntegrator;
+
+class SphereBatchIntegratorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SphereBatchIntegratorTest *createSuite() {
+    return new SphereBatchIntegratorTest();
+  }
+  static void destroySuite(SphereBatchIntegratorTest *suite) { delete suite; }
+
+  SphereBatchIntegratorTest() { FrameworkManager::Instance(); }
+
+  void test_matches_integrateSphere() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(10, -10.0, 10.0, 0);
+    ws->getBoxController()->setSplitThreshold(50);
+    ws->splitAllIfNeeded(nullptr);
+    AnalysisDataService::Instance().addOrReplace("SphereBatchIntegratorTest",
+                                                 ws);
+    FrameworkManager::Instance().exec(
+        "FakeMDEventData", 4, "InputWorkspace", "SphereBatchIntegratorTest",
+        "PeakParams", "10000, 1, 2, 3, 0.5");
+    FrameworkManager::Instance().exec(
+        "FakeMDEventData", 4, "InputWorkspace", "SphereBatchIntegratorTest",
+        "UniformParams", "20000");
+
+    struct Sphere {
+      SphereBatchIntegrator<MDLeanEvent<3>, 3>::Point center;
+      coord_t radius;
+      coord_t innerRadius;
+      bool useOnePercentBackgroundCorrection;
+    };
+    const std::vector<Sphere> spheres{
+        {{{1.f, 2.f, 3.f}}, 1.f, 0.f, false},
+        {{{1.f, 2.f, 3.f}}, 2.f, 1.f, true},
+        {{{1.f, 2.f, 3.f}}, 2.f, 1.f, false},
+        // Covers whole boxes
+        {{{0.f, 0.f, 0.f}}, 6.f, 0.f, false},
+        {{{-5.f, 5.f, 0.5f}}, 0.3f, 0.f, false},
+        // Partly outside the workspace
+        {{{9.5f, -9.5f, 9.5f}}, 3.f, 1.5f, true},
+        // Outside the workspace
+        {{{30.f, 30.f, 30.f}}, 1.f, 0.f, false}};
+
+    SphereBatchIntegrator<MDLeanEvent<3>, 3> integrator;
+    for (const auto &sphere : spheres)
+      integrator.addSphere(sphere.center, sphere.radius * sphere.radius,
+                           sphere.innerRadius * sphere.innerRadius,
+                           sphere.useOnePercentBackgroundCorrection);
+    integrator.integrate(*ws->getBox());
+
+    bool dimensionsUsed[3] = {true, true, true};
+    for (size_t i = 0; i < spheres.size(); ++i) {
+      const auto &sphere = spheres[i];
+      CoordTransformDistance radiusTransform(3, sphere.center.data(),
+                                             dimensionsUsed);
+      signal_t signal = 0;
+      signal_t errorSquared = 0;
+      ws->getBox()->integrateSphere(
+          radiusTransform, sphere.radius * sphere.radius, signal, errorSquared,
+          sphere.innerRadius * sphere.innerRadius,
+          sphere.useOnePercentBackgroundCorrection);
+      TS_ASSERT_DELTA(integrator.getSignal(i), signal,
+                      1e-9 * std::abs(signal));
+      TS_ASSERT_DELTA(integrator.getErrorSquared(i), errorSquared,
+                      1e-9 * std::abs(errorSquared));
+    }
+    TS_ASSERT_LESS_THAN(0., integrator.getSignal(0));
+    TS_ASSERT_EQUALS(integrator.getSignal(6), 0.);
+    AnalysisDataService::Instance().remove("SphereBatchIntegratorTest");
+  }
+
+  void test_workspace_that_is_not_split() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(10, -10.0, 10.0, 0);
+    ws->addEvent(MDLeanEvent<3>(2.f, 4.f, std::vector<coord_t>(3, 0.f).data()));
+    ws->addEvent(MDLeanEvent<3>(3.f, 9.f, std::vector<coord_t>(3, 5.f).data()));
+    ws->refreshCache();
+
+    SphereBatchIntegrator<MDLeanEvent<3>, 3> integrator;
+    integrator.addSphere({{0.f, 0.f, 0.f}}, 1.f);
+    integrator.addSphere({{0.f, 0.f, 0.f}}, 100.f);
+    integrator.integrate(*ws->getBox());
+    TS_ASSERT_EQUALS(integrator.getSignal(0), 2.);
+    TS_ASSERT_EQUALS(integrator.getErrorSquared(0), 4.);
+    TS_ASSERT_EQUALS(integrator.getSignal(1), 5.);
+    TS_ASSERT_EQUALS(integrator.getErrorSquared(1), 13.);
+  }
+};
@@ -0,0 +1,93 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidMDAlgorithms/TrajectoryIntersectionCache.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+using Mantid::MDAlgorithms::TrajectoryIntersectionCache;
+using Mantid::MDAlgorithms::calcIntegralsForIntersections;
+
+class TrajectoryIntersectionCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TrajectoryIntersectionCacheTest *createSuite() {
+    return new TrajectoryIntersectionCacheTest();
+  }
+  static void destroySuite(TrajectoryIntersectionCacheTest *suite) {
+    delete suite;
+  }
+
+  void test_memoryOf_counts_the_points_of_every_detector() {
+    TrajectoryIntersectionCache::Intersections intersections(2);
+    intersections[0].resize(3);
+    intersections[1].resize(1);
+    const size_t expected = 2 * sizeof(intersections.front()) +
+                            (intersections[0].capacity() +
+                             intersections[1].capacity()) *
+                                sizeof(std::array<double, 4>);
+    TS_ASSERT_EQUALS(TrajectoryIntersectionCache::memoryOf(intersections),
+                     expected);
+  }
+
+  void test_intersections_are_found_by_their_inputs() {
+    const auto intersections = makeIntersections(3);
+    TrajectoryIntersectionCache cache(1 << 20);
+    const std::vector<double> inputs{1., 2., 3.};
+    cache.insert(inputs, intersections);
+    TS_ASSERT_EQUALS(cache.find(inputs), intersections);
+    TS_ASSERT(!cache.find({1., 2., 4.}));
+    TS_ASSERT(!cache.find({1., 2.}));
+  }
+
+  void test_intersections_are_kept_by_their_memory() {
+    const auto intersections = makeIntersections(3);
+    const std::vector<double> inputs{1.};
+    const auto memory = TrajectoryIntersectionCache::memoryOf(*intersections) +
+                        inputs.capacity() * sizeof(double);
+    TrajectoryIntersectionCache cache(memory);
+    cache.insert(inputs, intersections);
+    TS_ASSERT_EQUALS(cache.find(inputs), intersections);
+    cache.insert({2.}, makeIntersections(3));
+    TS_ASSERT(!cache.find(inputs));
+    TS_ASSERT_EQUALS(cache.size(), 1);
+  }
+
+  void test_calcIntegralsForIntersections() {
+    // Integrated flux 0, 1, 3, 6, 10 at momenta 1 to 5
+    auto flux = WorkspaceCreationHelper::create2DWorkspacePoints(1, 5, 1., 1.);
+    flux->mutableY(0) = {0., 1., 3., 6., 10.};
+    const std::vector<double> xValues{0.5, 1., 1.5, 2.25, 3.5, 5., 7.};
+    std::vector<double> yValues(xValues.size());
+    calcIntegralsForIntersections(xValues, *flux, 0, yValues);
+    const std::vector<double> expected{0., 0., 0.5, 1.5, 4.5, 10., 10.};
+    for (size_t i = 0; i < expected.size(); ++i)
+      TS_ASSERT_DELTA(yValues[i], expected[i], 1e-12);
+  }
+
+  void test_calcIntegralsForIntersections_outside_flux() {
+    auto flux = WorkspaceCreationHelper::create2DWorkspacePoints(1, 5, 1., 1.);
+    flux->mutableY(0) = {0., 1., 3., 6., 10.};
+    std::vector<double> yValues(2);
+    calcIntegralsForIntersections({0.1, 0.2}, *flux, 0, yValues);
+    TS_ASSERT_EQUALS(yValues, std::vector<double>(2, 0.));
+    calcIntegralsForIntersections({6., 7.}, *flux, 0, yValues);
+    TS_ASSERT_EQUALS(yValues, std::vector<double>(2, 10.));
+  }
+
+private:
+  static std::shared_ptr<const TrajectoryIntersectionCache::Intersections>
+  makeIntersections(const size_t numPoints) {
+    auto intersections =
+        std::make_shared<TrajectoryIntersectionCache::Intersections>(1);
+    intersections->front().assign(numPoints, {{1., 2., 3., 4.}});
+    return intersections;
+  }
+};
@@ -0,0 +1,90 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace Mantid {
+namespace Parallel {
+namespace IO {
+
+/** BoundedQueue : A first-in first-out queue between threads holding at most
+  a given number of items. Producers wait while it is full and consumers wait
+  while it is empty, so that a fast stage of a pipeline cannot run ahead of a
+  slow one and fill the memory.
+
+  Once closed, items can no longer be pushed and consumers get the remaining
+  ones before being told that there are no more.
+*/
+template <class T> class BoundedQueue {
+public:
+  /// @param capacity :: the maximum number of items, at least 1
+  explicit BoundedQueue(const size_t capacity)
+      : m_capacity(capacity > 0 ? capacity : 1) {}
+
+  /** Add an item at the end, waiting while the queue is full
+   * @param item :: the item
+   * @return false, dropping the item, if the queue is closed
+   */
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notFull.wait(lock,
+                   [this] { return m_closed || m_items.size() < m_capacity; });
+    if (m_closed)
+      return false;
+    m_items.emplace_back(std::move(item));
+    lock.unlock();
+    m_notEmpty.notify_one();
+    return true;
+  }
+
+  /** Take the first item, waiting while the queue is empty
+   * @param item :: set to the item
+   * @return false if the queue is closed and empty
+   */
+  bool pop(T &item) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notEmpty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+    if (m_items.empty())
+      return false;
+    item = std::move(m_items.front());
+    m_items.pop_front();
+    lock.unlock();
+    m_notFull.notify_one();
+    return true;
+  }
+
+  /// Refuse any more items and wake up every waiting thread
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_closed = true;
+    }
+    m_notFull.notify_all();
+    m_notEmpty.notify_all();
+  }
+
+  /// @return the number of items in the queue
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_items.size();
+  }
+
+private:
+  const size_t m_capacity;
+  std::deque<T> m_items;
+  bool m_closed{false};
+  mutable std::mutex m_mutex;
+  std::condition_variable m_notFull;
+  std::condition_variable m_notEmpty;
+};
+
+} // namespace IO
+} // namespace Parallel
+} // namespace Mantid
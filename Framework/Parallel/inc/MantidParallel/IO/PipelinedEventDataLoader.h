@@ -0,0 +1,94 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MantidParallel/DllConfig.h"
+#include "MantidParallel/IO/BoundedQueue.h"
+#include "MantidParallel/IO/Chunker.h"
+#include "MantidParallel/IO/RawDataSetReader.h"
+
+namespace Mantid {
+namespace Parallel {
+namespace IO {
+
+/// The event_id and event_time_offset of a range of events of a bank
+struct EventDataChunk {
+  size_t bankIndex{0};
+  /// Index of the first event in the bank
+  size_t eventOffset{0};
+  std::string eventTimeOffsetUnit;
+  std::vector<uint32_t> eventId;
+  std::vector<float> eventTimeOffset;
+};
+
+/** PipelinedEventDataLoader : Loads ranges of events from the NXevent_data
+  groups of a file with reading and decompression in separate stages.
+
+  A reader thread reads the compressed chunks of event_id and
+  event_time_offset for the given ranges, one range after the other, and
+  hands them to a pool of decoder threads through a bounded queue. The
+  decoded ranges are returned by next() in the order of the ranges given,
+  while the reader is already reading the following ones. At most queueSize
+  ranges are held in each stage.
+
+  Only the reader thread uses the HDF5 library, so no other thread may use
+  it while loading, unless the library was built to be thread safe.
+*/
+class MANTID_PARALLEL_DLL PipelinedEventDataLoader {
+public:
+  PipelinedEventDataLoader(const std::string &filename,
+                           const std::string &groupName,
+                           const std::vector<std::string> &bankNames,
+                           std::vector<Chunker::LoadRange> ranges,
+                           const int numDecoders, const size_t queueSize);
+  ~PipelinedEventDataLoader();
+
+  bool next(EventDataChunk &chunk);
+
+private:
+  struct RawChunk {
+    size_t index;
+    size_t bankIndex;
+    std::string eventTimeOffsetUnit;
+    RawData eventId;
+    RawData eventTimeOffset;
+  };
+
+  void readChunks(const std::string &filename, const std::string &groupName,
+                  const std::vector<std::string> &bankNames);
+  void decodeChunks();
+  void fail(std::exception_ptr error);
+  void close();
+
+  std::vector<Chunker::LoadRange> m_ranges;
+  const size_t m_queueSize;
+  BoundedQueue<RawChunk> m_rawChunks;
+  /// Decoded ranges by index, waiting for the ranges before them
+  std::map<size_t, EventDataChunk> m_chunks;
+  /// Index of the next range to return
+  size_t m_nextChunk{0};
+  int m_runningDecoders;
+  bool m_closed{false};
+  std::exception_ptr m_error;
+  std::mutex m_mutex;
+  std::condition_variable m_chunkDecoded;
+  std::condition_variable m_chunkTaken;
+  std::thread m_reader;
+  std::vector<std::thread> m_decoders;
+};
+
+} // namespace IO
+} // namespace Parallel
+} // namespace Mantid
@@ -0,0 +1,75 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <H5Cpp.h>
+#include <memory>
+#include <vector>
+
+#include "MantidParallel/DllConfig.h"
+
+namespace Mantid {
+namespace Parallel {
+namespace IO {
+
+/// How the values of a data set are stored, which is all that is needed to
+/// decode them
+struct ChunkFormat {
+  enum class Type { SignedInteger, UnsignedInteger, Float };
+  Type type;
+  /// Bytes per value
+  size_t valueSize;
+  /// Values per chunk, 0 if the data set is not read by chunks
+  size_t chunkSize;
+  /// Filters applied to the chunks when they were written, in order
+  std::vector<H5Z_filter_t> filters;
+};
+
+/** Part of a one dimensional data set as read from the file. It either holds
+  the storage chunks overlapping the part, still compressed, or the values of
+  the part if the data set could not be read by chunks.
+*/
+struct RawData {
+  std::shared_ptr<const ChunkFormat> format;
+  /// Index of the first value of the part
+  size_t start{0};
+  /// Number of values in the part
+  size_t count{0};
+  /// Index of the first value of the first chunk
+  size_t chunksStart{0};
+  /// Chunks as stored in the file, or one buffer with the values of the part
+  std::vector<std::vector<char>> chunks;
+  /// Filters that were skipped for each chunk, one bit per filter
+  std::vector<uint32_t> filterMasks;
+};
+
+/** RawDataSetReader : Reads parts of a one dimensional data set without
+  decompressing them, such that decompression can be left to other threads.
+
+  Chunks compressed with the deflate and shuffle filters, in the native byte
+  order, are read directly from the file. Any other data set is read through
+  HDF5 as usual. Only reading uses the HDF5 library: decode() does not and
+  may be called from any thread.
+*/
+class MANTID_PARALLEL_DLL RawDataSetReader {
+public:
+  explicit RawDataSetReader(const H5::DataSet &dataSet);
+
+  /// @return true if the chunks are read without being decompressed
+  bool readsChunks() const { return m_format->chunkSize > 0; }
+  RawData read(const size_t start, const size_t count) const;
+
+private:
+  H5::DataSet m_dataSet;
+  std::shared_ptr<const ChunkFormat> m_format;
+};
+
+template <class T> void decode(const RawData &raw, T *buffer);
+
+} // namespace IO
+} // namespace Parallel
+} // namespace Mantid
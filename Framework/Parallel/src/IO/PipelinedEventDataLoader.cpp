@@ -0,0 +1,179 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidParallel/IO/PipelinedEventDataLoader.h"
+#include "MantidParallel/IO/NXEventDataLoader.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Parallel {
+namespace IO {
+
+namespace {
+/// Readers of the data sets of a bank
+struct BankReaders {
+  explicit BankReaders(const H5::Group &bank)
+      : eventId(bank.openDataSet("event_id")),
+        eventTimeOffset(bank.openDataSet("event_time_offset")),
+        eventTimeOffsetUnit(detail::readAttribute(
+            bank.openDataSet("event_time_offset"), "units")) {}
+  RawDataSetReader eventId;
+  RawDataSetReader eventTimeOffset;
+  std::string eventTimeOffsetUnit;
+};
+} // namespace
+
+/** Constructor, starting to read and decode
+ * @param filename :: the file to read
+ * @param groupName :: the group holding the NXevent_data groups
+ * @param bankNames :: names of the NXevent_data groups
+ * @param ranges :: ranges of events to load, in the order they are returned
+ * @param numDecoders :: the number of threads decompressing
+ * @param queueSize :: the maximum number of ranges waiting in each stage
+ */
+PipelinedEventDataLoader::PipelinedEventDataLoader(
+    const std::string &filename, const std::string &groupName,
+    const std::vector<std::string> &bankNames,
+    std::vector<Chunker::LoadRange> ranges, const int numDecoders,
+    const size_t queueSize)
+    : m_ranges(std::move(ranges)), m_queueSize(std::max<size_t>(queueSize, 1)),
+      m_rawChunks(m_queueSize), m_runningDecoders(std::max(numDecoders, 1)) {
+  m_ranges.erase(std::remove_if(m_ranges.begin(), m_ranges.end(),
+                                [](const Chunker::LoadRange &range) {
+                                  return range.eventCount == 0;
+                                }),
+                 m_ranges.end());
+  for (int i = 0; i < m_runningDecoders; ++i)
+    m_decoders.emplace_back([this] { decodeChunks(); });
+  m_reader = std::thread([this, filename, groupName, bankNames] {
+    readChunks(filename, groupName, bankNames);
+  });
+}
+
+/// Stop loading and wait for the threads to finish
+PipelinedEventDataLoader::~PipelinedEventDataLoader() {
+  close();
+  m_reader.join();
+  for (auto &decoder : m_decoders)
+    decoder.join();
+}
+
+/** Get the next range of events, waiting until it is decoded. Errors while
+ * reading or decoding are thrown from here.
+ * @param chunk :: set to the events of the range
+ * @return false if all ranges have been returned
+ */
+bool PipelinedEventDataLoader::next(EventDataChunk &chunk) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_chunkDecoded.wait(lock, [this] {
+    return m_error || m_closed || m_runningDecoders == 0 ||
+           m_chunks.count(m_nextChunk) > 0;
+  });
+  if (m_error)
+    std::rethrow_exception(m_error);
+  const auto it = m_chunks.find(m_nextChunk);
+  if (it == m_chunks.end())
+    return false;
+  chunk = std::move(it->second);
+  m_chunks.erase(it);
+  ++m_nextChunk;
+  lock.unlock();
+  m_chunkTaken.notify_all();
+  return true;
+}
+
+/// Read the ranges, without decompressing them. Runs on the reader thread.
+void PipelinedEventDataLoader::readChunks(
+    const std::string &filename, const std::string &groupName,
+    const std::vector<std::string> &bankNames) {
+  try {
+    H5::H5File file(filename, H5F_ACC_RDONLY);
+    const H5::Group group = file.openGroup(groupName);
+    // Readers are kept open since ranges of banks may be interleaved
+    std::vector<std::unique_ptr<BankReaders>> banks(bankNames.size());
+    for (size_t i = 0; i < m_ranges.size(); ++i) {
+      const auto &range = m_ranges[i];
+      auto &bank = banks.at(range.bankIndex);
+      if (!bank)
+        bank = std::make_unique<BankReaders>(
+            group.openGroup(bankNames[range.bankIndex]));
+      RawChunk chunk{i, range.bankIndex, bank->eventTimeOffsetUnit,
+                     bank->eventId.read(range.eventOffset, range.eventCount),
+                     bank->eventTimeOffset.read(range.eventOffset,
+                                                range.eventCount)};
+      if (!m_rawChunks.push(std::move(chunk)))
+        break;
+    }
+  } catch (const H5::Exception &e) {
+    fail(std::make_exception_ptr(std::runtime_error(e.getDetailMsg())));
+  } catch (...) {
+    fail(std::current_exception());
+  }
+  m_rawChunks.close();
+}
+
+/// Decompress the ranges read. Runs on each decoder thread.
+void PipelinedEventDataLoader::decodeChunks() {
+  try {
+    RawChunk raw;
+    while (m_rawChunks.pop(raw)) {
+      EventDataChunk chunk;
+      chunk.bankIndex = raw.bankIndex;
+      chunk.eventOffset = raw.eventId.start;
+      chunk.eventTimeOffsetUnit = std::move(raw.eventTimeOffsetUnit);
+      chunk.eventId.resize(raw.eventId.count);
+      decode(raw.eventId, chunk.eventId.data());
+      chunk.eventTimeOffset.resize(raw.eventTimeOffset.count);
+      decode(raw.eventTimeOffset, chunk.eventTimeOffset.data());
+
+      // Ranges far ahead of the next one wait, to bound the memory used
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_chunkTaken.wait(lock, [this, &raw] {
+        return m_closed || raw.index < m_nextChunk + m_queueSize;
+      });
+      if (m_closed)
+        break;
+      m_chunks.emplace(raw.index, std::move(chunk));
+      lock.unlock();
+      m_chunkDecoded.notify_all();
+    }
+  } catch (...) {
+    fail(std::current_exception());
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_runningDecoders;
+  }
+  m_chunkDecoded.notify_all();
+}
+
+/// Keep the first error, to be thrown by next(), and stop loading
+void PipelinedEventDataLoader::fail(std::exception_ptr error) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_error)
+      m_error = std::move(error);
+  }
+  close();
+}
+
+/// Stop every stage
+void PipelinedEventDataLoader::close() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+  }
+  m_rawChunks.close();
+  m_chunkDecoded.notify_all();
+  m_chunkTaken.notify_all();
+}
+
+} // namespace IO
+} // namespace Parallel
+} // namespace Mantid
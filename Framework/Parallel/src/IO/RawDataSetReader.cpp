@@ -0,0 +1,304 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidParallel/IO/RawDataSetReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace Mantid {
+namespace Parallel {
+namespace IO {
+
+namespace {
+/// @return the HDF5 type of a value in memory
+const H5::PredType &nativeType(const ChunkFormat &format) {
+  switch (format.type) {
+  case ChunkFormat::Type::Float:
+    return format.valueSize == 4 ? H5::PredType::NATIVE_FLOAT
+                                 : H5::PredType::NATIVE_DOUBLE;
+  case ChunkFormat::Type::SignedInteger:
+    switch (format.valueSize) {
+    case 1:
+      return H5::PredType::NATIVE_INT8;
+    case 2:
+      return H5::PredType::NATIVE_INT16;
+    case 4:
+      return H5::PredType::NATIVE_INT32;
+    default:
+      return H5::PredType::NATIVE_INT64;
+    }
+  case ChunkFormat::Type::UnsignedInteger:
+    break;
+  }
+  switch (format.valueSize) {
+  case 1:
+    return H5::PredType::NATIVE_UINT8;
+  case 2:
+    return H5::PredType::NATIVE_UINT16;
+  case 4:
+    return H5::PredType::NATIVE_UINT32;
+  default:
+    return H5::PredType::NATIVE_UINT64;
+  }
+}
+
+/// Undo the deflate filter
+void inflate(const std::vector<char> &in, std::vector<char> &out) {
+  auto size = static_cast<uLongf>(out.size());
+  if (uncompress(reinterpret_cast<Bytef *>(out.data()), &size,
+                 reinterpret_cast<const Bytef *>(in.data()),
+                 static_cast<uLong>(in.size())) != Z_OK)
+    throw std::runtime_error("Failed to decompress a chunk of a data set");
+  out.resize(size);
+}
+
+/// Undo the shuffle filter, which stores the n-th byte of every value in
+/// the n-th block of the chunk
+void unshuffle(const std::vector<char> &in, std::vector<char> &out,
+               const size_t valueSize) {
+  out.resize(in.size());
+  const size_t numValues = in.size() / valueSize;
+  for (size_t byte = 0; byte < valueSize; ++byte) {
+    const char *block = in.data() + byte * numValues;
+    for (size_t i = 0; i < numValues; ++i)
+      out[i * valueSize + byte] = block[i];
+  }
+  // Bytes beyond the last whole value are not shuffled
+  std::copy(in.begin() + numValues * valueSize, in.end(),
+            out.begin() + numValues * valueSize);
+}
+
+/** Undo the filters applied to a chunk
+ * @param format :: format of the data set
+ * @param chunk :: the chunk as stored in the file
+ * @param mask :: filters that were skipped for the chunk
+ * @param buffer :: work space
+ * @param scratch :: work space
+ * @return the bytes of the values of the chunk
+ */
+const std::vector<char> &unfilter(const ChunkFormat &format,
+                                  const std::vector<char> &chunk,
+                                  const uint32_t mask,
+                                  std::vector<char> &buffer,
+                                  std::vector<char> &scratch) {
+  const size_t chunkBytes = format.chunkSize * format.valueSize;
+  // Chunks never written hold the fill value
+  if (chunk.empty()) {
+    buffer.assign(chunkBytes, 0);
+    return buffer;
+  }
+  const std::vector<char> *current = &chunk;
+  for (auto i = format.filters.size(); i-- > 0;) {
+    if (mask & (1u << i))
+      continue;
+    auto &target = current == &buffer ? scratch : buffer;
+    target.resize(chunkBytes);
+    if (format.filters[i] == H5Z_FILTER_DEFLATE)
+      inflate(*current, target);
+    else
+      unshuffle(*current, target, format.valueSize);
+    current = &target;
+  }
+  if (current->size() < chunkBytes)
+    throw std::runtime_error("A chunk of a data set is shorter than expected");
+  return *current;
+}
+
+template <class S, class T>
+void convertValues(const char *in, const size_t count, T *out) {
+  for (size_t i = 0; i < count; ++i) {
+    S value;
+    std::memcpy(&value, in + i * sizeof(S), sizeof(S));
+    out[i] = static_cast<T>(value);
+  }
+}
+
+/// Convert values in the native format of a data set to T
+template <class T>
+void convert(const ChunkFormat &format, const char *in, const size_t count,
+             T *out) {
+  switch (format.type) {
+  case ChunkFormat::Type::Float:
+    if (format.valueSize == 4)
+      convertValues<float>(in, count, out);
+    else
+      convertValues<double>(in, count, out);
+    return;
+  case ChunkFormat::Type::SignedInteger:
+    switch (format.valueSize) {
+    case 1:
+      return convertValues<int8_t>(in, count, out);
+    case 2:
+      return convertValues<int16_t>(in, count, out);
+    case 4:
+      return convertValues<int32_t>(in, count, out);
+    default:
+      return convertValues<int64_t>(in, count, out);
+    }
+  case ChunkFormat::Type::UnsignedInteger:
+    switch (format.valueSize) {
+    case 1:
+      return convertValues<uint8_t>(in, count, out);
+    case 2:
+      return convertValues<uint16_t>(in, count, out);
+    case 4:
+      return convertValues<uint32_t>(in, count, out);
+    default:
+      return convertValues<uint64_t>(in, count, out);
+    }
+  }
+}
+} // namespace
+
+/** Constructor
+ * @param dataSet :: a one dimensional data set of integers or floating point
+ * numbers
+ */
+RawDataSetReader::RawDataSetReader(const H5::DataSet &dataSet)
+    : m_dataSet(dataSet) {
+  auto format = std::make_shared<ChunkFormat>();
+  H5T_order_t order;
+  const auto typeClass = dataSet.getTypeClass();
+  if (typeClass == H5T_INTEGER) {
+    const auto type = dataSet.getIntType();
+    format->type = type.getSign() == H5T_SGN_NONE
+                       ? ChunkFormat::Type::UnsignedInteger
+                       : ChunkFormat::Type::SignedInteger;
+    format->valueSize = type.getSize();
+    order = type.getOrder();
+  } else if (typeClass == H5T_FLOAT) {
+    const auto type = dataSet.getFloatType();
+    format->type = ChunkFormat::Type::Float;
+    format->valueSize = type.getSize();
+    order = type.getOrder();
+  } else {
+    throw std::runtime_error("Unsupported H5::DataType for reading by chunks");
+  }
+  const auto size = format->valueSize;
+  if ((format->type == ChunkFormat::Type::Float && size != 4 && size != 8) ||
+      (size != 1 && size != 2 && size != 4 && size != 8))
+    throw std::runtime_error("Unsupported H5::DataType for reading by chunks");
+
+  format->chunkSize = 0;
+#if H5_VERSION_GE(1, 10, 3)
+  const auto plist = dataSet.getCreatePlist();
+  bool byChunks = order == H5::PredType::NATIVE_INT.getOrder() &&
+                  plist.getLayout() == H5D_CHUNKED &&
+                  dataSet.getSpace().getSimpleExtentNdims() == 1;
+  for (int i = 0; byChunks && i < plist.getNfilters(); ++i) {
+    unsigned int flags, config;
+    unsigned int values[8];
+    size_t numValues = 8;
+    char name[64];
+    const auto filter = plist.getFilter(i, flags, numValues, values,
+                                        sizeof(name), name, config);
+    byChunks = filter == H5Z_FILTER_DEFLATE || filter == H5Z_FILTER_SHUFFLE;
+    format->filters.emplace_back(filter);
+  }
+  if (byChunks) {
+    hsize_t chunkSize;
+    plist.getChunk(1, &chunkSize);
+    format->chunkSize = static_cast<size_t>(chunkSize);
+  } else {
+    format->filters.clear();
+  }
+#else
+  static_cast<void>(order);
+#endif
+  m_format = std::move(format);
+}
+
+/** Read a part of the data set. Chunks are read as they are stored, other
+ * data sets are read and converted to the native byte order.
+ * @param start :: index of the first value
+ * @param count :: number of values
+ * @return the part read, which decode() turns into values
+ */
+RawData RawDataSetReader::read(const size_t start, const size_t count) const {
+  RawData raw;
+  raw.format = m_format;
+  raw.start = start;
+  raw.count = count;
+  H5::DataSpace dataSpace = m_dataSet.getSpace();
+  if (start + count > static_cast<size_t>(dataSpace.getSelectNpoints()))
+    throw std::out_of_range("End index is beyond end of file");
+  if (count == 0)
+    return raw;
+
+  if (!readsChunks()) {
+    auto hstart = static_cast<hsize_t>(start);
+    auto hcount = static_cast<hsize_t>(count);
+    dataSpace.selectHyperslab(H5S_SELECT_SET, &hcount, &hstart);
+    H5::DataSpace memSpace(1, &hcount);
+    raw.chunksStart = start;
+    raw.chunks.emplace_back(count * m_format->valueSize);
+    m_dataSet.read(raw.chunks.front().data(), nativeType(*m_format), memSpace,
+                   dataSpace);
+    return raw;
+  }
+
+#if H5_VERSION_GE(1, 10, 3)
+  const size_t chunkSize = m_format->chunkSize;
+  const size_t first = start / chunkSize;
+  const size_t last = (start + count - 1) / chunkSize;
+  raw.chunksStart = first * chunkSize;
+  for (size_t chunk = first; chunk <= last; ++chunk) {
+    auto offset = static_cast<hsize_t>(chunk * chunkSize);
+    hsize_t bytes = 0;
+    if (H5Dget_chunk_storage_size(m_dataSet.getId(), &offset, &bytes) < 0)
+      throw std::runtime_error("Failed to read the size of a chunk");
+    raw.chunks.emplace_back(static_cast<size_t>(bytes));
+    uint32_t mask = 0;
+    if (bytes > 0 && H5Dread_chunk(m_dataSet.getId(), H5P_DEFAULT, &offset,
+                                   &mask, raw.chunks.back().data()) < 0)
+      throw std::runtime_error("Failed to read a chunk");
+    raw.filterMasks.emplace_back(mask);
+  }
+#endif
+  return raw;
+}
+
+/** Decompress and convert the values of a part of a data set. This does not
+ * use the HDF5 library.
+ * @param raw :: the part as read by RawDataSetReader::read()
+ * @param buffer :: set to the raw.count values
+ */
+template <class T> void decode(const RawData &raw, T *buffer) {
+  if (raw.count == 0)
+    return;
+  const auto &format = *raw.format;
+  if (format.chunkSize == 0) {
+    convert(format, raw.chunks.front().data(), raw.count, buffer);
+    return;
+  }
+  std::vector<char> decoded, scratch;
+  const size_t end = raw.start + raw.count;
+  for (size_t i = 0; i < raw.chunks.size(); ++i) {
+    const size_t chunkStart = raw.chunksStart + i * format.chunkSize;
+    const size_t first = std::max(raw.start, chunkStart);
+    const size_t last = std::min(end, chunkStart + format.chunkSize);
+    const auto &bytes =
+        unfilter(format, raw.chunks[i], raw.filterMasks[i], decoded, scratch);
+    convert(format, bytes.data() + (first - chunkStart) * format.valueSize,
+            last - first, buffer + (first - raw.start));
+  }
+}
+
+/// @cond
+template MANTID_PARALLEL_DLL void decode(const RawData &, int32_t *);
+template MANTID_PARALLEL_DLL void decode(const RawData &, int64_t *);
+template MANTID_PARALLEL_DLL void decode(const RawData &, uint32_t *);
+template MANTID_PARALLEL_DLL void decode(const RawData &, uint64_t *);
+template MANTID_PARALLEL_DLL void decode(const RawData &, float *);
+template MANTID_PARALLEL_DLL void decode(const RawData &, double *);
+/// @endcond
+
+} // namespace IO
+} // namespace Parallel
+} // namespace Mantid
@@ -0,0 +1,91 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "MantidParallel/IO/BoundedQueue.h"
+
+using Mantid::Parallel::IO::BoundedQueue;
+
+class BoundedQueueTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BoundedQueueTest *createSuite() { return new BoundedQueueTest(); }
+  static void destroySuite(BoundedQueueTest *suite) { delete suite; }
+
+  void test_first_in_first_out() {
+    BoundedQueue<int> queue(3);
+    TS_ASSERT(queue.push(1));
+    TS_ASSERT(queue.push(2));
+    TS_ASSERT_EQUALS(queue.size(), 2);
+    int item;
+    TS_ASSERT(queue.pop(item));
+    TS_ASSERT_EQUALS(item, 1);
+    TS_ASSERT(queue.pop(item));
+    TS_ASSERT_EQUALS(item, 2);
+    TS_ASSERT_EQUALS(queue.size(), 0);
+  }
+
+  void test_close_keeps_remaining_items() {
+    BoundedQueue<int> queue(2);
+    queue.push(7);
+    queue.close();
+    TS_ASSERT(!queue.push(8));
+    int item;
+    TS_ASSERT(queue.pop(item));
+    TS_ASSERT_EQUALS(item, 7);
+    TS_ASSERT(!queue.pop(item));
+  }
+
+  void test_close_wakes_waiting_producer() {
+    BoundedQueue<int> queue(1);
+    queue.push(1);
+    bool pushed{true};
+    std::thread producer([&queue, &pushed] { pushed = queue.push(2); });
+    queue.close();
+    producer.join();
+    TS_ASSERT(!pushed);
+  }
+
+  void test_producers_and_consumers() {
+    BoundedQueue<int> queue(4);
+    const int itemsPerProducer = 1000;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 3; ++p)
+      producers.emplace_back([&queue, p] {
+        for (int i = 0; i < itemsPerProducer; ++i)
+          queue.push(p * itemsPerProducer + i);
+      });
+    std::vector<std::vector<int>> popped(2);
+    std::vector<std::thread> consumers;
+    for (auto &items : popped)
+      consumers.emplace_back([&queue, &items] {
+        int item;
+        while (queue.pop(item))
+          items.emplace_back(item);
+      });
+    for (auto &producer : producers)
+      producer.join();
+    queue.close();
+    for (auto &consumer : consumers)
+      consumer.join();
+
+    std::vector<int> all(popped[0]);
+    all.insert(all.end(), popped[1].begin(), popped[1].end());
+    std::sort(all.begin(), all.end());
+    std::vector<int> expected(3 * itemsPerProducer);
+    std::iota(expected.begin(), expected.end(), 0);
+    TS_ASSERT_EQUALS(all, expected);
+  }
+};
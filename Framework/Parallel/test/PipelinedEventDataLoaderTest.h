@@ -0,0 +1,137 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include <Poco/TemporaryFile.h>
+#include <string>
+#include <vector>
+
+#include "MantidParallel/IO/PipelinedEventDataLoader.h"
+
+using namespace Mantid::Parallel::IO;
+
+class PipelinedEventDataLoaderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PipelinedEventDataLoaderTest *createSuite() {
+    return new PipelinedEventDataLoaderTest();
+  }
+  static void destroySuite(PipelinedEventDataLoaderTest *suite) {
+    delete suite;
+  }
+
+  PipelinedEventDataLoaderTest() {
+    H5::H5File file(m_file.path(), H5F_ACC_TRUNC);
+    auto entry = file.createGroup("entry");
+    writeBank(entry, "bank1_events", 0, 2500);
+    writeBank(entry, "bank2_events", 1, 1200);
+  }
+
+  void test_chunks_are_returned_in_order() {
+    // Interleave the chunks of the two banks
+    std::vector<Chunker::LoadRange> ranges{
+        {0, 0, 1000}, {1, 0, 1000}, {0, 1000, 1000}, {1, 1000, 200},
+        {0, 2000, 500}};
+    PipelinedEventDataLoader loader(m_file.path(), "entry", m_bankNames,
+                                    ranges, 3, 1);
+    EventDataChunk chunk;
+    for (const auto &range : ranges) {
+      TS_ASSERT(loader.next(chunk));
+      TS_ASSERT_EQUALS(chunk.bankIndex, range.bankIndex);
+      TS_ASSERT_EQUALS(chunk.eventOffset, range.eventOffset);
+      TS_ASSERT_EQUALS(chunk.eventTimeOffsetUnit, "nanosecond");
+      TS_ASSERT_EQUALS(chunk.eventId.size(), range.eventCount);
+      TS_ASSERT_EQUALS(chunk.eventTimeOffset.size(), range.eventCount);
+      for (size_t i = 0; i < range.eventCount; ++i) {
+        const auto event = range.eventOffset + i;
+        TS_ASSERT_EQUALS(chunk.eventId[i], eventId(range.bankIndex, event));
+        TS_ASSERT_EQUALS(chunk.eventTimeOffset[i],
+                         eventTimeOffset(range.bankIndex, event));
+      }
+    }
+    TS_ASSERT(!loader.next(chunk));
+  }
+
+  void test_empty_ranges_are_skipped() {
+    PipelinedEventDataLoader loader(m_file.path(), "entry", m_bankNames,
+                                    {{0, 0, 0}, {1, 10, 5}}, 1, 1);
+    EventDataChunk chunk;
+    TS_ASSERT(loader.next(chunk));
+    TS_ASSERT_EQUALS(chunk.bankIndex, 1);
+    TS_ASSERT_EQUALS(chunk.eventId.size(), 5);
+    TS_ASSERT(!loader.next(chunk));
+  }
+
+  void test_read_error_is_thrown_by_next() {
+    PipelinedEventDataLoader loader(m_file.path(), "entry", m_bankNames,
+                                    {{0, 2000, 1000}}, 2, 2);
+    EventDataChunk chunk;
+    TS_ASSERT_THROWS(loader.next(chunk), const std::out_of_range &);
+  }
+
+  void test_missing_bank_is_thrown_by_next() {
+    PipelinedEventDataLoader loader(m_file.path(), "entry", {"bank3_events"},
+                                    {{0, 0, 10}}, 2, 2);
+    EventDataChunk chunk;
+    TS_ASSERT_THROWS(loader.next(chunk), const std::runtime_error &);
+  }
+
+  void test_stops_without_taking_all_chunks() {
+    std::vector<Chunker::LoadRange> ranges;
+    for (size_t i = 0; i < 25; ++i)
+      ranges.push_back({i % 2, (i / 2) * 100, 100});
+    PipelinedEventDataLoader loader(m_file.path(), "entry", m_bankNames,
+                                    ranges, 2, 1);
+    EventDataChunk chunk;
+    TS_ASSERT(loader.next(chunk));
+  }
+
+private:
+  static uint32_t eventId(const size_t bank, const size_t event) {
+    return static_cast<uint32_t>(bank * 10000 + event % 97);
+  }
+
+  static float eventTimeOffset(const size_t bank, const size_t event) {
+    return static_cast<float>(bank) + 0.5f * static_cast<float>(event);
+  }
+
+  void writeBank(H5::Group &entry, const std::string &name, const size_t bank,
+                 const size_t numEvents) {
+    m_bankNames.emplace_back(name);
+    auto group = entry.createGroup(name);
+    H5::DSetCreatPropList plist;
+    const hsize_t chunkSize = 256;
+    plist.setChunk(1, &chunkSize);
+    plist.setShuffle();
+    plist.setDeflate(1);
+    const hsize_t dims = numEvents;
+    H5::DataSpace dataSpace(1, &dims);
+
+    std::vector<uint32_t> ids(numEvents);
+    std::vector<float> offsets(numEvents);
+    for (size_t i = 0; i < numEvents; ++i) {
+      ids[i] = eventId(bank, i);
+      offsets[i] = eventTimeOffset(bank, i);
+    }
+    group.createDataSet("event_id", H5::PredType::NATIVE_UINT32, dataSpace,
+                        plist)
+        .write(ids.data(), H5::PredType::NATIVE_UINT32);
+    auto timeOffset = group.createDataSet(
+        "event_time_offset", H5::PredType::NATIVE_FLOAT, dataSpace, plist);
+    timeOffset.write(offsets.data(), H5::PredType::NATIVE_FLOAT);
+    const std::string unit("nanosecond");
+    H5::StrType strType(0, unit.size());
+    timeOffset.createAttribute("units", strType, H5::DataSpace(H5S_SCALAR))
+        .write(strType, unit);
+  }
+
+  Poco::TemporaryFile m_file;
+  std::vector<std::string> m_bankNames;
+};
@@ -0,0 +1,122 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include <Poco/TemporaryFile.h>
+#include <vector>
+
+#include "MantidParallel/IO/RawDataSetReader.h"
+
+using namespace Mantid::Parallel::IO;
+
+class RawDataSetReaderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static RawDataSetReaderTest *createSuite() {
+    return new RawDataSetReaderTest();
+  }
+  static void destroySuite(RawDataSetReaderTest *suite) { delete suite; }
+
+  void test_compressed_chunks() {
+    H5::DSetCreatPropList plist;
+    const hsize_t chunkSize = 64;
+    plist.setChunk(1, &chunkSize);
+    plist.setShuffle();
+    plist.setDeflate(6);
+    H5::H5File file(m_file.path(), H5F_ACC_TRUNC);
+    const auto dataSet = write(file, H5::PredType::NATIVE_INT64, plist);
+
+    RawDataSetReader reader(dataSet);
+    TS_ASSERT(reader.readsChunks());
+    checkReads(reader);
+  }
+
+  void test_chunks_without_filters() {
+    H5::DSetCreatPropList plist;
+    const hsize_t chunkSize = 100;
+    plist.setChunk(1, &chunkSize);
+    H5::H5File file(m_file.path(), H5F_ACC_TRUNC);
+    const auto dataSet = write(file, H5::PredType::NATIVE_INT64, plist);
+
+    RawDataSetReader reader(dataSet);
+    TS_ASSERT(reader.readsChunks());
+    checkReads(reader);
+  }
+
+  void test_contiguous_data_set_is_not_read_by_chunks() {
+    H5::H5File file(m_file.path(), H5F_ACC_TRUNC);
+    const auto dataSet =
+        write(file, H5::PredType::NATIVE_INT64, H5::DSetCreatPropList());
+
+    RawDataSetReader reader(dataSet);
+    TS_ASSERT(!reader.readsChunks());
+    checkReads(reader);
+  }
+
+  void test_other_byte_order_is_not_read_by_chunks() {
+    H5::DSetCreatPropList plist;
+    const hsize_t chunkSize = 64;
+    plist.setChunk(1, &chunkSize);
+    plist.setDeflate(6);
+    const auto &otherOrder =
+        H5::PredType::NATIVE_INT.getOrder() == H5T_ORDER_LE
+            ? H5::PredType::STD_I64BE
+            : H5::PredType::STD_I64LE;
+    H5::H5File file(m_file.path(), H5F_ACC_TRUNC);
+    const auto dataSet = write(file, otherOrder, plist);
+
+    RawDataSetReader reader(dataSet);
+    TS_ASSERT(!reader.readsChunks());
+    checkReads(reader);
+  }
+
+  void test_read_beyond_end() {
+    H5::H5File file(m_file.path(), H5F_ACC_TRUNC);
+    const auto dataSet =
+        write(file, H5::PredType::NATIVE_INT64, H5::DSetCreatPropList());
+    RawDataSetReader reader(dataSet);
+    TS_ASSERT_THROWS(reader.read(size - 1, 2), const std::out_of_range &);
+  }
+
+private:
+  static constexpr size_t size = 1000;
+
+  H5::DataSet write(H5::H5File &file, const H5::PredType &type,
+                    const H5::DSetCreatPropList &plist) {
+    const hsize_t dims = size;
+    H5::DataSpace dataSpace(1, &dims);
+    auto dataSet = file.createDataSet("values", type, dataSpace, plist);
+    std::vector<int64_t> values(size);
+    for (size_t i = 0; i < size; ++i)
+      values[i] = value(i);
+    dataSet.write(values.data(), H5::PredType::NATIVE_INT64);
+    return dataSet;
+  }
+
+  static int64_t value(const size_t i) {
+    return static_cast<int64_t>(i * i) - 5000;
+  }
+
+  void checkReads(const RawDataSetReader &reader) {
+    for (const size_t start : {0, 1, 63, 64, 500, 999}) {
+      for (const size_t count : {0, 1, 64, 65, 300}) {
+        if (start + count > size)
+          continue;
+        const auto raw = reader.read(start, count);
+        std::vector<double> values(count);
+        decode(raw, values.data());
+        for (size_t i = 0; i < count; ++i)
+          TS_ASSERT_EQUALS(values[i], static_cast<double>(value(start + i)));
+      }
+    }
+  }
+
+  Poco::TemporaryFile m_file;
+};
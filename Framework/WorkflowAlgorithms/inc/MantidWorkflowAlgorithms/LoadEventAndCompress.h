@@ -6,16 +6,14 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
-#include "MantidAPI/DataProcessorAlgorithm.h"
-#include "MantidAPI/ITableWorkspace_fwd.h"
-#include "MantidKernel/System.h"
+#include "MantidWorkflowAlgorithms/LoadEventByChunks.h"
 
 namespace Mantid {
 namespace WorkflowAlgorithms {
 
 /** LoadEventAndCompress : TODO: DESCRIPTION
  */
-class DLLExport LoadEventAndCompress : public API::DataProcessorAlgorithm {
+class DLLExport LoadEventAndCompress : public LoadEventByChunks {
 public:
   const std::string name() const override;
   int version() const override;
@@ -26,21 +24,12 @@ public:
   const std::string summary() const override;
 
 protected:
-  API::ITableWorkspace_sptr
-  determineChunk(const std::string &filename) override;
-  API::MatrixWorkspace_sptr loadChunk(const size_t rowIndex) override;
-  API::MatrixWorkspace_sptr processChunk(API::MatrixWorkspace_sptr &wksp);
-
-  Parallel::ExecutionMode getParallelExecutionMode(
-      const std::map<std::string, Parallel::StorageMode> &storageModes)
-      const override;
+  API::MatrixWorkspace_sptr
+  processChunk(API::MatrixWorkspace_sptr &wksp) override;
 
 private:
   void init() override;
   void exec() override;
-
-  API::ITableWorkspace_sptr m_chunkingTable;
-  double m_filterBadPulses;
 };
 
 } // namespace WorkflowAlgorithms
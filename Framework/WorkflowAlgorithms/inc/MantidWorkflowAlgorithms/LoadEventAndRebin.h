@@ -0,0 +1,39 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidWorkflowAlgorithms/LoadEventByChunks.h"
+
+namespace Mantid {
+namespace WorkflowAlgorithms {
+
+/** LoadEventAndRebin : Load an event NeXus file by chunks and histogram each
+  chunk as it is loaded, so that the events of the whole run are never held in
+  memory at once. The histograms of the chunks are summed into a Workspace2D.
+ */
+class DLLExport LoadEventAndRebin : public LoadEventByChunks {
+public:
+  const std::string name() const override;
+  int version() const override;
+  const std::vector<std::string> seeAlso() const override {
+    return {"LoadEventNexus", "LoadEventAndCompress", "Rebin", "SumSpectra"};
+  }
+  const std::string category() const override;
+  const std::string summary() const override;
+  std::map<std::string, std::string> validateInputs() override;
+
+protected:
+  API::MatrixWorkspace_sptr
+  processChunk(API::MatrixWorkspace_sptr &wksp) override;
+
+private:
+  void init() override;
+  void exec() override;
+};
+
+} // namespace WorkflowAlgorithms
+} // namespace Mantid
@@ -0,0 +1,46 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DataProcessorAlgorithm.h"
+#include "MantidAPI/ITableWorkspace_fwd.h"
+#include "MantidKernel/System.h"
+
+namespace Mantid {
+namespace WorkflowAlgorithms {
+
+/** LoadEventByChunks : Base class of the workflow algorithms that load an
+  event NeXus file by chunks, process each chunk as it is loaded and add up
+  the processed chunks.
+
+  The chunks are found by DetermineChunking and loaded by LoadEventNexus with
+  the Filename, MaxChunkSize, FilterByTof*, FilterByTime*, NXentryName and
+  FilterBadPulses properties, which the algorithm must declare. The monitor
+  properties of LoadEventNexus are passed on too if the algorithm declares
+  LoadMonitors. The data of each chunk is released as it is added to the
+  total.
+ */
+class DLLExport LoadEventByChunks : public API::DataProcessorAlgorithm {
+protected:
+  API::ITableWorkspace_sptr
+  determineChunk(const std::string &filename) override;
+  API::MatrixWorkspace_sptr loadChunk(const size_t rowIndex) override;
+  /// Process a chunk once it is loaded, releasing what is no longer needed
+  virtual API::MatrixWorkspace_sptr
+  processChunk(API::MatrixWorkspace_sptr &wksp) = 0;
+  API::Workspace_sptr loadAndProcessChunks();
+
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
+
+  API::ITableWorkspace_sptr m_chunkingTable;
+  double m_filterBadPulses{0.};
+};
+
+} // namespace WorkflowAlgorithms
+} // namespace Mantid
@@ -110,83 +110,6 @@ void LoadEventAndCompress::init() {
   declareProperty("FilterBadPulses", 95., range);
 }
 
-/// @see DataProcessorAlgorithm::determineChunk(const std::string &)
-ITableWorkspace_sptr
-LoadEventAndCompress::determineChunk(const std::string &filename) {
-  double maxChunkSize = getProperty("MaxChunkSize");
-
-  auto alg = createChildAlgorithm("DetermineChunking");
-  alg->setProperty("Filename", filename);
-  alg->setProperty("MaxChunkSize", maxChunkSize);
-  alg->executeAsChildAlg();
-  ITableWorkspace_sptr chunkingTable = alg->getProperty("OutputWorkspace");
-
-  if (chunkingTable->rowCount() > 1)
-    g_log.information() << "Will load data in " << chunkingTable->rowCount()
-                        << " chunks\n";
-  else
-    g_log.information("Not chunking");
-
-  return chunkingTable;
-}
-
-/// @see DataProcessorAlgorithm::loadChunk(const size_t)
-MatrixWorkspace_sptr LoadEventAndCompress::loadChunk(const size_t rowIndex) {
-  g_log.debug() << "loadChunk(" << rowIndex << ")\n";
-
-  auto rowCount = static_cast<double>(m_chunkingTable->rowCount());
-  double progStart = static_cast<double>(rowIndex) / rowCount;
-  double progStop = static_cast<double>(rowIndex + 1) / rowCount;
-
-  auto alg = createChildAlgorithm("LoadEventNexus", progStart, progStop, true);
-  alg->setProperty<string>("Filename", getProperty("Filename"));
-  alg->setProperty<double>("FilterByTofMin", getProperty("FilterByTofMin"));
-  alg->setProperty<double>("FilterByTofMax", getProperty("FilterByTofMax"));
-  alg->setProperty<double>("FilterByTimeStart",
-                           getProperty("FilterByTimeStart"));
-  alg->setProperty<double>("FilterByTimeStop", getProperty("FilterByTimeStop"));
-
-  alg->setProperty<string>("NXentryName", getProperty("NXentryName"));
-  alg->setProperty<bool>("LoadMonitors", getProperty("LoadMonitors"));
-  alg->setProperty<string>("MonitorsLoadOnly", getProperty("MonitorsLoadOnly"));
-  alg->setProperty<double>("FilterMonByTofMin",
-                           getProperty("FilterMonByTofMin"));
-  alg->setProperty<double>("FilterMonByTofMax",
-                           getProperty("FilterMonByTofMax"));
-  alg->setProperty<double>("FilterMonByTimeStart",
-                           getProperty("FilterMonByTimeStart"));
-  alg->setProperty<double>("FilterMonByTimeStop",
-                           getProperty("FilterMonByTimeStop"));
-
-  // determine if loading logs - always load logs for first chunk or
-  // `FilterBadPulses` which will change delete some of the proton_charge log
-  // and change its value
-  bool loadLogs = (rowIndex == 0) || (m_filterBadPulses > 0.);
-  if (!loadLogs) {
-    // logs are needed for any of these
-    const double filterByTimeStart = getProperty("FilterByTimeStart");
-    const double filterByTimeStop = getProperty("FilterByTimeStop");
-    const double filterMonByTimeStart = getProperty("FilterMonByTimeStart");
-    const double filterMonByTimeStop = getProperty("FilterMonByTimeStop");
-    loadLogs = (!isEmpty(filterByTimeStart)) || (!isEmpty(filterByTimeStop)) ||
-               (!isEmpty(filterMonByTimeStart)) ||
-               (!isEmpty(filterMonByTimeStop));
-  }
-  alg->setProperty<bool>("LoadLogs", loadLogs);
-
-  // set chunking information
-  if (rowCount > 0.) {
-    const std::vector<string> COL_NAMES = m_chunkingTable->getColumnNames();
-    for (const auto &name : COL_NAMES) {
-      alg->setProperty(name, m_chunkingTable->getRef<int>(name, rowIndex));
-    }
-  }
-
-  alg->executeAsChildAlg();
-  Workspace_sptr wksp = alg->getProperty("OutputWorkspace");
-  return std::dynamic_pointer_cast<MatrixWorkspace>(wksp);
-}
-
 /**
  * Process a chunk in-place
  */
@@ -218,46 +141,7 @@ LoadEventAndCompress::processChunk(API::MatrixWorkspace_sptr &wksp) {
 /** Execute the algorithm.
  */
 void LoadEventAndCompress::exec() {
-  const std::string filename = getPropertyValue("Filename");
-  m_filterBadPulses = getProperty("FilterBadPulses");
-
-  m_chunkingTable = determineChunk(filename);
-
-  Progress progress(this, 0.0, 1.0, 2);
-
-  // first run is free
-  progress.report("Loading Chunk");
-  MatrixWorkspace_sptr resultWS = loadChunk(0);
-  progress.report("Process Chunk");
-  resultWS = processChunk(resultWS);
-
-  // load the other chunks
-  const size_t numRows = m_chunkingTable->rowCount();
-
-  progress.resetNumSteps(numRows, 0, 1);
-
-  for (size_t i = 1; i < numRows; ++i) {
-    MatrixWorkspace_sptr temp = loadChunk(i);
-    temp = processChunk(temp);
-
-    // remove logs
-    auto removeLogsAlg = createChildAlgorithm("RemoveLogs");
-    removeLogsAlg->setProperty("Workspace", temp);
-    removeLogsAlg->executeAsChildAlg();
-    temp = removeLogsAlg->getProperty("Workspace");
-
-    // accumulate data
-    auto plusAlg = createChildAlgorithm("Plus");
-    plusAlg->setProperty("LHSWorkspace", resultWS);
-    plusAlg->setProperty("RHSWorkspace", temp);
-    plusAlg->setProperty("OutputWorkspace", resultWS);
-    plusAlg->setProperty("ClearRHSWorkspace", true);
-    plusAlg->executeAsChildAlg();
-    resultWS = plusAlg->getProperty("OutputWorkspace");
-
-    progress.report();
-  }
-  Workspace_sptr total = assemble(resultWS);
+  Workspace_sptr total = loadAndProcessChunks();
 
   // don't assume that any chunk had the correct binning so just reset it here
   EventWorkspace_sptr totalEventWS =
@@ -271,11 +155,5 @@ void LoadEventAndCompress::exec() {
   setProperty("OutputWorkspace", total);
 }
 
-Parallel::ExecutionMode LoadEventAndCompress::getParallelExecutionMode(
-    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
-  static_cast<void>(storageModes);
-  return Parallel::ExecutionMode::Distributed;
-}
-
 } // namespace WorkflowAlgorithms
 } // namespace Mantid
@@ -0,0 +1,152 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidWorkflowAlgorithms/LoadEventAndRebin.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/RebinParamsValidator.h"
+
+namespace Mantid {
+namespace WorkflowAlgorithms {
+
+using std::size_t;
+using std::string;
+using namespace Kernel;
+using namespace API;
+using namespace DataObjects;
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(LoadEventAndRebin)
+
+//----------------------------------------------------------------------------------------------
+
+/// Algorithms name for identification. @see Algorithm::name
+const string LoadEventAndRebin::name() const { return "LoadEventAndRebin"; }
+
+/// Algorithm's version for identification. @see Algorithm::version
+int LoadEventAndRebin::version() const { return 1; }
+
+/// Algorithm's category for identification. @see Algorithm::category
+const string LoadEventAndRebin::category() const {
+  return "Workflow\\DataHandling";
+}
+
+/// Algorithm's summary for use in the GUI and help. @see Algorithm::summary
+const string LoadEventAndRebin::summary() const {
+  return "Load an event nexus file by chunks and histogram each chunk without "
+         "keeping its events";
+}
+
+//----------------------------------------------------------------------------------------------
+/** Initialize the algorithm's properties.
+ */
+void LoadEventAndRebin::init() {
+  // algorithms to copy properties from
+  auto algLoadEventNexus =
+      AlgorithmManager::Instance().createUnmanaged("LoadEventNexus");
+  algLoadEventNexus->initialize();
+  auto algDetermineChunking =
+      AlgorithmManager::Instance().createUnmanaged("DetermineChunking");
+  algDetermineChunking->initialize();
+
+  // declare properties
+  copyProperty(algLoadEventNexus, "Filename");
+  declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>(
+                      "OutputWorkspace", "", Direction::Output),
+                  "The histogrammed workspace");
+  copyProperty(algDetermineChunking, "MaxChunkSize");
+  declareProperty(
+      std::make_unique<ArrayProperty<double>>(
+          "Params", std::make_shared<RebinParamsValidator>()),
+      "A comma separated list of first bin boundary, width, last bin "
+      "boundary, as for Rebin. The boundaries must be given as every chunk is "
+      "binned the same way. A single bin integrates the events between the "
+      "boundaries.");
+  declareProperty("SumSpectra", false,
+                  "Sum the spectra of each chunk as it is histogrammed");
+
+  copyProperty(algLoadEventNexus, "FilterByTofMin");
+  copyProperty(algLoadEventNexus, "FilterByTofMax");
+  copyProperty(algLoadEventNexus, "FilterByTimeStart");
+  copyProperty(algLoadEventNexus, "FilterByTimeStop");
+
+  std::string grp1 = "Filter Events";
+  setPropertyGroup("FilterByTofMin", grp1);
+  setPropertyGroup("FilterByTofMax", grp1);
+  setPropertyGroup("FilterByTimeStart", grp1);
+  setPropertyGroup("FilterByTimeStop", grp1);
+
+  copyProperty(algLoadEventNexus, "NXentryName");
+
+  auto range = std::make_shared<BoundedValidator<double>>();
+  range->setBounds(0., 100.);
+  declareProperty("FilterBadPulses", 95., range);
+}
+
+/// @return messages for the properties that are not valid
+std::map<std::string, std::string> LoadEventAndRebin::validateInputs() {
+  std::map<std::string, std::string> errors;
+  const std::vector<double> params = getProperty("Params");
+  if (params.size() < 3)
+    errors["Params"] = "The first and last bin boundaries must be given";
+  return errors;
+}
+
+/**
+ * Histogram a chunk. The returned workspace holds no events.
+ */
+API::MatrixWorkspace_sptr
+LoadEventAndRebin::processChunk(API::MatrixWorkspace_sptr &wksp) {
+  EventWorkspace_sptr eventWS = std::dynamic_pointer_cast<EventWorkspace>(wksp);
+
+  if (m_filterBadPulses > 0.) {
+    auto filterBadPulsesAlgo = createChildAlgorithm("FilterBadPulses");
+    filterBadPulsesAlgo->setProperty("InputWorkspace", eventWS);
+    filterBadPulsesAlgo->setProperty("OutputWorkspace", eventWS);
+    filterBadPulsesAlgo->setProperty("LowerCutoff", m_filterBadPulses);
+    filterBadPulsesAlgo->executeAsChildAlg();
+    eventWS = filterBadPulsesAlgo->getProperty("OutputWorkspace");
+  }
+
+  const std::vector<double> params = getProperty("Params");
+  auto rebin = createChildAlgorithm("Rebin");
+  rebin->setProperty("InputWorkspace", eventWS);
+  rebin->setPropertyValue("OutputWorkspace", "__histogram");
+  rebin->setProperty("Params", params);
+  rebin->setProperty("PreserveEvents", false);
+  rebin->executeAsChildAlg();
+  MatrixWorkspace_sptr histogram = rebin->getProperty("OutputWorkspace");
+  // drop the events before going on
+  eventWS.reset();
+  wksp.reset();
+
+  const bool sumSpectra = getProperty("SumSpectra");
+  if (sumSpectra) {
+    auto sumSpectraAlgo = createChildAlgorithm("SumSpectra");
+    sumSpectraAlgo->setProperty("InputWorkspace", histogram);
+    sumSpectraAlgo->setProperty("OutputWorkspace", histogram);
+    sumSpectraAlgo->executeAsChildAlg();
+    histogram = sumSpectraAlgo->getProperty("OutputWorkspace");
+  }
+
+  return histogram;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void LoadEventAndRebin::exec() {
+  Workspace_sptr total = loadAndProcessChunks();
+
+  setProperty("OutputWorkspace",
+              std::dynamic_pointer_cast<MatrixWorkspace>(total));
+}
+
+} // namespace WorkflowAlgorithms
+} // namespace Mantid
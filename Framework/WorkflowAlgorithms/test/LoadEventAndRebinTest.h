@@ -0,0 +1,130 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidWorkflowAlgorithms/LoadEventAndRebin.h"
+
+#include <numeric>
+
+using Mantid::WorkflowAlgorithms::LoadEventAndRebin;
+using namespace Mantid::DataObjects;
+using namespace Mantid::API;
+
+namespace {
+const std::string FILENAME{"ARCS_sim_event.nxs"};
+const double CHUNKSIZE{.00001}; // REALLY small file
+const std::string PARAMS{"1000,100,20000"};
+} // anonymous namespace
+
+class LoadEventAndRebinTest : public CxxTest::TestSuite {
+
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LoadEventAndRebinTest *createSuite() {
+    return new LoadEventAndRebinTest();
+  }
+  static void destroySuite(LoadEventAndRebinTest *suite) { delete suite; }
+
+  void test_Init() {
+    LoadEventAndRebin alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize());
+    TS_ASSERT(alg.isInitialized());
+  }
+
+  void test_bin_boundaries_are_required() {
+    LoadEventAndRebin alg;
+    alg.initialize();
+    alg.setPropertyValue("Filename", FILENAME);
+    alg.setPropertyValue("OutputWorkspace", "LoadEventAndRebin_no_bounds");
+    alg.setPropertyValue("Params", "100");
+    TS_ASSERT_THROWS(alg.execute(), const std::runtime_error &);
+    TS_ASSERT(!alg.isExecuted());
+  }
+
+  void test_chunks_match_rebin_of_whole_run() {
+    const std::string WS_NAME_CHUNKS("LoadEventAndRebin_chunks");
+    runAlgorithm(WS_NAME_CHUNKS, CHUNKSIZE, false);
+
+    // Reference: load everything, then histogram
+    const std::string WS_NAME_EVENTS("LoadEventAndRebin_events");
+    auto load = AlgorithmManager::Instance().create("LoadEventNexus");
+    load->setPropertyValue("Filename", FILENAME);
+    load->setPropertyValue("OutputWorkspace", WS_NAME_EVENTS);
+    load->execute();
+    auto rebin = AlgorithmManager::Instance().create("Rebin");
+    rebin->setPropertyValue("InputWorkspace", WS_NAME_EVENTS);
+    rebin->setPropertyValue("OutputWorkspace", WS_NAME_EVENTS);
+    rebin->setPropertyValue("Params", PARAMS);
+    rebin->setProperty("PreserveEvents", false);
+    rebin->execute();
+
+    Workspace2D_sptr wsChunks;
+    TS_ASSERT_THROWS_NOTHING(
+        wsChunks = AnalysisDataService::Instance().retrieveWS<Workspace2D>(
+            WS_NAME_CHUNKS));
+    TS_ASSERT(wsChunks);
+    if (!wsChunks)
+      return;
+    TS_ASSERT_EQUALS(wsChunks->blocksize(), 190);
+
+    auto checkAlg = AlgorithmManager::Instance().create("CompareWorkspaces");
+    checkAlg->setPropertyValue("Workspace1", WS_NAME_EVENTS);
+    checkAlg->setPropertyValue("Workspace2", WS_NAME_CHUNKS);
+    checkAlg->setProperty("CheckSample", false);
+    checkAlg->setProperty("Tolerance", 1e-10);
+    checkAlg->execute();
+    TS_ASSERT(checkAlg->getProperty("Result"));
+
+    AnalysisDataService::Instance().remove(WS_NAME_EVENTS);
+    AnalysisDataService::Instance().remove(WS_NAME_CHUNKS);
+  }
+
+  void test_sum_spectra() {
+    const std::string WS_NAME_CHUNKS("LoadEventAndRebin_sum_chunks");
+    runAlgorithm(WS_NAME_CHUNKS, CHUNKSIZE, true);
+    const std::string WS_NAME("LoadEventAndRebin_sum");
+    runAlgorithm(WS_NAME, 0., true);
+
+    const auto wsChunks =
+        AnalysisDataService::Instance().retrieveWS<Workspace2D>(WS_NAME_CHUNKS);
+    const auto ws =
+        AnalysisDataService::Instance().retrieveWS<Workspace2D>(WS_NAME);
+    TS_ASSERT_EQUALS(wsChunks->getNumberHistograms(), 1);
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 1);
+    const auto &y = ws->y(0);
+    const auto &yChunks = wsChunks->y(0);
+    TS_ASSERT_DELTA(std::accumulate(yChunks.cbegin(), yChunks.cend(), 0.),
+                    std::accumulate(y.cbegin(), y.cend(), 0.), 1e-6);
+    for (size_t i = 0; i < y.size(); ++i)
+      TS_ASSERT_DELTA(yChunks[i], y[i], 1e-6);
+
+    AnalysisDataService::Instance().remove(WS_NAME_CHUNKS);
+    AnalysisDataService::Instance().remove(WS_NAME);
+  }
+
+private:
+  void runAlgorithm(const std::string &name, const double chunkSize,
+                    const bool sumSpectra) {
+    LoadEventAndRebin alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize());
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Filename", FILENAME));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputWorkspace", name));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Params", PARAMS));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("FilterBadPulses", "0"));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("SumSpectra", sumSpectra));
+    if (chunkSize > 0.)
+      TS_ASSERT_THROWS_NOTHING(alg.setProperty("MaxChunkSize", chunkSize));
+    TS_ASSERT_THROWS_NOTHING(alg.execute(););
+    TS_ASSERT(alg.isExecuted());
+  }
+};